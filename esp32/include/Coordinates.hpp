@@ -0,0 +1,71 @@
+#pragma once
+#ifndef COORDINATES_H
+#define COORDINATES_H
+#include <Arduino.h>
+
+/**
+ * @brief Coordinate units per degree, coordinates are int32 in 1e-7 degrees
+ *
+ * @details 1e-7 degree is about 1.1 cm, and ±180 degrees fit in an int32.
+ */
+#define COORDINATE_SCALE 10000000L
+
+/**
+ * @brief Centimeters per 10000 coordinate units, a thousandth of a degree of latitude
+ */
+#define COORDINATE_CENTIMETERS_PER_MILLIDEGREE 11132
+
+/**
+ * @brief Fixed-point of the cosines, 1.0 is 1 << COORDINATE_COSINE_BITS
+ */
+#define COORDINATE_COSINE_BITS 15
+
+/**
+ * @brief Integer geometry on coordinates, for the ESP32-C3 that has no FPU
+ */
+namespace Coordinates
+{
+    /**
+     * @brief Degrees of a coordinate, for the logs
+     */
+    inline double toDegrees(int32_t units) { return (double)units / COORDINATE_SCALE; }
+
+    /**
+     * @brief North-south distance in centimeters of a difference of latitude
+     */
+    inline int64_t toCentimeters(int64_t units) { return units * COORDINATE_CENTIMETERS_PER_MILLIDEGREE / 10000; }
+
+    /**
+     * @brief Difference of latitude of a north-south distance in centimeters
+     */
+    inline int64_t fromCentimeters(int64_t centimeters) { return centimeters * 10000 / COORDINATE_CENTIMETERS_PER_MILLIDEGREE; }
+
+    /**
+     * @brief Cosine of a latitude, in 1 << COORDINATE_COSINE_BITS
+     *
+     * @details Table of the whole degrees with linear interpolation, within 0.1% of the cosine up to 85 degrees.
+     */
+    int32_t cosine(int32_t latitude);
+
+    /**
+     * @brief Integer square root, rounded down
+     */
+    uint32_t squareRoot(uint64_t value);
+
+    /**
+     * @brief Distance in centimeters between two positions, equirectangular approximation
+     *
+     * @details Within a few meters up to tens of kilometers, the longitude difference is taken across the
+     * antimeridian when it is shorter.
+     */
+    uint32_t distance(int32_t latitude1, int32_t longitude1, int32_t latitude2, int32_t longitude2);
+
+    /**
+     * @brief Distance in centimeters between a position and the segment between two others
+     *
+     * @details In the equirectangular frame of the first end, UINT32_MAX when a point is more than 1000 km away.
+     */
+    uint32_t segmentDistance(int32_t latitude, int32_t longitude, int32_t latitude1, int32_t longitude1, int32_t latitude2, int32_t longitude2);
+}
+
+#endif // COORDINATES_H
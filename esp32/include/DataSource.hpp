@@ -0,0 +1,37 @@
+#pragma once
+#ifndef DATA_SOURCE_H
+#define DATA_SOURCE_H
+#include <Arduino.h>
+
+/**
+ * @brief Pull-based source of bytes
+ *
+ * @details The consumer asks for the next bytes when it has room for them, so a payload
+ * can be produced piece by piece instead of being built in memory first.
+ */
+class DataSource
+{
+public:
+    /**
+     * @brief Destructor
+     */
+    virtual ~DataSource() = default;
+
+    /**
+     * @brief Get the total number of bytes, known before the first read
+     *
+     * @return Number of bytes
+     */
+    virtual size_t size() const = 0;
+
+    /**
+     * @brief Copy the next bytes
+     *
+     * @param buffer Destination
+     * @param length Room in the destination
+     * @return Number of bytes copied, 0 once everything was read
+     */
+    virtual size_t read(uint8_t *buffer, size_t length) = 0;
+};
+
+#endif // DATA_SOURCE_H
@@ -0,0 +1,78 @@
+#pragma once
+#ifndef EVENT_LOOP_H
+#define EVENT_LOOP_H
+#include <Arduino.h>
+
+/**
+ * @brief Longest time the loop sleeps without any wakeup registered, in milliseconds
+ */
+#define EVENT_LOOP_MAX_WAIT 5000
+
+/**
+ * @brief Event loop
+ *
+ * @details The main loop sleeps at its end until something can change: bytes from the modem
+ * (UART onReceive), a notification from another task, or the nearest deadline registered
+ * during the iteration (FSM delays, AT command timeouts, poll intervals).
+ * Anything waiting on time must register its deadline with wakeAt(), or it will only
+ * be checked after EVENT_LOOP_MAX_WAIT.
+ */
+struct EventLoop
+{
+    /**
+     * @brief Task running loop(), woken by notify()
+     */
+    TaskHandle_t task = nullptr;
+
+    /**
+     * @brief Nearest deadline registered during the iteration (millis)
+     */
+    unsigned long nextWake = 0;
+
+    /**
+     * @brief Whether a deadline was registered during the iteration
+     */
+    bool hasWake = false;
+
+    /**
+     * @brief Number of iterations, to measure how often the loop runs
+     */
+    uint32_t cycles = 0;
+
+    /**
+     * @brief Setup function
+     *
+     * @details Must be called from the task running loop().
+     */
+    void setup();
+
+    /**
+     * @brief Wake the loop up
+     *
+     * @details Can be called from another task, e.g. the UART event task. Not from an ISR.
+     */
+    void notify();
+
+    /**
+     * @brief Ask for the next iteration to run no later than a time
+     *
+     * @param time Time (millis) of the deadline
+     */
+    void wakeAt(unsigned long time);
+
+    /**
+     * @brief Ask for the next iteration to run right away
+     */
+    void wakeNow();
+
+    /**
+     * @brief Sleep until a notification or the nearest deadline
+     *
+     * @details Called once at the end of loop(), the registered deadlines are then cleared.
+     */
+    void wait();
+};
+
+extern EventLoop events;
+
+#endif // EVENT_LOOP_H
@@ -2,6 +2,7 @@
 #ifndef FSM_H
 #define FSM_H
 #include <Arduino.h>
+#include <EventLoop.hpp>
 // #include <SIM7080G/Serial.hpp>
 
 /**
@@ -103,6 +104,7 @@ struct FSM
      * @param delayTime The time to delay in milliseconds
      *
      * @details This function is used to delay the FSM without blocking the main loop.
+     * The end of the delay is registered with the event loop.
      */
     bool delay(int delayTime);
 
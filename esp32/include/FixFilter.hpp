@@ -0,0 +1,121 @@
+#pragma once
+#ifndef FIX_FILTER_H
+#define FIX_FILTER_H
+#include <Arduino.h>
+#include <Coordinates.hpp>
+
+/**
+ * @brief Acceleration noise of the constant-velocity model, in cm/s² squared
+ */
+#define FIX_FILTER_ACCELERATION_NOISE (50L * 50L)
+
+/**
+ * @brief Speed uncertainty of a new track, in cm/s squared
+ */
+#define FIX_FILTER_INITIAL_SPEED_VARIANCE (500LL * 500LL)
+
+/**
+ * @brief Bounds of the position and speed variances, they keep the fixed-point products within 64 bits
+ */
+#define FIX_FILTER_MAX_POSITION_VARIANCE 1000000000LL
+#define FIX_FILTER_MAX_SPEED_VARIANCE 100000000LL
+
+/**
+ * @brief Innovation gate in standard deviations, a fix further away is an outlier
+ */
+#define FIX_FILTER_GATE 3
+
+/**
+ * @brief Consecutive outliers after which the filter starts again from the last fix
+ */
+#define FIX_FILTER_MAX_OUTLIERS 3
+
+/**
+ * @brief Time without fix after which the track is dropped, in milliseconds
+ */
+#define FIX_FILTER_MAX_GAP (1000UL * 60 * 5)
+
+/**
+ * @brief Constant-velocity Kalman filter over successive GNSS fixes
+ *
+ * @details Positions are kept in centimeters north and east of the first fix, speeds in cm/s, all in
+ * integers: the ESP32-C3 has no FPU. The two axes are filtered apart with the same measurement noise,
+ * taken from the HPA of each fix.
+ */
+class FixFilter
+{
+private:
+    /**
+     * @brief State and covariance of one axis
+     */
+    struct Axis
+    {
+        int32_t position;
+        int32_t speed;
+        int64_t p00;
+        int64_t p01;
+        int64_t p11;
+
+        void reset(int32_t position, int64_t variance);
+        void predict(int64_t dt);
+        int64_t innovation(int32_t measurement) const { return (int64_t)measurement - position; }
+        void correct(int64_t innovation, int64_t variance);
+    };
+
+    Axis north;
+    Axis east;
+
+    /**
+     * @brief Origin of the local frame, the first fix, in 1e-7 degrees
+     */
+    int32_t originLatitude = 0;
+    int32_t originLongitude = 0;
+
+    /**
+     * @brief Cosine of the origin latitude, in 1 << COORDINATE_COSINE_BITS
+     */
+    int32_t originCosine = 0;
+
+    /**
+     * @brief Time (millis) of the last fix used
+     */
+    unsigned long lastTime = 0;
+
+    uint8_t outliers = 0;
+    bool initialized = false;
+
+    void start(int32_t latitude, int32_t longitude, int64_t variance, unsigned long time);
+
+public:
+    /**
+     * @brief Forget the track
+     */
+    void reset() { initialized = false; }
+
+    /**
+     * @brief Check if at least one fix was used
+     */
+    bool hasEstimate() const { return initialized; }
+
+    /**
+     * @brief Fuse a fix
+     *
+     * @param latitude, longitude Position in 1e-7 degrees
+     * @param accuracy Horizontal accuracy of the fix in centimeters
+     * @param time Time (millis) of the fix
+     * @return false if the fix was rejected as an outlier
+     */
+    bool update(int32_t latitude, int32_t longitude, uint32_t accuracy, unsigned long time);
+
+    /**
+     * @brief Horizontal standard deviation of the estimate in centimeters
+     */
+    uint32_t uncertainty() const;
+
+    /**
+     * @brief Filtered position in 1e-7 degrees
+     */
+    void estimate(int32_t &latitude, int32_t &longitude) const;
+};
+
+#endif // FIX_FILTER_H
@@ -0,0 +1,117 @@
+#pragma once
+#ifndef GEOFENCE_H
+#define GEOFENCE_H
+#include <Arduino.h>
+#include <Coordinates.hpp>
+
+/**
+ * @brief Most fences watched at once, one bit each in the inside mask
+ */
+#define GEOFENCE_MAX 64
+
+/**
+ * @brief Default distance in meters past the boundary before a crossing counts, against the GNSS noise
+ */
+#define GEOFENCE_MARGIN 10
+
+/**
+ * @brief Largest span of a fence in 1e-7 degrees, 90 degrees, it keeps the crossing products within 64 bits
+ */
+#define GEOFENCE_MAX_SPAN (90L * COORDINATE_SCALE)
+
+/**
+ * @brief Vertex of a fence, in 1e-7 degrees
+ */
+struct GeofencePoint
+{
+    int32_t latitude;
+    int32_t longitude;
+};
+
+/**
+ * @brief Polygon watched by the collar, it must not cross the antimeridian
+ */
+struct Geofence
+{
+    const char *name;
+    const GeofencePoint *vertices;
+    uint8_t count;
+};
+
+/**
+ * @brief Evaluate the fences on each fix and flag the crossings
+ *
+ * @details The bounding box of each fence is computed once by begin(), a fix outside of it is outside of
+ * the fence without looking at the vertices. Inside a box, an even-odd ray cast in integers tells if the
+ * fix is in the polygon. A change of side counts only once the fix is margin meters past the boundary, so
+ * a collar resting on it does not raise an alert on every fix.
+ */
+class Geofences
+{
+private:
+    /**
+     * @brief Bounding box of a fence, in 1e-7 degrees
+     */
+    struct Box
+    {
+        int32_t south;
+        int32_t west;
+        int32_t north;
+        int32_t east;
+    };
+
+    const Geofence *fences = nullptr;
+    uint8_t count = 0;
+    Box boxes[GEOFENCE_MAX];
+
+    /**
+     * @brief Bit i is set while the collar is inside fence i
+     */
+    uint64_t inside = 0;
+    bool hasState = false;
+
+    /**
+     * @brief Check if a position is inside a fence
+     */
+    bool contains(uint8_t fence, int32_t latitude, int32_t longitude) const;
+
+    /**
+     * @brief Distance in centimeters between a position and the boundary of a fence
+     */
+    uint32_t boundaryDistance(uint8_t fence, int32_t latitude, int32_t longitude) const;
+
+public:
+    /**
+     * @brief Distance in meters past the boundary before a crossing counts
+     */
+    uint32_t margin = GEOFENCE_MARGIN;
+
+    /**
+     * @brief Set when a fence is crossed, the upload it triggers clears it
+     */
+    bool alert = false;
+
+    /**
+     * @brief Watch a table of fences, the table must outlive the watch
+     *
+     * @details Fences beyond GEOFENCE_MAX, with less than 3 vertices or wider than GEOFENCE_MAX_SPAN are ignored.
+     */
+    void begin(const Geofence *fences, uint8_t count);
+
+    /**
+     * @brief Evaluate the fences on a fix, the first fix only sets the sides
+     *
+     * @param latitude, longitude Position in 1e-7 degrees
+     * @return True if a fence was crossed, alert is then set
+     */
+    bool update(int32_t latitude, int32_t longitude);
+
+    /**
+     * @brief Check if the collar was inside a fence on the last fix
+     */
+    bool isInside(uint8_t fence) const { return inside & (1ULL << fence); }
+};
+
+extern Geofences geofences;
+
+#endif // GEOFENCE_H
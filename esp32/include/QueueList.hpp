@@ -2,93 +2,212 @@
 #define QUEUE_LIST_HPP
 #include <nlohmann/json.hpp>
 #include <Arduino.h>
+#include <DataSource.hpp>
+#include <new>
 
 using json = nlohmann::json;
 
-struct Node
+/**
+ * @brief Most items held by the queue, a power of two, the oldest item makes room for a new one
+ */
+#define QUEUE_LIST_CAPACITY 128
+
+/**
+ * @brief Bytes of an item in a record, the largest DataItem must fit
+ */
+#define QUEUE_LIST_RECORD_SIZE 48
+
+/**
+ * @brief Type of an item, sent as its name
+ */
+enum DataType : uint8_t
 {
+    DATA_GNSS,
+    DATA_CELL,
+    DATA_BATTERY
+};
+
+/**
+ * @brief Name of a type, "GNSS", "CELL" or "BATTERY"
+ */
+const char *dataTypeName(DataType type);
+
+class DataItem
+{
+public:
+    /**
+     * @brief Destructor
+     */
+    virtual ~DataItem() = default;
     /**
-     * @brief Pointer to the data
+     * @brief Convert to json
+     * @return Json object
      */
-    void *data;
+    virtual json to_json() const = 0;
+};
+
+/**
+ * @brief Slot of the queue, the item is built in place
+ */
+struct QueueRecord
+{
     /**
-     * @brief Type of the data
+     * @brief Storage of the item
      */
-    std::string type;
+    alignas(8) uint8_t data[QUEUE_LIST_RECORD_SIZE];
     /**
-     * @brief Pointer to the next node
+     * @brief Item built in data
      */
-    Node *next;
-
+    DataItem *item;
     /**
-     * @brief Constructor
-     * @param d Pointer to the data
-     * @param t Type of the data
+     * @brief Type of the item
      */
-    Node(void *d, const std::string &t) : data(d), type(t), next(nullptr) {}
+    DataType type;
 };
 
-class DataItem
+class QueueList;
+
+/**
+ * @brief CBOR encoding of a queue, produced one item at a time
+ *
+ * @details Gives the same bytes as QueueList::to_cbor(), but only the CBOR of the item
+ * being read is held in memory. Items queued after begin() are left for the next encoding. If a full queue
+ * evicts an item before it is read, the encoding stops short of size(): the send fails and what is left stays
+ * queued for the next one.
+ */
+class QueueListCbor : public DataSource
 {
+private:
+    /**
+     * @brief Queue encoded
+     */
+    const QueueList *queue = nullptr;
+
+    /**
+     * @brief Number of items encoded, taken once for both passes
+     */
+    size_t count = 0;
+
+    /**
+     * @brief Next item to encode, from the head at begin()
+     */
+    size_t index = 0;
+
+    /**
+     * @brief Items dequeued before begin(), to tell the encoded ones dropped since
+     */
+    uint32_t start = 0;
+
+    /**
+     * @brief Bytes being read: the envelope header, one item or the envelope trailer
+     */
+    std::vector<uint8_t> chunk;
+
+    /**
+     * @brief Bytes of chunk already read
+     */
+    size_t chunkOffset = 0;
+
+    /**
+     * @brief Part of the envelope being read, 0 header, 1 items, 2 trailer, 3 done
+     */
+    uint8_t stage = 0;
+
+    /**
+     * @brief Timestamp of the envelope, taken once for both passes
+     */
+    long time = 0;
+
+    /**
+     * @brief Total number of bytes
+     */
+    size_t total = 0;
+
+    /**
+     * @brief Encode the next part of the envelope into chunk
+     *
+     * @return false once everything was encoded
+     */
+    bool nextChunk();
+
 public:
     /**
-     * @brief Destructor
+     * @brief Start encoding a queue
+     *
+     * @details Runs a first pass over the items to know the size announced to AT+CASEND.
+     *
+     * @param queue Queue to encode
      */
-    virtual ~DataItem() = default;
+    void begin(const QueueList &queue);
+
     /**
-     * @brief Convert to json
-     * @return Json object
+     * @brief Drop the encoding buffer
      */
-    virtual json to_json() const = 0;
+    void end();
+
     /**
-     * @brief Get the type of the data
-     * @return Type of the data
+     * @brief Number of encoded items still at the head of the queue, the ones to drop once they are sent
      */
-    virtual std::string get_type() const = 0;
+    size_t items() const;
+
+    size_t size() const override;
+    size_t read(uint8_t *buffer, size_t length) override;
 };
 
 /**
- * @brief Queue list
+ * @brief Queue of the items to upload, a fixed ring of records
+ *
+ * @details The items are copied into the records, without any allocation, and read in order from a contiguous
+ * array. When the queue is full, the oldest item is dropped to make room.
  */
 class QueueList
 {
+    friend class QueueListCbor;
+
 private:
     /**
-     * @brief Pointer to the head of the queue
+     * @brief Records, head is the oldest
      */
-    Node *head;
+    QueueRecord records[QUEUE_LIST_CAPACITY];
     /**
-     * @brief Pointer to the tail of the queue
+     * @brief Index of the oldest record
      */
-    Node *tail;
+    size_t head;
     /**
      * @brief Count of the queue
      */
     size_t count;
+    /**
+     * @brief Items dequeued since boot
+     */
+    uint32_t dequeued = 0;
 
     /**
-     * @brief Clone the data
-     * @param item Item to clone
-     * @return Cloned item
+     * @brief Record at a position from the head
      */
-    template <typename T>
-    static T *clone(const T &item)
-    {
-        return new T(item);
-    };
+    const QueueRecord &at(size_t index) const { return records[(head + index) & (QUEUE_LIST_CAPACITY - 1)]; }
 
     /**
-     * @brief Convert to the data
-     * @param ptr Pointer to the data
-     * @return Data
+     * @brief Free record at the tail, the oldest item is dropped if the queue is full
      */
-    template <typename T>
-    static T *as(void *ptr)
-    {
-        return static_cast<T *>(ptr);
-    };
+    QueueRecord &push();
 
 public:
+    /**
+     * @brief Items dropped because the queue was full, since boot
+     */
+    uint32_t dropped = 0;
+
+    /**
+     * @brief Called once an item is queued, e.g. to keep a copy in flash
+     */
+    void (*onEnqueue)(const QueueRecord &record) = nullptr;
+
+    /**
+     * @brief Called before the oldest item leaves the queue, sent or dropped
+     */
+    void (*onDequeue)() = nullptr;
+
     /**
      * @brief Constructor
      */
@@ -100,30 +219,32 @@ public:
 
     /**
      * @brief Enqueue an item
-     * @param item Item to enqueue
+     * @param item Item to enqueue, copied into the queue
      */
     template <typename T>
     void enqueue(const T &item)
     {
         static_assert(std::is_base_of<DataItem, T>::value, "T must derive from DataItem");
+        static_assert(sizeof(T) <= QUEUE_LIST_RECORD_SIZE && alignof(T) <= 8, "T must fit in a record");
 
-        T *data_copy = clone(item);
-        std::string type = data_copy->get_type();
+        QueueRecord &record = push();
+        record.item = new (record.data) T(item);
+        record.type = T::TYPE;
 
-        Node *new_node = new Node(static_cast<void *>(data_copy), type);
+        if (onEnqueue)
+            onEnqueue(record);
+    };
 
-        if (tail == nullptr)
-        {
-            head = tail = new_node;
-        }
-        else
-        {
-            tail->next = new_node;
-            tail = new_node;
-        }
+    /**
+     * @brief Drop the oldest item
+     */
+    void dequeue();
 
-        count++;
-    };
+    /**
+     * @brief Drop the oldest items, e.g. the ones just sent
+     * @param items Number of items to drop
+     */
+    void drop(size_t items);
 
     /**
      * @brief Check if the queue is empty
@@ -131,6 +252,12 @@ public:
      */
     bool isEmpty() const;
 
+    /**
+     * @brief Get the number of items
+     * @return Number of items
+     */
+    size_t size() const;
+
     /**
      * @brief Get the size of the queue
      * @return Size of the queue
@@ -0,0 +1,209 @@
+#pragma once
+#ifndef QUEUE_STORE_H
+#define QUEUE_STORE_H
+#include <Arduino.h>
+#include <QueueList.hpp>
+#include <vector>
+
+/**
+ * @brief Directory of the log segments on LittleFS
+ */
+#define QUEUE_STORE_DIRECTORY "/queue"
+
+/**
+ * @brief Size in bytes past which a new segment is started
+ */
+#define QUEUE_STORE_SEGMENT_SIZE 4096
+
+/**
+ * @brief Most segments kept, the oldest is deleted to make room even with items not sent
+ */
+#define QUEUE_STORE_MAX_SEGMENTS 16
+
+/**
+ * @brief Items buffered before they are written, a write wears a whole flash page
+ */
+#define QUEUE_STORE_BATCH 8
+
+/**
+ * @brief Longest time an item or an upload waits in the buffer before it is written, in milliseconds
+ */
+#define QUEUE_STORE_FLUSH_DELAY (1000UL * 60 * 5)
+
+/**
+ * @brief First byte of a record, any other byte ends the segment
+ */
+#define QUEUE_STORE_MAGIC 0x51
+
+/**
+ * @brief Kind of a commit record, the kind of an item record is its DataType
+ */
+#define QUEUE_STORE_COMMIT 0xFF
+
+/**
+ * @brief Bytes of a record around its payload: magic, kind, length, sequence, then the CRC-32
+ */
+#define QUEUE_STORE_HEADER_SIZE 8
+#define QUEUE_STORE_CRC_SIZE 4
+
+/**
+ * @brief Copy of the upload queue in flash, rebuilt at boot after a power loss
+ *
+ * @details A write-ahead log split in append-only segments. Each queued item gets a sequence number and is
+ * appended as a record, its CBOR with a CRC-32; an upload appends a commit record, the last sequence sent.
+ * Records are buffered and written by batches of QUEUE_STORE_BATCH, or after QUEUE_STORE_FLUSH_DELAY, and
+ * items already sent by then are never written. A segment is deleted once all of its items are committed.
+ *
+ * At boot, begin() reads the segments in order, stops a segment at its first torn or corrupt record, and queues
+ * again the items past the last commit. A power loss loses at most the buffered items; an upload whose
+ * commit was not written yet is sent again.
+ */
+class QueueStore
+{
+private:
+    /**
+     * @brief Segment file, named after its index
+     */
+    struct Segment
+    {
+        uint32_t index;
+        /**
+         * @brief Last item sequence in the segment, 0 if none
+         */
+        uint32_t last;
+        /**
+         * @brief Bytes written
+         */
+        size_t size;
+    };
+
+    /**
+     * @brief Segments, oldest first, the last one is appended to
+     */
+    Segment segments[QUEUE_STORE_MAX_SEGMENTS];
+    size_t segmentCount = 0;
+
+    /**
+     * @brief Index of the next segment started
+     */
+    uint32_t nextSegment = 0;
+
+    /**
+     * @brief Start a new segment on the next write, e.g. after a boot or a failed write
+     */
+    bool roll = true;
+
+    /**
+     * @brief Sequences of the items in the queue, in the same order
+     */
+    uint32_t sequences[QUEUE_LIST_CAPACITY];
+    size_t head = 0;
+    size_t count = 0;
+
+    /**
+     * @brief Sequence of the next item
+     */
+    uint32_t nextSequence = 1;
+
+    /**
+     * @brief Sequence of the item being queued again by begin(), 0 otherwise
+     */
+    uint32_t restoring = 0;
+
+    /**
+     * @brief Last item sequence left the queue, sent or dropped
+     */
+    uint32_t committed = 0;
+
+    /**
+     * @brief Last commit written
+     */
+    uint32_t durable = 0;
+
+    /**
+     * @brief Last item sequence written
+     */
+    uint32_t written = 0;
+
+    /**
+     * @brief Records waiting to be written
+     */
+    std::vector<uint8_t> buffer;
+    size_t batchItems = 0;
+
+    /**
+     * @brief Time (millis) since which something waits to be written
+     */
+    unsigned long batchTime = 0;
+
+    /**
+     * @brief Check if something waits to be written
+     */
+    bool dirty() const { return !buffer.empty() || needsCommit(); }
+
+    /**
+     * @brief Check if items written were sent since the last commit written
+     */
+    bool needsCommit() const { return committed > durable && written > durable; }
+
+    void appendRecord(std::vector<uint8_t> &out, uint8_t kind, uint32_t sequence, const uint8_t *payload, size_t length) const;
+    void path(char *out, uint32_t index) const;
+    void openSegment();
+    void purge();
+    void scan(Segment &segment, QueueList *queue);
+
+public:
+    /**
+     * @brief Time taken by the last begin(), in milliseconds
+     */
+    unsigned long recoveryTime = 0;
+
+    /**
+     * @brief Items queued again by the last begin()
+     */
+    size_t restored = 0;
+
+    /**
+     * @brief Bytes written since boot
+     */
+    uint32_t bytesWritten = 0;
+
+    /**
+     * @brief Rebuild a queue from the segments
+     *
+     * @details LittleFS must be mounted and the hooks of the queue set, before anything is queued.
+     *
+     * @param queue Empty queue, the items not sent are queued again in order
+     */
+    void begin(QueueList &queue);
+
+    /**
+     * @brief Write the buffer if it is full or old enough, called on each loop
+     */
+    void loop();
+
+    /**
+     * @brief Write the buffer now, e.g. before the power goes off
+     *
+     * @details On a short write, the records not written whole stay in the buffer for the next batch.
+     *
+     * @return false if the write failed, the items stay in the queue
+     */
+    bool flush();
+
+    /**
+     * @brief Hook of QueueList::enqueue(), buffer the item
+     */
+    void enqueued(const QueueRecord &record);
+
+    /**
+     * @brief Hook of QueueList::dequeue(), commit the oldest item
+     *
+     * @details Only called for an upload the modem confirmed, or an item dropped from a full queue.
+     */
+    void dequeued();
+};
+
+extern QueueStore queueStore;
+
+#endif // QUEUE_STORE_H
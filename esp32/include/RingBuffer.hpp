@@ -0,0 +1,191 @@
+#pragma once
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+#include <Arduino.h>
+
+/**
+ * @brief Fixed-capacity byte ring buffer
+ *
+ * @details Bytes are addressed by absolute positions that only grow, so a position stays
+ * valid until the byte is overwritten. The storage is mirrored: every byte is also written
+ * Capacity bytes further, which makes any span of up to Capacity bytes contiguous in memory
+ * even when it wraps around the end of the ring.
+ *
+ * @tparam Capacity Number of bytes kept, must be a power of two
+ */
+template <size_t Capacity>
+class RingBuffer
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+private:
+    /**
+     * @brief Storage, the second half mirrors the first one
+     */
+    char storage[Capacity * 2];
+
+    /**
+     * @brief Position after the last byte written
+     */
+    size_t head = 0;
+
+    /**
+     * @brief Position of the oldest byte kept
+     */
+    size_t tail = 0;
+
+    /**
+     * @brief Copy freshly written bytes to their mirror
+     *
+     * @param index Index of the first byte in the first half
+     * @param length Number of bytes, must not cross the end of the first half
+     */
+    void mirror(size_t index, size_t length)
+    {
+        memcpy(storage + Capacity + index, storage + index, length);
+    }
+
+    /**
+     * @brief Overwrite the byte at a position, and its mirror
+     */
+    void put(size_t position, char c)
+    {
+        size_t index = position & (Capacity - 1);
+        storage[index] = c;
+        storage[index + Capacity] = c;
+    }
+
+public:
+    /**
+     * @brief Position of the oldest byte kept
+     */
+    size_t begin() const { return tail; }
+
+    /**
+     * @brief Position after the last byte written
+     */
+    size_t end() const { return head; }
+
+    /**
+     * @brief Number of bytes kept
+     */
+    size_t size() const { return head - tail; }
+
+    /**
+     * @brief Number of bytes that can be written before the buffer is full
+     */
+    size_t space() const { return Capacity - size(); }
+
+    /**
+     * @brief Get a pointer to the byte at a position
+     *
+     * @details The pointer can be read for up to Capacity bytes without wrapping.
+     *
+     * @param position Absolute position of the byte
+     * @return Pointer into the storage
+     */
+    const char *at(size_t position) const
+    {
+        return storage + (position & (Capacity - 1));
+    }
+
+    /**
+     * @brief Drop every byte before a position
+     *
+     * @param position First position to keep
+     */
+    void consume(size_t position)
+    {
+        tail = position;
+    }
+
+    /**
+     * @brief Drop every byte
+     */
+    void clear()
+    {
+        tail = head;
+    }
+
+    /**
+     * @brief Remove a span of bytes, the bytes after it move back to fill the gap
+     *
+     * @details Positions after the span shift down by its length.
+     *
+     * @param from First position removed
+     * @param to Position after the last byte removed
+     */
+    void erase(size_t from, size_t to)
+    {
+        size_t count = head - to;
+
+        for (size_t i = 0; i < count; i++)
+            put(from + i, *at(to + i));
+
+        head -= to - from;
+    }
+
+    /**
+     * @brief Write bytes
+     *
+     * @param data Bytes to write
+     * @param length Number of bytes
+     * @return Number of bytes written, less than length when the buffer is full
+     */
+    size_t write(const char *data, size_t length)
+    {
+        size_t count = length < space() ? length : space();
+        size_t written = 0;
+
+        while (written < count)
+        {
+            size_t index = head & (Capacity - 1);
+            size_t chunk = count - written < Capacity - index ? count - written : Capacity - index;
+
+            memcpy(storage + index, data + written, chunk);
+            mirror(index, chunk);
+            head += chunk;
+            written += chunk;
+        }
+
+        return written;
+    }
+
+    /**
+     * @brief Read everything a stream has available, in one call
+     *
+     * @details Bytes are read straight into the storage, no intermediate copy is made.
+     * What does not fit stays in the stream.
+     *
+     * @param source Stream providing available() and read(uint8_t *, size_t)
+     * @return Number of bytes read
+     */
+    template <typename Source>
+    size_t receive(Source &source)
+    {
+        int available = source.available();
+        if (available <= 0)
+            return 0;
+
+        size_t count = (size_t)available < space() ? (size_t)available : space();
+        size_t received = 0;
+
+        while (received < count)
+        {
+            size_t index = head & (Capacity - 1);
+            size_t chunk = count - received < Capacity - index ? count - received : Capacity - index;
+
+            size_t read = source.read((uint8_t *)storage + index, chunk);
+            if (read == 0)
+                break;
+
+            mirror(index, read);
+            head += read;
+            received += read;
+        }
+
+        return received;
+    }
+};
+
+#endif // RING_BUFFER_H
@@ -0,0 +1,295 @@
+#pragma once
+#ifndef SIM7080G_AT_COMMANDS_H
+#define SIM7080G_AT_COMMANDS_H
+#include <SIM7080G/Serial.hpp>
+
+/**
+ * @brief Quoted string argument
+ *
+ * @details Written between double quotes by the %q placeholder.
+ */
+struct Quoted
+{
+    const char *value;
+};
+
+/**
+ * @brief Placeholder letter expected for an argument type
+ *
+ * @details %d for integers, %q for Quoted, %s for raw text. Any other type does not compile.
+ */
+template <typename T>
+struct ATArgumentKind;
+
+template <>
+struct ATArgumentKind<int>
+{
+    static constexpr char value = 'd';
+};
+
+template <>
+struct ATArgumentKind<long>
+{
+    static constexpr char value = 'd';
+};
+
+template <>
+struct ATArgumentKind<Quoted>
+{
+    static constexpr char value = 'q';
+};
+
+template <>
+struct ATArgumentKind<const char *>
+{
+    static constexpr char value = 's';
+};
+
+/**
+ * @brief Argument of a command, once its type is erased
+ */
+struct ATArgument
+{
+    char kind;
+    long number;
+    const char *text;
+
+    ATArgument(int value) : kind('d'), number(value), text(nullptr) {}
+    ATArgument(long value) : kind('d'), number(value), text(nullptr) {}
+    ATArgument(Quoted value) : kind('q'), number(0), text(value.value) {}
+    ATArgument(const char *value) : kind('s'), number(0), text(value) {}
+};
+
+/**
+ * @brief Reached only by malformed command patterns
+ *
+ * @details Not constexpr on purpose: evaluating it while building a constexpr ATCommandSpec
+ * stops the compilation.
+ */
+void malformedATCommand();
+
+/**
+ * @brief Check a command pattern against its argument types
+ *
+ * @param pattern Command pattern, e.g. "AT+CASEND=%d,%d"
+ * @param kinds Expected placeholder letters, in order, null-terminated
+ * @return true if the pattern starts with AT, has no line ending, and has exactly one valid placeholder per argument
+ */
+constexpr bool isValidATPattern(const char *pattern, const char *kinds)
+{
+    if (pattern[0] != 'A' || pattern[1] != 'T')
+        return false;
+
+    size_t argument = 0;
+
+    for (size_t i = 0; pattern[i] != '\0'; i++)
+    {
+        if (pattern[i] == '\r' || pattern[i] == '\n')
+            return false;
+
+        if (pattern[i] != '%')
+            continue;
+
+        if (kinds[argument] == '\0' || pattern[i + 1] != kinds[argument])
+            return false;
+
+        argument++;
+        i++;
+    }
+
+    return kinds[argument] == '\0';
+}
+
+/**
+ * @brief Writes a command into a fixed buffer
+ */
+class ATCommandWriter
+{
+private:
+    char *buffer;
+    size_t capacity;
+    size_t length = 0;
+    bool overflow = false;
+
+public:
+    ATCommandWriter(char *buffer, size_t capacity) : buffer(buffer), capacity(capacity) {}
+
+    void append(char c);
+    void append(const char *text);
+    void append(long number);
+
+    /**
+     * @brief Null-terminate the buffer
+     *
+     * @return true if everything fitted
+     */
+    bool finish();
+};
+
+/**
+ * @brief Format a command pattern with type-erased arguments
+ *
+ * @return true if the command fitted in the buffer and quoted arguments have no double quote
+ */
+bool formatATCommand(char *buffer, size_t capacity, const char *pattern, const ATArgument *arguments, size_t count);
+
+/**
+ * @brief Description of an AT command
+ *
+ * @details Holds the command pattern with one placeholder per argument (%d integer,
+ * %q quoted string, %s raw text), the line ending its response when it is not OK, the prefix of
+ * its information line, its default timeout and its priority. Declared constexpr, a pattern that does not
+ * match the argument types fails to compile.
+ *
+ * @tparam Args Argument types, int, long, Quoted or const char *
+ */
+template <typename... Args>
+class ATCommandSpec
+{
+private:
+    static constexpr char kinds[] = {ATArgumentKind<Args>::value..., '\0'};
+
+public:
+    /**
+     * @brief Command pattern
+     */
+    const char *pattern;
+
+    /**
+     * @brief Default timeout in milliseconds
+     */
+    unsigned long timeout;
+
+    /**
+     * @brief Line prefix ending the response instead of OK, nullptr for OK
+     */
+    const char *terminator;
+
+    /**
+     * @brief Prefix of the information line of the response, nullptr if there is none
+     */
+    const char *expected;
+
+    /**
+     * @brief Priority in the scheduler
+     */
+    AT_PRIORITY priority;
+
+    constexpr ATCommandSpec(const char *pattern, unsigned long timeout = 1000, const char *terminator = nullptr, const char *expected = nullptr, AT_PRIORITY priority = AT_PRIORITY_NORMAL)
+        : pattern(isValidATPattern(pattern, kinds) ? pattern : (malformedATCommand(), pattern)),
+          timeout(timeout),
+          terminator(terminator),
+          expected(expected),
+          priority(priority)
+    {
+    }
+
+    /**
+     * @brief Write the command into a buffer
+     *
+     * @param buffer Destination, usually on the stack
+     * @param args Arguments, in pattern order
+     * @return true if the command fitted
+     */
+    template <size_t N>
+    bool format(char (&buffer)[N], Args... args) const
+    {
+        const ATArgument arguments[] = {ATArgument(args)..., ATArgument(0)};
+        return formatATCommand(buffer, N, pattern, arguments, sizeof...(Args));
+    }
+
+    /**
+     * @brief Send the command through the scheduler
+     *
+     * @details Same polling contract as SIM7080GHardwareSerial::sendATCommand(),
+     * the command is formatted on the stack only when it is queued.
+     *
+     * @param future Handle of the caller
+     * @param args Arguments, in pattern order
+     * @return AT_RESPONSE Response of the command
+     */
+    AT_RESPONSE send(ATFuture &future, Args... args) const
+    {
+        if (future.slot < 0)
+        {
+            char command[SIM7080G_COMMAND_SIZE];
+
+            if (!format(command, args...))
+            {
+                Serial.printf("[x] AT command does not fit: %s\n", pattern);
+                return AT_RESPONSE{ATView(), true, AT_ERROR};
+            }
+
+            future = Sim7080G.submit(command, timeout, terminator, priority);
+            Sim7080G.setChaining(future, expected);
+        }
+
+        return Sim7080G.poll(future);
+    }
+
+    /**
+     * @brief Queue the command without polling it
+     *
+     * @details A read-only query can wait to be chained with the next query sent by another module,
+     * which saves a round-trip when its result is not needed right away.
+     *
+     * @param onComplete Called with the response, then the job is released. Nothing polls the job, without it the
+     * response is kept until it expires
+     * @param hold Time in milliseconds the query may wait for another one, 0 to run it when its turn comes
+     * @param args Arguments, in pattern order
+     * @return true if the command was queued
+     */
+    bool submit(void (*onComplete)(const AT_RESPONSE &response), unsigned long hold, Args... args) const
+    {
+        char command[SIM7080G_COMMAND_SIZE];
+
+        if (!format(command, args...))
+        {
+            Serial.printf("[x] AT command does not fit: %s\n", pattern);
+            return false;
+        }
+
+        ATFuture future = Sim7080G.submit(command, timeout, terminator, priority, 0, onComplete);
+        Sim7080G.setChaining(future, expected, hold);
+
+        return future.slot >= 0;
+    }
+};
+
+template <typename... Args>
+constexpr char ATCommandSpec<Args...>::kinds[];
+
+/**
+ * @brief Catalogue of the AT commands used by the firmware
+ */
+namespace ATCommands
+{
+    constexpr ATCommandSpec<> PROBE("AT", 300, nullptr, nullptr, AT_PRIORITY_LINK);
+    constexpr ATCommandSpec<long> IPR("AT+IPR=%d", 1000, nullptr, nullptr, AT_PRIORITY_LINK);
+
+    constexpr ATCommandSpec<> GSN("AT+GSN");
+    constexpr ATCommandSpec<> CBC("AT+CBC", 1000, nullptr, "+CBC:", AT_PRIORITY_LOW);
+    constexpr ATCommandSpec<int> CPOWD("AT+CPOWD=%d", 1000, "NORMAL POWER DOWN");
+
+    constexpr ATCommandSpec<int, int, int, int, int> GNSS_POWER_ON("AT+CGNSPWR=1;+CGNSMOD=%d,%d,%d,%d,%d", 2000);
+    constexpr ATCommandSpec<int> CGNSPWR("AT+CGNSPWR=%d", 2000);
+    constexpr ATCommandSpec<> CGNSINF("AT+CGNSINF", 2000, nullptr, "+CGNSINF:");
+    constexpr ATCommandSpec<int> CGNSURC("AT+CGNSURC=%d", 2000);
+    constexpr ATCommandSpec<Quoted, Quoted> HTTPTOFS("AT+HTTPTOFS=%q,%q", 60000, "+HTTPTOFS:");
+    constexpr ATCommandSpec<> CGNSCPY("AT+CGNSCPY", 5000);
+    constexpr ATCommandSpec<int> CGNSXTRA("AT+CGNSXTRA=%d", 2000);
+
+    constexpr ATCommandSpec<Quoted, const char *> CATM1_CONFIGURE("AT+CNMP=38;+CMNB=1;+CNACT=0,0;+CGDCONT=1,\"IP\",%q;+CNCFG=0,1,%s");
+    constexpr ATCommandSpec<int, int> PDP_ACTIVATE("AT+CNACT=%d,%d", 15000, "+APP PDP:");
+    constexpr ATCommandSpec<int, int> PDP_DEACTIVATE("AT+CNACT=%d,%d");
+    constexpr ATCommandSpec<> CEREG_READ("AT+CEREG?", 1000, nullptr, "+CEREG:");
+    constexpr ATCommandSpec<> CNACT_READ("AT+CNACT?", 1000, nullptr, "+CNACT:");
+    constexpr ATCommandSpec<> CPSI_READ("AT+CPSI?", 1000, nullptr, "+CPSI:");
+    constexpr ATCommandSpec<int, int> CLBS("AT+CLBS=%d,%d", 60000, nullptr, "+CLBS:");
+
+    constexpr ATCommandSpec<int, int, Quoted, Quoted, int> CAOPEN("AT+CAOPEN=%d,%d,%q,%q,%d", 10000, nullptr, "+CAOPEN:");
+    constexpr ATCommandSpec<int, int> CASEND("AT+CASEND=%d,%d", 1000, ">", nullptr, AT_PRIORITY_HIGH);
+    constexpr ATCommandSpec<int> CACLOSE("AT+CACLOSE=%d");
+}
+
+#endif // SIM7080G_AT_COMMANDS_H
@@ -0,0 +1,144 @@
+#pragma once
+#ifndef SIM7080G_AT_VIEW_H
+#define SIM7080G_AT_VIEW_H
+#include <Arduino.h>
+
+/**
+ * @brief Non-owning view on AT response text
+ *
+ * @details This class points into the receive buffer of the modem, nothing is copied.
+ * It offers the subset of the Arduino String API used to parse responses, and a view
+ * stays valid until the receive buffer is reused by the next command.
+ */
+class ATView : public Printable
+{
+private:
+    /**
+     * @brief First character
+     */
+    const char *text;
+
+    /**
+     * @brief Number of characters
+     */
+    size_t size;
+
+public:
+    /**
+     * @brief Default constructor, empty view
+     */
+    ATView() : text(""), size(0) {}
+
+    /**
+     * @brief Constructor with a pointer and a length
+     */
+    ATView(const char *text, size_t size) : text(text), size(size) {}
+
+    /**
+     * @brief Constructor with a null-terminated string
+     */
+    ATView(const char *text) : text(text), size(strlen(text)) {}
+
+    /**
+     * @brief Get the first character
+     *
+     * @return Pointer to the first character, not null-terminated
+     */
+    const char *data() const { return text; }
+
+    /**
+     * @brief Get the number of characters
+     */
+    size_t length() const { return size; }
+
+    /**
+     * @brief Check if the view is empty
+     */
+    bool isEmpty() const { return size == 0; }
+
+    /**
+     * @brief Get a character
+     */
+    char operator[](size_t index) const { return text[index]; }
+
+    /**
+     * @brief Find a character
+     *
+     * @return Index of the character, -1 if not found
+     */
+    int indexOf(char c, size_t from = 0) const;
+
+    /**
+     * @brief Find a string
+     *
+     * @return Index of the string, -1 if not found
+     */
+    int indexOf(const char *pattern, size_t from = 0) const;
+
+    /**
+     * @brief Get the view from an index to the end
+     */
+    ATView substring(size_t from) const;
+
+    /**
+     * @brief Get the view between two indexes
+     */
+    ATView substring(size_t from, size_t to) const;
+
+    /**
+     * @brief Remove leading and trailing whitespace
+     */
+    void trim();
+
+    /**
+     * @brief Check if the view starts with a string
+     */
+    bool startsWith(const char *prefix) const;
+
+    /**
+     * @brief Check if the view equals a string
+     */
+    bool equals(const char *other) const;
+
+    bool operator==(const char *other) const { return equals(other); }
+    bool operator!=(const char *other) const { return !equals(other); }
+
+    /**
+     * @brief Parse a leading integer, like atoi()
+     */
+    long toInt() const;
+
+    /**
+     * @brief Parse a leading decimal number, like String::toFloat()
+     */
+    float toFloat() const;
+
+    /**
+     * @brief Parse a leading decimal number as an integer count of 10^-decimals, without floating point
+     *
+     * @details "45.7640431" with 7 decimals gives 457640431. Further digits are rounded.
+     */
+    long toFixed(uint8_t decimals) const;
+
+    /**
+     * @brief Copy the view into a String
+     *
+     * @details This allocates, keep it for logs.
+     */
+    String toString() const;
+
+    /**
+     * @brief Get the next non-empty line
+     *
+     * @param offset Where to start, moved past the returned line
+     * @return The trimmed line, empty when there is no line left
+     */
+    ATView nextLine(size_t &offset) const;
+
+    /**
+     * @brief Print the view without copying it
+     */
+    size_t printTo(Print &p) const override;
+};
+
+#endif // SIM7080G_AT_VIEW_H
@@ -2,8 +2,14 @@
 #ifndef SIM7080G_CATM1_H
 #define SIM7080G_CATM1_H
 #include <SIM7080G/Serial.hpp>
+#include <SIM7080G/ATCommands.hpp>
 #include <QueueList.hpp>
 
+/**
+ * @brief Minimum time between two registration polls in milliseconds
+ */
+#define CATM1_POLL_INTERVAL 1000
+
 enum CATM1State
 {
     CATM1_OFF,
@@ -34,6 +40,35 @@ public:
     */
     FSM fsmCATM1;
 
+    /**
+     * @brief Handle on the AT command in flight
+     */
+    ATFuture atCommand;
+
+    /**
+     * @brief Time of the last AT+CEREG? poll
+     */
+    unsigned long lastPoll = 0;
+
+    /**
+     * @brief PDP context state, kept up to date by the +APP PDP URC
+     *
+     * @details Once it drops, the context is activated again before the session goes on.
+     */
+    bool pdpActive = false;
+
+    /**
+     * @brief Access point name of the SIM card
+     */
+    const char *APN = "iot.1nce.net";
+
+    /**
+     * @brief Setup function
+     *
+     * This function is used to register the URC handlers of the module.
+     */
+    void setup();
+
     /**
      * @brief Power on CATM1
      * 
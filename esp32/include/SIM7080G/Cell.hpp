@@ -0,0 +1,146 @@
+#pragma once
+#ifndef SIM7080G_CELL_H
+#define SIM7080G_CELL_H
+#include <SIM7080G/Serial.hpp>
+#include <SIM7080G/ATCommands.hpp>
+#include <SIM7080G/GNSS.hpp>
+#include <QueueList.hpp>
+
+/**
+ * @brief AT+CLBS request type, longitude, latitude, accuracy, date and time
+ */
+#define CELL_CLBS_TYPE 4
+
+/**
+ * @brief Cell positioning state
+ */
+enum CellState
+{
+    CELL_INFO,
+    CELL_LOCATE
+};
+
+/**
+ * @brief Coarse position from the cell network
+ *
+ * @details Queued in place of a GNSS fix when the GNSS gets none within its budget. The accuracy of a cell
+ * position is hundreds of meters to a few kilometers.
+ */
+struct CELLData : public DataItem
+{
+    /**
+     * @brief UTC date and time given by the location service
+     */
+    DateTime utcDateTime;
+
+    /**
+     * @brief Latitude in 1e-7 degrees
+     */
+    int32_t latitude = 0;
+
+    /**
+     * @brief Longitude in 1e-7 degrees
+     */
+    int32_t longitude = 0;
+
+    /**
+     * @brief Accuracy in meters
+     */
+    uint32_t accuracy = 0;
+
+    /**
+     * @brief Serving cell, 0 when AT+CPSI? gave none
+     */
+    uint16_t mcc = 0;
+    uint16_t mnc = 0;
+    uint16_t tac = 0;
+    uint32_t cellId = 0;
+
+    /**
+     * @brief RSRP of the serving cell in dBm
+     */
+    int16_t rsrp = 0;
+
+    /**
+     * @brief Convert to JSON
+     *
+     * @return The JSON
+     */
+    json to_json() const override;
+
+    /**
+     * @brief Item rebuilt from its to_json(), when the queue is restored from flash
+     */
+    static CELLData from_json(const json &j);
+
+    /**
+     * @brief Type of the item in the queue
+     */
+    static constexpr DataType TYPE = DATA_CELL;
+};
+
+/**
+ * @brief SIM7080G cell positioning
+ *
+ * @details Reads the serving cell with AT+CPSI? and asks the location service of the network for its
+ * position with AT+CLBS. The location service needs the PDP context, so it runs on the upload session.
+ */
+class SIM7080GCell
+{
+private:
+    /**
+     * @brief Position being read
+     */
+    CELLData data;
+
+    /**
+     * @brief Read the serving cell of a +CPSI line
+     */
+    void parseServingCell(const ATView &response);
+
+    /**
+     * @brief Read the position of a +CLBS line
+     *
+     * @return False if the location service failed or gave no date
+     */
+    bool parseLocation(const ATView &response);
+
+public:
+    /**
+     * @brief Default constructor
+     */
+    SIM7080GCell();
+
+    /**
+     * @brief Destructor
+     */
+    ~SIM7080GCell();
+
+    /**
+     * @brief FSM for the cell position
+     */
+    FSM fsmCell;
+
+    /**
+     * @brief Handle on the AT command in flight
+     */
+    ATFuture atCommand;
+
+    /**
+     * @brief Whether a sample is waiting for a cell position
+     */
+    bool pending = false;
+
+    /**
+     * @brief Read the serving cell and its position, then queue it
+     *
+     * @details Needs the PDP context up.
+     *
+     * @return True once finished, whether it succeeded or not
+     */
+    bool Locate();
+};
+
+extern SIM7080GCell Cell;
+
+#endif // SIM7080G_CELL_H
@@ -1,7 +1,109 @@
 #ifndef SIM7080G_GNSS_H
 #define SIM7080G_GNSS_H
 #include <SIM7080G/Serial.hpp>
+#include <SIM7080G/ATCommands.hpp>
+#include <SIM7080G/GNSSTuner.hpp>
 #include <QueueList.hpp>
+#include <FixFilter.hpp>
+#include <TrackSimplifier.hpp>
+#include <Geofence.hpp>
+#include <Coordinates.hpp>
+
+/**
+ * @brief Minimum time between two AT+CGNSINF polls in milliseconds
+ */
+#define GNSS_POLL_INTERVAL 1000
+
+/**
+ * @brief Default time between two GNSS samples in milliseconds
+ */
+#define GNSS_SAMPLE_INTERVAL (1000 * 60)
+
+/**
+ * @brief Time to first fix assumed before one is measured, in milliseconds
+ */
+#define GNSS_DEFAULT_TTFF (1000 * 30)
+
+/**
+ * @brief Power drawn while acquiring a fix, relative to tracking one
+ *
+ * @details Tracking is cheaper when the engine would spend more than 1 / GNSS_ACQUISITION_COST of the
+ * interval acquiring the next fix anyway.
+ */
+#define GNSS_ACQUISITION_COST 2
+
+/**
+ * @brief Longest interval between two +UGNSINF reports in seconds, limit of AT+CGNSURC
+ */
+#define GNSS_MAX_REPORT_RATE 255
+
+/**
+ * @brief XTRA assistance data, downloaded to the modem file system then copied to the GNSS engine
+ */
+#define GNSS_XTRA_URL "http://iot1.xtracloud.net/xtra3gr_72h.bin"
+#define GNSS_XTRA_FILE "/customer/Xtra3.bin"
+
+/**
+ * @brief Validity of the XTRA data in milliseconds, it is refreshed GNSS_XTRA_REFRESH before it ends
+ */
+#define GNSS_XTRA_VALIDITY (1000UL * 60 * 60 * 72)
+#define GNSS_XTRA_REFRESH (1000UL * 60 * 60 * 24)
+
+/**
+ * @brief Time before another download after a failed one, in milliseconds
+ */
+#define GNSS_XTRA_RETRY (1000UL * 60 * 60)
+
+/**
+ * @brief Earliest year taken as the current UTC, the modem reports 1980 before its first fix
+ */
+#define GNSS_CLOCK_MIN_YEAR 2024
+
+/**
+ * @brief Bounds of the sampling interval in milliseconds, it doubles while stationary
+ */
+#define GNSS_MIN_INTERVAL (1000 * 15)
+#define GNSS_MAX_INTERVAL (1000 * 60 * 16)
+
+/**
+ * @brief Default radius in meters around the last queued fix within which a fix is not queued
+ */
+#define GNSS_STATIONARY_RADIUS 25
+
+/**
+ * @brief Speed over ground, in hundredths of km/h, above which the device is moving
+ */
+#define GNSS_MOVING_SPEED 300
+
+/**
+ * @brief Speed over ground, in hundredths of km/h, above which the shortest interval is used
+ */
+#define GNSS_FAST_SPEED 1500
+
+/**
+ * @brief Default uncertainty of the filtered position, in centimeters, under which a sample ends
+ */
+#define GNSS_TARGET_ACCURACY 1500
+
+/**
+ * @brief Default longest time a sample keeps the engine on, in milliseconds
+ */
+#define GNSS_ACQUISITION_TIMEOUT (1000UL * 60 * 3)
+
+/**
+ * @brief User equivalent range error in meters, the accuracy of a fix without HPA is HDOP times this
+ */
+#define GNSS_UERE 5
+
+/**
+ * @brief Accuracy in meters of a fix without HPA nor HDOP
+ */
+#define GNSS_UNKNOWN_ACCURACY 100
+
+/**
+ * @brief Number of fields of a +CGNSINF line
+ */
+#define CGNSINF_FIELD_COUNT 21
 
 /**
  * @brief GNSS response
@@ -18,6 +120,48 @@ enum GNSSState
     GNSS_OFF,
     GNSS_ON,
     GNSS_GET_POSITION,
+    GNSS_TRACKING,
+};
+
+/**
+ * @brief How the GNSS samples positions
+ */
+enum GNSSMode
+{
+    /**
+     * @brief Power on, poll AT+CGNSINF until a fix, power off, at every sample
+     */
+    GNSS_MODE_DUTY_CYCLE,
+
+    /**
+     * @brief Keep the engine running, the modem reports the position with +UGNSINF at every sample
+     */
+    GNSS_MODE_TRACKING,
+
+    /**
+     * @brief Pick the cheaper of the two from the interval and the measured time to first fix
+     */
+    GNSS_MODE_AUTO
+};
+
+/**
+ * @brief XTRA assistance download state
+ */
+enum GNSSAssistanceState
+{
+    GNSS_ASSISTANCE_DOWNLOAD,
+    GNSS_ASSISTANCE_COPY,
+    GNSS_ASSISTANCE_ENABLE
+};
+
+/**
+ * @brief Progress of a sample
+ */
+enum GNSSAcquisition
+{
+    GNSS_ACQUIRING,
+    GNSS_ACQUIRED,
+    GNSS_ACQUISITION_FAILED
 };
 
 /**
@@ -29,6 +173,34 @@ enum GNSSPositionState
     GNSS_POSITION_BUSY
 };
 
+/**
+ * @brief Fields of a +CGNSINF line, in order
+ */
+enum CGNSINFField
+{
+    CGNSINF_RUN_STATUS,
+    CGNSINF_FIX_STATUS,
+    CGNSINF_UTC_DATE_TIME,
+    CGNSINF_LATITUDE,
+    CGNSINF_LONGITUDE,
+    CGNSINF_ALTITUDE,
+    CGNSINF_SPEED,
+    CGNSINF_COURSE,
+    CGNSINF_FIX_MODE,
+    CGNSINF_RESERVED_1,
+    CGNSINF_HDOP,
+    CGNSINF_PDOP,
+    CGNSINF_VDOP,
+    CGNSINF_RESERVED_2,
+    CGNSINF_SATELLITES_IN_VIEW,
+    CGNSINF_SATELLITES_USED,
+    CGNSINF_GLONASS_USED,
+    CGNSINF_RESERVED_3,
+    CGNSINF_CN0_MAX,
+    CGNSINF_HPA,
+    CGNSINF_VPA
+};
+
 /**
  * @brief DateTime
  *
@@ -58,7 +230,14 @@ public:
     /**
      * @brief Constructor with AT+CGNSINF response time string
      */
-    DateTime(String value);
+    DateTime(String value) : DateTime(ATView(value.c_str())) {}
+
+    /**
+     * @brief Constructor with AT+CGNSINF response time, "yyyyMMddhhmmss.sss", read in place
+     *
+     * @details Every field is 0 if the time is too short, e.g. an empty field before the first fix.
+     */
+    DateTime(const ATView &value);
 
     /**
      * @brief Destructor
@@ -72,6 +251,11 @@ public:
      */
     long long int toUnixTime() const;
 
+    /**
+     * @brief Date and time of a Unix time, inverse of toUnixTime()
+     */
+    static DateTime fromUnixTime(long long int time);
+
     /**
      * @brief Convert to String
      *
@@ -80,10 +264,64 @@ public:
     String toString();
 };
 
+/**
+ * @brief Fields of a +CGNSINF line
+ *
+ * @details The line is read once, in place from the receive buffer, without any allocation. A field the
+ * modem left empty keeps its 0 value and its bit of present stays clear.
+ */
+struct CGNSINFFields
+{
+    bool runStatus = false;
+    bool fixStatus = false;
+    DateTime utcDateTime;
+    int32_t latitude = 0;
+    int32_t longitude = 0;
+    float altitude = 0;
+    float speed = 0;
+    float course = 0;
+    uint8_t fixMode = 0;
+    float hdop = 0;
+    float pdop = 0;
+    float vdop = 0;
+    uint8_t satellitesInView = 0;
+    uint8_t satellitesUsed = 0;
+    uint8_t glonassUsed = 0;
+    uint8_t cn0Max = 0;
+    float hpa = 0;
+    float vpa = 0;
+
+    /**
+     * @brief Bit (1 << CGNSINFField) set for each field that is not empty
+     */
+    uint32_t present = 0;
+
+    /**
+     * @brief Parse the +CGNSINF line of a response
+     *
+     * @param response Response of AT+CGNSINF, the line itself or a +UGNSINF report
+     * @return false if there is no +CGNSINF or +UGNSINF line or its run status is empty
+     */
+    bool parse(const ATView &response);
+
+    /**
+     * @brief Check if a field was not empty
+     */
+    bool has(CGNSINFField field) const { return (present & (1UL << field)) != 0; }
+
+private:
+    /**
+     * @brief Store the value of one field
+     */
+    void set(CGNSINFField field, const ATView &value);
+};
+
 /**
  * @brief GNSS data
  *
- * @details This class is used to store the GNSS data.
+ * @details This class is used to store the GNSS data. The fields read from +CGNSINF after the position are
+ * integer-scaled, 12 bytes for all of them. A fix with every field set takes 83 bytes of CBOR in the upload,
+ * its "t" and "d" keys included, as measured with nlohmann::json::to_cbor().
  */
 struct GNSSData : public DataItem
 {
@@ -103,14 +341,14 @@ struct GNSSData : public DataItem
     DateTime utcDateTime;
 
     /**
-     * @brief Latitude
+     * @brief Latitude in 1e-7 degrees
      */
-    float latitude;
+    int32_t latitude;
 
     /**
-     * @brief Longitude
+     * @brief Longitude in 1e-7 degrees
      */
-    float longitude;
+    int32_t longitude;
 
     /**
      * @brief HDOP
@@ -118,10 +356,50 @@ struct GNSSData : public DataItem
     float hdop;
 
     /**
-     * @brief VPA
+     * @brief HPA, horizontal position accuracy in meters
      */
     float hpa;
 
+    /**
+     * @brief MSL altitude in centimeters
+     */
+    int32_t altitude = 0;
+
+    /**
+     * @brief Speed over ground in hundredths of km/h, saturated at UINT16_MAX
+     */
+    uint16_t speed = 0;
+
+    /**
+     * @brief Course over ground in hundredths of degrees
+     */
+    uint16_t course = 0;
+
+    /**
+     * @brief Vertical position accuracy in centimeters, saturated at UINT16_MAX
+     */
+    uint16_t vpa = 0;
+
+    /**
+     * @brief GNSS satellites in view
+     */
+    uint8_t satellitesInView = 0;
+
+    /**
+     * @brief GNSS satellites used for the fix
+     */
+    uint8_t satellitesUsed = 0;
+
+    /**
+     * @brief Horizontal accuracy in centimeters, the HPA or else an estimate from the HDOP
+     */
+    uint32_t accuracy() const;
+
+    /**
+     * @brief Distance to another fix in centimeters, equirectangular approximation
+     */
+    uint32_t distanceTo(const GNSSData &other) const;
+
     /**
      * @brief Convert to JSON
      *
@@ -130,11 +408,19 @@ struct GNSSData : public DataItem
     json to_json() const override;
 
     /**
-     * @brief Get the type
-     *
-     * @return The type
+     * @brief Read back the JSON of to_json(), e.g. from the persistent queue
+     */
+    static GNSSData from_json(const json &j);
+
+    /**
+     * @brief Copy the fields of a +CGNSINF or +UGNSINF line into a GNSS record
      */
-    std::string get_type() const override;
+    static GNSSData from_fields(const CGNSINFFields &fields);
+
+    /**
+     * @brief Type of the item in the queue
+     */
+    static constexpr DataType TYPE = DATA_GNSS;
 };
 
 /**
@@ -145,6 +431,138 @@ struct GNSSData : public DataItem
 class SIM7080GGNSS
 {
 private:
+    /**
+     * @brief Time (millis) the engine was powered on
+     */
+    unsigned long powerOnTime = 0;
+
+    /**
+     * @brief Whether the first fix since power on is still awaited
+     */
+    bool awaitingFix = false;
+
+    /**
+     * @brief Whether ttff was measured, GNSS_MODE_AUTO duty cycles until then
+     */
+    bool ttffMeasured = false;
+
+    /**
+     * @brief Time (millis) the last tracked fix was queued, 0 before the first one
+     */
+    unsigned long lastQueued = 0;
+
+    /**
+     * @brief Time (millis) the current sample started, or while tracking the last position within targetAccuracy
+     */
+    unsigned long acquisitionStart = 0;
+
+    /**
+     * @brief Filter over the fixes since power on
+     */
+    FixFilter filter;
+
+    /**
+     * @brief Last fix fused by the filter, carries the fields the filter does not estimate
+     */
+    GNSSData lastFused;
+
+    /**
+     * @brief Fuse a fix read from the modem
+     *
+     * @return True if the filtered position is within targetAccuracy
+     */
+    bool fuse(const GNSSData &fix);
+
+    /**
+     * @brief Last fused fix with the filtered position, its HPA is the uncertainty of the filter
+     */
+    GNSSData filtered() const;
+
+    /**
+     * @brief Update the time to first fix with a sample ending since power on
+     *
+     * @return True if it was the first one since power on
+     */
+    bool measureFix();
+
+    /**
+     * @brief Seconds between two +UGNSINF reports for the interval
+     */
+    unsigned long reportRate() const;
+
+    /**
+     * @brief Seconds between two +UGNSINF reports asked to the modem
+     */
+    unsigned long trackingRate = 0;
+
+    /**
+     * @brief Seconds between two reports in the AT+CGNSURC sent while tracking, 0 if none is in flight
+     */
+    unsigned long requestedRate = 0;
+
+    /**
+     * @brief Whether XTRA data was injected, and the time (millis) it ends
+     */
+    bool hasAssistance = false;
+    unsigned long assistanceExpiry = 0;
+
+    /**
+     * @brief Time (millis) a failed download may be retried, 0 if none failed
+     */
+    unsigned long assistanceRetry = 0;
+
+    /**
+     * @brief Whether the end of the injected XTRA data still waits for the clock to be written to flash
+     */
+    bool assistanceUnsaved = false;
+
+    /**
+     * @brief End of the XTRA data of a previous boot, in Unix time, 0 once checked against the clock
+     */
+    uint32_t storedExpiry = 0;
+
+    /**
+     * @brief UTC of the last fix or cell position, in Unix time, and the time (millis) it was taken, 0 before any
+     */
+    long long clockTime = 0;
+    unsigned long clockSetAt = 0;
+
+    /**
+     * @brief Keeps the end of the XTRA data across a reset, the modem keeps the data itself
+     */
+    Preferences preferences;
+
+    /**
+     * @brief Current UTC in Unix time, 0 while unknown
+     */
+    long long utcNow() const;
+
+    /**
+     * @brief Write the end of the XTRA data to flash as UTC, once the clock is known
+     */
+    void saveAssistance();
+
+    /**
+     * @brief Give up the download until GNSS_XTRA_RETRY has passed
+     */
+    void failAssistance(const char *step, const AT_RESPONSE &response);
+
+    /**
+     * @brief Last fix queued, the reference for the stationary radius
+     */
+    GNSSData lastFix;
+    bool hasLastFix = false;
+
+    /**
+     * @brief Simplifier over the accepted fixes, only the fixes it keeps are queued
+     */
+    TrackSimplifier track;
+
+    /**
+     * @brief Last fix recorded, queued if the simplifier keeps it later
+     */
+    GNSSData trackEnd;
+
 public:
     /**
      * @brief Default constructor
@@ -166,6 +584,168 @@ public:
      */
     FSM fsmGetPosition;
 
+    /**
+     * @brief FSM for the XTRA download
+     */
+    FSM fsmAssistance;
+
+    /**
+     * @brief Handle on the AT command in flight
+     */
+    ATFuture atCommand;
+
+    /**
+     * @brief Whether XTRA assistance data is downloaded to cut the time to first fix of cold starts
+     */
+    bool assisted = true;
+
+    /**
+     * @brief How positions are sampled
+     */
+    GNSSMode mode = GNSS_MODE_AUTO;
+
+    /**
+     * @brief Time between two samples in milliseconds
+     */
+    unsigned long interval = GNSS_SAMPLE_INTERVAL;
+
+    /**
+     * @brief Uncertainty of the filtered position, in centimeters, under which a sample ends
+     */
+    uint32_t targetAccuracy = GNSS_TARGET_ACCURACY;
+
+    /**
+     * @brief Longest time a sample keeps the engine on, in milliseconds
+     */
+    unsigned long acquisitionTimeout = GNSS_ACQUISITION_TIMEOUT;
+
+    /**
+     * @brief Time to first fix within targetAccuracy in milliseconds, moving average of the samples since power on
+     *
+     * @details The engine keeps its ephemeris while the modem stays powered, so once it is warm this
+     * measures a hot start.
+     */
+    unsigned long ttff = GNSS_DEFAULT_TTFF;
+
+    /**
+     * @brief Whether the interval follows the motion and fixes within stationaryRadius are dropped
+     */
+    bool adaptive = true;
+
+    /**
+     * @brief Interval while moving at walking speed, in milliseconds
+     */
+    unsigned long baseInterval = GNSS_SAMPLE_INTERVAL;
+
+    /**
+     * @brief Radius in meters around the last queued fix within which a fix is not queued
+     */
+    uint32_t stationaryRadius = GNSS_STATIONARY_RADIUS;
+
+    /**
+     * @brief Adapt the interval to a new accurate fix and decide if it is queued
+     *
+     * @details While the device stays within stationaryRadius of the last queued fix and does not move, the
+     * fix is dropped and the interval doubles up to GNSS_MAX_INTERVAL. Once it leaves, the interval goes back
+     * to baseInterval, or GNSS_MIN_INTERVAL above GNSS_FAST_SPEED.
+     *
+     * @return True if the fix must be queued
+     */
+    bool accept(const GNSSData &fix);
+
+    /**
+     * @brief Constellation set of each power on, tuned on the measured time to fix
+     */
+    GNSSTuner tuner;
+
+    /**
+     * @brief Largest distance in meters between a dropped fix and the uploaded track, 0 queues every fix
+     */
+    uint32_t trackTolerance = TRACK_TOLERANCE;
+
+    /**
+     * @brief Queue an accepted fix if the track turns there, nearly collinear fixes are dropped
+     *
+     * @details The newest fix is held until the next one tells if the track goes on straight.
+     */
+    void record(const GNSSData &fix);
+
+    /**
+     * @brief Queue the held fix, the track ends there
+     */
+    void endTrack();
+
+    /**
+     * @brief Evaluate the geofences on a fix, then queue it through accept() and record()
+     *
+     * @details A fix crossing a fence is queued right away, even stationary, and sets geofences.alert.
+     */
+    void queue(const GNSSData &fix);
+
+    /**
+     * @brief Setup function, registers the +UGNSINF URC
+     */
+    void setup();
+
+    /**
+     * @brief Check if the current mode, or the cheaper strategy in GNSS_MODE_AUTO, is tracking
+     *
+     * @details GNSS_MODE_AUTO only tracks once a time to fix was measured, the default one may not hold where
+     * the collar is.
+     */
+    bool useTracking() const;
+
+    /**
+     * @brief Power on and keep the engine running with a +UGNSINF report every interval
+     *
+     * @details The URC handler queues the filtered position of the reports once it is within targetAccuracy.
+     *
+     * @return True once the reports are enabled
+     */
+    bool StartTracking();
+
+    /**
+     * @brief Check if tracking went acquisitionTimeout past a report without a position within targetAccuracy
+     *
+     * @details Ends like a failed Acquire(), before the first fix or once it is lost, e.g. indoors. Tracking is not
+     * used again in GNSS_MODE_AUTO until a duty cycle sample measures the time to fix. The engine is left on for
+     * PowerOff().
+     *
+     * @return True once, when the sample failed
+     */
+    bool TrackingFailed();
+
+    /**
+     * @brief Handle a +UGNSINF report
+     */
+    void onReport(const ATView &line);
+
+    /**
+     * @brief Handle the response of the AT+CGNSURC sent by onReport()
+     */
+    void onRateApplied(const AT_RESPONSE &response);
+
+    /**
+     * @brief Check if the XTRA data is missing or ends within GNSS_XTRA_REFRESH
+     *
+     * @details The data injected before a reset counts once the clock tells it is still valid.
+     */
+    bool needsAssistance() const;
+
+    /**
+     * @brief Set the UTC from a fix or a cell position, and check the XTRA data of a previous boot against it
+     */
+    void setClock(const DateTime &utc);
+
+    /**
+     * @brief Download the XTRA data and inject it into the GNSS engine
+     *
+     * @details Needs the PDP context up and the GNSS off. The engine uses the data from the next power on.
+     *
+     * @return True once finished, whether it succeeded or not
+     */
+    bool DownloadAssistance();
+
     /**
      * @brief Power on
      *
@@ -174,12 +754,23 @@ public:
     bool PowerOn();
 
     /**
-     * @brief Power off
+     * @brief Power off, from GNSS_ON or GNSS_TRACKING
      *
      * @return True if the power is off, false otherwise
      */
     bool PowerOff();
 
+    /**
+     * @brief Power on and poll AT+CGNSINF until the filtered position is within targetAccuracy
+     *
+     * @details The fixes are fused by a FixFilter, outliers are dropped. After acquisitionTimeout the sample
+     * ends with the estimate as it is, or fails if the engine had no fix at all.
+     *
+     * @param fix Filtered position once GNSS_ACQUIRED
+     * @return The progress of the sample
+     */
+    GNSSAcquisition Acquire(GNSSData &fix);
+
     /**
      * @brief Get data
      *
@@ -0,0 +1,150 @@
+#pragma once
+#ifndef SIM7080G_GNSS_TUNER_H
+#define SIM7080G_GNSS_TUNER_H
+#include <Arduino.h>
+#include <Preferences.h>
+
+/**
+ * @brief Number of constellation sets tried by the tuner
+ */
+#define GNSS_CONSTELLATION_COUNT 4
+
+/**
+ * @brief Share of the power ons, in percent, that try another set than the best one
+ */
+#define GNSS_TUNER_EXPLORATION 10
+
+/**
+ * @brief Samples of each set before the best one is used
+ */
+#define GNSS_TUNER_MIN_SAMPLES 2
+
+/**
+ * @brief Samples between two writes of the statistics to flash
+ */
+#define GNSS_TUNER_SAVE_SAMPLES 8
+
+/**
+ * @brief Layout of the statistics in flash, older ones are dropped
+ */
+#define GNSS_TUNER_VERSION 1
+
+/**
+ * @brief Systems enabled by AT+CGNSMOD, 1 or 0 each
+ */
+struct GNSSConstellations
+{
+    const char *name;
+    uint8_t gps;
+    uint8_t glonass;
+    uint8_t beidou;
+    uint8_t galileo;
+    uint8_t qzss;
+};
+
+/**
+ * @brief Measures of a constellation set, moving averages over its samples
+ */
+struct GNSSTunerStats
+{
+    uint16_t samples;
+
+    /**
+     * @brief Time from power on to a fix within the target accuracy, in milliseconds, a failure counts its timeout
+     */
+    uint32_t time;
+
+    /**
+     * @brief Uncertainty of the fix that ended the sample, in centimeters
+     */
+    uint32_t accuracy;
+};
+
+/**
+ * @brief Pick the AT+CGNSMOD constellation set that gets a fix the fastest where the collar is
+ *
+ * @details Epsilon-greedy: each set is first tried GNSS_TUNER_MIN_SAMPLES times, then the power ons use the
+ * set with the shortest average time to fix, and GNSS_TUNER_EXPLORATION percent of them another one, so that
+ * a change of region or sky shows up. The statistics survive a reset in NVS.
+ */
+class GNSSTuner
+{
+private:
+    GNSSTunerStats stats[GNSS_CONSTELLATION_COUNT];
+
+    /**
+     * @brief Set used by the current power on, valid while selected
+     */
+    uint8_t current = 0;
+    bool selected = false;
+
+    /**
+     * @brief Samples since the last write to flash
+     */
+    uint8_t unsaved = 0;
+
+    Preferences preferences;
+
+    /**
+     * @brief Account a sample of the current set
+     */
+    void measure(unsigned long time, uint32_t accuracy, bool hasFix);
+
+    /**
+     * @brief Write the statistics to flash
+     */
+    void save();
+
+public:
+    /**
+     * @brief Whether the sets are tuned, otherwise the first one, GPS and Galileo, is always used
+     */
+    bool enabled = true;
+
+    /**
+     * @brief Share of the power ons, in percent, that try another set than the best one
+     */
+    uint8_t exploration = GNSS_TUNER_EXPLORATION;
+
+    /**
+     * @brief Load the statistics from flash
+     */
+    void begin();
+
+    /**
+     * @brief Set for the next power on, chosen once until its sample ends
+     */
+    const GNSSConstellations &select();
+
+    /**
+     * @brief End the sample of the current set with a fix
+     *
+     * @param time Time from power on to the fix in milliseconds
+     * @param accuracy Uncertainty of the fix in centimeters
+     */
+    void record(unsigned long time, uint32_t accuracy);
+
+    /**
+     * @brief End the sample of the current set without a fix
+     *
+     * @param time Time the engine searched in milliseconds
+     */
+    void fail(unsigned long time);
+
+    /**
+     * @brief Set with the shortest average time to fix, among the ones tried enough
+     */
+    uint8_t best() const;
+
+    /**
+     * @brief Measures of a set
+     */
+    const GNSSTunerStats &statistics(uint8_t set) const { return stats[set]; }
+
+    /**
+     * @brief Systems of a set
+     */
+    static const GNSSConstellations &constellations(uint8_t set);
+};
+
+#endif // SIM7080G_GNSS_TUNER_H
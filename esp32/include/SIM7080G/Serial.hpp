@@ -2,9 +2,15 @@
 #ifndef SIM7080G_SERIAL_H
 #define SIM7080G_SERIAL_H
 #include <Arduino.h>
+#include <Preferences.h>
 #include <FSM.hpp>
+#include <EventLoop.hpp>
 #include <nlohmann/json.hpp>
 #include <QueueList.hpp>
+#include <RingBuffer.hpp>
+#include <DataSource.hpp>
+#include <SIM7080G/ATView.hpp>
+#include <SIM7080G/Trace.hpp>
 using json = nlohmann::json;
 
 #define SIM7080G_BAUD 57600
@@ -12,6 +18,79 @@ using json = nlohmann::json;
 #define RX0 20
 #define TX0 21
 
+/**
+ * @brief Size of the UART driver buffer and of the AT receive ring buffer, in bytes
+ */
+#define SIM7080G_RX_BUFFER_SIZE 1024
+
+/**
+ * @brief Number of AT commands that can be queued at the same time
+ */
+#define SIM7080G_JOB_COUNT 8
+
+/**
+ * @brief Longest AT command that can be queued, in bytes
+ */
+#define SIM7080G_COMMAND_SIZE 160
+
+/**
+ * @brief Time a finished command is kept for its caller before being dropped, in milliseconds
+ */
+#define SIM7080G_JOB_RETENTION 5000
+
+/**
+ * @brief Number of unsolicited result code handlers that can be registered
+ */
+#define SIM7080G_URC_COUNT 8
+
+/**
+ * @brief Fastest UART rate negotiated with AT+IPR
+ */
+#define SIM7080G_BAUD_MAX 921600
+
+/**
+ * @brief Number of "AT" probes answered in a row for a rate to be kept
+ */
+#define SIM7080G_LINK_ATTEMPTS 3
+
+/**
+ * @brief Number of timed out commands in a row before the link falls back to a lower rate
+ */
+#define SIM7080G_LINK_MAX_ERRORS 3
+
+/**
+ * @brief PWRKEY pulse turning the modem on, in milliseconds
+ */
+#define SIM7080G_POWER_PULSE 200
+
+/**
+ * @brief PWRKEY pulse forcing a reset of the modem, in milliseconds
+ */
+#define SIM7080G_RESET_PULSE 15000
+
+/**
+ * @brief Longest wait for the modem to answer after the PWRKEY pulse, in milliseconds, PWRKEY is pulsed again after it
+ */
+#define SIM7080G_BOOT_TIMEOUT 10000
+
+/**
+ * @brief Time the modem takes to shut down after NORMAL POWER DOWN, before PWRKEY may turn it on again, in milliseconds
+ */
+#define SIM7080G_POWER_DOWN_SETTLE 2000
+
+/**
+ * @brief Outcome of an AT command
+ *
+ * This enum is used to tell how an AT command completed.
+ */
+enum AT_STATUS
+{
+    AT_PENDING,
+    AT_OK,
+    AT_ERROR,
+    AT_TIMEOUT
+};
+
 /**
  * @brief AT command response
  *
@@ -19,30 +98,192 @@ using json = nlohmann::json;
  */
 struct AT_RESPONSE
 {
-    String message;
+    /**
+     * @brief Response text, a view into the receive buffer valid until the next command
+     */
+    ATView message;
     bool isFinished;
+
+    /**
+     * @brief Final result of the command, AT_PENDING until isFinished is set
+     */
+    AT_STATUS status = AT_PENDING;
 };
 
 /**
- * @brief Finite State Machine (FSM) states for AT commands
+ * @brief Priority of an AT command
  *
- * This enum is used to define the states of the FSM for AT commands.
+ * Queued commands run by priority first, then in submission order.
  */
-enum AT_COMMAND
+enum AT_PRIORITY
 {
-    AT_FREE,
-    AT_BUSY
+    AT_PRIORITY_LINK,   // UART rate negotiation, the only commands sent until the link is ready
+    AT_PRIORITY_HIGH,   // Upload-critical commands (AT+CASEND, payload)
+    AT_PRIORITY_NORMAL, // Module sequencing (GNSS, CAT-M1, sockets)
+    AT_PRIORITY_LOW     // Housekeeping (battery, IMEI)
 };
 
 /**
- * @brief States for TimedRead FSM
+ * @brief States of the modem power sequence
  */
-enum TimedReadState
+enum POWER_STATE
 {
-    TIMED_READ_INIT,
-    TIMED_READ_RUNNING,
-    TIMED_READ_TIMEOUT,
-    TIMED_READ_SUCCESS
+    POWER_OFF,
+    POWER_PULSE, // PWRKEY held low
+    POWER_BOOT,  // Waiting for RDY or an answer to "AT"
+    POWER_ON,
+    POWER_DOWN,  // AT+CPOWD=1 sent, waiting for NORMAL POWER DOWN
+    POWER_SETTLE // Modem shutting down
+};
+
+/**
+ * @brief States of the UART link with the modem
+ */
+enum LINK_STATE
+{
+    LINK_PROBE,    // Looking for the rate the modem answers at
+    LINK_SET_BAUD, // Asking the modem to move to the target rate
+    LINK_CHECK,    // Echo test at the new rate
+    LINK_FALLBACK, // Too many errors, back to autobaud at SIM7080G_BAUD
+    LINK_READY
+};
+
+/**
+ * @brief States of a queued AT command
+ */
+enum AT_JOB_STATE
+{
+    AT_JOB_FREE,
+    AT_JOB_QUEUED,
+    AT_JOB_RUNNING,
+    AT_JOB_DONE
+};
+
+/**
+ * @brief AT command queued in the scheduler
+ */
+struct ATJob
+{
+    /**
+     * @brief Command line, without the line ending
+     */
+    char command[SIM7080G_COMMAND_SIZE];
+
+    /**
+     * @brief Raw payload written instead of a command line, not owned
+     */
+    DataSource *source = nullptr;
+
+    /**
+     * @brief Bytes of the raw payload written so far
+     */
+    size_t dataSent = 0;
+
+    /**
+     * @brief Time (millis) the command was written, or started to be
+     */
+    unsigned long startTime = 0;
+
+    /**
+     * @brief Line prefix ending the response instead of OK, nullptr for OK
+     */
+    const char *terminator = nullptr;
+
+    /**
+     * @brief Prefix of the information lines of a read-only query (e.g. "+CBC:"), nullptr otherwise
+     *
+     * Queries with a prefix can be chained with other queued queries in one command line.
+     */
+    const char *expected = nullptr;
+
+    /**
+     * @brief Never chained with other queries, set after a chained line failed
+     */
+    bool standalone = false;
+
+    /**
+     * @brief Time (millis) before which the query only runs chained with another one, 0 for none
+     */
+    unsigned long holdUntil = 0;
+
+    /**
+     * @brief Timeout in milliseconds once the command is written
+     */
+    unsigned long timeout = 1000;
+
+    /**
+     * @brief Time (millis) by which the command must have started, 0 for none
+     */
+    unsigned long deadline = 0;
+
+    /**
+     * @brief Priority
+     */
+    AT_PRIORITY priority = AT_PRIORITY_NORMAL;
+
+    /**
+     * @brief Submission number, keeps the order within a priority and identifies the job
+     */
+    uint32_t sequence = 0;
+
+    /**
+     * @brief State
+     */
+    AT_JOB_STATE state = AT_JOB_FREE;
+
+    /**
+     * @brief Time (millis) of the last state change
+     */
+    unsigned long lastUpdate = 0;
+
+    /**
+     * @brief Position in the receive buffer where the response starts
+     */
+    size_t responseStart = 0;
+
+    /**
+     * @brief Response, valid once the job is done
+     */
+    AT_RESPONSE response;
+
+    /**
+     * @brief Called when the command is done, the job is released right after
+     */
+    void (*onComplete)(const AT_RESPONSE &response) = nullptr;
+};
+
+/**
+ * @brief Handler of an unsolicited result code (URC)
+ */
+struct URCHandler
+{
+    /**
+     * @brief Start of the lines handled, e.g. "+CASTATE:"
+     */
+    const char *prefix;
+
+    /**
+     * @brief Called with the trimmed line as soon as it is complete
+     */
+    void (*handler)(const ATView &line);
+};
+
+/**
+ * @brief Handle on a queued AT command
+ *
+ * This struct is kept by the caller to poll the command it submitted.
+ */
+struct ATFuture
+{
+    /**
+     * @brief Index of the job, -1 when nothing is pending
+     */
+    int8_t slot = -1;
+
+    /**
+     * @brief Submission number of the job
+     */
+    uint32_t sequence = 0;
 };
 
 
@@ -61,11 +302,14 @@ struct BATTERYData : public DataItem
     json to_json() const override;
 
     /**
-     * @brief Get the type
-     *
-     * @return The type
+     * @brief Battery level read back from to_json()
      */
-    std::string get_type() const override;
+    static BATTERYData from_json(const json &j);
+
+    /**
+     * @brief Type of the item in the queue
+     */
+    static constexpr DataType TYPE = DATA_BATTERY;
 };
 
 /**
@@ -81,35 +325,151 @@ public:
     ~SIM7080GHardwareSerial();
 
     /**
-     * @brief Finite State Machine (FSM) for AT commands
-     *
-     * This struct is used to store the state of the FSM for AT commands.
+     * @brief AT commands waiting, running or waiting to be collected
      */
-    FSM fsm;
+    ATJob jobs[SIM7080G_JOB_COUNT];
 
     /**
-     * @brief Finite State Machine (FSM) for TimedRead
-     *
-     * This struct is used to store the state of the FSM for TimedRead.
+     * @brief Index of the running job, -1 when the modem is idle
      */
-    FSM timedReadFSM;
+    int8_t running = -1;
 
     /**
-     * @brief AT command response
-     *
-     * This struct is used to store the response of an AT command.
+     * @brief Submission number given to the next job
+     */
+    uint32_t nextSequence = 1;
+
+    /**
+     * @brief Response of the running command
      */
     AT_RESPONSE response;
 
     /**
-     * @brief Result of the last TimedRead operation
+     * @brief Command line written for the running job, with the queries chained to it
+     */
+    char runningCommand[SIM7080G_COMMAND_SIZE];
+
+    /**
+     * @brief Timeout of the running command line, the sum of the chained queries ones
+     */
+    unsigned long runningTimeout = 0;
+
+    /**
+     * @brief Jobs written in the running command line, in order, the running job first
+     */
+    int8_t batch[SIM7080G_JOB_COUNT];
+
+    /**
+     * @brief Number of jobs in batch
+     */
+    uint8_t batchSize = 0;
+
+    /**
+     * @brief Handle on AT+CPOWD, apart from the handles of the modules
+     */
+    ATFuture powerCommand;
+
+    /**
+     * @brief Registered unsolicited result code handlers
+     */
+    URCHandler urcHandlers[SIM7080G_URC_COUNT];
+
+    /**
+     * @brief Number of registered unsolicited result code handlers
+     */
+    uint8_t urcCount = 0;
+
+    /**
+     * @brief Receive buffer
+     *
+     * Every byte coming from the modem lands here, response views point into it.
      */
-    int timedReadResult = -1;
+    RingBuffer<SIM7080G_RX_BUFFER_SIZE> rxBuffer;
 
     /**
-     * @brief Start time of the last TimedRead operation
+     * @brief Position in rxBuffer where the current response starts
      */
-    unsigned long timedReadStartTime = 0;
+    size_t responseStart = 0;
+
+    /**
+     * @brief Position in rxBuffer where the line being received starts
+     */
+    size_t responseLineStart = 0;
+
+    /**
+     * @brief Position in rxBuffer up to which the response has been scanned
+     */
+    size_t responseScanned = 0;
+
+    /**
+     * @brief State of the power sequence
+     */
+    POWER_STATE powerState = POWER_OFF;
+
+    /**
+     * @brief Time (millis) the current power step started
+     */
+    unsigned long powerTimer = 0;
+
+    /**
+     * @brief Length of the PWRKEY pulse being sent
+     */
+    unsigned long powerPulse = SIM7080G_POWER_PULSE;
+
+    /**
+     * @brief Set by the RDY URC once the modem booted
+     */
+    bool modemReady = false;
+
+    /**
+     * @brief State of the UART link
+     */
+    LINK_STATE linkState = LINK_PROBE;
+
+    /**
+     * @brief Current UART rate
+     */
+    uint32_t linkBaud = SIM7080G_BAUD;
+
+    /**
+     * @brief Rate the link is negotiated to
+     */
+    uint32_t targetBaud = SIM7080G_BAUD_MAX;
+
+    /**
+     * @brief Probes answered, or not answered, in a row at the current rate
+     */
+    uint8_t linkAttempts = 0;
+
+    /**
+     * @brief Commands timed out in a row
+     */
+    uint8_t linkErrors = 0;
+
+    /**
+     * @brief Handle on the link negotiation command in flight
+     */
+    ATFuture linkCommand;
+
+    /**
+     * @brief Flash storage of the last good rate
+     */
+    Preferences preferences;
+
+    /**
+     * @brief Recorder of the bytes exchanged with the modem, inactive until begin() is called
+     */
+    TraceWriter trace;
+
+    /**
+     * @brief Stands in for the modem when set (e.g. a TraceReplay or a ModemSimulator), nullptr to use the UART
+     */
+    Stream *emulator = nullptr;
+
+    /**
+     * @brief Time the modem spent running commands since power on, in milliseconds
+     */
+    unsigned long busyTime = 0;
 
     /**
      * @brief IMEI of the IoT device
@@ -123,41 +483,256 @@ public:
      */
     void setup();
 
+    using HardwareSerial::write;
+
+    /**
+     * @brief Write to the modem, or to the emulator, and to the trace
+     */
+    size_t write(uint8_t c) override;
+
+    /**
+     * @brief Write to the modem, or to the emulator, and to the trace
+     */
+    size_t write(const uint8_t *buffer, size_t size) override;
+
+    /**
+     * @brief Set the coalescing options of a queued command
+     *
+     * @param future Handle returned by submit()
+     * @param expected Prefix of the information lines of a read-only query, nullptr if the command can't be chained
+     * @param hold Time in milliseconds the query may wait to be chained with another one, 0 to run it when its turn comes
+     */
+    void setChaining(const ATFuture &future, const char *expected, unsigned long hold = 0);
+
+    /**
+     * @brief Queue an AT command
+     *
+     * This function is used to add a command to the scheduler, it is written to the modem
+     * once every command of higher priority and every older command of the same priority is done.
+     *
+     * @param command AT command to be sent, copied
+     * @param timeout Timeout in milliseconds once the command is written
+     * @param terminator Line prefix ending the response instead of OK (e.g. "+APP PDP:" or ">"), nullptr for OK
+     * @param priority Priority of the command
+     * @param deadline Time (millis) by which the command must have started, 0 for none
+     * @param onComplete Called when the command is done, nullptr to poll the returned future instead
+     * @return ATFuture Handle on the command, with a slot of -1 if the queue is full
+     */
+    ATFuture submit(const char *command, unsigned long timeout = 1000, const char *terminator = nullptr, AT_PRIORITY priority = AT_PRIORITY_NORMAL, unsigned long deadline = 0, void (*onComplete)(const AT_RESPONSE &response) = nullptr);
+
+    /**
+     * @brief Poll a queued AT command
+     *
+     * This function is used to get the response of a command. Once it is finished the job is released,
+     * so the response must be processed before the next call to loop().
+     *
+     * @param future Handle returned by submit(), reset once the command is finished
+     * @return AT_RESPONSE Response of the AT command
+     */
+    AT_RESPONSE poll(ATFuture &future);
+
+    /**
+     * @brief Check if a queued AT command is not finished yet
+     *
+     * @param future Handle returned by submit()
+     * @return true if the command is queued or running
+     */
+    bool isPending(const ATFuture &future) const;
+
+    /**
+     * @brief Check if no AT command is queued or running
+     */
+    bool isIdle() const;
+
+    /**
+     * @brief Register an unsolicited result code handler
+     *
+     * This function is used to receive the lines the modem sends on its own (URC).
+     * A line starting with the prefix is given to the handler as soon as it is complete
+     * and is removed from the response of the running command, unless it is that command's own result
+     * (same name as the command, or its terminator).
+     *
+     * @param prefix Start of the lines handled, e.g. "+CASTATE:", must stay valid
+     * @param handler Called with the trimmed line
+     * @return true if the handler was registered, false if there is no room left
+     */
+    bool onURC(const char *prefix, void (*handler)(const ATView &line));
+
+    /**
+     * @brief Loop of the AT scheduler
+     *
+     * This function is used to read the running command response and to start the next queued command.
+     * Called once at the beginning of the main loop.
+     */
+    void loop();
+
     /**
      * @brief Send AT command
      *
      * This function is used to send an AT command to the IoT device.
+     * The command is queued on the first call and polled on the next ones with the same future.
+     * The response is finished as soon as a final result code (OK, ERROR,
+     * +CME ERROR) is received, the timeout is only an upper bound.
      * DO NOT CALL INSIDE DELAY() FUNCTION
      *
+     * @param future Handle of the caller, one per command in flight
      * @param command AT command to be sent
      * @param timeout Timeout in milliseconds
+     * @param terminator Line prefix ending the response instead of OK (e.g. "+APP PDP:" or ">"), nullptr for OK
+     * @param priority Priority of the command
      * @return AT_RESPONSE Response of the AT command
      */
-    AT_RESPONSE sendATCommand(const char *command, unsigned long timeout = 1000);
+    AT_RESPONSE sendATCommand(ATFuture &future, const char *command, unsigned long timeout = 1000, const char *terminator = nullptr, AT_PRIORITY priority = AT_PRIORITY_NORMAL);
 
     /**
      * @brief Send TCP Data
      *
-     * This fuction is used to send data to this TCP server.
+     * This fuction is used to send data to this TCP server, after AT+CASEND returned its prompt.
+     * The bytes are pulled from the source as the UART TX FIFO has room for them, nothing is buffered here.
+     * The source must stay valid until the response is finished.
+     * The response is finished on OK, SEND OK or ERROR, or 10 seconds after the last byte was written.
      * DO NOT CALL INSIDE DELAY() FUNCTION
+     *
+     * @param future Handle of the caller
+     * @param source Data to be sent, size() bytes
+     */
+    AT_RESPONSE sendTCPData(ATFuture &future, DataSource &source);
+
+    /**
+     * @brief Get the final result code carried by a response line
+     *
+     * @param line Response line without its line ending
+     * @param terminator Line prefix ending the response instead of OK, nullptr for OK
+     * @return AT_STATUS AT_PENDING if the line does not end the response
+     */
+    static AT_STATUS finalResultCode(const ATView &line, const char *terminator = nullptr);
+
+    /**
+     * @brief Loop of the UART link negotiation
+     *
+     * This function is used to find the rate the modem answers at, to move it to targetBaud with AT+IPR
+     * and to keep the new rate only if it passes an echo test. Otherwise the rate steps down,
+     * and after a failed echo test or too many timeouts the modem goes back to autobaud at SIM7080G_BAUD.
+     * Only AT_PRIORITY_LINK commands are dispatched until the link is ready.
+     */
+    void linkLoop();
+
+    /**
+     * @brief Restart the link negotiation from SIM7080G_BAUD
+     *
+     * This function is used after a power cycle, when the modem is back to autobaud.
+     */
+    void restartLink();
+
+    /**
+     * @brief Change the UART rate of the ESP32 side
+     */
+    void switchBaud(uint32_t baud);
+
+    /**
+     * @brief Get the next supported rate below a rate
+     *
+     * @return The next rate, SIM7080G_BAUD at the bottom
      */
-    AT_RESPONSE sendTCPData(std::vector<std::uint8_t> data);
+    static uint32_t lowerBaud(uint32_t baud);
+
     /**
-     * @brief Free the AT command state
+     * @brief Get the rate to probe after a rate the modem did not answer at
      *
-     * This function is used to reset the state of the FSM for AT commands.
-     * Most of the time called when you've fully processed the response.
+     * @return SIM7080G_BAUD, then targetBaud, then the other rates from the fastest
      */
-    void freeATState();
+    uint32_t nextProbeBaud(uint32_t baud) const;
 
     /**
-     * @brief Read from the serial port with timeout
+     * @brief Move what the modem, or the emulator, sent into the receive buffer and to the trace
      *
-     * This function is used to read from the serial port with a timeout.
+     * @return Number of bytes received
+     */
+    size_t receive();
+
+    /**
+     * @brief Start a new response
      *
-     * @return int Character read from the serial port
+     * This function is used to drop what is left of the previous response
+     * and to make the response view start at the next received byte.
      */
-    int TimedRead();
+    void beginResponse();
+
+    /**
+     * @brief Read the UART and update the response
+     *
+     * This function is used to move everything the UART has received into the receive buffer in one call,
+     * then to give each completed unsolicited line to its handler and to look for a final result code
+     * in the other lines, or in the pending line when waiting for the ">" prompt which has no line ending.
+     * With no command running, every line goes to the URC handlers.
+     */
+    void readResponse();
+
+    /**
+     * @brief Check if a line is a result of a command rather than a URC
+     *
+     * @param line Trimmed line
+     * @param command Running command line
+     * @param terminator Terminator of the running command, nullptr for none
+     * @return true if the line starts with a command name (e.g. "+CGNSINF" for AT+CGNSINF) or with the terminator
+     */
+    static bool isSolicited(const ATView &line, const char *command, const char *terminator);
+
+    /**
+     * @brief Check if a job is a read-only query that can be chained with others
+     */
+    static bool isChainable(const ATJob &job);
+
+    /**
+     * @brief Check if a queued job waits for another query to be chained to
+     */
+    bool isHeld(const ATJob &job) const;
+
+    /**
+     * @brief Chain the queued queries compatible with the running job to its command line
+     */
+    void chainQueries();
+
+    /**
+     * @brief Split the response of a chained command line between its jobs
+     *
+     * This function is used to give each query its own information lines. A query whose lines are missing
+     * after an ERROR or a timeout is queued again on its own, so the failing one gets its own result.
+     */
+    void completeBatch();
+
+    /**
+     * @brief Give a line to the URC handler registered for it
+     *
+     * @param line Trimmed line
+     * @return true if a handler took the line
+     */
+    bool dispatchURC(const ATView &line);
+
+    /**
+     * @brief Start the job that should run next, if any
+     */
+    void dispatch();
+
+    /**
+     * @brief Write the raw payload of the running job, as much as the UART TX FIFO takes
+     */
+    void writeData(ATJob &job);
+
+    /**
+     * @brief Mark a job as done, its response must be set
+     */
+    void complete(ATJob &job);
+
+    /**
+     * @brief Release a job slot
+     */
+    void release(ATJob &job);
+
+    /**
+     * @brief Let the receive buffer reuse bytes no response still points to
+     */
+    void releaseBuffer();
 
     /**
      * @brief Send AT command without FSM architecture
@@ -171,11 +746,44 @@ public:
      */
     String send_AT_bloquant(String message, int timeout);
 
-    void powerOn();
+    /**
+     * @brief Power the modem on
+     *
+     * This function is used to pulse PWRKEY then wait for the modem to boot, without blocking.
+     * The wait ends on RDY or as soon as "AT" is answered. Without either after SIM7080G_BOOT_TIMEOUT,
+     * PWRKEY is pulsed again. Call it until it returns true, it does nothing more once the modem is on.
+     *
+     * @return true once the modem answered
+     */
+    bool powerOn();
+
+    /**
+     * @brief Power the modem off
+     *
+     * This function is used to send AT+CPOWD=1 then wait for NORMAL POWER DOWN and for SIM7080G_POWER_DOWN_SETTLE,
+     * without blocking, so that the next powerOn() does not pulse PWRKEY on a modem still going down.
+     * Call it until it returns true.
+     *
+     * @return true once the modem is off
+     */
+    bool powerOff();
 
-    void powerOff();
+    /**
+     * @brief Reset the modem with a long PWRKEY pulse
+     *
+     * This function is used like powerOn(), the sequence starts on the first call. Stop calling it once it returned true,
+     * a new call starts a new reset.
+     *
+     * @return true once the modem is back on
+     */
+    bool hardReset();
 
-    void hardReset();
+    /**
+     * @brief Run the power sequence
+     *
+     * @return true once the modem is on
+     */
+    bool powerSequence();
 };
 
 /**
@@ -0,0 +1,311 @@
+#pragma once
+#ifndef SIM7080G_SIMULATOR_H
+#define SIM7080G_SIMULATOR_H
+#include <Arduino.h>
+#include <SIM7080G/Serial.hpp>
+
+/**
+ * @brief Size of the answers waiting to be read from the simulator
+ */
+#define SIMULATOR_OUTPUT_SIZE 512
+
+/**
+ * @brief Point of a simulated track
+ */
+struct SimulatorWaypoint
+{
+    /**
+     * @brief Time since ModemSimulator::begin() in milliseconds
+     */
+    unsigned long time;
+
+    double latitude;
+    double longitude;
+};
+
+/**
+ * @brief Behaviour of the simulated modem, times in milliseconds
+ */
+struct SimulatorConfig
+{
+    /**
+     * @brief Time between the end of a command and its answer
+     */
+    unsigned long latency = 20;
+
+    /**
+     * @brief Time between AT+CGNSPWR=1 and the first fix
+     */
+    unsigned long fixTime = 30000;
+
+    /**
+     * @brief Time to the first fix when the engine was powered off less than hotStartWindow ago
+     */
+    unsigned long hotStartTime = 2000;
+
+    /**
+     * @brief Time to the first fix of a cold start with XTRA data injected
+     */
+    unsigned long assistedFixTime = 8000;
+
+    /**
+     * @brief Time AT+HTTPTOFS takes to download the XTRA data
+     */
+    unsigned long downloadTime = 3000;
+
+    /**
+     * @brief Time the ephemeris stays valid after AT+CGNSPWR=0
+     */
+    unsigned long hotStartWindow = 1000UL * 60 * 60 * 2;
+
+    /**
+     * @brief Time between power on, or the end of the previous session, and the network registration
+     */
+    unsigned long registrationTime = 5000;
+
+    /**
+     * @brief Time between AT+CNACT=0,1 and the +APP PDP URC
+     */
+    unsigned long pdpTime = 1000;
+
+    /**
+     * @brief Share of a full sky each system brings, in percent, GPS, GLONASS, BeiDou, Galileo and QZSS
+     *
+     * @details The time to fix is divided by the share of the systems enabled by AT+CGNSMOD, up to 100.
+     */
+    uint8_t systemShare[5] = {100, 0, 0, 0, 0};
+
+    /**
+     * @brief Random spread of the time to fix of each power on, in percent either way
+     */
+    uint8_t fixJitter = 0;
+
+    /**
+     * @brief Whether the GNSS never gets a fix, e.g. indoors
+     */
+    bool noFix = false;
+
+    /**
+     * @brief Share of the commands answered ERROR, in percent
+     */
+    uint8_t errorRate = 0;
+
+    /**
+     * @brief Track followed by the reported position, in time order, nullptr to stay still
+     *
+     * @details The position moves in a straight line between two waypoints and stays on the last one.
+     */
+    const SimulatorWaypoint *track = nullptr;
+    size_t trackLength = 0;
+};
+
+/**
+ * @brief Scriptable SIM7080G answering the AT commands of the firmware
+ *
+ * @details Set as Sim7080G.emulator to run the firmware, GNSS fix, cell position, CAT-M1 attach and TCP upload included,
+ * without a modem or a server. The bytes sent over the socket are counted in place of the server.
+ */
+class ModemSimulator : public Stream
+{
+private:
+    /**
+     * @brief Command being written by the firmware
+     */
+    char line[SIM7080G_COMMAND_SIZE];
+    size_t lineLength = 0;
+
+    /**
+     * @brief Answers not read yet
+     */
+    char output[SIMULATOR_OUTPUT_SIZE];
+    size_t outputStart = 0;
+    size_t outputEnd = 0;
+
+    /**
+     * @brief Time (millis) the answers become readable
+     */
+    unsigned long answerAt = 0;
+
+    /**
+     * @brief Time (millis) the +APP PDP URC is due, 0 when none is
+     */
+    unsigned long pdpAt = 0;
+
+    /**
+     * @brief Time (millis) the session started, counts for the registration delay
+     */
+    unsigned long sessionStart = 0;
+
+    /**
+     * @brief Time to fix of the current power on, before and after the share of the enabled systems
+     */
+    unsigned long gnssBaseFixTime = 0;
+    unsigned long gnssFixTime = 0;
+
+    /**
+     * @brief Share of a full sky of the systems enabled by AT+CGNSMOD, in percent
+     */
+    unsigned int gnssShare = 100;
+
+    /**
+     * @brief Time (millis) of AT+CGNSPWR=1
+     */
+    unsigned long gnssPowerOn = 0;
+
+    /**
+     * @brief Time (millis) the GNSS was powered off, 0 before the first session
+     */
+    unsigned long gnssStop = 0;
+
+    /**
+     * @brief Time (millis) begin() or restartTrack() was called, start of the track
+     */
+    unsigned long trackStart = 0;
+
+    /**
+     * @brief Time the GNSS was on during the sessions that ended, in milliseconds
+     */
+    unsigned long gnssOnTime = 0;
+
+    /**
+     * @brief Seconds between two +UGNSINF reports, 0 when AT+CGNSURC disabled them
+     */
+    unsigned long reportRate = 0;
+
+    /**
+     * @brief Time (millis) of the next +UGNSINF report
+     */
+    unsigned long nextReport = 0;
+
+    /**
+     * @brief Time (millis) the +HTTPTOFS URC is due, 0 when none is
+     */
+    unsigned long downloadAt = 0;
+
+    /**
+     * @brief Whether the XTRA data was downloaded, then copied, then enabled
+     */
+    bool xtraDownloaded = false;
+    bool xtraCopied = false;
+    bool xtraEnabled = false;
+
+    bool gnssOn = false;
+    bool pdpActive = false;
+    bool socketOpen = false;
+
+    /**
+     * @brief Bytes still expected after the AT+CASEND prompt
+     */
+    size_t dataLeft = 0;
+    size_t dataLength = 0;
+
+    /**
+     * @brief Queue an answer
+     *
+     * @param text Answer, sent as is
+     */
+    void answer(const char *text);
+
+    /**
+     * @brief Time to fix of the current power on from its base and the enabled systems
+     */
+    void scheduleFix();
+
+    /**
+     * @brief Queue the current position, as +CGNSINF or +UGNSINF
+     */
+    void answerFix(const char *prefix);
+
+    /**
+     * @brief Position on the track
+     *
+     * @param time Time since begin() in milliseconds
+     * @param latitude, longitude Position in degrees
+     * @param speed Speed over ground in km/h
+     */
+    void position(unsigned long time, double &latitude, double &longitude, float &speed) const;
+
+    /**
+     * @brief Run one command of a line, without "AT" and ";"
+     *
+     * @param command Command, e.g. "+CGNSPWR=1"
+     * @return false if the modem answers ERROR
+     */
+    bool execute(const char *command);
+
+    /**
+     * @brief Run a command line written by the firmware
+     */
+    void executeLine();
+
+    /**
+     * @brief Handle one byte written by the firmware
+     */
+    void receive(uint8_t c);
+
+public:
+    /**
+     * @brief Behaviour of the simulated modem, may be changed at any time
+     */
+    SimulatorConfig config;
+
+    /**
+     * @brief Bytes received by the simulated server
+     */
+    uint32_t serverBytes = 0;
+
+    /**
+     * @brief Number of uploads received by the simulated server
+     */
+    uint32_t serverUploads = 0;
+
+    /**
+     * @brief Number of positions given by the location service, AT+CLBS
+     */
+    uint32_t cellLocations = 0;
+
+    /**
+     * @brief Number of command lines answered ERROR, config.errorRate aside
+     */
+    uint32_t errors = 0;
+
+    /**
+     * @brief Rate set by AT+IPR, 0 while the modem autobauds
+     *
+     * @details Bytes written at any other rate are lost. Set it to start with a modem left at a fixed rate by a previous run.
+     */
+    uint32_t baud = 0;
+
+    /**
+     * @brief Power the simulated modem on, it announces itself with RDY
+     */
+    void begin();
+
+    /**
+     * @brief Time the GNSS has been on since begin(), in milliseconds
+     */
+    unsigned long gnssTime() const;
+
+    /**
+     * @brief Follow config.track from its start again, the modem stays on
+     */
+    void restartTrack();
+
+    /**
+     * @brief The server closes the socket, announced by +CASTATE
+     */
+    void closeSocket();
+
+    /**
+     * @brief The network drops the PDP context, announced by +APP PDP, the socket goes with it
+     */
+    void dropPDP();
+
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+};
+
+#endif // SIM7080G_SIMULATOR_H
@@ -2,6 +2,7 @@
 #ifndef SIM7080G_TCP_H
 #define SIM7080G_TCP_H
 #include <SIM7080G/Serial.hpp>
+#include <SIM7080G/ATCommands.hpp>
 #include <QueueList.hpp>
 
 enum TCPState
@@ -32,6 +33,30 @@ public:
      */
     FSM fsmTCP;
 
+    /**
+     * @brief Handle on the AT command in flight
+     */
+    ATFuture atCommand;
+
+    /**
+     * @brief CBOR payload being uploaded, encoded item by item as the UART takes it
+     */
+    QueueListCbor payload;
+
+    /**
+     * @brief Socket state, cleared by the +CASTATE URC when the server closes it
+     *
+     * @details Nothing is sent on a closed socket, it is opened again instead.
+     */
+    bool socketOpen = false;
+
+    /**
+     * @brief Setup function
+     *
+     * This function is used to register the URC handlers of the module.
+     */
+    void setup();
+
     /**
      * @brief Open socket
      */
@@ -47,6 +72,13 @@ public:
      */
     void sendData();
 
+    /**
+     * @brief Forget the socket and the upload in progress, the next loop opens a new socket
+     *
+     * @details Only once the command in flight is finished, e.g. after the PDP context dropped. The items stay queued.
+     */
+    void reset();
+
     /**
      * @brief Loop of the TCP State Machine
      */
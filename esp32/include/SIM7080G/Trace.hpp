@@ -0,0 +1,161 @@
+#pragma once
+#ifndef SIM7080G_TRACE_H
+#define SIM7080G_TRACE_H
+#include <Arduino.h>
+
+/**
+ * @brief First bytes of a trace, followed by the format version
+ */
+#define TRACE_MAGIC "SIMT"
+#define TRACE_VERSION 1
+
+/**
+ * @brief Flag of the record header for bytes written to the modem
+ */
+#define TRACE_TX 0x80
+
+/**
+ * @brief Most bytes in one record
+ */
+#define TRACE_RECORD_SIZE 128
+
+/**
+ * @brief Records every byte exchanged with the modem
+ *
+ * @details A trace is TRACE_MAGIC, TRACE_VERSION, then records:
+ * - one header byte, TRACE_TX for bytes written to the modem, and the number of bytes minus one
+ * - the time since the previous record in microseconds, as a LEB128 varint
+ * - the bytes
+ */
+class TraceWriter
+{
+private:
+    /**
+     * @brief Where the trace goes, e.g. a LittleFS file
+     */
+    Print *sink = nullptr;
+
+    /**
+     * @brief Time (micros) of the previous record
+     */
+    uint32_t lastRecord = 0;
+
+    /**
+     * @brief Bytes written since the sink was last flushed
+     */
+    size_t unflushed = 0;
+
+public:
+    /**
+     * @brief Start a trace
+     *
+     * @param sink Where the trace goes, must stay valid until end()
+     */
+    void begin(Print &sink);
+
+    /**
+     * @brief Stop the trace
+     */
+    void end();
+
+    /**
+     * @brief Check if a trace is being recorded
+     */
+    bool isActive() const { return sink != nullptr; }
+
+    /**
+     * @brief Record bytes
+     *
+     * @param tx true for bytes written to the modem, false for bytes received from it
+     * @param data Bytes
+     * @param length Number of bytes, split into several records if needed
+     */
+    void record(bool tx, const uint8_t *data, size_t length);
+};
+
+/**
+ * @brief Plays a trace back in place of the modem
+ *
+ * @details The received bytes of the trace are given back in order, each record once the bytes the trace
+ * wrote before it were written again and its original delay has passed. The firmware therefore sees the
+ * same answers, with the same latencies, as in the recorded session.
+ */
+class TraceReplay : public Stream
+{
+private:
+    /**
+     * @brief Trace played back, e.g. a LittleFS file
+     */
+    Stream *trace = nullptr;
+
+    /**
+     * @brief Whether the current record holds bytes written to the modem
+     */
+    bool recordTx = false;
+
+    /**
+     * @brief Bytes of the current record not played yet, 0 when a new record must be read
+     */
+    size_t recordLeft = 0;
+
+    /**
+     * @brief Delay of the current record after the previous one, in microseconds
+     */
+    uint32_t recordDelay = 0;
+
+    /**
+     * @brief Time (micros) the previous record was played
+     */
+    uint32_t lastRecord = 0;
+
+    /**
+     * @brief Bytes written by the firmware and not matched with the trace yet
+     */
+    size_t written = 0;
+
+    /**
+     * @brief Read the header of the next record
+     *
+     * @return false at the end of the trace
+     */
+    bool nextRecord();
+
+    /**
+     * @brief Read a LEB128 varint from the trace
+     */
+    uint32_t readVarint();
+
+    /**
+     * @brief Play the written records matched by the firmware output
+     *
+     * @return true if the current record holds received bytes that are due
+     */
+    bool advance();
+
+public:
+    /**
+     * @brief Start playing a trace
+     *
+     * @param trace Trace, must stay valid until end()
+     * @return false if it is not a trace of this version
+     */
+    bool begin(Stream &trace);
+
+    /**
+     * @brief Stop playing
+     */
+    void end();
+
+    /**
+     * @brief Check if a trace is being played
+     */
+    bool isActive() const { return trace != nullptr; }
+
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+};
+
+#endif // SIM7080G_TRACE_H
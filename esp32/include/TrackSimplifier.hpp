@@ -0,0 +1,108 @@
+#pragma once
+#ifndef TRACK_SIMPLIFIER_H
+#define TRACK_SIMPLIFIER_H
+#include <Arduino.h>
+#include <Coordinates.hpp>
+
+/**
+ * @brief Default largest distance in meters between a dropped point and the simplified track
+ */
+#define TRACK_TOLERANCE 10
+
+/**
+ * @brief Points held since the last kept one, a full window keeps its last point
+ */
+#define TRACK_WINDOW_SIZE 16
+
+/**
+ * @brief Longest time in milliseconds between two kept points while moving
+ */
+#define TRACK_MAX_SPAN (1000UL * 60 * 15)
+
+/**
+ * @brief What becomes of a point pushed to the simplifier
+ */
+enum TrackDecision
+{
+    /**
+     * @brief The point is held, it is kept only if the track turns after it
+     */
+    TRACK_HOLD,
+
+    /**
+     * @brief The point starts a track, keep it
+     */
+    TRACK_KEEP,
+
+    /**
+     * @brief The previous point ends a straight segment, keep it, this one is held
+     */
+    TRACK_KEEP_PREVIOUS
+};
+
+/**
+ * @brief Streaming track simplification, opening window variant of Douglas-Peucker
+ *
+ * @details A point is dropped while every point since the last kept one stays within tolerance of the segment
+ * from the last kept point to the newest. When one strays, the point before the newest is kept and starts
+ * the next window. The window is bounded to TRACK_WINDOW_SIZE points and TRACK_MAX_SPAN, so a long straight
+ * line still gets a point now and then. Only positions are held, the caller keeps the last record.
+ */
+class TrackSimplifier
+{
+private:
+    /**
+     * @brief Last kept point, in 1e-7 degrees
+     */
+    int32_t anchorLatitude = 0;
+    int32_t anchorLongitude = 0;
+    unsigned long anchorTime = 0;
+    bool hasAnchor = false;
+
+    /**
+     * @brief Points held since the anchor, in 1e-7 degrees with their time (millis), the last one is the newest
+     */
+    int32_t latitudes[TRACK_WINDOW_SIZE];
+    int32_t longitudes[TRACK_WINDOW_SIZE];
+    unsigned long times[TRACK_WINDOW_SIZE];
+    uint8_t count = 0;
+
+    /**
+     * @brief Check if every held point stays within tolerance of the segment from the anchor to a point
+     */
+    bool fits(int32_t latitude, int32_t longitude) const;
+
+    /**
+     * @brief Make the newest held point the anchor
+     */
+    void keepLast();
+
+public:
+    /**
+     * @brief Largest distance in meters between a dropped point and the simplified track, 0 keeps every point
+     */
+    uint32_t tolerance = TRACK_TOLERANCE;
+
+    /**
+     * @brief Add the newest point of the track
+     *
+     * @param latitude, longitude Position in 1e-7 degrees
+     * @param time Time (millis) of the point
+     * @return Which point to keep, if any
+     */
+    TrackDecision push(int32_t latitude, int32_t longitude, unsigned long time);
+
+    /**
+     * @brief End the current segment at the newest point, e.g. when the device stops
+     *
+     * @return True if the newest point must be kept
+     */
+    bool flush();
+
+    /**
+     * @brief Forget the track, the next point starts a new one
+     */
+    void reset();
+};
+
+#endif // TRACK_SIMPLIFIER_H
@@ -0,0 +1,93 @@
+#include <Coordinates.hpp>
+
+/**
+ * @brief Cosine of each whole degree from 0 to 90, in 1 << COORDINATE_COSINE_BITS
+ */
+static const uint16_t COSINES[] = {
+    32768, 32763, 32748, 32723, 32688, 32643, 32588, 32524, 32449, 32365,
+    32270, 32166, 32052, 31928, 31795, 31651, 31499, 31336, 31164, 30983,
+    30792, 30592, 30382, 30163, 29935, 29698, 29452, 29197, 28932, 28660,
+    28378, 28088, 27789, 27482, 27166, 26842, 26510, 26170, 25822, 25466,
+    25102, 24730, 24351, 23965, 23571, 23170, 22763, 22348, 21926, 21498,
+    21063, 20622, 20174, 19720, 19261, 18795, 18324, 17847, 17364, 16877,
+    16384, 15886, 15384, 14876, 14365, 13848, 13328, 12803, 12275, 11743,
+    11207, 10668, 10126, 9580, 9032, 8481, 7927, 7371, 6813, 6252,
+    5690, 5126, 4560, 3993, 3425, 2856, 2286, 1715, 1144, 572,
+    0};
+
+int32_t Coordinates::cosine(int32_t latitude)
+{
+    int64_t x = latitude < 0 ? -(int64_t)latitude : latitude;
+    if (x >= 90 * COORDINATE_SCALE)
+        return 0;
+
+    // Linear between two whole degrees
+    int32_t degree = x / COORDINATE_SCALE;
+    int64_t fraction = x % COORDINATE_SCALE;
+
+    return COSINES[degree] - (int32_t)((COSINES[degree] - COSINES[degree + 1]) * fraction / COORDINATE_SCALE);
+}
+
+uint32_t Coordinates::squareRoot(uint64_t value)
+{
+    uint64_t root = 0;
+
+    for (uint64_t bit = 1ULL << 62; bit > 0; bit >>= 2)
+    {
+        if (value >= root + bit)
+        {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+    }
+
+    return (uint32_t)root;
+}
+
+uint32_t Coordinates::distance(int32_t latitude1, int32_t longitude1, int32_t latitude2, int32_t longitude2)
+{
+    int64_t dLongitude = (int64_t)longitude2 - longitude1;
+    if (dLongitude > 180 * COORDINATE_SCALE)
+        dLongitude -= 360 * COORDINATE_SCALE;
+    else if (dLongitude < -180 * COORDINATE_SCALE)
+        dLongitude += 360 * COORDINATE_SCALE;
+
+    int64_t dy = toCentimeters((int64_t)latitude2 - latitude1);
+    int64_t dx = (toCentimeters(dLongitude) * cosine(latitude1 / 2 + latitude2 / 2)) >> COORDINATE_COSINE_BITS;
+
+    return squareRoot((uint64_t)(dx * dx) + (uint64_t)(dy * dy));
+}
+
+/**
+ * @brief Offset in centimeters beyond which the frame of segmentDistance does not hold, 1000 km
+ */
+#define COORDINATE_MAX_OFFSET 100000000LL
+
+uint32_t Coordinates::segmentDistance(int32_t latitude, int32_t longitude, int32_t latitude1, int32_t longitude1, int32_t latitude2, int32_t longitude2)
+{
+    int32_t c = cosine(latitude1);
+    int64_t px = (toCentimeters((int64_t)longitude - longitude1) * c) >> COORDINATE_COSINE_BITS;
+    int64_t py = toCentimeters((int64_t)latitude - latitude1);
+    int64_t bx = (toCentimeters((int64_t)longitude2 - longitude1) * c) >> COORDINATE_COSINE_BITS;
+    int64_t by = toCentimeters((int64_t)latitude2 - latitude1);
+
+    if (px > COORDINATE_MAX_OFFSET || px < -COORDINATE_MAX_OFFSET || py > COORDINATE_MAX_OFFSET || py < -COORDINATE_MAX_OFFSET ||
+        bx > COORDINATE_MAX_OFFSET || bx < -COORDINATE_MAX_OFFSET || by > COORDINATE_MAX_OFFSET || by < -COORDINATE_MAX_OFFSET)
+        return UINT32_MAX;
+
+    // To the nearest end when the point falls outside of the segment
+    int64_t dot = px * bx + py * by;
+    int64_t length2 = bx * bx + by * by;
+
+    if (length2 == 0 || dot <= 0)
+        return squareRoot(px * px + py * py);
+    if (dot >= length2)
+        return squareRoot((px - bx) * (px - bx) + (py - by) * (py - by));
+
+    int64_t cross = px * by - py * bx;
+    return (cross < 0 ? -cross : cross) / squareRoot(length2);
+}
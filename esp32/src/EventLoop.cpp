@@ -0,0 +1,46 @@
+#include <EventLoop.hpp>
+
+void EventLoop::setup()
+{
+    task = xTaskGetCurrentTaskHandle();
+}
+
+void EventLoop::notify()
+{
+    if (task != nullptr)
+        xTaskNotifyGive(task);
+}
+
+void EventLoop::wakeAt(unsigned long time)
+{
+    if (!hasWake || (long)(time - nextWake) < 0)
+        nextWake = time;
+
+    hasWake = true;
+}
+
+void EventLoop::wakeNow()
+{
+    wakeAt(millis());
+}
+
+void EventLoop::wait()
+{
+    cycles++;
+
+    unsigned long timeout = EVENT_LOOP_MAX_WAIT;
+
+    if (hasWake)
+    {
+        long remaining = (long)(nextWake - millis());
+        if (remaining < (long)timeout)
+            timeout = remaining > 0 ? remaining : 0;
+    }
+
+    hasWake = false;
+
+    // Notifications received while the iteration ran are pending, they end the wait at once
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeout));
+}
+
+EventLoop events;
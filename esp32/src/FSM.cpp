@@ -15,6 +15,7 @@ void FSM::setState(unsigned char newState)
         if (debug)
             Serial.printf("[%s] changed from '%d' to '%d'\n", name, currentState, newState);
         lastUpdate = millis();
+        events.wakeNow();
     }
 
     previousState = currentState;
@@ -27,6 +28,7 @@ bool FSM::delay(int delayTime)
     {
         timer = millis();
         inDelay = true;
+        events.wakeAt(timer + delayTime);
         return false;
     }
 
@@ -34,15 +36,23 @@ bool FSM::delay(int delayTime)
     {
         timer = 0;
         inDelay = false;
+
+        // A repeated delay starts again on the next iteration
+        events.wakeNow();
         return true;
     }
 
+    events.wakeAt(timer + delayTime);
     return false;
 }
 
 bool FSM::isOutOfDelay(int delayTime)
 {
-    return millis() - timer >= delayTime;
+    if (millis() - timer >= delayTime)
+        return true;
+
+    events.wakeAt(timer + delayTime);
+    return false;
 }
 
 void FSM::resetTimer()
@@ -0,0 +1,135 @@
+#include <FixFilter.hpp>
+
+#pragma region Axis
+void FixFilter::Axis::reset(int32_t position, int64_t variance)
+{
+    this->position = position;
+    speed = 0;
+    p00 = variance;
+    p01 = 0;
+    p11 = FIX_FILTER_INITIAL_SPEED_VARIANCE;
+}
+
+void FixFilter::Axis::predict(int64_t dt)
+{
+    // dt in milliseconds, below FIX_FILTER_MAX_GAP: q * dt³ stays within 64 bits
+    const int64_t q = FIX_FILTER_ACCELERATION_NOISE;
+
+    position += (int32_t)((int64_t)speed * dt / 1000);
+
+    p00 += 2 * dt * p01 / 1000 + dt * dt / 1000 * p11 / 1000 + q * dt * dt / 1000 * dt / 3000000;
+    p01 += dt * p11 / 1000 + q * dt * dt / 2000000;
+    p11 += q * dt / 1000;
+
+    // A clamped covariance drops its correlation, which keeps it positive
+    if (p00 > FIX_FILTER_MAX_POSITION_VARIANCE || p11 > FIX_FILTER_MAX_SPEED_VARIANCE)
+    {
+        p00 = p00 < FIX_FILTER_MAX_POSITION_VARIANCE ? p00 : FIX_FILTER_MAX_POSITION_VARIANCE;
+        p11 = p11 < FIX_FILTER_MAX_SPEED_VARIANCE ? p11 : FIX_FILTER_MAX_SPEED_VARIANCE;
+        p01 = 0;
+    }
+}
+
+void FixFilter::Axis::correct(int64_t innovation, int64_t variance)
+{
+    int64_t s = p00 + variance;
+
+    position += (int32_t)(p00 * innovation / s);
+    speed += (int32_t)(p01 * innovation / s);
+
+    int64_t p01Next = p01 * variance / s;
+    p11 -= p01 * p01 / s;
+    p00 = p00 * variance / s;
+    p01 = p01Next;
+}
+#pragma endregion Axis
+
+#pragma region FixFilter
+void FixFilter::start(int32_t latitude, int32_t longitude, int64_t variance, unsigned long time)
+{
+    originLatitude = latitude;
+    originLongitude = longitude;
+    originCosine = Coordinates::cosine(latitude);
+
+    // Near the poles, a degree of longitude still counts
+    if (originCosine < 1)
+        originCosine = 1;
+
+    north.reset(0, variance);
+    east.reset(0, variance);
+
+    lastTime = time;
+    outliers = 0;
+    initialized = true;
+}
+
+bool FixFilter::update(int32_t latitude, int32_t longitude, uint32_t accuracy, unsigned long time)
+{
+    // At least a meter, the HPA of the modem is optimistic when it is small
+    int64_t centimeters = accuracy > 100 ? accuracy : 100;
+    int64_t variance = centimeters * centimeters;
+    if (variance > FIX_FILTER_MAX_POSITION_VARIANCE)
+        variance = FIX_FILTER_MAX_POSITION_VARIANCE;
+
+    if (!initialized || time - lastTime > FIX_FILTER_MAX_GAP)
+    {
+        start(latitude, longitude, variance, time);
+        return true;
+    }
+
+    int64_t y = Coordinates::toCentimeters((int64_t)latitude - originLatitude);
+    int64_t x = (Coordinates::toCentimeters((int64_t)longitude - originLongitude) * originCosine) >> COORDINATE_COSINE_BITS;
+
+    // Too far from the origin for the local frame, 1000 km
+    if (x > 100000000 || x < -100000000 || y > 100000000 || y < -100000000)
+    {
+        start(latitude, longitude, variance, time);
+        return true;
+    }
+
+    Axis northNext = north;
+    Axis eastNext = east;
+    northNext.predict(time - lastTime);
+    eastNext.predict(time - lastTime);
+
+    int64_t dy = northNext.innovation((int32_t)y);
+    int64_t dx = eastNext.innovation((int32_t)x);
+
+    // Gate on the distance, against the combined variance of the prediction and the fix
+    int64_t gate = (int64_t)FIX_FILTER_GATE * FIX_FILTER_GATE * (northNext.p00 + eastNext.p00 + 2 * variance);
+    if (dx * dx + dy * dy > gate)
+    {
+        if (++outliers >= FIX_FILTER_MAX_OUTLIERS)
+        {
+            start(latitude, longitude, variance, time);
+            return true;
+        }
+
+        return false;
+    }
+
+    northNext.correct(dy, variance);
+    eastNext.correct(dx, variance);
+
+    north = northNext;
+    east = eastNext;
+    lastTime = time;
+    outliers = 0;
+
+    return true;
+}
+
+uint32_t FixFilter::uncertainty() const
+{
+    if (!initialized)
+        return UINT32_MAX;
+
+    return Coordinates::squareRoot(north.p00 + east.p00);
+}
+
+void FixFilter::estimate(int32_t &latitude, int32_t &longitude) const
+{
+    latitude = originLatitude + (int32_t)Coordinates::fromCentimeters(north.position);
+    longitude = originLongitude + (int32_t)Coordinates::fromCentimeters((int64_t)east.position * (1 << COORDINATE_COSINE_BITS) / originCosine);
+}
+#pragma endregion FixFilter
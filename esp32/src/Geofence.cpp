@@ -0,0 +1,121 @@
+#include <Geofence.hpp>
+
+Geofences geofences = Geofences();
+
+void Geofences::begin(const Geofence *fences, uint8_t count)
+{
+    this->fences = fences;
+    this->count = 0;
+    inside = 0;
+    hasState = false;
+    alert = false;
+
+    for (uint8_t i = 0; i < count && i < GEOFENCE_MAX; i++)
+    {
+        const Geofence &fence = fences[i];
+        Box box = {INT32_MAX, INT32_MAX, INT32_MIN, INT32_MIN};
+
+        for (uint8_t j = 0; j < fence.count; j++)
+        {
+            const GeofencePoint &vertex = fence.vertices[j];
+            box.south = vertex.latitude < box.south ? vertex.latitude : box.south;
+            box.west = vertex.longitude < box.west ? vertex.longitude : box.west;
+            box.north = vertex.latitude > box.north ? vertex.latitude : box.north;
+            box.east = vertex.longitude > box.east ? vertex.longitude : box.east;
+        }
+
+        // An ignored fence keeps an empty box, it never contains a fix
+        if (fence.count < 3 || (int64_t)box.north - box.south > GEOFENCE_MAX_SPAN || (int64_t)box.east - box.west > GEOFENCE_MAX_SPAN)
+        {
+            Serial.printf("[x] Geofence %s ignored\n", fence.name);
+            box = {INT32_MAX, INT32_MAX, INT32_MIN, INT32_MIN};
+        }
+
+        boxes[i] = box;
+        this->count++;
+    }
+}
+
+bool Geofences::contains(uint8_t fence, int32_t latitude, int32_t longitude) const
+{
+    const Box &box = boxes[fence];
+
+    if (latitude < box.south || latitude > box.north || longitude < box.west || longitude > box.east)
+        return false;
+
+    // Even-odd rule, a ray going east from the fix crosses the edges an odd number of times from inside
+    const GeofencePoint *vertices = fences[fence].vertices;
+    uint8_t n = fences[fence].count;
+    bool result = false;
+
+    for (uint8_t i = 0, j = n - 1; i < n; j = i++)
+    {
+        const GeofencePoint &a = vertices[j];
+        const GeofencePoint &b = vertices[i];
+
+        if ((a.latitude > latitude) == (b.latitude > latitude))
+            continue;
+
+        // The edge crosses the parallel of the fix east of it when the fix is on its west side,
+        // every difference is within the box so the products stay within 64 bits
+        int64_t dLatitude = (int64_t)b.latitude - a.latitude;
+        int64_t side = ((int64_t)longitude - a.longitude) * dLatitude - ((int64_t)b.longitude - a.longitude) * ((int64_t)latitude - a.latitude);
+
+        if ((side < 0) == (dLatitude > 0))
+            result = !result;
+    }
+
+    return result;
+}
+
+uint32_t Geofences::boundaryDistance(uint8_t fence, int32_t latitude, int32_t longitude) const
+{
+    const GeofencePoint *vertices = fences[fence].vertices;
+    uint8_t n = fences[fence].count;
+    uint32_t result = UINT32_MAX;
+
+    for (uint8_t i = 0, j = n - 1; i < n; j = i++)
+    {
+        uint32_t distance = Coordinates::segmentDistance(latitude, longitude, vertices[j].latitude, vertices[j].longitude,
+                                                         vertices[i].latitude, vertices[i].longitude);
+        if (distance < result)
+            result = distance;
+    }
+
+    return result;
+}
+
+bool Geofences::update(int32_t latitude, int32_t longitude)
+{
+    bool crossed = false;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        uint64_t bit = 1ULL << i;
+        bool isIn = contains(i, latitude, longitude);
+
+        if (!hasState)
+        {
+            inside = isIn ? inside | bit : inside & ~bit;
+            continue;
+        }
+
+        if (isIn == ((inside & bit) != 0))
+            continue;
+
+        // Only the rare changes of side pay for the distance to the edges
+        if (boundaryDistance(i, latitude, longitude) < margin * 100)
+            continue;
+
+        inside ^= bit;
+        crossed = true;
+        Serial.printf("[!] Geofence %s %s\n", fences[i].name, isIn ? "entered" : "left");
+    }
+
+    hasState = true;
+
+    if (crossed)
+        alert = true;
+
+    return crossed;
+}
@@ -3,31 +3,84 @@
 
 QueueList queueList = QueueList();
 
-QueueList::QueueList() : head(nullptr), tail(nullptr), count(0) {}
+const char *dataTypeName(DataType type)
+{
+    switch (type)
+    {
+    case DATA_GNSS:
+        return "GNSS";
+    case DATA_CELL:
+        return "CELL";
+    case DATA_BATTERY:
+        return "BATTERY";
+    default:
+        return "";
+    }
+}
+
+QueueList::QueueList() : head(0), count(0) {}
 
 QueueList::~QueueList()
 {
     clear();
 }
 
+QueueRecord &QueueList::push()
+{
+    if (count == QUEUE_LIST_CAPACITY)
+    {
+        dequeue();
+        dropped++;
+        Serial.printf("[x] Queue full, oldest item dropped (%lu so far)\n", (unsigned long)dropped);
+    }
+
+    count++;
+    return records[(head + count - 1) & (QUEUE_LIST_CAPACITY - 1)];
+}
+
+void QueueList::dequeue()
+{
+    if (count == 0)
+        return;
+
+    if (onDequeue)
+        onDequeue();
+
+    records[head].item->~DataItem();
+    records[head].item = nullptr;
+
+    head = (head + 1) & (QUEUE_LIST_CAPACITY - 1);
+    count--;
+    dequeued++;
+}
+
+void QueueList::drop(size_t items)
+{
+    while (items-- > 0 && count > 0)
+        dequeue();
+}
+
 bool QueueList::isEmpty() const
 {
-    return head == nullptr;
+    return count == 0;
+}
+
+size_t QueueList::size() const
+{
+    return count;
 }
 
 json QueueList::to_json() const
 {
     json dataArray = json::array();
 
-    Node *current = head;
-    while (current != nullptr)
+    for (size_t i = 0; i < count; i++)
     {
-        DataItem *item = static_cast<DataItem *>(current->data);
+        const QueueRecord &record = at(i);
         json dataItem = {
-            {"t", current->type},
-            {"d", item->to_json()}};
+            {"t", dataTypeName(record.type)},
+            {"d", record.item->to_json()}};
         dataArray.push_back(dataItem);
-        current = current->next;
     }
 
     json result = {
@@ -63,21 +116,164 @@ bool QueueList::send(void *client)
 
 void QueueList::clear()
 {
-    Node *current = head;
-    while (current != nullptr)
+    drop(count);
+    head = 0;
+}
+#pragma region QueueListCbor
+/**
+ * @brief Append a CBOR head with the shortest argument, like nlohmann::json does
+ */
+static void cborHead(std::vector<uint8_t> &out, uint8_t major, uint64_t value)
+{
+    major <<= 5;
+
+    if (value < 24)
     {
-        Node *temp = current;
-        current = current->next;
+        out.push_back(major | value);
+        return;
+    }
+
+    uint8_t bytes = value <= 0xFF ? 1 : value <= 0xFFFF ? 2
+                                    : value <= 0xFFFFFFFF ? 4
+                                                          : 8;
+    out.push_back(major | (bytes == 1 ? 24 : bytes == 2 ? 25
+                                         : bytes == 4   ? 26
+                                                        : 27));
+
+    for (int8_t i = bytes - 1; i >= 0; i--)
+        out.push_back((value >> (i * 8)) & 0xFF);
+}
+
+static void cborText(std::vector<uint8_t> &out, const char *text)
+{
+    size_t length = strlen(text);
+    cborHead(out, 3, length);
+    out.insert(out.end(), text, text + length);
+}
+
+static void cborInteger(std::vector<uint8_t> &out, long value)
+{
+    if (value >= 0)
+        cborHead(out, 0, value);
+    else
+        cborHead(out, 1, -1 - value);
+}
+
+bool QueueListCbor::nextChunk()
+{
+    chunk.clear();
+    chunkOffset = 0;
 
-        if (temp->data != nullptr)
+    // Keys in the order nlohmann::json sorts them: c, i, it, t
+    if (stage == 0)
+    {
+        cborHead(chunk, 5, 4);
+        cborText(chunk, "c");
+        cborHead(chunk, 0, count);
+        cborText(chunk, "i");
+        cborText(chunk, Sim7080G.imei.c_str());
+        cborText(chunk, "it");
+        cborHead(chunk, 4, count);
+
+        index = 0;
+        stage = 1;
+        return true;
+    }
+
+    if (stage == 1 && index < count)
+    {
+        // Records are counted from the head at begin(), the head moves when a full queue makes room
+        size_t gone = queue->dequeued - start;
+        if (index < gone)
         {
-            delete static_cast<DataItem *>(temp->data);
-            temp->data = nullptr;
+            Serial.printf("[x] Item %u evicted while it was being sent\n", (unsigned)index);
+            stage = 3;
+            return false;
         }
 
-        delete temp;
+        const QueueRecord &record = queue->at(index - gone);
+        json::to_cbor(json{{"t", dataTypeName(record.type)}, {"d", record.item->to_json()}}, chunk);
+
+        index++;
+        return true;
+    }
+
+    if (stage == 1)
+    {
+        cborText(chunk, "t");
+        cborInteger(chunk, time);
+
+        stage = 2;
+        return true;
     }
 
-    head = tail = nullptr;
-    count = 0;
-}
\ No newline at end of file
+    stage = 3;
+    return false;
+}
+
+void QueueListCbor::begin(const QueueList &queue)
+{
+    this->queue = &queue;
+    count = queue.count;
+    start = queue.dequeued;
+    time = static_cast<long>(std::time(nullptr));
+    stage = 0;
+    total = 0;
+
+    while (nextChunk())
+        total += chunk.size();
+
+    stage = 0;
+    chunk.clear();
+    chunkOffset = 0;
+}
+
+void QueueListCbor::end()
+{
+    queue = nullptr;
+    count = index = 0;
+    stage = 3;
+    total = 0;
+
+    chunk.clear();
+    chunk.shrink_to_fit();
+}
+
+size_t QueueListCbor::items() const
+{
+    if (queue == nullptr)
+        return 0;
+
+    size_t gone = queue->dequeued - start;
+    return gone < count ? count - gone : 0;
+}
+
+size_t QueueListCbor::size() const
+{
+    return total;
+}
+
+size_t QueueListCbor::read(uint8_t *buffer, size_t length)
+{
+    if (queue == nullptr)
+        return 0;
+
+    size_t copied = 0;
+
+    while (copied < length)
+    {
+        if (chunkOffset == chunk.size() && !nextChunk())
+            break;
+
+        size_t count = chunk.size() - chunkOffset;
+        if (count > length - copied)
+            count = length - copied;
+
+        memcpy(buffer + copied, chunk.data() + chunkOffset, count);
+        chunkOffset += count;
+        copied += count;
+    }
+
+    return copied;
+}
+#pragma endregion QueueListCbor
@@ -0,0 +1,389 @@
+#include <QueueStore.hpp>
+#include <EventLoop.hpp>
+#include <Color.hpp>
+#include <SIM7080G/GNSS.hpp>
+#include <SIM7080G/Cell.hpp>
+#include <SIM7080G/Serial.hpp>
+#include <LittleFS.h>
+#include <algorithm>
+
+QueueStore queueStore = QueueStore();
+
+/**
+ * @brief CRC-32 (IEEE 802.3) of a buffer, with a 16-entry table to keep it small
+ */
+static uint32_t crc32(const uint8_t *data, size_t length)
+{
+    static const uint32_t TABLE[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C};
+
+    uint32_t crc = 0xFFFFFFFF;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        crc = TABLE[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
+        crc = TABLE[(crc ^ (data[i] >> 4)) & 0x0F] ^ (crc >> 4);
+    }
+
+    return ~crc;
+}
+
+static uint32_t read32(const uint8_t *data)
+{
+    return data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+static void write32(std::vector<uint8_t> &out, uint32_t value)
+{
+    for (uint8_t i = 0; i < 4; i++)
+        out.push_back((value >> (i * 8)) & 0xFF);
+}
+
+/**
+ * @brief Bytes of the record at data, header and CRC-32 included
+ */
+static size_t recordSize(const uint8_t *data)
+{
+    return QUEUE_STORE_HEADER_SIZE + (data[2] | (data[3] << 8)) + QUEUE_STORE_CRC_SIZE;
+}
+
+void QueueStore::appendRecord(std::vector<uint8_t> &out, uint8_t kind, uint32_t sequence, const uint8_t *payload, size_t length) const
+{
+    size_t start = out.size();
+
+    out.push_back(QUEUE_STORE_MAGIC);
+    out.push_back(kind);
+    out.push_back(length & 0xFF);
+    out.push_back((length >> 8) & 0xFF);
+    write32(out, sequence);
+    out.insert(out.end(), payload, payload + length);
+    write32(out, crc32(out.data() + start, out.size() - start));
+}
+
+void QueueStore::path(char *out, uint32_t index) const
+{
+    sprintf(out, QUEUE_STORE_DIRECTORY "/%08lu.log", (unsigned long)index);
+}
+
+void QueueStore::openSegment()
+{
+    char name[32];
+
+    if (segmentCount == QUEUE_STORE_MAX_SEGMENTS)
+    {
+        path(name, segments[0].index);
+        LittleFS.remove(name);
+        Serial.printf("[x] Queue store full, segment %lu dropped\n", (unsigned long)segments[0].index);
+
+        memmove(segments, segments + 1, --segmentCount * sizeof(Segment));
+    }
+
+    segments[segmentCount++] = {nextSegment++, 0, 0};
+    roll = false;
+}
+
+void QueueStore::purge()
+{
+    // The segment appended to is kept, it holds the last commit
+    while (segmentCount > 1 && segments[0].last <= durable)
+    {
+        char name[32];
+        path(name, segments[0].index);
+        LittleFS.remove(name);
+
+        memmove(segments, segments + 1, --segmentCount * sizeof(Segment));
+    }
+}
+
+void QueueStore::scan(Segment &segment, QueueList *queue)
+{
+    char name[32];
+    path(name, segment.index);
+
+    File file = LittleFS.open(name, "r");
+    if (!file)
+        return;
+
+    std::vector<uint8_t> data(file.size());
+    data.resize(file.read(data.data(), data.size()));
+    file.close();
+
+    segment.size = data.size();
+
+    // A record torn by a power loss, or corrupt, ends the segment
+    for (size_t offset = 0; offset + QUEUE_STORE_HEADER_SIZE + QUEUE_STORE_CRC_SIZE <= data.size();)
+    {
+        const uint8_t *record = data.data() + offset;
+        size_t length = record[2] | (record[3] << 8);
+        size_t end = offset + QUEUE_STORE_HEADER_SIZE + length;
+
+        if (record[0] != QUEUE_STORE_MAGIC || end + QUEUE_STORE_CRC_SIZE > data.size() ||
+            crc32(record, QUEUE_STORE_HEADER_SIZE + length) != read32(data.data() + end))
+        {
+            Serial.printf("[x] Queue store segment %lu ends at byte %u of %u\n", (unsigned long)segment.index, (unsigned)offset, (unsigned)data.size());
+            break;
+        }
+
+        uint8_t kind = record[1];
+        uint32_t sequence = read32(record + 4);
+        offset = end + QUEUE_STORE_CRC_SIZE;
+
+        // First pass, the last commit and the last sequence
+        if (queue == nullptr)
+        {
+            if (kind == QUEUE_STORE_COMMIT)
+                committed = sequence > committed ? sequence : committed;
+            else
+                segment.last = sequence > segment.last ? sequence : segment.last;
+
+            nextSequence = sequence >= nextSequence ? sequence + 1 : nextSequence;
+            continue;
+        }
+
+        // Second pass, the items not sent
+        if (kind == QUEUE_STORE_COMMIT || sequence <= durable)
+            continue;
+
+        json j = json::from_cbor(record + QUEUE_STORE_HEADER_SIZE, record + QUEUE_STORE_HEADER_SIZE + length, true, false);
+        if (!j.is_object())
+            continue;
+
+        restoring = sequence;
+
+        switch (kind)
+        {
+        case DATA_GNSS:
+            queue->enqueue<GNSSData>(GNSSData::from_json(j));
+            restored++;
+            break;
+        case DATA_CELL:
+            queue->enqueue<CELLData>(CELLData::from_json(j));
+            restored++;
+            break;
+        case DATA_BATTERY:
+            queue->enqueue<BATTERYData>(BATTERYData::from_json(j));
+            restored++;
+            break;
+        default:
+            break;
+        }
+
+        restoring = 0;
+    }
+}
+
+void QueueStore::begin(QueueList &queue)
+{
+    unsigned long start = millis();
+    std::vector<uint32_t> indexes;
+
+    if (!LittleFS.exists(QUEUE_STORE_DIRECTORY))
+        LittleFS.mkdir(QUEUE_STORE_DIRECTORY);
+
+    File directory = LittleFS.open(QUEUE_STORE_DIRECTORY);
+    if (directory && directory.isDirectory())
+    {
+        for (File file = directory.openNextFile(); file; file = directory.openNextFile())
+        {
+            const char *name = strrchr(file.name(), '/');
+            name = name ? name + 1 : file.name();
+
+            char *end;
+            unsigned long index = strtoul(name, &end, 10);
+            if (end != name && strcmp(end, ".log") == 0)
+                indexes.push_back(index);
+
+            file.close();
+        }
+        directory.close();
+    }
+
+    std::sort(indexes.begin(), indexes.end());
+
+    segmentCount = 0;
+    nextSegment = indexes.empty() ? 0 : indexes.back() + 1;
+
+    for (size_t i = 0; i < indexes.size(); i++)
+    {
+        // More segments than kept, from an older firmware: the oldest go
+        if (indexes.size() - i > QUEUE_STORE_MAX_SEGMENTS)
+        {
+            char name[32];
+            path(name, indexes[i]);
+            LittleFS.remove(name);
+            continue;
+        }
+
+        segments[segmentCount++] = {indexes[i], 0, 0};
+    }
+
+    // A commit can outlive its items, the sequences go on past both
+    for (size_t i = 0; i < segmentCount; i++)
+        scan(segments[i], nullptr);
+
+    durable = committed;
+    written = nextSequence - 1;
+    restored = 0;
+
+    for (size_t i = 0; i < segmentCount; i++)
+        scan(segments[i], &queue);
+
+    // Never append after a torn record, the next write starts a segment
+    roll = true;
+    purge();
+
+    recoveryTime = millis() - start;
+    Serial.printf("%sQueue store%s: %u items restored from %u segments in %lu ms\n", Color::_GRAY, Color::_RESET,
+                  (unsigned)restored, (unsigned)segmentCount, recoveryTime);
+}
+
+void QueueStore::loop()
+{
+    if (!dirty())
+        return;
+
+    if (batchItems >= QUEUE_STORE_BATCH || millis() - batchTime >= QUEUE_STORE_FLUSH_DELAY)
+        flush();
+    else
+        events.wakeAt(batchTime + QUEUE_STORE_FLUSH_DELAY);
+}
+
+bool QueueStore::flush()
+{
+    std::vector<uint8_t> out;
+    uint32_t last = written;
+
+    // Items sent while they were buffered are never written
+    for (size_t offset = 0; offset < buffer.size(); offset += recordSize(buffer.data() + offset))
+    {
+        uint32_t sequence = read32(buffer.data() + offset + 4);
+
+        if (sequence > committed)
+        {
+            out.insert(out.end(), buffer.begin() + offset, buffer.begin() + offset + recordSize(buffer.data() + offset));
+            last = sequence;
+        }
+    }
+
+    bool commit = needsCommit();
+
+    if (out.empty() && !commit)
+    {
+        buffer.clear();
+        buffer.shrink_to_fit();
+        batchItems = 0;
+        return true;
+    }
+
+    // A new segment starts with the commit, the older ones can then go
+    if (roll || segmentCount == 0 || segments[segmentCount - 1].size + out.size() > QUEUE_STORE_SEGMENT_SIZE)
+    {
+        openSegment();
+        commit = true;
+    }
+
+    if (commit)
+    {
+        std::vector<uint8_t> record;
+        appendRecord(record, QUEUE_STORE_COMMIT, committed, nullptr, 0);
+        out.insert(out.begin(), record.begin(), record.end());
+    }
+
+    Segment &segment = segments[segmentCount - 1];
+    char name[32];
+    path(name, segment.index);
+
+    File file = LittleFS.open(name, "a");
+    size_t size = file ? file.write(out.data(), out.size()) : 0;
+    if (file)
+        file.close();
+
+    segment.size += size;
+    bytesWritten += size;
+
+    // The records written whole are in flash, scan() stops at the torn one
+    bool commitWritten = false;
+    for (size_t offset = 0; offset < size;)
+    {
+        size_t length = recordSize(out.data() + offset);
+        if (offset + length > size)
+            break;
+
+        if (out[offset + 1] == QUEUE_STORE_COMMIT)
+            commitWritten = true;
+        else
+            written = read32(out.data() + offset + 4);
+
+        offset += length;
+    }
+
+    segment.last = written > segment.last ? written : segment.last;
+    if (commitWritten)
+        durable = committed;
+
+    if (size != out.size())
+    {
+        Serial.printf("[x] Queue store write failed, %u of %u bytes\n", (unsigned)size, (unsigned)out.size());
+        roll = true;
+
+        // The records not written stay in the buffer, retried with the next batch rather than on every loop
+        std::vector<uint8_t> tail;
+        for (size_t offset = 0; offset < buffer.size(); offset += recordSize(buffer.data() + offset))
+        {
+            uint32_t sequence = read32(buffer.data() + offset + 4);
+            if (sequence > written && sequence > committed)
+                tail.insert(tail.end(), buffer.begin() + offset, buffer.begin() + offset + recordSize(buffer.data() + offset));
+        }
+
+        buffer.swap(tail);
+        batchItems = 0;
+        batchTime = millis();
+        return false;
+    }
+
+    written = last;
+    buffer.clear();
+    buffer.shrink_to_fit();
+    batchItems = 0;
+
+    purge();
+    return true;
+}
+
+void QueueStore::enqueued(const QueueRecord &record)
+{
+    uint32_t sequence = restoring;
+
+    // An item queued again by begin() is already in flash
+    if (sequence == 0)
+    {
+        if (!dirty())
+            batchTime = millis();
+
+        sequence = nextSequence++;
+        std::vector<uint8_t> payload = json::to_cbor(record.item->to_json());
+        appendRecord(buffer, record.type, sequence, payload.data(), payload.size());
+        batchItems++;
+    }
+
+    // Never full here, QueueList::enqueue() drops the oldest item of a full queue first, through dequeued()
+
+    sequences[(head + count) & (QUEUE_LIST_CAPACITY - 1)] = sequence;
+    count++;
+}
+
+void QueueStore::dequeued()
+{
+    if (count == 0)
+        return;
+
+    bool wasDirty = dirty();
+
+    committed = sequences[head];
+    head = (head + 1) & (QUEUE_LIST_CAPACITY - 1);
+    count--;
+
+    if (!wasDirty && dirty())
+        batchTime = millis();
+}
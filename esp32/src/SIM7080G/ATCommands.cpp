@@ -0,0 +1,88 @@
+#include <SIM7080G/ATCommands.hpp>
+
+void ATCommandWriter::append(char c)
+{
+    if (length + 1 >= capacity)
+    {
+        overflow = true;
+        return;
+    }
+
+    buffer[length++] = c;
+}
+
+void ATCommandWriter::append(const char *text)
+{
+    while (*text != '\0')
+        append(*text++);
+}
+
+void ATCommandWriter::append(long number)
+{
+    // Digits come out in reverse order, 20 covers every long
+    char digits[20];
+    size_t count = 0;
+    unsigned long value = number < 0 ? -(unsigned long)number : number;
+
+    do
+    {
+        digits[count++] = '0' + value % 10;
+        value /= 10;
+    } while (value > 0);
+
+    if (number < 0)
+        append('-');
+
+    while (count > 0)
+        append(digits[--count]);
+}
+
+bool ATCommandWriter::finish()
+{
+    if (capacity == 0)
+        return false;
+
+    buffer[length < capacity ? length : capacity - 1] = '\0';
+    return !overflow;
+}
+
+bool formatATCommand(char *buffer, size_t capacity, const char *pattern, const ATArgument *arguments, size_t count)
+{
+    ATCommandWriter writer(buffer, capacity);
+    size_t argument = 0;
+
+    for (const char *c = pattern; *c != '\0'; c++)
+    {
+        if (*c != '%' || argument >= count)
+        {
+            writer.append(*c);
+            continue;
+        }
+
+        const ATArgument &value = arguments[argument++];
+        c++;
+
+        switch (value.kind)
+        {
+        case 'd':
+            writer.append(value.number);
+            break;
+
+        case 'q':
+            if (value.text == nullptr || strchr(value.text, '"') != nullptr)
+                return false;
+
+            writer.append('"');
+            writer.append(value.text);
+            writer.append('"');
+            break;
+
+        default:
+            if (value.text != nullptr)
+                writer.append(value.text);
+            break;
+        }
+    }
+
+    return writer.finish();
+}
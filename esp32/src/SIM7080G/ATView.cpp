@@ -0,0 +1,169 @@
+#include <SIM7080G/ATView.hpp>
+
+static bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+int ATView::indexOf(char c, size_t from) const
+{
+    for (size_t i = from; i < size; i++)
+    {
+        if (text[i] == c)
+            return i;
+    }
+
+    return -1;
+}
+
+int ATView::indexOf(const char *pattern, size_t from) const
+{
+    size_t patternLength = strlen(pattern);
+
+    if (patternLength > size)
+        return -1;
+
+    for (size_t i = from; i + patternLength <= size; i++)
+    {
+        if (memcmp(text + i, pattern, patternLength) == 0)
+            return i;
+    }
+
+    return -1;
+}
+
+ATView ATView::substring(size_t from) const
+{
+    return substring(from, size);
+}
+
+ATView ATView::substring(size_t from, size_t to) const
+{
+    if (from > to)
+    {
+        size_t temp = from;
+        from = to;
+        to = temp;
+    }
+
+    if (from > size)
+        from = size;
+    if (to > size)
+        to = size;
+
+    return ATView(text + from, to - from);
+}
+
+void ATView::trim()
+{
+    while (size > 0 && isSpace(text[0]))
+    {
+        text++;
+        size--;
+    }
+
+    while (size > 0 && isSpace(text[size - 1]))
+        size--;
+}
+
+bool ATView::startsWith(const char *prefix) const
+{
+    size_t prefixLength = strlen(prefix);
+    return prefixLength <= size && memcmp(text, prefix, prefixLength) == 0;
+}
+
+bool ATView::equals(const char *other) const
+{
+    return strlen(other) == size && memcmp(text, other, size) == 0;
+}
+
+long ATView::toInt() const
+{
+    size_t i = 0;
+    while (i < size && isSpace(text[i]))
+        i++;
+
+    bool negative = false;
+    if (i < size && (text[i] == '-' || text[i] == '+'))
+        negative = text[i++] == '-';
+
+    // Unsigned so that a garbled run of digits wraps around instead of overflowing
+    unsigned long value = 0;
+    while (i < size && text[i] >= '0' && text[i] <= '9')
+        value = value * 10 + (text[i++] - '0');
+
+    return (long)(negative ? 0UL - value : value);
+}
+
+float ATView::toFloat() const
+{
+    // Numbers in AT responses are short, a small stack copy gives strtof its terminator
+    char buffer[32];
+    size_t count = size < sizeof(buffer) - 1 ? size : sizeof(buffer) - 1;
+
+    memcpy(buffer, text, count);
+    buffer[count] = '\0';
+
+    return strtof(buffer, nullptr);
+}
+
+long ATView::toFixed(uint8_t decimals) const
+{
+    size_t i = 0;
+    while (i < size && isSpace(text[i]))
+        i++;
+
+    bool negative = false;
+    if (i < size && (text[i] == '-' || text[i] == '+'))
+        negative = text[i++] == '-';
+
+    unsigned long value = 0;
+    while (i < size && text[i] >= '0' && text[i] <= '9')
+        value = value * 10 + (text[i++] - '0');
+
+    if (i < size && text[i] == '.')
+        i++;
+
+    // Missing decimals count as zeros, the first extra one rounds
+    for (uint8_t d = 0; d < decimals; d++)
+        value = value * 10 + (i < size && text[i] >= '0' && text[i] <= '9' ? text[i++] - '0' : 0);
+
+    if (i < size && text[i] >= '5' && text[i] <= '9')
+        value++;
+
+    return (long)(negative ? 0UL - value : value);
+}
+
+String ATView::toString() const
+{
+    String result;
+    result.reserve(size);
+
+    for (size_t i = 0; i < size; i++)
+        result += text[i];
+
+    return result;
+}
+
+ATView ATView::nextLine(size_t &offset) const
+{
+    while (offset < size)
+    {
+        int end = indexOf('\n', offset);
+        size_t lineEnd = end == -1 ? size : end;
+
+        ATView line = substring(offset, lineEnd);
+        offset = lineEnd + 1;
+
+        line.trim();
+        if (!line.isEmpty())
+            return line;
+    }
+
+    return ATView();
+}
+
+size_t ATView::printTo(Print &p) const
+{
+    return p.write((const uint8_t *)text, size);
+}
@@ -15,38 +15,45 @@ SIM7080GCATM1::~SIM7080GCATM1()
 {
 }
 
+void SIM7080GCATM1::setup()
+{
+    // The network can drop the PDP context at any time
+    Sim7080G.onURC("+APP PDP:", [](const ATView &line)
+                   {
+        CATM1.pdpActive = line.indexOf("DEACTIVE") == -1;
+        Serial.print("[!] PDP context changed : ");
+        Serial.println(line); });
+}
+
 void SIM7080GCATM1::powerOn()
 {
-    AT_RESPONSE response = Sim7080G.sendATCommand("AT+CNMP=38;+CMNB=1;+CNACT=0,0;+CGDCONT=1,\"IP\",\"iot.1nce.net\";+CNCFG=0,1,iot.1nce.net");
+    AT_RESPONSE response = ATCommands::CATM1_CONFIGURE.send(atCommand, Quoted{APN}, APN);
 
     if (response.isFinished)
     {
         Serial.println(response.message);
         fsmCATM1.setState(PDP);
-        Sim7080G.freeATState();
     }
 }
 
 void SIM7080GCATM1::powerOff()
 {
     Serial.println("Powering off CATM1");
-    AT_RESPONSE response = Sim7080G.sendATCommand("AT+CNACT=0,0");
+    AT_RESPONSE response = ATCommands::PDP_DEACTIVATE.send(atCommand, 0, 0);
 
     if (response.isFinished)
     {
         fsmCATM1.setState(CATM1_ON);
         fsm.setState(MODULE_TCP);
-        Sim7080G.freeATState();
     }
 }
 
 void SIM7080GCATM1::pdp()
 {
-    AT_RESPONSE response = Sim7080G.sendATCommand("AT+CNACT=0,1", 15000);
+    AT_RESPONSE response = ATCommands::PDP_ACTIVATE.send(atCommand, 0, 1);
 
     if (response.isFinished)
     {
-        Sim7080G.freeATState();
         if (response.message.indexOf("ERROR") != -1)
         {
             Serial.println("[x] PDP context error");
@@ -58,6 +65,7 @@ void SIM7080GCATM1::pdp()
         else if (response.message.indexOf("ACTIVE") != -1)
         {
             Serial.println("[+] PDP context is active");
+            pdpActive = true;
             fsmCATM1.setState(CEREG);
         }
         else
@@ -69,12 +77,18 @@ void SIM7080GCATM1::pdp()
 
 void SIM7080GCATM1::cereg()
 {
-    if (fsmCATM1.isOutOfDelay(2000))
+    // Come back when the next poll is due, a poll already due would keep the loop from sleeping at all
+    if (!Sim7080G.isPending(atCommand) && millis() - lastPoll < CATM1_POLL_INTERVAL)
+        events.wakeAt(lastPoll + CATM1_POLL_INTERVAL);
+
+    if (fsmCATM1.isOutOfDelay(2000) && (Sim7080G.isPending(atCommand) || millis() - lastPoll >= CATM1_POLL_INTERVAL))
     {
-        AT_RESPONSE response = Sim7080G.sendATCommand("AT+CEREG?");
+        AT_RESPONSE response = ATCommands::CEREG_READ.send(atCommand);
         // AT+CEREG?
         if (response.isFinished)
         {
+            lastPoll = millis();
+
             // Serial.println("Raw msg : " + response.message);
 
             response.message = response.message.substring(response.message.indexOf(",") + 1);
@@ -84,9 +98,7 @@ void SIM7080GCATM1::cereg()
 
             // Serial.println(response.message);
 
-            Sim7080G.freeATState();
-
-            if (atoi(response.message.c_str()) == 5)
+            if (response.message.toInt() == 5)
             {
                 Serial.println("[+] Cereg OK");
 
@@ -96,10 +108,11 @@ void SIM7080GCATM1::cereg()
             }
             else
             {
-                Serial.println("[!] Cereg not ok : " + response.message);
+                Serial.print("[!] Cereg not ok : ");
+                Serial.println(response.message);
     
                 int delay = 0;
-                switch (atoi(response.message.c_str()))
+                switch (response.message.toInt())
                 {
                 case 0:
                     delay = 7000;
@@ -130,11 +143,11 @@ void SIM7080GCATM1::getIp()
 {
     if (fsmCATM1.isOutOfDelay(2000))
     {
-        AT_RESPONSE response = Sim7080G.sendATCommand("AT+CNACT?");
+        AT_RESPONSE response = ATCommands::CNACT_READ.send(atCommand);
 
         if (response.isFinished)
         {
-            String fullResponse = response.message;
+            ATView fullResponse = response.message;
             // Serial.println("res ip : " + response.message);
             response.message = response.message.substring(response.message.indexOf(",") + 1);
             response.message = response.message.substring(response.message.indexOf(",") + 1);
@@ -143,12 +156,12 @@ void SIM7080GCATM1::getIp()
             response.message = response.message.substring(0, response.message.indexOf("."));
             // Serial.println("substring : " + response.message);
 
-            Sim7080G.freeATState();
             fsmCATM1.resetTimer();
 
             if (response.message != "0")
             {
-                Serial.println("IP : " + fullResponse);
+                Serial.print("IP : ");
+                Serial.println(fullResponse);
                 fsm.setState(MODULE_TCP);
                 // fsmCATM1.setState(CATM1_ON);
             }
@@ -170,14 +183,21 @@ void SIM7080GCATM1::loop()
         pdp();
         break;
     case CEREG:
-    {
-        cereg();
-
-        break;
-    }
     case IP:
     {
-        getIp();
+        // Dropped by the network since it was activated, the IP address would never come
+        if (!pdpActive && !Sim7080G.isPending(atCommand))
+        {
+            Serial.println("[x] PDP context dropped, activating it again");
+            atCommand = ATFuture();
+            fsmCATM1.setState(PDP);
+            break;
+        }
+
+        if (fsmCATM1.currentState == CEREG)
+            cereg();
+        else
+            getIp();
         break;
     }
     case CATM1_OFF:
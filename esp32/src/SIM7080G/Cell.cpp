@@ -0,0 +1,203 @@
+#include <SIM7080G/Cell.hpp>
+#include <Color.hpp>
+
+#pragma region Cell
+SIM7080GCell Cell = SIM7080GCell();
+
+SIM7080GCell::SIM7080GCell()
+{
+    fsmCell.name = "Cell";
+    fsmCell.debug = true;
+    fsmCell.currentState = CELL_INFO;
+}
+
+SIM7080GCell::~SIM7080GCell()
+{
+}
+
+/**
+ * @brief Information line of a response, after its prefix and without the line end
+ *
+ * @return Empty if the response has no such line
+ */
+static ATView informationLine(const ATView &response, const char *prefix)
+{
+    int at = response.indexOf(prefix);
+    if (at < 0)
+        return ATView();
+
+    ATView line = response.substring(at + strlen(prefix));
+    int end = line.indexOf('\r');
+    if (end >= 0)
+        line = line.substring(0, end);
+
+    line.trim();
+    return line;
+}
+
+/**
+ * @brief Field of a comma-separated line, empty if the line has fewer
+ */
+static ATView field(const ATView &line, uint8_t index)
+{
+    size_t from = 0;
+
+    for (uint8_t i = 0; i < index; i++)
+    {
+        int comma = line.indexOf(',', from);
+        if (comma < 0)
+            return ATView();
+        from = comma + 1;
+    }
+
+    int end = line.indexOf(',', from);
+    return line.substring(from, end < 0 ? line.length() : end);
+}
+
+/**
+ * @brief Read a hexadecimal number, "0x1B5A"
+ */
+static uint32_t readHex(const ATView &value)
+{
+    uint32_t result = 0;
+    size_t i = value.startsWith("0x") || value.startsWith("0X") ? 2 : 0;
+
+    for (; i < value.length(); i++)
+    {
+        char c = value[i];
+        if (c >= '0' && c <= '9')
+            result = result * 16 + (c - '0');
+        else if (c >= 'a' && c <= 'f')
+            result = result * 16 + (c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F')
+            result = result * 16 + (c - 'A' + 10);
+        else
+            break;
+    }
+
+    return result;
+}
+
+void SIM7080GCell::parseServingCell(const ATView &response)
+{
+    // +CPSI: LTE CAT-M1,Online,<MCC>-<MNC>,<TAC>,<SCellID>,<PCellID>,<band>,<earfcn>,<dlbw>,<ulbw>,<RSRQ>,<RSRP>,<RSSI>,<RSSNR>
+    // or +CPSI: NO SERVICE,Online without a cell
+    ATView line = informationLine(response, "+CPSI:");
+    ATView network = field(line, 2);
+    int dash = network.indexOf('-');
+
+    if (dash < 0)
+        return;
+
+    data.mcc = network.substring(0, dash).toInt();
+    data.mnc = network.substring(dash + 1).toInt();
+    data.tac = readHex(field(line, 3));
+    data.cellId = field(line, 4).toInt();
+    data.rsrp = field(line, 11).toInt();
+}
+
+bool SIM7080GCell::parseLocation(const ATView &response)
+{
+    // +CLBS: <location code>[,<longitude>,<latitude>,<accuracy>,<yy/MM/dd>,<hh:mm:ss>], 0 on success
+    ATView line = informationLine(response, "+CLBS:");
+
+    ATView code = field(line, 0);
+    ATView date = field(line, 4);
+    ATView time = field(line, 5);
+
+    // A position without its date would be queued in year 0
+    if (code.isEmpty() || code.toInt() != 0 || field(line, 3).isEmpty() || date.length() < 8 || time.length() < 8)
+        return false;
+
+    data.longitude = field(line, 1).toFixed(7);
+    data.latitude = field(line, 2).toFixed(7);
+    data.accuracy = field(line, 3).toInt();
+    data.utcDateTime = DateTime(2000 + date.substring(0, 2).toInt(), date.substring(3, 5).toInt(), date.substring(6, 8).toInt(),
+                                time.substring(0, 2).toInt(), time.substring(3, 5).toInt(), time.substring(6, 8).toInt(), 0);
+
+    return true;
+}
+
+bool SIM7080GCell::Locate()
+{
+    switch (fsmCell.currentState)
+    {
+    case CELL_INFO:
+    {
+        AT_RESPONSE response = ATCommands::CPSI_READ.send(atCommand);
+
+        if (response.isFinished)
+        {
+            data = CELLData();
+
+            if (response.status == AT_OK)
+                parseServingCell(response.message);
+
+            fsmCell.setState(CELL_LOCATE);
+        }
+        break;
+    }
+    case CELL_LOCATE:
+    {
+        AT_RESPONSE response = ATCommands::CLBS.send(atCommand, CELL_CLBS_TYPE, 0);
+
+        if (response.isFinished)
+        {
+            pending = false;
+            fsmCell.setState(CELL_INFO);
+
+            if (response.status != AT_OK || !parseLocation(response.message))
+            {
+                Serial.print("[x] Cell position failed: ");
+                Serial.println(response.message);
+                return true;
+            }
+
+            Serial.printf("%sCell position%s: %.7f, %.7f within %lu m (cell %lu)\n", Color::_GRAY, Color::_RESET,
+                          Coordinates::toDegrees(data.latitude), Coordinates::toDegrees(data.longitude), (unsigned long)data.accuracy, (unsigned long)data.cellId);
+            queueList.enqueue<CELLData>(data);
+            GNSS.setClock(data.utcDateTime);
+            return true;
+        }
+        break;
+    }
+    default:
+        fsmCell.setState(CELL_INFO);
+        break;
+    }
+
+    return false;
+}
+#pragma endregion Cell
+
+#pragma region CELLData
+json CELLData::to_json() const
+{
+    return json{
+        {"t", utcDateTime.toUnixTime()},
+        {"y", latitude},
+        {"x", longitude},
+        {"acc", accuracy},
+        {"mcc", mcc},
+        {"mnc", mnc},
+        {"tac", tac},
+        {"ci", cellId},
+        {"rsrp", rsrp}
+    };
+}
+
+CELLData CELLData::from_json(const json &j)
+{
+    CELLData data;
+    data.utcDateTime = DateTime::fromUnixTime(j.value("t", 0LL));
+    data.latitude = j.value("y", 0);
+    data.longitude = j.value("x", 0);
+    data.accuracy = j.value("acc", 0);
+    data.mcc = j.value("mcc", 0);
+    data.mnc = j.value("mnc", 0);
+    data.tac = j.value("tac", 0);
+    data.cellId = j.value("ci", 0);
+    data.rsrp = j.value("rsrp", 0);
+    return data;
+}
+#pragma endregion CELLData
@@ -1,4 +1,5 @@
 #include <SIM7080G/GNSS.hpp>
+#include <Color.hpp>
 
 #pragma region GNSS
 SIM7080GGNSS GNSS = SIM7080GGNSS();
@@ -9,38 +10,315 @@ SIM7080GGNSS::SIM7080GGNSS()
     fsmPower.debug = true;
     fsmPower.currentState = GNSS_OFF;
     fsmPower.previousState = GNSS_OFF;
+
+    fsmAssistance.name = "XTRA";
+    fsmAssistance.debug = true;
+    fsmAssistance.currentState = GNSS_ASSISTANCE_DOWNLOAD;
 }
 
 SIM7080GGNSS::~SIM7080GGNSS()
 {
 }
 
+/**
+ * @brief Scale a value to hundredths, saturated to the range of the record field
+ */
+static uint16_t toHundredths(float value)
+{
+    long scaled = lroundf(value * 100);
+    return scaled < 0 ? 0 : scaled > UINT16_MAX ? UINT16_MAX : (uint16_t)scaled;
+}
+
+GNSSData GNSSData::from_fields(const CGNSINFFields &fields)
+{
+    GNSSData data;
+    data.gnssRunStatus = fields.runStatus;
+    data.fixStatus = fields.fixStatus;
+    data.utcDateTime = fields.utcDateTime;
+    data.latitude = fields.latitude;
+    data.longitude = fields.longitude;
+    data.hdop = fields.hdop;
+    data.hpa = fields.hpa;
+    data.altitude = lroundf(fields.altitude * 100);
+    data.speed = toHundredths(fields.speed);
+    data.course = toHundredths(fields.course);
+    data.vpa = toHundredths(fields.vpa);
+    data.satellitesInView = fields.satellitesInView;
+    data.satellitesUsed = fields.satellitesUsed;
+    return data;
+}
+
+void SIM7080GGNSS::setup()
+{
+    // +UGNSINF: <same fields as +CGNSINF>, sent every AT+CGNSURC fixes while tracking
+    Sim7080G.onURC("+UGNSINF:", [](const ATView &line)
+                   { GNSS.onReport(line); });
+
+    tuner.begin();
+
+    preferences.begin("gnss", false);
+    storedExpiry = preferences.getUInt("xtra", 0);
+}
+
+bool SIM7080GGNSS::useTracking() const
+{
+    switch (mode)
+    {
+    case GNSS_MODE_DUTY_CYCLE:
+        return false;
+    case GNSS_MODE_TRACKING:
+        return true;
+    default:
+        // A duty cycle spends about the time to first fix acquiring, at a higher draw, per interval
+        return ttffMeasured && interval / 1000 <= GNSS_MAX_REPORT_RATE && interval <= ttff * GNSS_ACQUISITION_COST;
+    }
+}
+
+unsigned long SIM7080GGNSS::reportRate() const
+{
+    unsigned long rate = interval / 1000;
+
+    if (rate < 1)
+        return 1;
+    if (rate > GNSS_MAX_REPORT_RATE)
+        return GNSS_MAX_REPORT_RATE;
+
+    return rate;
+}
+
+bool SIM7080GGNSS::accept(const GNSSData &fix)
+{
+    if (!adaptive)
+        return true;
+
+    bool moving = fix.speed >= GNSS_MOVING_SPEED;
+
+    if (hasLastFix && !moving && fix.distanceTo(lastFix) < stationaryRadius * 100)
+    {
+        interval = interval * 2 < GNSS_MAX_INTERVAL ? interval * 2 : GNSS_MAX_INTERVAL;
+        Serial.printf("[-] Stationary, next GNSS sample in %lu s\n", interval / 1000);
+        endTrack();
+        return false;
+    }
+
+    interval = fix.speed >= GNSS_FAST_SPEED ? GNSS_MIN_INTERVAL : baseInterval;
+    lastFix = fix;
+    hasLastFix = true;
+
+    return true;
+}
+
+void SIM7080GGNSS::record(const GNSSData &fix)
+{
+    track.tolerance = trackTolerance;
+
+    switch (track.push(fix.latitude, fix.longitude, millis()))
+    {
+    case TRACK_KEEP:
+        queueList.enqueue<GNSSData>(fix);
+        break;
+    case TRACK_KEEP_PREVIOUS:
+        queueList.enqueue<GNSSData>(trackEnd);
+        break;
+    default:
+        Serial.printf("[-] GNSS fix held by the track simplifier\n");
+        break;
+    }
+
+    trackEnd = fix;
+}
+
+void SIM7080GGNSS::endTrack()
+{
+    if (track.flush())
+        queueList.enqueue<GNSSData>(trackEnd);
+}
+
+void SIM7080GGNSS::queue(const GNSSData &fix)
+{
+    bool crossed = geofences.update(fix.latitude, fix.longitude);
+
+    if (!accept(fix) && !crossed)
+        return;
+
+    record(fix);
+
+    // The alert carries the crossing fix, not the one before
+    if (crossed)
+        endTrack();
+}
+
+bool SIM7080GGNSS::fuse(const GNSSData &fix)
+{
+    if (!filter.update(fix.latitude, fix.longitude, fix.accuracy(), millis()))
+    {
+        Serial.printf("[-] GNSS outlier dropped: %.7f, %.7f\n", Coordinates::toDegrees(fix.latitude), Coordinates::toDegrees(fix.longitude));
+        return false;
+    }
+
+    lastFused = fix;
+    setClock(fix.utcDateTime);
+    return filter.uncertainty() <= targetAccuracy;
+}
+
+GNSSData SIM7080GGNSS::filtered() const
+{
+    GNSSData fix = lastFused;
+    filter.estimate(fix.latitude, fix.longitude);
+    fix.hpa = filter.uncertainty() / 100.0f;
+    return fix;
+}
+
+bool SIM7080GGNSS::measureFix()
+{
+    if (!awaitingFix)
+        return false;
+
+    awaitingFix = false;
+    ttffMeasured = true;
+    ttff = (ttff * 3 + (millis() - powerOnTime)) / 4;
+    tuner.record(millis() - powerOnTime, filter.uncertainty());
+
+    Serial.printf("[+] GNSS fix after %lu ms, time to first fix now %lu ms\n", millis() - powerOnTime, ttff);
+    return true;
+}
+
 bool SIM7080GGNSS::PowerOn()
 {
-    if (fsmPower.currentState == GNSS_OFF)
+    // The engine is already running, only the reports stop
+    if (fsmPower.currentState == GNSS_TRACKING)
     {
-        AT_RESPONSE response = Sim7080G.sendATCommand("AT+CGNSPWR=1;+CGNSMOD=1,0,0,1,0", 2000);
+        AT_RESPONSE response = ATCommands::CGNSURC.send(atCommand, 0);
 
         if (response.isFinished)
         {
+            trackingRate = 0;
+            acquisitionStart = millis();
+            fsmPower.setState(GNSS_ON);
+        }
+    }
+    else if (fsmPower.currentState == GNSS_OFF)
+    {
+        const GNSSConstellations &systems = tuner.select();
+        AT_RESPONSE response = ATCommands::GNSS_POWER_ON.send(atCommand, systems.gps, systems.glonass, systems.beidou, systems.galileo, systems.qzss);
+
+        if (response.isFinished)
+        {
+            // The previous track is stale, the fixes start again from the first one
+            powerOnTime = acquisitionStart = millis();
+            awaitingFix = true;
+            filter.reset();
             fsmPower.setState(GNSS_ON);
-            Sim7080G.freeATState();
         }
     }
 
     return fsmPower.currentState == GNSS_ON;
 }
 
+bool SIM7080GGNSS::StartTracking()
+{
+    if (fsmPower.currentState == GNSS_TRACKING)
+        return true;
+
+    if (!PowerOn())
+        return false;
+
+    // Every second until the first fix, so that it is neither late nor measured late
+    unsigned long rate = awaitingFix ? 1 : reportRate();
+    AT_RESPONSE response = ATCommands::CGNSURC.send(atCommand, (int)rate);
+
+    if (response.isFinished && response.status == AT_OK)
+    {
+        trackingRate = rate;
+        requestedRate = 0;
+        fsmPower.setState(GNSS_TRACKING);
+    }
+
+    return fsmPower.currentState == GNSS_TRACKING;
+}
+
+bool SIM7080GGNSS::TrackingFailed()
+{
+    if (fsmPower.currentState != GNSS_TRACKING)
+        return false;
+
+    // A report is due every trackingRate seconds, the deadline is still registered in case they stop
+    unsigned long deadline = acquisitionStart + trackingRate * 1000 + acquisitionTimeout;
+    if ((long)(millis() - deadline) < 0)
+    {
+        events.wakeAt(deadline);
+        return false;
+    }
+
+    acquisitionStart = millis();
+    awaitingFix = false;
+    ttffMeasured = false;
+
+    // Only accounted when the first fix was awaited, the tuner measures the time to first fix
+    tuner.fail(millis() - powerOnTime);
+    endTrack();
+    return true;
+}
+
+void SIM7080GGNSS::onReport(const ATView &line)
+{
+    // Reports still in flight after AT+CGNSPWR=0 are dropped
+    if (fsmPower.currentState != GNSS_TRACKING)
+        return;
+
+    CGNSINFFields fields;
+    if (!fields.parse(line))
+        return;
+
+    GNSSData data = GNSSData::from_fields(fields);
+
+    if (data.fixStatus && fuse(data))
+    {
+        acquisitionStart = millis();
+        measureFix();
+
+        // The reports at the first fix rate may still be in flight
+        if (lastQueued == 0 || millis() - lastQueued >= interval / 2)
+        {
+            lastQueued = millis();
+
+            GNSSData fix = filtered();
+            Serial.printf("%sTracked position%s: %.7f, %.7f\n", Color::_GRAY, Color::_RESET, Coordinates::toDegrees(fix.latitude), Coordinates::toDegrees(fix.longitude));
+            queue(fix);
+        }
+    }
+
+    // Follow the interval once the first fix is in, it changes with the motion, one AT+CGNSURC at a time
+    if (!awaitingFix && requestedRate == 0 && reportRate() != trackingRate)
+    {
+        requestedRate = reportRate();
+
+        if (!ATCommands::CGNSURC.submit([](const AT_RESPONSE &response)
+                                        { GNSS.onRateApplied(response); }, 0, (int)requestedRate))
+            requestedRate = 0;
+    }
+}
+
+void SIM7080GGNSS::onRateApplied(const AT_RESPONSE &response)
+{
+    // On an error trackingRate keeps the rate the modem still applies, the next report asks again
+    if (response.status == AT_OK)
+        trackingRate = requestedRate;
+    else
+        Serial.printf("[x] Report rate of %lu s not applied\n", requestedRate);
+
+    requestedRate = 0;
+}
+
 bool SIM7080GGNSS::PowerOff()
 {
-    if (fsmPower.currentState == GNSS_ON)
+    if (fsmPower.currentState == GNSS_ON || fsmPower.currentState == GNSS_TRACKING)
     {
-        AT_RESPONSE response = Sim7080G.sendATCommand("AT+CGNSPWR=0", 2000);
+        AT_RESPONSE response = ATCommands::CGNSPWR.send(atCommand, 0);
 
         if (response.isFinished)
         {
             fsmPower.setState(GNSS_OFF);
-            Sim7080G.freeATState();
         }
         // Serial.println("CGNSMOD ==========================");
         // Serial.println(Sim7080G.send_AT_bloquant("AT+CGNSMOD=1,1,0,0,0", 2000));
@@ -53,118 +331,395 @@ bool SIM7080GGNSS::PowerOff()
 
 GNSSResponse SIM7080GGNSS::GetData()
 {
-    if (fsmPower.currentState == GNSS_ON)
+    // Answers come back in milliseconds now, keep polling at the same pace as before
+    if (fsmPower.currentState == GNSS_ON && (Sim7080G.isPending(atCommand) || fsmGetPosition.isOutOfDelay(GNSS_POLL_INTERVAL)))
     {
-        AT_RESPONSE response = Sim7080G.sendATCommand("AT+CGNSINF", 2000);
+        AT_RESPONSE response = ATCommands::CGNSINF.send(atCommand);
 
         if (response.isFinished)
         {
+            fsmGetPosition.resetTimer();
+
             GNSSResponse gnssResponse;
             gnssResponse.isFinished = true;
 
             Serial.println(response.message);
 
-            response.message = response.message.substring(response.message.indexOf(": ") + 2);
-
-            gnssResponse.data.gnssRunStatus = strcmp(response.message.substring(0, 1).c_str(), "1") == 0;
-            response.message = response.message.substring(response.message.indexOf(",") + 1);
-            gnssResponse.data.fixStatus = strcmp(response.message.substring(0, 1).c_str(), "1") == 0;
-            response.message = response.message.substring(response.message.indexOf(",") + 1);
-            gnssResponse.data.utcDateTime = DateTime(response.message.substring(0, response.message.indexOf(",")));
-            response.message = response.message.substring(response.message.indexOf(",") + 1);
-            gnssResponse.data.latitude = response.message.substring(0, response.message.indexOf(",")).toFloat();
-            response.message = response.message.substring(response.message.indexOf(",") + 1);
-            gnssResponse.data.longitude = response.message.substring(0, response.message.indexOf(",")).toFloat();
-            response.message = response.message.substring(response.message.indexOf(",") + 1);
-
-            // Sauter les champs inutiles jusqu'à HDOP (8 champs à sauter)
-            for (int i = 0; i < 5; ++i) {
-                response.message = response.message.substring(response.message.indexOf(",") + 1);
-            }
+            CGNSINFFields fields;
+            fields.parse(response.message);
 
-            // HDOP
-            gnssResponse.data.hdop = response.message.substring(0, response.message.indexOf(",")).toFloat();
-            response.message = response.message.substring(response.message.indexOf(",") + 1);
+            gnssResponse.data = GNSSData::from_fields(fields);
 
-            // Sauter PDOP et VDOP (2 champs)
-            for (int i = 0; i < 2; ++i) {
-                response.message = response.message.substring(response.message.indexOf(",") + 1);
-            }
+            return gnssResponse;
+        }
+        else
+        {
+            fsmGetPosition.setState(GNSS_POSITION_BUSY);
+        }
+    }
+
+    return {};
+}
+
+GNSSAcquisition SIM7080GGNSS::Acquire(GNSSData &fix)
+{
+    if (!PowerOn())
+        return GNSS_ACQUIRING;
+
+    GNSSResponse response = GetData();
+
+    if (response.isFinished)
+    {
+        response.free();
+
+        if (response.data.fixStatus && fuse(response.data))
+        {
+            measureFix();
+            fix = filtered();
+            return GNSS_ACQUIRED;
+        }
+    }
+
+    if (millis() - acquisitionStart < acquisitionTimeout)
+        return GNSS_ACQUIRING;
+
+    // Out of time, a coarse position is still worth more than none
+    if (!filter.hasEstimate())
+    {
+        // The cell position comes next, the track before it must not be held back
+        tuner.fail(millis() - powerOnTime);
+        endTrack();
+        return GNSS_ACQUISITION_FAILED;
+    }
+
+    measureFix();
+    fix = filtered();
+    return GNSS_ACQUIRED;
+}
+
+bool SIM7080GGNSS::needsAssistance() const
+{
+    if (!assisted || (assistanceRetry != 0 && (long)(millis() - assistanceRetry) < 0))
+        return false;
+
+    return !hasAssistance || (long)(millis() - (assistanceExpiry - GNSS_XTRA_REFRESH)) >= 0;
+}
+
+long long SIM7080GGNSS::utcNow() const
+{
+    return clockTime == 0 ? 0 : clockTime + (millis() - clockSetAt) / 1000;
+}
+
+void SIM7080GGNSS::setClock(const DateTime &utc)
+{
+    if (utc.year < GNSS_CLOCK_MIN_YEAR)
+        return;
+
+    clockTime = utc.toUnixTime();
+    clockSetAt = millis();
+
+    if (assistanceUnsaved)
+        saveAssistance();
+
+    if (storedExpiry == 0)
+        return;
+
+    // The modem kept the data of the previous boot, no download while it is valid
+    if (!hasAssistance && storedExpiry > clockTime)
+    {
+        // Never longer than a download gives, the clock may have been wrong when it was written
+        unsigned long left = storedExpiry - clockTime < GNSS_XTRA_VALIDITY / 1000 ? (storedExpiry - clockTime) * 1000 : GNSS_XTRA_VALIDITY;
+        hasAssistance = true;
+        assistanceExpiry = millis() + left;
+        Serial.printf("[+] XTRA assistance data still valid for %lu h\n", left / (1000UL * 60 * 60));
+    }
+
+    storedExpiry = 0;
+}
+
+void SIM7080GGNSS::saveAssistance()
+{
+    long long now = utcNow();
+    if (now == 0)
+    {
+        assistanceUnsaved = true;
+        return;
+    }
 
-            // Sauter jusqu'à HPA (8 champs à sauter)
-            for (int i = 0; i < 8; ++i) {
-                response.message = response.message.substring(response.message.indexOf(",") + 1);
+    preferences.putUInt("xtra", (uint32_t)(now + (assistanceExpiry - millis()) / 1000));
+    assistanceUnsaved = false;
+}
+
+void SIM7080GGNSS::failAssistance(const char *step, const AT_RESPONSE &response)
+{
+    Serial.printf("[x] XTRA %s failed: ", step);
+    Serial.println(response.message);
+
+    assistanceRetry = millis() + GNSS_XTRA_RETRY;
+    fsmAssistance.setState(GNSS_ASSISTANCE_DOWNLOAD);
+}
+
+bool SIM7080GGNSS::DownloadAssistance()
+{
+    switch (fsmAssistance.currentState)
+    {
+    case GNSS_ASSISTANCE_DOWNLOAD:
+    {
+        AT_RESPONSE response = ATCommands::HTTPTOFS.send(atCommand, Quoted{GNSS_XTRA_URL}, Quoted{GNSS_XTRA_FILE});
+
+        if (response.isFinished)
+        {
+            // +HTTPTOFS: <HTTP status>,<size>
+            int at = response.message.indexOf("+HTTPTOFS:");
+            long status = at >= 0 ? response.message.substring(at + strlen("+HTTPTOFS:")).toInt() : 0;
+
+            if (response.status != AT_OK || status != 200)
+            {
+                failAssistance("download", response);
+                return true;
             }
 
-            // HPA
-            gnssResponse.data.hpa = response.message.substring(0, response.message.indexOf(",")).toFloat();
+            fsmAssistance.setState(GNSS_ASSISTANCE_COPY);
+        }
+        break;
+    }
+    case GNSS_ASSISTANCE_COPY:
+    {
+        AT_RESPONSE response = ATCommands::CGNSCPY.send(atCommand);
 
-            if (fsmGetPosition.currentState == GNSS_POSITION_FREE)
+        if (response.isFinished)
+        {
+            if (response.status != AT_OK)
             {
-                Sim7080G.freeATState();
+                failAssistance("copy", response);
+                return true;
             }
 
-            return gnssResponse;
+            fsmAssistance.setState(GNSS_ASSISTANCE_ENABLE);
         }
-        else
+        break;
+    }
+    case GNSS_ASSISTANCE_ENABLE:
+    {
+        AT_RESPONSE response = ATCommands::CGNSXTRA.send(atCommand, 1);
+
+        if (response.isFinished)
         {
-            fsmGetPosition.setState(GNSS_POSITION_BUSY);
+            if (response.status != AT_OK)
+            {
+                failAssistance("injection", response);
+                return true;
+            }
+
+            hasAssistance = true;
+            assistanceExpiry = millis() + GNSS_XTRA_VALIDITY;
+            assistanceRetry = 0;
+            storedExpiry = 0;
+            saveAssistance();
+            fsmAssistance.setState(GNSS_ASSISTANCE_DOWNLOAD);
+
+            Serial.println("[+] XTRA assistance data injected");
+            return true;
         }
+        break;
+    }
+    default:
+        fsmAssistance.setState(GNSS_ASSISTANCE_DOWNLOAD);
+        break;
     }
 
-    return {};
+    return false;
 }
 
 void SIM7080GGNSS::freeData()
 {
     fsmGetPosition.setState(GNSS_POSITION_FREE);
-    Sim7080G.freeATState();
+}
+
+uint32_t GNSSData::accuracy() const
+{
+    if (hpa > 0)
+        return lroundf(hpa * 100);
+
+    return hdop > 0 ? lroundf(hdop * GNSS_UERE * 100) : GNSS_UNKNOWN_ACCURACY * 100;
+}
+
+uint32_t GNSSData::distanceTo(const GNSSData &other) const
+{
+    return Coordinates::distance(latitude, longitude, other.latitude, other.longitude);
 }
 
 json GNSSData::to_json() const
 {
     return json{
         {"t", utcDateTime.toUnixTime()},
-        {"la", latitude},
-        {"lo", longitude},
+        {"y", latitude},
+        {"x", longitude},
         {"hdop", hdop},
-        {"hpa", hpa}
+        {"hpa", hpa},
+        {"al", altitude},
+        {"sp", speed},
+        {"co", course},
+        {"vpa", vpa},
+        {"sv", satellitesInView},
+        {"su", satellitesUsed}
     };
 }
 
-std::string GNSSData::get_type() const
+GNSSData GNSSData::from_json(const json &j)
 {
-    return "GNSS";
+    GNSSData data;
+    data.gnssRunStatus = data.fixStatus = true;
+    data.utcDateTime = DateTime::fromUnixTime(j.value("t", 0LL));
+    data.latitude = j.value("y", 0);
+    data.longitude = j.value("x", 0);
+    data.hdop = j.value("hdop", 0.0f);
+    data.hpa = j.value("hpa", 0.0f);
+    data.altitude = j.value("al", 0);
+    data.speed = j.value("sp", 0);
+    data.course = j.value("co", 0);
+    data.vpa = j.value("vpa", 0);
+    data.satellitesInView = j.value("sv", 0);
+    data.satellitesUsed = j.value("su", 0);
+    return data;
 }
 #pragma endregion GNSS
 
+#pragma region CGNSINF
+bool CGNSINFFields::parse(const ATView &response)
+{
+    *this = CGNSINFFields();
+
+    // +CGNSINF answers and +UGNSINF reports carry the same fields
+    int start = response.indexOf("GNSINF:");
+    if (start < 1 || (response[start - 1] != 'C' && response[start - 1] != 'U'))
+        return false;
+
+    size_t i = start + strlen("GNSINF:");
+    size_t length = response.length();
+
+    while (i < length && response[i] == ' ')
+        i++;
+
+    // One pass over the line, each field ends at a comma or at the end of the line
+    for (uint8_t field = 0; field < CGNSINF_FIELD_COUNT; field++)
+    {
+        size_t from = i;
+        while (i < length && response[i] != ',' && response[i] != '\r' && response[i] != '\n')
+            i++;
+
+        if (i > from)
+        {
+            present |= 1UL << field;
+            set((CGNSINFField)field, response.substring(from, i));
+        }
+
+        if (i >= length || response[i] != ',')
+            break;
+
+        i++;
+    }
+
+    return has(CGNSINF_RUN_STATUS);
+}
+
+void CGNSINFFields::set(CGNSINFField field, const ATView &value)
+{
+    switch (field)
+    {
+    case CGNSINF_RUN_STATUS:
+        runStatus = value.toInt() == 1;
+        break;
+    case CGNSINF_FIX_STATUS:
+        fixStatus = value.toInt() == 1;
+        break;
+    case CGNSINF_UTC_DATE_TIME:
+        utcDateTime = DateTime(value);
+        break;
+    case CGNSINF_LATITUDE:
+        latitude = value.toFixed(7);
+        break;
+    case CGNSINF_LONGITUDE:
+        longitude = value.toFixed(7);
+        break;
+    case CGNSINF_ALTITUDE:
+        altitude = value.toFloat();
+        break;
+    case CGNSINF_SPEED:
+        speed = value.toFloat();
+        break;
+    case CGNSINF_COURSE:
+        course = value.toFloat();
+        break;
+    case CGNSINF_FIX_MODE:
+        fixMode = value.toInt();
+        break;
+    case CGNSINF_HDOP:
+        hdop = value.toFloat();
+        break;
+    case CGNSINF_PDOP:
+        pdop = value.toFloat();
+        break;
+    case CGNSINF_VDOP:
+        vdop = value.toFloat();
+        break;
+    case CGNSINF_SATELLITES_IN_VIEW:
+        satellitesInView = value.toInt();
+        break;
+    case CGNSINF_SATELLITES_USED:
+        satellitesUsed = value.toInt();
+        break;
+    case CGNSINF_GLONASS_USED:
+        glonassUsed = value.toInt();
+        break;
+    case CGNSINF_CN0_MAX:
+        cn0Max = value.toInt();
+        break;
+    case CGNSINF_HPA:
+        hpa = value.toFloat();
+        break;
+    case CGNSINF_VPA:
+        vpa = value.toFloat();
+        break;
+    default:
+        break;
+    }
+}
+#pragma endregion CGNSINF
+
 #pragma region DateTime
-DateTime::DateTime(String value)
+/**
+ * @brief Read a fixed-width decimal number
+ */
+static int readDigits(const ATView &value, size_t from, size_t count)
 {
-    if (!value || value.length() == 0)
+    int result = 0;
+
+    for (size_t i = from; i < from + count && i < value.length(); i++)
     {
-        this->year = 0;
-        this->month = 0;
-        this->day = 0;
-        this->hour = 0;
-        this->minute = 0;
-        this->second = 0;
-        this->millisecond = 0;
-        return;
+        if (value[i] < '0' || value[i] > '9')
+            break;
+        result = result * 10 + (value[i] - '0');
     }
 
-    this->year = atoi(value.substring(0, 4).c_str());
-    value = value.substring(4);
-    this->month = atoi(value.substring(0, 2).c_str());
-    value = value.substring(2);
-    this->day = atoi(value.substring(0, 2).c_str());
-    value = value.substring(2);
-    this->hour = atoi(value.substring(0, 2).c_str());
-    value = value.substring(2);
-    this->minute = atoi(value.substring(0, 2).c_str());
-    value = value.substring(2);
-    this->second = atoi(value.substring(0, 2).c_str());
-    value = value.substring(2);
+    return result;
+}
+
+DateTime::DateTime(const ATView &value) : DateTime()
+{
+    if (value.length() < 14)
+        return;
+
+    year = readDigits(value, 0, 4);
+    month = readDigits(value, 4, 2);
+    day = readDigits(value, 6, 2);
+    hour = readDigits(value, 8, 2);
+    minute = readDigits(value, 10, 2);
+    second = readDigits(value, 12, 2);
+
+    // "yyyyMMddhhmmss.sss"
+    if (value.length() > 15 && value[14] == '.')
+        millisecond = readDigits(value, 15, 3);
 }
 
 long long DateTime::toUnixTime() const
@@ -176,10 +731,21 @@ long long DateTime::toUnixTime() const
     t.tm_hour = hour;
     t.tm_min = minute;
     t.tm_sec = second;
+    // UTC, an unset flag could shift the time by an hour
+    t.tm_isdst = 0;
 
     return mktime(&t);
 }
 
+DateTime DateTime::fromUnixTime(long long int time)
+{
+    time_t seconds = time;
+    struct tm t;
+    gmtime_r(&seconds, &t);
+
+    return DateTime(t.tm_year + 1900, t.tm_mon + 1, t.tm_mday, t.tm_hour, t.tm_min, t.tm_sec, 0);
+}
+
 String DateTime::toString()
 {
     return String(year) + "-" + String(month) + "-" + String(day) + " " + String(hour) + ":" + String(minute) + ":" + String(second) + "." + String(millisecond) + " (Unix Time: " + String(toUnixTime()) + ")";
@@ -0,0 +1,135 @@
+#include <SIM7080G/GNSSTuner.hpp>
+
+/**
+ * @brief Sets tried by the tuner, GPS is always on, the first one is the historic default
+ */
+static const GNSSConstellations CONSTELLATIONS[GNSS_CONSTELLATION_COUNT] = {
+    {"GPS+Galileo", 1, 0, 0, 1, 0},
+    {"GPS+GLONASS", 1, 1, 0, 0, 0},
+    {"GPS+BeiDou", 1, 0, 1, 0, 0},
+    {"GPS+GLONASS+Galileo", 1, 1, 0, 1, 0},
+};
+
+/**
+ * @brief Statistics as written to flash
+ */
+struct GNSSTunerRecord
+{
+    uint8_t version;
+    GNSSTunerStats stats[GNSS_CONSTELLATION_COUNT];
+};
+
+const GNSSConstellations &GNSSTuner::constellations(uint8_t set)
+{
+    return CONSTELLATIONS[set];
+}
+
+void GNSSTuner::begin()
+{
+    memset(stats, 0, sizeof(stats));
+    preferences.begin("gnss", false);
+
+    GNSSTunerRecord record;
+    if (preferences.getBytesLength("tuner") == sizeof(record) &&
+        preferences.getBytes("tuner", &record, sizeof(record)) == sizeof(record) &&
+        record.version == GNSS_TUNER_VERSION)
+    {
+        memcpy(stats, record.stats, sizeof(stats));
+        Serial.printf("[+] GNSS tuner loaded, best set %s\n", CONSTELLATIONS[best()].name);
+    }
+}
+
+void GNSSTuner::save()
+{
+    GNSSTunerRecord record;
+    record.version = GNSS_TUNER_VERSION;
+    memcpy(record.stats, stats, sizeof(stats));
+
+    preferences.putBytes("tuner", &record, sizeof(record));
+    unsaved = 0;
+}
+
+uint8_t GNSSTuner::best() const
+{
+    uint8_t result = 0;
+
+    for (uint8_t i = 1; i < GNSS_CONSTELLATION_COUNT; i++)
+    {
+        if (stats[i].samples >= GNSS_TUNER_MIN_SAMPLES &&
+            (stats[result].samples < GNSS_TUNER_MIN_SAMPLES || stats[i].time < stats[result].time))
+            result = i;
+    }
+
+    return result;
+}
+
+const GNSSConstellations &GNSSTuner::select()
+{
+    if (!enabled)
+        return CONSTELLATIONS[0];
+
+    if (selected)
+        return CONSTELLATIONS[current];
+
+    selected = true;
+    current = best();
+
+    // The sets not tried enough go first
+    for (uint8_t i = 0; i < GNSS_CONSTELLATION_COUNT; i++)
+    {
+        if (stats[i].samples < GNSS_TUNER_MIN_SAMPLES)
+        {
+            current = i;
+            Serial.printf("[+] GNSS constellations %s, trying it\n", CONSTELLATIONS[current].name);
+            return CONSTELLATIONS[current];
+        }
+    }
+
+    if (random(100) < exploration)
+    {
+        // Any set but the best one
+        current = (current + 1 + random(GNSS_CONSTELLATION_COUNT - 1)) % GNSS_CONSTELLATION_COUNT;
+        Serial.printf("[+] GNSS constellations %s, exploring\n", CONSTELLATIONS[current].name);
+    }
+    else
+    {
+        Serial.printf("[+] GNSS constellations %s, best at %lu ms\n", CONSTELLATIONS[current].name, (unsigned long)stats[current].time);
+    }
+
+    return CONSTELLATIONS[current];
+}
+
+void GNSSTuner::measure(unsigned long time, uint32_t accuracy, bool hasFix)
+{
+    if (!enabled || !selected)
+        return;
+
+    selected = false;
+    GNSSTunerStats &set = stats[current];
+
+    // Same weight as the time to first fix of the engine, the latest samples tell the current sky
+    if (set.samples == 0)
+        set.time = time;
+    else
+        set.time = (set.time * 3 + time) / 4;
+
+    if (hasFix)
+        set.accuracy = set.accuracy == 0 ? accuracy : (set.accuracy * 3 + accuracy) / 4;
+
+    if (set.samples < UINT16_MAX)
+        set.samples++;
+
+    // NVS levels the wear, the writes are still batched
+    if (++unsaved >= GNSS_TUNER_SAVE_SAMPLES)
+        save();
+}
+
+void GNSSTuner::record(unsigned long time, uint32_t accuracy)
+{
+    measure(time, accuracy, true);
+}
+
+void GNSSTuner::fail(unsigned long time)
+{
+    measure(time, 0, false);
+}
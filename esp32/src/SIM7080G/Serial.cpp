@@ -1,12 +1,14 @@
 #include <SIM7080G/Serial.hpp>
+#include <SIM7080G/ATCommands.hpp>
 
-SIM7080GHardwareSerial Sim7080G = *((SIM7080GHardwareSerial *)(&Serial1));
+// Built on UART 1 rather than copied from Serial1, a copy would fill the members of this class with whatever follows Serial1 in memory
+SIM7080GHardwareSerial Sim7080G(1);
 
 SIM7080GHardwareSerial::SIM7080GHardwareSerial(uint8_t uart_nr) : HardwareSerial(uart_nr)
 {
     _uart_nr = uart_nr;
     _uart = NULL;
-    _rxBufferSize = 256;
+    _rxBufferSize = SIM7080G_RX_BUFFER_SIZE;
     _txBufferSize = 0;
     _onReceiveCB = NULL;
     _onReceiveErrorCB = NULL;
@@ -48,130 +50,819 @@ SIM7080GHardwareSerial::~SIM7080GHardwareSerial()
 
 void SIM7080GHardwareSerial::setup()
 {
-    fsm.name = "SIM7080G AT";
-    fsm.debug = false;
-    fsm.currentState = AT_FREE;
-    fsm.previousState = AT_FREE;
+    for (ATJob &job : jobs)
+        job.state = AT_JOB_FREE;
 
-    timedReadFSM.name = "TimedRead";
-    timedReadFSM.debug = false;
-    timedReadFSM.currentState = TIMED_READ_INIT;
-    timedReadFSM.previousState = TIMED_READ_INIT;
+    running = -1;
 
-    fsm.changeStateCondition = []()
+    // Bytes from the modem wake the main loop up
+    onReceive([]()
+              { events.notify(); });
+
+    // Sent at the end of the boot when the modem runs at a fixed rate
+    onURC("RDY", [](const ATView &line)
+          { Sim7080G.modemReady = true; });
+
+    preferences.begin("sim7080g", false);
+    restartLink();
+}
+
+size_t SIM7080GHardwareSerial::write(uint8_t c)
+{
+    return write(&c, 1);
+}
+
+size_t SIM7080GHardwareSerial::write(const uint8_t *buffer, size_t size)
+{
+    size_t count = emulator != nullptr ? emulator->write(buffer, size) : HardwareSerial::write(buffer, size);
+    trace.record(true, buffer, count);
+
+    return count;
+}
+
+/**
+ * @brief Gives a Stream the read(buffer, size) RingBuffer::receive() expects
+ */
+struct StreamSource
+{
+    Stream &stream;
+
+    int available() { return stream.available(); }
+    size_t read(uint8_t *buffer, size_t size) { return stream.readBytes(buffer, size); }
+};
+
+size_t SIM7080GHardwareSerial::receive()
+{
+    size_t count;
+
+    if (emulator != nullptr)
+    {
+        StreamSource source{*emulator};
+        count = rxBuffer.receive(source);
+    }
+    else
     {
-        return true; // Always return true for now
-    };
+        count = rxBuffer.receive(*this);
+    }
+
+    if (count > 0)
+        trace.record(false, (const uint8_t *)rxBuffer.at(rxBuffer.end() - count), count);
+
+    return count;
 }
 
-int SIM7080GHardwareSerial::TimedRead()
+#pragma region Link
+/**
+ * @brief Rates supported by AT+IPR, fastest first
+ */
+static const uint32_t LINK_BAUD_RATES[] = {921600, 460800, 230400, 115200, SIM7080G_BAUD};
+
+void SIM7080GHardwareSerial::linkLoop()
 {
-    switch (timedReadFSM.currentState)
+    switch (linkState)
+    {
+    case LINK_PROBE:
     {
-    case TIMED_READ_INIT:
-        timedReadStartTime = millis();
-        timedReadFSM.setState(TIMED_READ_RUNNING);
+        AT_RESPONSE response = ATCommands::PROBE.send(linkCommand);
+        if (!response.isFinished)
+            return;
 
-    case TIMED_READ_RUNNING:
+        if (response.status == AT_OK)
+        {
+            linkAttempts = 0;
+            linkState = linkBaud != targetBaud ? LINK_SET_BAUD : LINK_CHECK;
+            return;
+        }
+
+        if (++linkAttempts < SIM7080G_LINK_ATTEMPTS)
+            return;
+
+        // Not answering at this rate, the modem may still run at a rate set before the ESP32 restarted.
+        // Also while booting: every rate is probed within SIM7080G_BOOT_TIMEOUT, before PWRKEY is pulsed again
+        linkAttempts = 0;
+        switchBaud(nextProbeBaud(linkBaud));
+        return;
+    }
+
+    case LINK_SET_BAUD:
     {
-        int c = read();
-        if (c >= 0)
+        AT_RESPONSE response = ATCommands::IPR.send(linkCommand, (long)targetBaud);
+        if (!response.isFinished)
+            return;
+
+        if (response.status == AT_OK)
         {
-            timedReadResult = c;
-            timedReadFSM.setState(TIMED_READ_SUCCESS);
-            return -1;
+            // The modem answers OK at the old rate then moves to the new one
+            switchBaud(targetBaud);
+            linkState = LINK_CHECK;
+            return;
         }
 
-        if (millis() - timedReadStartTime >= _timeout)
+        targetBaud = lowerBaud(targetBaud);
+        if (targetBaud <= linkBaud)
+            linkState = LINK_CHECK;
+        return;
+    }
+
+    case LINK_CHECK:
+    {
+        AT_RESPONSE response = ATCommands::PROBE.send(linkCommand);
+        if (!response.isFinished)
+            return;
+
+        if (response.status != AT_OK)
         {
-            timedReadFSM.setState(TIMED_READ_TIMEOUT);
-            timedReadResult = -1;
-            return -1;
+            linkAttempts = 0;
+            linkState = linkBaud == SIM7080G_BAUD ? LINK_PROBE : LINK_FALLBACK;
+            return;
         }
-        break;
+
+        if (++linkAttempts < SIM7080G_LINK_ATTEMPTS)
+            return;
+
+        linkAttempts = 0;
+        linkErrors = 0;
+        linkState = LINK_READY;
+
+        if (preferences.getUInt("baud", 0) != linkBaud)
+            preferences.putUInt("baud", linkBaud);
+
+        Serial.printf("[+] Modem link ready at %lu baud\n", (unsigned long)linkBaud);
+        return;
+    }
+
+    case LINK_FALLBACK:
+    {
+        // Best effort through the errors, AT+IPR=0 puts the modem back to autobaud
+        AT_RESPONSE response = ATCommands::IPR.send(linkCommand, 0L);
+        if (!response.isFinished)
+            return;
+
+        Serial.printf("[x] Modem link unreliable at %lu baud, falling back\n", (unsigned long)linkBaud);
+
+        targetBaud = lowerBaud(linkBaud);
+        preferences.putUInt("baud", targetBaud);
+
+        switchBaud(SIM7080G_BAUD);
+        linkState = LINK_PROBE;
+        return;
+    }
+
+    default:
+        return;
+    }
+}
+
+void SIM7080GHardwareSerial::restartLink()
+{
+    switchBaud(SIM7080G_BAUD);
+    targetBaud = preferences.getUInt("baud", SIM7080G_BAUD_MAX);
+    linkState = LINK_PROBE;
+    linkAttempts = 0;
+    linkErrors = 0;
+}
+
+void SIM7080GHardwareSerial::switchBaud(uint32_t baud)
+{
+    if (baud != linkBaud)
+        updateBaudRate(baud);
+
+    linkBaud = baud;
+}
+
+uint32_t SIM7080GHardwareSerial::lowerBaud(uint32_t baud)
+{
+    for (uint32_t rate : LINK_BAUD_RATES)
+    {
+        if (rate < baud)
+            return rate;
     }
 
-    case TIMED_READ_TIMEOUT:
-        timedReadFSM.setState(TIMED_READ_INIT);
-        return -1;
+    return SIM7080G_BAUD;
+}
 
-    case TIMED_READ_SUCCESS:
-        timedReadFSM.setState(TIMED_READ_INIT);
-        return timedReadResult;
+uint32_t SIM7080GHardwareSerial::nextProbeBaud(uint32_t baud) const
+{
+    // SIM7080G_BAUD first, it is where a freshly powered modem autobauds, then the stored rate a modem left on
+    // most likely runs at, then every other rate from the fastest
+    if (baud == SIM7080G_BAUD)
+        return targetBaud != SIM7080G_BAUD ? targetBaud : LINK_BAUD_RATES[0];
+
+    uint32_t next = baud == targetBaud ? LINK_BAUD_RATES[0] : lowerBaud(baud);
+    return next == targetBaud ? lowerBaud(next) : next;
+}
+#pragma endregion Link
+
+#pragma region Scheduler
+ATFuture SIM7080GHardwareSerial::submit(const char *command, unsigned long timeout, const char *terminator, AT_PRIORITY priority, unsigned long deadline, void (*onComplete)(const AT_RESPONSE &response))
+{
+    ATFuture future;
+    size_t length = strlen(command);
+
+    if (length >= SIM7080G_COMMAND_SIZE)
+    {
+        Serial.printf("[x] AT command too long: %s\n", command);
+        return future;
+    }
+
+    for (int8_t i = 0; i < SIM7080G_JOB_COUNT; i++)
+    {
+        ATJob &job = jobs[i];
+        if (job.state != AT_JOB_FREE)
+            continue;
+
+        memcpy(job.command, command, length + 1);
+        job.source = nullptr;
+        job.dataSent = 0;
+        job.expected = nullptr;
+        job.standalone = false;
+        job.holdUntil = 0;
+        job.terminator = terminator;
+        job.timeout = timeout;
+        job.deadline = deadline;
+        job.priority = priority;
+        job.sequence = nextSequence++;
+        job.onComplete = onComplete;
+        job.response = AT_RESPONSE{ATView(), false, AT_PENDING};
+        job.state = AT_JOB_QUEUED;
+        job.lastUpdate = millis();
+
+        future.slot = i;
+        future.sequence = job.sequence;
+
+        // Dispatched by the next loop()
+        events.wakeNow();
+        return future;
     }
 
-    return -1;
+    Serial.printf("[x] AT queue full, dropped: %s\n", command);
+    return future;
+}
+
+void SIM7080GHardwareSerial::setChaining(const ATFuture &future, const char *expected, unsigned long hold)
+{
+    if (future.slot < 0)
+        return;
+
+    ATJob &job = jobs[future.slot];
+    if (job.sequence != future.sequence || job.state != AT_JOB_QUEUED)
+        return;
+
+    job.expected = expected;
+    job.holdUntil = hold != 0 ? millis() + hold : 0;
+
+    if (job.holdUntil != 0)
+        events.wakeAt(job.holdUntil);
 }
 
-AT_RESPONSE SIM7080GHardwareSerial::sendATCommand(const char *command, unsigned long timeout)
+AT_RESPONSE SIM7080GHardwareSerial::poll(ATFuture &future)
 {
-    if (fsm.currentState == AT_FREE)
+    // Not queued (queue was full), the caller will submit again
+    if (future.slot < 0)
+        return AT_RESPONSE{ATView(), false, AT_PENDING};
+
+    ATJob &job = jobs[future.slot];
+
+    // Dropped after its retention time or after its completion callback
+    if (job.sequence != future.sequence || job.state == AT_JOB_FREE)
     {
-        response.isFinished = false;
-        response.message = "";
-        write(command, strlen(command));
-        write("\r\n", 2); // Send the command with a newline
-        // Serial.println("AT Command sent: " + String(command));
+        future = ATFuture();
+        return AT_RESPONSE{ATView(), true, AT_TIMEOUT};
+    }
+
+    if (job.state != AT_JOB_DONE)
+        return AT_RESPONSE{ATView(), false, AT_PENDING};
+
+    AT_RESPONSE result = job.response;
+    release(job);
+    future = ATFuture();
+
+    return result;
+}
 
-        fsm.setState(AT_BUSY);
+bool SIM7080GHardwareSerial::isPending(const ATFuture &future) const
+{
+    if (future.slot < 0)
+        return false;
+
+    const ATJob &job = jobs[future.slot];
+    return job.sequence == future.sequence && job.state != AT_JOB_FREE;
+}
+
+bool SIM7080GHardwareSerial::isIdle() const
+{
+    for (const ATJob &job : jobs)
+    {
+        // A held query waits for another command, it does not keep the modem busy
+        if ((job.state == AT_JOB_QUEUED && !isHeld(job)) || job.state == AT_JOB_RUNNING)
+            return false;
     }
 
-    if (fsm.currentState == AT_BUSY)
+    return true;
+}
+
+void SIM7080GHardwareSerial::loop()
+{
+    if (linkState != LINK_READY)
+        linkLoop();
+
+    readResponse();
+
+    if (running >= 0)
     {
-        if (response.isFinished == false)
+        ATJob &job = jobs[running];
+
+        if (job.source != nullptr && !response.isFinished)
+            writeData(job);
+
+        if (!response.isFinished && millis() - job.lastUpdate > runningTimeout)
+        {
+            response.isFinished = true;
+            response.status = AT_TIMEOUT;
+        }
+
+        if (response.isFinished)
         {
-            int c = TimedRead();
-            if (c >= 0)
+            busyTime += millis() - job.startTime;
+
+#if defined(SIM7080G_TRACE) || defined(SIM7080G_SIMULATOR)
+            // Payload throughput, for the sessions recorded or simulated
+            if (job.source != nullptr)
             {
-                response.message += (char)c;
+                unsigned long elapsed = millis() - job.startTime;
+                Serial.printf("TCP Data: %u bytes in %lu ms at %lu baud\n", (unsigned)job.dataSent, elapsed, (unsigned long)linkBaud);
+                Serial.print("Response AT: ");
+                Serial.println(response.message);
             }
+#endif
+
+            if (job.priority != AT_PRIORITY_LINK)
+                linkErrors = response.status == AT_TIMEOUT ? linkErrors + 1 : 0;
 
-            if (millis() - fsm.lastUpdate > (timeout == -1 ? 1000 : timeout))
+            if (batchSize > 1)
+            {
+                completeBatch();
+            }
+            else
             {
-                response.isFinished = true;
+                job.response = response;
+                complete(job);
             }
         }
     }
 
-    return response;
+    unsigned long now = millis();
+
+    for (ATJob &job : jobs)
+    {
+        if (job.state == AT_JOB_QUEUED && job.deadline != 0 && (long)(now - job.deadline) > 0)
+        {
+            job.response = AT_RESPONSE{ATView(), true, AT_TIMEOUT};
+            complete(job);
+        }
+        else if (job.state == AT_JOB_DONE && now - job.lastUpdate > SIM7080G_JOB_RETENTION)
+        {
+            release(job);
+        }
+    }
+
+    if (linkState == LINK_READY && linkErrors >= SIM7080G_LINK_MAX_ERRORS)
+    {
+        linkErrors = 0;
+        linkState = linkBaud == SIM7080G_BAUD ? LINK_PROBE : LINK_FALLBACK;
+    }
+
+    if (running < 0)
+        dispatch();
+
+    // An emulator does not wake the loop up like the UART does
+    if (emulator != nullptr)
+        events.wakeAt(millis() + 1);
+
+    // Come back for the next timeout, deadline, end of hold or end of retention
+    if (running >= 0)
+        events.wakeAt(jobs[running].lastUpdate + runningTimeout + 1);
+
+    for (const ATJob &job : jobs)
+    {
+        if (job.state == AT_JOB_QUEUED && job.deadline != 0)
+            events.wakeAt(job.deadline + 1);
+        if (job.state == AT_JOB_QUEUED && isHeld(job))
+            events.wakeAt(job.holdUntil);
+        else if (job.state == AT_JOB_DONE)
+            events.wakeAt(job.lastUpdate + SIM7080G_JOB_RETENTION + 1);
+    }
+}
+
+void SIM7080GHardwareSerial::dispatch()
+{
+    int8_t next = -1;
+
+    for (int8_t i = 0; i < SIM7080G_JOB_COUNT; i++)
+    {
+        const ATJob &job = jobs[i];
+        if (job.state != AT_JOB_QUEUED)
+            continue;
+
+        // Nothing else goes through a link that is not ready
+        if (linkState != LINK_READY && job.priority != AT_PRIORITY_LINK)
+            continue;
+
+        if (isHeld(job))
+            continue;
+
+        if (next < 0 || job.priority < jobs[next].priority || (job.priority == jobs[next].priority && (int32_t)(job.sequence - jobs[next].sequence) < 0))
+            next = i;
+    }
+
+    if (next < 0)
+        return;
+
+    ATJob &job = jobs[next];
+
+    beginResponse();
+    running = next;
+    releaseBuffer();
+
+    job.responseStart = responseStart;
+    job.state = AT_JOB_RUNNING;
+    job.lastUpdate = job.startTime = millis();
+
+    strcpy(runningCommand, job.command);
+    runningTimeout = job.timeout;
+    batch[0] = next;
+    batchSize = 1;
+
+    if (job.source != nullptr)
+    {
+        writeData(job);
+        return;
+    }
+
+    if (isChainable(job))
+        chainQueries();
+
+    write(runningCommand, strlen(runningCommand));
+    write("\r\n", 2); // Send the command with a newline
+}
+
+bool SIM7080GHardwareSerial::isChainable(const ATJob &job)
+{
+    return job.expected != nullptr && !job.standalone && job.terminator == nullptr && job.source == nullptr &&
+           strncmp(job.command, "AT+", 3) == 0 && strchr(job.command, '=') == nullptr && strchr(job.command, ';') == nullptr;
+}
+
+bool SIM7080GHardwareSerial::isHeld(const ATJob &job) const
+{
+    return job.holdUntil != 0 && (long)(millis() - job.holdUntil) < 0;
 }
 
-AT_RESPONSE SIM7080GHardwareSerial::sendTCPData(std::vector<std::uint8_t> data)
+void SIM7080GHardwareSerial::chainQueries()
 {
-    if (fsm.currentState == AT_FREE)
+    ATJob &leader = jobs[running];
+    size_t length = strlen(runningCommand);
+
+    for (int8_t i = 0; i < SIM7080G_JOB_COUNT; i++)
     {
-        response.isFinished = false;
-        response.message = "";
-        write(data.data(), data.size());
-        Serial.println("TCP Data sent: " + String(data.size()) + " bytes");
+        ATJob &job = jobs[i];
+        if (job.state != AT_JOB_QUEUED || !isChainable(job))
+            continue;
+
+        if (linkState != LINK_READY && job.priority != AT_PRIORITY_LINK)
+            continue;
+
+        // Two queries with the same prefix could not be told apart in the reply
+        bool duplicate = false;
+        for (uint8_t j = 0; j < batchSize; j++)
+            duplicate |= strcmp(jobs[batch[j]].expected, job.expected) == 0;
+
+        // "AT+CEREG?" is chained as ";+CEREG?"
+        size_t added = strlen(job.command) - 1;
+        if (duplicate || length + added >= SIM7080G_COMMAND_SIZE)
+            continue;
+
+        runningCommand[length] = ';';
+        strcpy(runningCommand + length + 1, job.command + 2);
+        length += added;
 
-        fsm.setState(AT_BUSY);
+        job.state = AT_JOB_RUNNING;
+        job.responseStart = leader.responseStart;
+        job.lastUpdate = job.startTime = leader.startTime;
+
+        runningTimeout += job.timeout;
+        batch[batchSize++] = i;
     }
+}
+
+void SIM7080GHardwareSerial::completeBatch()
+{
+    running = -1;
+
+    ATView message = response.message;
+    size_t offset = 0;
 
-    if (fsm.currentState == AT_BUSY)
+    for (uint8_t i = 0; i < batchSize; i++)
     {
-        if (response.isFinished == false)
+        ATJob &job = jobs[batch[i]];
+
+        // The lines of each query follow each other, in the order of the command line
+        const char *start = nullptr;
+        const char *end = nullptr;
+        size_t scan = offset;
+
+        while (true)
         {
-            int c = TimedRead();
-            if (c >= 0)
+            ATView line = message.nextLine(scan);
+            if (line.isEmpty())
+                break;
+
+            if (line.startsWith(job.expected))
             {
-                response.message += (char)c;
+                if (start == nullptr)
+                    start = line.data();
+                end = line.data() + line.length();
+                offset = scan;
             }
-
-            if (millis() - fsm.lastUpdate > 10000)
+            else if (start != nullptr)
             {
-                response.isFinished = true;
-                Serial.println("Response AT: " + response.message);
+                break;
             }
         }
+
+        if (start != nullptr || response.status == AT_OK)
+        {
+            job.response = AT_RESPONSE{start != nullptr ? ATView(start, end - start) : ATView(), true, AT_OK};
+            complete(job);
+            continue;
+        }
+
+        // Not answered, run it again on its own to get its own result
+        job.state = AT_JOB_QUEUED;
+        job.standalone = true;
+        job.holdUntil = 0;
+        job.lastUpdate = millis();
     }
 
-    return response;
+    batchSize = 0;
+    events.wakeNow();
+}
+
+void SIM7080GHardwareSerial::writeData(ATJob &job)
+{
+    size_t total = job.source->size();
+
+    while (job.dataSent < total)
+    {
+        int room = availableForWrite();
+        if (room <= 0)
+        {
+            // The FIFO drains in about a millisecond
+            events.wakeAt(millis() + 1);
+            return;
+        }
+
+        // Small stack chunk, the source holds at most one queue item
+        uint8_t chunk[64];
+        size_t count = job.source->read(chunk, (size_t)room < sizeof(chunk) ? room : sizeof(chunk));
+
+        if (count == 0)
+        {
+            Serial.printf("[x] TCP Data ended after %u of %u bytes\n", (unsigned)job.dataSent, (unsigned)total);
+            job.dataSent = total;
+            return;
+        }
+
+        write(chunk, count);
+        job.dataSent += count;
+
+        // The timeout runs from the last byte written
+        job.lastUpdate = millis();
+    }
+}
+
+void SIM7080GHardwareSerial::complete(ATJob &job)
+{
+    if (running >= 0 && &jobs[running] == &job)
+        running = -1;
+
+    job.state = AT_JOB_DONE;
+    job.lastUpdate = millis();
+
+    // The caller polls it in the next iteration
+    events.wakeNow();
+
+    if (job.onComplete != nullptr)
+    {
+        job.onComplete(job.response);
+        release(job);
+    }
+}
+
+void SIM7080GHardwareSerial::release(ATJob &job)
+{
+    job.state = AT_JOB_FREE;
+    job.onComplete = nullptr;
+
+    releaseBuffer();
+}
+
+void SIM7080GHardwareSerial::releaseBuffer()
+{
+    size_t end = rxBuffer.end();
+    size_t tail = running >= 0 ? responseStart : responseLineStart;
+
+    // Keep the bytes of responses their caller has not collected yet
+    for (const ATJob &job : jobs)
+    {
+        if (job.state == AT_JOB_DONE && !job.response.message.isEmpty() && end - job.responseStart > end - tail)
+            tail = job.responseStart;
+    }
+
+    rxBuffer.consume(tail);
+}
+#pragma endregion Scheduler
+
+AT_RESPONSE SIM7080GHardwareSerial::sendATCommand(ATFuture &future, const char *command, unsigned long timeout, const char *terminator, AT_PRIORITY priority)
+{
+    if (future.slot < 0)
+        future = submit(command, timeout, terminator, priority);
+
+    return poll(future);
+}
+
+AT_RESPONSE SIM7080GHardwareSerial::sendTCPData(ATFuture &future, DataSource &source)
+{
+    if (future.slot < 0)
+    {
+        future = submit("", 10000, nullptr, AT_PRIORITY_HIGH);
+
+        if (future.slot >= 0)
+        {
+            jobs[future.slot].source = &source;
+        }
+    }
+
+    return poll(future);
+}
+
+AT_STATUS SIM7080GHardwareSerial::finalResultCode(const ATView &line, const char *terminator)
+{
+    if (line == "ERROR" || line.startsWith("+CME ERROR:") || line == "SEND FAIL")
+        return AT_ERROR;
+
+    if (terminator != nullptr)
+        return line.startsWith(terminator) ? AT_OK : AT_PENDING;
+
+    if (line == "OK" || line == "SEND OK")
+        return AT_OK;
+
+    return AT_PENDING;
 }
 
-void SIM7080GHardwareSerial::freeATState()
+void SIM7080GHardwareSerial::beginResponse()
 {
-    fsm.setState(AT_FREE);
+    // Hand the complete lines received meanwhile to the URC handlers
+    readResponse();
+
+    // Drop what is left so it can't end this response
+    Stream &modem = emulator != nullptr ? *emulator : *(Stream *)this;
+    while (modem.available() > 0)
+    {
+        if (receive() == 0)
+        {
+            // Buffer held by responses not collected yet
+            uint8_t c = modem.read();
+            trace.record(false, &c, 1);
+        }
+    }
+
+    responseStart = responseLineStart = responseScanned = rxBuffer.end();
+
+    response.isFinished = false;
+    response.status = AT_PENDING;
+    response.message = ATView();
+}
+
+void SIM7080GHardwareSerial::readResponse()
+{
+    receive();
+
+    ATJob *job = running >= 0 ? &jobs[running] : nullptr;
+    size_t end = rxBuffer.end();
+
+    while (responseScanned != end && !(job != nullptr && response.isFinished))
+    {
+        if (*rxBuffer.at(responseScanned) != '\n')
+        {
+            responseScanned++;
+            continue;
+        }
+
+        size_t lineEnd = responseScanned + 1;
+        ATView line(rxBuffer.at(responseLineStart), responseScanned - responseLineStart);
+        line.trim();
+
+        if ((job == nullptr || !isSolicited(line, runningCommand, job->terminator)) && dispatchURC(line) && job != nullptr)
+        {
+            // Take the line out so the response stays contiguous
+            rxBuffer.erase(responseLineStart, lineEnd);
+            end = rxBuffer.end();
+            responseScanned = responseLineStart;
+            continue;
+        }
+
+        responseLineStart = responseScanned = lineEnd;
+
+        if (job == nullptr)
+            continue;
+
+        AT_STATUS status = finalResultCode(line, job->terminator);
+        if (status != AT_PENDING)
+        {
+            response.status = status;
+            response.isFinished = true;
+        }
+    }
+
+    if (job == nullptr)
+    {
+        releaseBuffer();
+        return;
+    }
+
+    // Bytes after the final result code belong to what comes next
+    size_t messageEnd = response.isFinished ? responseLineStart : rxBuffer.end();
+    response.message = ATView(rxBuffer.at(responseStart), messageEnd - responseStart);
+
+    // The ">" prompt of AT+CASEND is not followed by a line ending
+    if (!response.isFinished && job->terminator != nullptr && job->terminator[0] == '>')
+    {
+        ATView line = response.message.substring(responseLineStart - responseStart);
+        line.trim();
+
+        if (finalResultCode(line, job->terminator) != AT_PENDING)
+        {
+            response.status = AT_OK;
+            response.isFinished = true;
+        }
+    }
+}
+
+bool SIM7080GHardwareSerial::isSolicited(const ATView &line, const char *command, const char *terminator)
+{
+    if (terminator != nullptr && line.startsWith(terminator))
+        return true;
+
+    int colon = line.indexOf(':');
+    if (line.isEmpty() || line[0] != '+' || colon < 0)
+        return false;
+
+    // Compare with the name of each command of the line, "AT+A=1;+B?" gives "+A" then "+B"
+    if (strncmp(command, "AT", 2) == 0)
+        command += 2;
+
+    while (*command != '\0')
+    {
+        const char *nameEnd = command;
+        while (*nameEnd != '\0' && *nameEnd != '=' && *nameEnd != '?' && *nameEnd != ';')
+            nameEnd++;
+
+        if ((size_t)(nameEnd - command) == (size_t)colon && memcmp(line.data(), command, colon) == 0)
+            return true;
+
+        command = strchr(nameEnd, ';');
+        if (command == nullptr)
+            break;
+        command++;
+    }
+
+    return false;
+}
+
+bool SIM7080GHardwareSerial::onURC(const char *prefix, void (*handler)(const ATView &line))
+{
+    if (urcCount >= SIM7080G_URC_COUNT)
+    {
+        Serial.printf("[x] No room left for URC handler %s\n", prefix);
+        return false;
+    }
+
+    urcHandlers[urcCount++] = URCHandler{prefix, handler};
+    return true;
+}
+
+bool SIM7080GHardwareSerial::dispatchURC(const ATView &line)
+{
+    for (uint8_t i = 0; i < urcCount; i++)
+    {
+        if (line.startsWith(urcHandlers[i].prefix))
+        {
+            urcHandlers[i].handler(line);
+            return true;
+        }
+    }
+
+    return false;
 }
 
 String SIM7080GHardwareSerial::send_AT_bloquant(String message, int timeout)
@@ -217,30 +908,123 @@ String SIM7080GHardwareSerial::send_AT_bloquant(String message, int timeout)
     return response;
 }
 
-void SIM7080GHardwareSerial::powerOn()
+bool SIM7080GHardwareSerial::powerOn()
 {
-    digitalWrite(PWR_KEY, LOW);
-    delay(200);
-    digitalWrite(PWR_KEY, OUTPUT_OPEN_DRAIN);
-    delay(3000);
+    if (powerState == POWER_OFF)
+    {
+        powerPulse = SIM7080G_POWER_PULSE;
+        powerState = POWER_PULSE;
+        powerTimer = millis();
+        digitalWrite(PWR_KEY, LOW);
+    }
+
+    return powerSequence();
 }
 
-void SIM7080GHardwareSerial::powerOff()
+bool SIM7080GHardwareSerial::powerOff()
 {
-    if (Sim7080G.sendATCommand("AT+CPOWD=1").isFinished)
+    if (powerState == POWER_OFF)
+        return true;
+
+    if (powerState != POWER_DOWN && powerState != POWER_SETTLE)
     {
-        Sim7080G.freeATState();
+        // AT+CPOWD would wait in the queue for a link that is not up, the next powerOn() finds out if the modem is on
+        if (powerState != POWER_ON || linkState != LINK_READY)
+        {
+            if (powerState == POWER_PULSE)
+                digitalWrite(PWR_KEY, OUTPUT_OPEN_DRAIN);
+
+            powerState = POWER_OFF;
+            return true;
+        }
+
+        powerCommand = ATFuture();
+        powerState = POWER_DOWN;
     }
+
+    return !powerSequence() && powerState == POWER_OFF;
 }
 
-void SIM7080GHardwareSerial::hardReset()
+bool SIM7080GHardwareSerial::hardReset()
 {
-    digitalWrite(PWR_KEY, LOW);
-    delay(15000);
-    digitalWrite(PWR_KEY, OUTPUT_OPEN_DRAIN);
-    delay(3000);
+    if (powerState == POWER_OFF || powerState == POWER_ON)
+    {
+        powerPulse = SIM7080G_RESET_PULSE;
+        powerState = POWER_PULSE;
+        powerTimer = millis();
+        digitalWrite(PWR_KEY, LOW);
+    }
+
+    return powerSequence();
+}
+
+bool SIM7080GHardwareSerial::powerSequence()
+{
+    if (powerState == POWER_PULSE)
+    {
+        if (millis() - powerTimer < powerPulse)
+        {
+            events.wakeAt(powerTimer + powerPulse);
+            return false;
+        }
+
+        digitalWrite(PWR_KEY, OUTPUT_OPEN_DRAIN);
+
+        // The modem is back to autobaud, probe it at SIM7080G_BAUD until it answers
+        flush();
+        restartLink();
+        modemReady = false;
+
+        powerState = POWER_BOOT;
+        powerTimer = millis();
+    }
+
+    if (powerState == POWER_BOOT)
+    {
+        if (!modemReady && linkState == LINK_PROBE)
+        {
+            if (millis() - powerTimer < SIM7080G_BOOT_TIMEOUT)
+            {
+                events.wakeAt(powerTimer + SIM7080G_BOOT_TIMEOUT);
+                return false;
+            }
+
+            // The pulse may have turned off a modem that was still on, the next one turns it on
+            Serial.printf("[x] Modem silent %lu ms after PWRKEY, pulsing again\n", millis() - powerTimer);
+            powerState = POWER_OFF;
+            return false;
+        }
+
+        Serial.printf("[+] Modem booted in %lu ms\n", millis() - powerTimer);
+        powerState = POWER_ON;
+    }
+
+    if (powerState == POWER_DOWN)
+    {
+        AT_RESPONSE response = ATCommands::CPOWD.send(powerCommand, 1);
+        if (!response.isFinished)
+            return false;
+
+        // Without NORMAL POWER DOWN, the boot check of the next powerOn() tells if the modem is still on
+        if (response.status != AT_OK)
+            Serial.printf("[x] No NORMAL POWER DOWN from the modem\n");
+
+        powerState = POWER_SETTLE;
+        powerTimer = millis();
+    }
+
+    if (powerState == POWER_SETTLE)
+    {
+        if (millis() - powerTimer < SIM7080G_POWER_DOWN_SETTLE)
+        {
+            events.wakeAt(powerTimer + SIM7080G_POWER_DOWN_SETTLE);
+            return false;
+        }
+
+        powerState = POWER_OFF;
+    }
 
-    Sim7080G.flush();
+    return powerState == POWER_ON;
 }
 
 json BATTERYData::to_json() const
@@ -249,7 +1033,9 @@ json BATTERYData::to_json() const
         {"b", batteryLevel}};
 }
 
-std::string BATTERYData::get_type() const
+BATTERYData BATTERYData::from_json(const json &j)
 {
-    return "BATTERY";
+    BATTERYData data;
+    data.batteryLevel = j.value("b", 0);
+    return data;
 }
\ No newline at end of file
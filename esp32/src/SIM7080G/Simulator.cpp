@@ -0,0 +1,497 @@
+#include <SIM7080G/Simulator.hpp>
+
+/**
+ * @brief Position reported once the simulated GNSS has a fix
+ */
+#define SIMULATOR_LATITUDE 45.764043
+#define SIMULATOR_LONGITUDE 4.835659
+
+/**
+ * @brief Accuracy in meters of the cell position, and its offset from the track in degrees of latitude
+ */
+#define SIMULATOR_CELL_ACCURACY 550
+#define SIMULATOR_CELL_OFFSET 0.003
+
+void ModemSimulator::begin()
+{
+    lineLength = 0;
+    outputStart = outputEnd = 0;
+    pdpAt = 0;
+    reportRate = 0;
+    gnssStop = 0;
+    gnssOnTime = 0;
+    gnssShare = 100;
+    downloadAt = 0;
+    xtraDownloaded = xtraCopied = xtraEnabled = false;
+    gnssOn = pdpActive = socketOpen = false;
+    dataLeft = 0;
+    baud = 0;
+
+    sessionStart = trackStart = millis();
+    answerAt = sessionStart + config.latency;
+    answer("\r\nRDY\r\n");
+}
+
+void ModemSimulator::scheduleFix()
+{
+    unsigned int share = gnssShare < 1 ? 1 : gnssShare > 100 ? 100 : gnssShare;
+    gnssFixTime = gnssBaseFixTime * 100 / share;
+}
+
+unsigned long ModemSimulator::gnssTime() const
+{
+    return gnssOnTime + (gnssOn ? millis() - gnssPowerOn : 0);
+}
+
+void ModemSimulator::restartTrack()
+{
+    trackStart = millis();
+}
+
+void ModemSimulator::closeSocket()
+{
+    if (socketOpen)
+        answer("\r\n+CASTATE: 0,0\r\n");
+    socketOpen = false;
+}
+
+void ModemSimulator::dropPDP()
+{
+    if (pdpActive)
+        answer("\r\n+APP PDP: 0,DEACTIVE\r\n");
+    pdpActive = socketOpen = false;
+}
+
+void ModemSimulator::position(unsigned long time, double &latitude, double &longitude, float &speed) const
+{
+    latitude = SIMULATOR_LATITUDE;
+    longitude = SIMULATOR_LONGITUDE;
+    speed = 0;
+
+    if (config.track == nullptr || config.trackLength == 0)
+        return;
+
+    const SimulatorWaypoint *track = config.track;
+    size_t last = config.trackLength - 1;
+
+    latitude = track[last].latitude;
+    longitude = track[last].longitude;
+
+    for (size_t i = 0; i < last; i++)
+    {
+        if (time >= track[i + 1].time)
+            continue;
+
+        if (time < track[i].time || track[i + 1].time == track[i].time)
+        {
+            latitude = track[i].latitude;
+            longitude = track[i].longitude;
+            return;
+        }
+
+        double ratio = (double)(time - track[i].time) / (track[i + 1].time - track[i].time);
+        double dLatitude = track[i + 1].latitude - track[i].latitude;
+        double dLongitude = track[i + 1].longitude - track[i].longitude;
+
+        latitude = track[i].latitude + dLatitude * ratio;
+        longitude = track[i].longitude + dLongitude * ratio;
+
+        double dy = dLatitude * 111320.0;
+        double dx = dLongitude * 111320.0 * cos(latitude * DEG_TO_RAD);
+        speed = sqrt(dx * dx + dy * dy) / (track[i + 1].time - track[i].time) * 3600.0;
+        return;
+    }
+}
+
+void ModemSimulator::answer(const char *text)
+{
+    size_t length = strlen(text);
+
+    // Make room at the end of the buffer, the answers already read are dropped
+    if (outputEnd + length > SIMULATOR_OUTPUT_SIZE && outputStart > 0)
+    {
+        memmove(output, output + outputStart, outputEnd - outputStart);
+        outputEnd -= outputStart;
+        outputStart = 0;
+    }
+
+    if (outputEnd + length > SIMULATOR_OUTPUT_SIZE)
+        length = SIMULATOR_OUTPUT_SIZE - outputEnd;
+
+    memcpy(output + outputEnd, text, length);
+    outputEnd += length;
+}
+
+void ModemSimulator::answerFix(const char *prefix)
+{
+    char text[160];
+    unsigned long now = millis();
+
+    if (!gnssOn)
+    {
+        snprintf(text, sizeof(text), "\r\n%s: 0,,,,,,,,,,,,,,,,,,,,\r\n", prefix);
+    }
+    else if (config.noFix || now - gnssPowerOn < gnssFixTime)
+    {
+        snprintf(text, sizeof(text), "\r\n%s: 1,0,,,,,,,,,,,,,,,,,,,\r\n", prefix);
+    }
+    else
+    {
+        // The time of day follows the uptime, the position wanders by a meter or so around the track
+        unsigned long seconds = now / 1000 % 86400;
+        double drift = (now / 1000 % 10) * 0.000002;
+
+        double latitude, longitude;
+        float speed;
+        position(now - trackStart, latitude, longitude, speed);
+
+        snprintf(text, sizeof(text), "\r\n%s: 1,1,20240601%02lu%02lu%02lu.000,%.6f,%.6f,170.000,%.2f,0.0,1,,1.1,1.4,0.9,,12,8,,,35,2.4,3.1\r\n",
+                 prefix, seconds / 3600, seconds / 60 % 60, seconds % 60, latitude + drift, longitude + drift, speed);
+    }
+
+    answer(text);
+}
+
+bool ModemSimulator::execute(const char *command)
+{
+    if (command[0] == '\0')
+        return true;
+
+    // The OK goes out at the old rate, the next command is expected at the new one
+    if (strncmp(command, "+IPR=", 5) == 0)
+    {
+        baud = atol(command + 5);
+        return true;
+    }
+
+    if (strcmp(command, "+GSN") == 0)
+    {
+        answer("\r\n869951030000001\r\n");
+        return true;
+    }
+
+    if (strcmp(command, "+CBC") == 0)
+    {
+        answer("\r\n+CBC: 0,87,4100\r\n");
+        return true;
+    }
+
+    if (strncmp(command, "+CPOWD=", 7) == 0)
+    {
+        // The modem goes down, the next session registers from scratch
+        answer("\r\nNORMAL POWER DOWN\r\n");
+        if (gnssOn)
+            gnssOnTime += millis() - gnssPowerOn;
+        gnssOn = pdpActive = socketOpen = false;
+        reportRate = 0;
+        baud = 0;
+        sessionStart = millis();
+        return true;
+    }
+
+    if (strncmp(command, "+CGNSPWR=", 9) == 0)
+    {
+        bool on = command[9] == '1';
+        // A hot start needs the ephemeris of a previous session, a cold start is shorter with XTRA data
+        unsigned long ttff = config.fixTime;
+        if (gnssStop != 0 && millis() - gnssStop < config.hotStartWindow)
+            ttff = config.hotStartTime;
+        else if (xtraEnabled)
+            ttff = config.assistedFixTime;
+
+        if (on && !gnssOn)
+        {
+            gnssPowerOn = millis();
+            gnssBaseFixTime = ttff;
+            if (config.fixJitter > 0)
+                gnssBaseFixTime = ttff * (100 - config.fixJitter + random(2 * config.fixJitter + 1)) / 100;
+            scheduleFix();
+        }
+        if (!on && gnssOn)
+        {
+            gnssStop = millis();
+            gnssOnTime += gnssStop - gnssPowerOn;
+        }
+        gnssOn = on;
+        return true;
+    }
+
+    if (strncmp(command, "+CGNSMOD=", 9) == 0)
+    {
+        int systems[5] = {0};
+        sscanf(command + 9, "%d,%d,%d,%d,%d", &systems[0], &systems[1], &systems[2], &systems[3], &systems[4]);
+
+        gnssShare = 0;
+        for (int i = 0; i < 5; i++)
+            gnssShare += systems[i] ? config.systemShare[i] : 0;
+
+        if (gnssOn)
+            scheduleFix();
+        return true;
+    }
+
+    if (strcmp(command, "+CGNSINF") == 0)
+    {
+        answerFix("+CGNSINF");
+        return true;
+    }
+
+    if (strncmp(command, "+CGNSURC=", 9) == 0)
+    {
+        reportRate = atoi(command + 9);
+        nextReport = millis() + reportRate * 1000;
+        return true;
+    }
+
+    if (strncmp(command, "+HTTPTOFS=", 10) == 0)
+    {
+        if (!pdpActive)
+        {
+            answer("\r\n+HTTPTOFS: 603,0\r\n");
+            return true;
+        }
+
+        downloadAt = millis() + config.downloadTime;
+        return true;
+    }
+
+    if (strcmp(command, "+CGNSCPY") == 0)
+    {
+        // The engine must be off to take the file
+        xtraCopied = xtraDownloaded && !gnssOn;
+        return xtraCopied;
+    }
+
+    if (strncmp(command, "+CGNSXTRA=", 10) == 0)
+    {
+        xtraEnabled = command[10] == '1' && xtraCopied;
+        return command[10] == '0' || xtraEnabled;
+    }
+
+    if (strcmp(command, "+CEREG?") == 0)
+    {
+        answer(millis() - sessionStart >= config.registrationTime ? "\r\n+CEREG: 0,5\r\n" : "\r\n+CEREG: 0,2\r\n");
+        return true;
+    }
+
+    if (strcmp(command, "+CNACT?") == 0)
+    {
+        answer(pdpActive ? "\r\n+CNACT: 0,1,\"10.64.0.2\"\r\n" : "\r\n+CNACT: 0,0,\"0.0.0.0\"\r\n");
+        return true;
+    }
+
+    if (strcmp(command, "+CPSI?") == 0)
+    {
+        answer(millis() - sessionStart >= config.registrationTime
+                   ? "\r\n+CPSI: LTE CAT-M1,Online,208-01,0x1B5A,27446555,123,EUTRAN-BAND20,6300,5,5,-10,-95,-65,15\r\n"
+                   : "\r\n+CPSI: NO SERVICE,Online\r\n");
+        return true;
+    }
+
+    if (strncmp(command, "+CLBS=", 6) == 0)
+    {
+        // The location service of the network is reached over the PDP context
+        if (!pdpActive)
+        {
+            answer("\r\n+CLBS: 1\r\n");
+            return true;
+        }
+
+        char text[96];
+        unsigned long seconds = millis() / 1000 % 86400;
+        double latitude, longitude;
+        float speed;
+        position(millis() - trackStart, latitude, longitude, speed);
+
+        snprintf(text, sizeof(text), "\r\n+CLBS: 0,%.6f,%.6f,%d,24/06/01,%02lu:%02lu:%02lu\r\n",
+                 longitude, latitude + SIMULATOR_CELL_OFFSET, SIMULATOR_CELL_ACCURACY, seconds / 3600, seconds / 60 % 60, seconds % 60);
+        answer(text);
+        cellLocations++;
+        return true;
+    }
+
+    if (strcmp(command, "+CNACT=0,1") == 0)
+    {
+        if (millis() - sessionStart < config.registrationTime)
+            return false;
+
+        pdpAt = millis() + config.pdpTime;
+        return true;
+    }
+
+    if (strcmp(command, "+CNACT=0,0") == 0)
+    {
+        if (pdpActive)
+            answer("\r\n+APP PDP: 0,DEACTIVE\r\n");
+        pdpActive = false;
+        return true;
+    }
+
+    if (strncmp(command, "+CAOPEN=", 8) == 0)
+    {
+        if (!pdpActive)
+        {
+            answer("\r\n+CAOPEN: 0,1\r\n");
+            return true;
+        }
+
+        // The server greets every connection
+        socketOpen = true;
+        answer("\r\n+CAOPEN: 0,0\r\n");
+        answer("\r\n+CADATAIND: 0\r\n");
+        return true;
+    }
+
+    if (strncmp(command, "+CASEND=", 8) == 0)
+    {
+        const char *length = strchr(command, ',');
+        if (!socketOpen || length == nullptr)
+            return false;
+
+        dataLength = dataLeft = atoi(length + 1);
+        return dataLeft > 0;
+    }
+
+    if (strncmp(command, "+CACLOSE=", 9) == 0)
+    {
+        socketOpen = false;
+        return true;
+    }
+
+    // Configuration commands are accepted as is
+    return strncmp(command, "+CNMP=", 6) == 0 || strncmp(command, "+CMNB=", 6) == 0 ||
+           strncmp(command, "+CGDCONT=", 9) == 0 || strncmp(command, "+CNCFG=", 7) == 0;
+}
+
+void ModemSimulator::executeLine()
+{
+    line[lineLength] = '\0';
+    lineLength = 0;
+
+    if (strncasecmp(line, "AT", 2) != 0)
+        return;
+
+    answerAt = millis() + config.latency;
+
+    if (config.errorRate > 0 && random(100) < config.errorRate)
+    {
+        answer("\r\nERROR\r\n");
+        return;
+    }
+
+    // Chained commands run in order, the first error ends the line
+    char *command = line + 2;
+
+    while (true)
+    {
+        char *next = strchr(command, ';');
+        if (next != nullptr)
+            *next = '\0';
+
+        if (!execute(command))
+        {
+            errors++;
+            answer("\r\nERROR\r\n");
+            dataLeft = 0;
+            return;
+        }
+
+        if (next == nullptr)
+            break;
+
+        command = next + 1;
+    }
+
+    // The data prompt takes the place of the final result code
+    answer(dataLeft > 0 ? "\r\n> " : "\r\nOK\r\n");
+}
+
+void ModemSimulator::receive(uint8_t c)
+{
+    // Sampled at the wrong rate, the byte is noise to the modem
+    if (baud != 0 && Sim7080G.linkBaud != baud)
+        return;
+
+    if (dataLeft > 0)
+    {
+        if (--dataLeft == 0)
+        {
+            serverBytes += dataLength;
+            serverUploads++;
+
+            // The payload takes its time on the UART at the link rate, 10 bits a byte
+            answerAt = millis() + config.latency + dataLength * 10000UL / Sim7080G.linkBaud;
+            answer("\r\nOK\r\n");
+        }
+        return;
+    }
+
+    if (c == '\r')
+    {
+        executeLine();
+    }
+    else if (c != '\n' && lineLength < sizeof(line) - 1)
+    {
+        line[lineLength++] = c;
+    }
+}
+
+int ModemSimulator::available()
+{
+    unsigned long now = millis();
+
+    if (gnssOn && reportRate > 0 && (long)(now - nextReport) >= 0)
+    {
+        nextReport = now + reportRate * 1000;
+        answerFix("+UGNSINF");
+    }
+
+    if (downloadAt != 0 && (long)(now - downloadAt) >= 0)
+    {
+        downloadAt = 0;
+        xtraDownloaded = true;
+        answer("\r\n+HTTPTOFS: 200,38016\r\n");
+    }
+
+    if (pdpAt != 0 && (long)(now - pdpAt) >= 0)
+    {
+        pdpAt = 0;
+        pdpActive = true;
+        answer("\r\n+APP PDP: 0,ACTIVE\r\n");
+    }
+
+    if ((long)(now - answerAt) < 0)
+        return 0;
+
+    return outputEnd - outputStart;
+}
+
+int ModemSimulator::read()
+{
+    if (available() <= 0)
+        return -1;
+
+    return output[outputStart++];
+}
+
+int ModemSimulator::peek()
+{
+    if (available() <= 0)
+        return -1;
+
+    return output[outputStart];
+}
+
+size_t ModemSimulator::write(uint8_t c)
+{
+    receive(c);
+    return 1;
+}
+
+size_t ModemSimulator::write(const uint8_t *buffer, size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+        receive(buffer[i]);
+
+    return size;
+}
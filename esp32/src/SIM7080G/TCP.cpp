@@ -15,27 +15,38 @@ SIM7080GTCP::~SIM7080GTCP()
 {
 }
 
-void SIM7080GTCP::openSocket()
+void SIM7080GTCP::setup()
 {
-    // Serial.println("open socket");
-    // String command = "AT+CAOPEN=0,0,\"TCP\",\"" + String(URL) + "\"," + String(PORT) + "";
-
-    String command = "AT+CAOPEN=0,0,\"TCP\",\"" + String(URL) + "\"," + String(PORT);
+    // +CASTATE: <cid>,<state>, state 0 means the socket was closed
+    Sim7080G.onURC("+CASTATE:", [](const ATView &line)
+                   {
+        if (line.substring(line.indexOf(",") + 1).toInt() == 0)
+            TCP.socketOpen = false;
+        Serial.print("[!] Socket state changed : ");
+        Serial.println(line); });
+
+    // The server greets every connection, the greeting is never read and stays in the modem
+    Sim7080G.onURC("+CADATAIND:", [](const ATView &line) {});
+}
 
-    AT_RESPONSE response = Sim7080G.sendATCommand(command.c_str(), 10000);
+void SIM7080GTCP::openSocket()
+{
+    AT_RESPONSE response = ATCommands::CAOPEN.send(atCommand, 0, 0, Quoted{"TCP"}, Quoted{URL}, PORT);
 
     if (response.isFinished)
     {
-        Sim7080G.freeATState();
-        Serial.println("socket opened : " + response.message);
+        Serial.print("socket opened : ");
+        Serial.println(response.message);
         if (response.message.indexOf("+CAOPEN: 0,0") != -1)
         {
+            socketOpen = true;
             fsmTCP.setState(TCP_SEND);
             return;
         }
         else
         {
-            Serial.println("Error opening socket: " + response.message);
+            Serial.print("Error opening socket: ");
+            Serial.println(response.message);
             fsmTCP.setState(TCP_CLOSE);
             return;
         }
@@ -44,17 +55,12 @@ void SIM7080GTCP::openSocket()
 
 void SIM7080GTCP::sendData()
 {
-    std::vector<std::uint8_t> cborData = queueList.to_cbor();
     // static String message = "";
 
     if (fsmTCP.currentState == TCP_SEND)
     {
-        // Initial state, start with sending size
-        // message = "";
-        // for (std::uint8_t i : cborData)
-        // {
-        //     message += (char)i;
-        // }
+        // Initial state, size the payload once and start with sending size, it is encoded while it is written
+        payload.begin(queueList);
 
         fsmTCP.setState(TCP_SEND_SIZE);
         return;
@@ -62,14 +68,21 @@ void SIM7080GTCP::sendData()
 
     if (fsmTCP.currentState == TCP_SEND_SIZE)
     {
-        String sizeCommand = "AT+CASEND=0," + String(cborData.size());
-        AT_RESPONSE response = Sim7080G.sendATCommand(sizeCommand.c_str());
+        // Closed by the server, before the size went out or while it was answered ERROR
+        if (!socketOpen && atCommand.slot < 0)
+        {
+            Serial.println("[x] Socket closed by the server, opening it again");
+            reset();
+            return;
+        }
+
+        AT_RESPONSE response = ATCommands::CASEND.send(atCommand, 0, (int)payload.size());
 
         if (response.isFinished)
         {
-            Serial.println("Size sent: " + response.message);
-            Sim7080G.freeATState();
-            if (!response.message.isEmpty())
+            Serial.print("Size sent: ");
+            Serial.println(response.message);
+            if (response.status == AT_OK)
             {
                 fsmTCP.setState(TCP_SEND_DATA);
             }
@@ -77,20 +90,20 @@ void SIM7080GTCP::sendData()
     }
     else if (fsmTCP.currentState == TCP_SEND_DATA)
     {
-        AT_RESPONSE response = Sim7080G.sendTCPData(cborData);
+        AT_RESPONSE response = Sim7080G.sendTCPData(atCommand, payload);
 
         if (response.isFinished)
         {
-            queueList.clear();
+            size_t sent = payload.items();
+            payload.end();
 
-            for (std::uint8_t i : cborData)
-            {
-                Serial.printf("%02X ", i);
-            }
-            Serial.println();
+            // Only an upload the modem confirmed leaves the queue, and commits it in the queue store.
+            // Items queued during the upload stay for the next one
+            if (response.status == AT_OK)
+                queueList.drop(sent);
 
-            Serial.println("Data sent: " + response.message);
-            Sim7080G.freeATState();
+            Serial.print("Data sent: ");
+            Serial.println(response.message);
             fsmTCP.setState(TCP_CLOSE);
         }
     }
@@ -98,22 +111,40 @@ void SIM7080GTCP::sendData()
 
 void SIM7080GTCP::closeSocket()
 {
+    // Already closed by the server, AT+CACLOSE would fail
+    if (!socketOpen && atCommand.slot < 0)
+    {
+        fsmTCP.setState(TCP_OPEN);
+        fsm.setState(BasicState::PAUSED);
+        return;
+    }
+
     // Serial.println("close socket");
-    AT_RESPONSE response = Sim7080G.sendATCommand("AT+CACLOSE=0");
+    AT_RESPONSE response = ATCommands::CACLOSE.send(atCommand, 0);
 
     if (response.isFinished)
     {
-        Serial.println("socket closed : " + response.message);
+        Serial.print("socket closed : ");
+        Serial.println(response.message);
 
-        Sim7080G.freeATState();
         if (!response.message.isEmpty())
         {
+            socketOpen = false;
             fsmTCP.setState(TCP_OPEN);
             fsm.setState(BasicState::PAUSED);
         }
     }
 }
 
+void SIM7080GTCP::reset()
+{
+    // A response not polled yet goes with the handle, the scheduler drops it after its retention time
+    atCommand = ATFuture();
+    payload.end();
+    socketOpen = false;
+    fsmTCP.setState(TCP_OPEN);
+}
+
 void SIM7080GTCP::loop()
 {
     switch (fsmTCP.currentState)
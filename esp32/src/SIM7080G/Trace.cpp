@@ -0,0 +1,185 @@
+#include <SIM7080G/Trace.hpp>
+
+/**
+ * @brief Bytes recorded between two flushes of the sink
+ */
+#define TRACE_FLUSH_SIZE 4096
+
+#pragma region TraceWriter
+void TraceWriter::begin(Print &sink)
+{
+    this->sink = &sink;
+    unflushed = 0;
+
+    sink.write((const uint8_t *)TRACE_MAGIC, strlen(TRACE_MAGIC));
+    sink.write((uint8_t)TRACE_VERSION);
+
+    lastRecord = micros();
+}
+
+void TraceWriter::end()
+{
+    if (sink != nullptr)
+        sink->flush();
+
+    sink = nullptr;
+}
+
+void TraceWriter::record(bool tx, const uint8_t *data, size_t length)
+{
+    if (sink == nullptr)
+        return;
+
+    uint32_t now = micros();
+
+    while (length > 0)
+    {
+        size_t count = length < TRACE_RECORD_SIZE ? length : TRACE_RECORD_SIZE;
+
+        // Header, then the delay as a varint, 1 byte below 128 us and 3 bytes below 2 s
+        uint8_t header[1 + 5];
+        size_t headerLength = 0;
+        header[headerLength++] = (tx ? TRACE_TX : 0) | (count - 1);
+
+        uint32_t delay = now - lastRecord;
+        do
+        {
+            header[headerLength++] = (delay & 0x7F) | (delay >= 0x80 ? 0x80 : 0);
+            delay >>= 7;
+        } while (delay > 0);
+
+        sink->write(header, headerLength);
+        sink->write(data, count);
+
+        lastRecord = now;
+        data += count;
+        length -= count;
+        unflushed += headerLength + count;
+    }
+
+    if (unflushed >= TRACE_FLUSH_SIZE)
+    {
+        sink->flush();
+        unflushed = 0;
+    }
+}
+#pragma endregion TraceWriter
+
+#pragma region TraceReplay
+bool TraceReplay::begin(Stream &trace)
+{
+    char magic[sizeof(TRACE_MAGIC)] = {};
+
+    if (trace.readBytes(magic, strlen(TRACE_MAGIC)) != strlen(TRACE_MAGIC) || strcmp(magic, TRACE_MAGIC) != 0 || trace.read() != TRACE_VERSION)
+    {
+        Serial.println("[x] Not a modem trace");
+        return false;
+    }
+
+    this->trace = &trace;
+    recordLeft = 0;
+    written = 0;
+    lastRecord = micros();
+
+    return true;
+}
+
+void TraceReplay::end()
+{
+    trace = nullptr;
+}
+
+uint32_t TraceReplay::readVarint()
+{
+    uint32_t value = 0;
+
+    for (uint8_t shift = 0; shift < 32; shift += 7)
+    {
+        int c = trace->read();
+        if (c < 0)
+            break;
+
+        value |= (uint32_t)(c & 0x7F) << shift;
+        if ((c & 0x80) == 0)
+            break;
+    }
+
+    return value;
+}
+
+bool TraceReplay::nextRecord()
+{
+    if (trace == nullptr || trace->available() <= 0)
+        return false;
+
+    int header = trace->read();
+    recordTx = (header & TRACE_TX) != 0;
+    recordLeft = (header & ~TRACE_TX) + 1;
+    recordDelay = readVarint();
+
+    return true;
+}
+
+bool TraceReplay::advance()
+{
+    while (true)
+    {
+        if (recordLeft == 0 && !nextRecord())
+            return false;
+
+        if (!recordTx)
+            return micros() - lastRecord >= recordDelay;
+
+        // Written bytes are matched by count, the firmware may word its commands differently
+        if (written == 0)
+            return false;
+
+        size_t count = written < recordLeft ? written : recordLeft;
+        for (size_t i = 0; i < count; i++)
+            trace->read();
+
+        written -= count;
+        recordLeft -= count;
+
+        if (recordLeft == 0)
+            lastRecord = micros();
+    }
+}
+
+int TraceReplay::available()
+{
+    return advance() ? recordLeft : 0;
+}
+
+int TraceReplay::read()
+{
+    if (!advance())
+        return -1;
+
+    int c = trace->read();
+
+    // The rest of the record was received with it
+    recordDelay = 0;
+    if (--recordLeft == 0)
+        lastRecord = micros();
+
+    return c;
+}
+
+int TraceReplay::peek()
+{
+    return advance() ? trace->peek() : -1;
+}
+
+size_t TraceReplay::write(uint8_t c)
+{
+    written++;
+    return 1;
+}
+
+size_t TraceReplay::write(const uint8_t *buffer, size_t size)
+{
+    written += size;
+    return size;
+}
+#pragma endregion TraceReplay
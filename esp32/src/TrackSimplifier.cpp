@@ -0,0 +1,66 @@
+#include <TrackSimplifier.hpp>
+
+bool TrackSimplifier::fits(int32_t latitude, int32_t longitude) const
+{
+    uint32_t limit = tolerance * 100;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (Coordinates::segmentDistance(latitudes[i], longitudes[i], anchorLatitude, anchorLongitude, latitude, longitude) > limit)
+            return false;
+    }
+
+    return true;
+}
+
+void TrackSimplifier::keepLast()
+{
+    anchorLatitude = latitudes[count - 1];
+    anchorLongitude = longitudes[count - 1];
+    anchorTime = times[count - 1];
+    count = 0;
+}
+
+TrackDecision TrackSimplifier::push(int32_t latitude, int32_t longitude, unsigned long time)
+{
+    if (!hasAnchor || tolerance == 0)
+    {
+        anchorLatitude = latitude;
+        anchorLongitude = longitude;
+        anchorTime = time;
+        hasAnchor = true;
+        count = 0;
+        return TRACK_KEEP;
+    }
+
+    TrackDecision decision = TRACK_HOLD;
+
+    if (count > 0 && (count == TRACK_WINDOW_SIZE || time - anchorTime > TRACK_MAX_SPAN || !fits(latitude, longitude)))
+    {
+        // TRACK_MAX_SPAN runs from the kept point, not from this one
+        keepLast();
+        decision = TRACK_KEEP_PREVIOUS;
+    }
+
+    latitudes[count] = latitude;
+    longitudes[count] = longitude;
+    times[count] = time;
+    count++;
+
+    return decision;
+}
+
+bool TrackSimplifier::flush()
+{
+    if (count == 0)
+        return false;
+
+    keepLast();
+    return true;
+}
+
+void TrackSimplifier::reset()
+{
+    hasAnchor = false;
+    count = 0;
+}
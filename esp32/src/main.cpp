@@ -1,16 +1,146 @@
 #include <Arduino.h>
 #include <SIM7080G/Serial.hpp>
+#include <SIM7080G/ATCommands.hpp>
 #include <SIM7080G/GNSS.hpp>
 #include <SIM7080G/CATM1.hpp>
+#include <SIM7080G/Cell.hpp>
+#include <Geofence.hpp>
 #include <FSM.hpp>
 #include <QueueList.hpp>
+#include <QueueStore.hpp>
 #include <SIM7080G/TCP.hpp>
 #include <Color.hpp>
+#include <LittleFS.h>
+
+#if defined(SIM7080G_TRACE) || defined(SIM7080G_REPLAY)
+/**
+ * @brief Modem session recorded by SIM7080G_TRACE builds, played back by SIM7080G_REPLAY builds
+ */
+#define TRACE_FILE "/trace.bin"
+
+File traceFile;
+#endif
+
+#ifdef SIM7080G_REPLAY
+TraceReplay traceReplay;
+#endif
+
+#ifdef SIM7080G_SIMULATOR
+#include <SIM7080G/Simulator.hpp>
+
+ModemSimulator simulator;
+
+/**
+ * @brief Day of a collar, an hour in the kennel, a 20-minute walk of about 1.5 km, then back to sleep
+ */
+static const SimulatorWaypoint SIMULATOR_TRACK[] = {
+    {0, 45.764043, 4.835659},
+    {1000UL * 60 * 60, 45.764043, 4.835659},
+    {1000UL * 60 * 70, 45.770043, 4.840659},
+    {1000UL * 60 * 80, 45.774043, 4.848659},
+    {1000UL * 60 * 90, 45.774043, 4.848659},
+};
+
+/**
+ * @brief Log the cost of each run of the master FSM, from leaving PAUSED until it is back to it
+ *
+ * @details The wall time, the time the modem spent on commands and the heap peak of the cycle give the
+ * cost of a fix or an upload, to compare two versions of the firmware on the same simulated modem.
+ * The peak is the lowest free heap seen between two loops, or the low-water mark of the ESP32 when the
+ * cycle lowered it, which also catches the allocations freed within a loop.
+ */
+void benchmarkCycle()
+{
+  static bool running = false;
+  static unsigned char firstState = 0;
+  static unsigned long startTime = 0;
+  static unsigned long startBusy = 0;
+  static uint32_t startMinFree = 0;
+  static uint32_t lowestFree = 0;
+
+  if (!running && fsm.currentState != BasicState::PAUSED && fsm.currentState != BasicState::ENTRYPOINT)
+  {
+    running = true;
+    firstState = fsm.currentState;
+    startTime = millis();
+    startBusy = Sim7080G.busyTime;
+    startMinFree = ESP.getMinFreeHeap();
+    lowestFree = ESP.getFreeHeap();
+  }
+  else if (running)
+  {
+    uint32_t freeHeap = ESP.getFreeHeap();
+    lowestFree = freeHeap < lowestFree ? freeHeap : lowestFree;
+  }
+
+  if (running && fsm.currentState == BasicState::PAUSED)
+  {
+    running = false;
+
+    uint32_t minFree = ESP.getMinFreeHeap();
+    if (minFree < startMinFree)
+      lowestFree = minFree;
+
+    Serial.printf("%sCycle%s from state %u: %lu ms, modem busy %lu ms, heap peak %u bytes, server %u bytes in %u uploads, GNSS on %lu s, TTFF %lu ms\n",
+                  Color::_GRAY, Color::_RESET, firstState, millis() - startTime, Sim7080G.busyTime - startBusy,
+                  (unsigned)(ESP.getHeapSize() - lowestFree), (unsigned)simulator.serverBytes, (unsigned)simulator.serverUploads,
+                  simulator.gnssTime() / 1000, GNSS.ttff);
+  }
+}
+#endif
 
 #define BAUD_RATE 115200
 
+/**
+ * @brief Home zone of the collar, around the kennel, in 1e-7 degrees
+ */
+static const GeofencePoint HOME_FENCE[] = {
+    {457625000, 48330000},
+    {457625000, 48385000},
+    {457655000, 48385000},
+    {457655000, 48330000},
+};
+
+/**
+ * @brief Zones watched by the collar, a crossing is uploaded at once
+ */
+static const Geofence GEOFENCES[] = {
+    {"home", HOME_FENCE, sizeof(HOME_FENCE) / sizeof(HOME_FENCE[0])},
+};
+
+/**
+ * @brief Time the battery query may wait to be chained with a GNSS or network query, in milliseconds
+ */
+#define BATTERY_HOLD (1000 * 90)
+
 FSM sendFSM;
 
+/**
+ * @brief Handle on the AT command sent by the main FSM
+ */
+ATFuture atCommand;
+
+/**
+ * @brief Queue the battery level read by AT+CBC
+ *
+ * @param response Response of AT+CBC, "+CBC: <bcs>,<bcl>,<voltage>"
+ */
+void onBatteryStatus(const AT_RESPONSE &response)
+{
+  if (response.status != AT_OK)
+    return;
+
+  BATTERYData batteryData;
+
+  ATView message = response.message.substring(response.message.indexOf(",") + 1);
+  message = message.substring(0, message.indexOf(","));
+  batteryData.batteryLevel = message.toInt();
+
+  Serial.printf("%sBattery status%s: %d%%\n", Color::_GRAY, Color::_RESET, batteryData.batteryLevel);
+
+  queueList.enqueue<BATTERYData>(batteryData);
+}
+
 void setup()
 {
   // Initialize pins
@@ -19,47 +149,88 @@ void setup()
   // Initialize the serial port
   Serial.begin(BAUD_RATE);
 
+  // Set up the event loop, loop() sleeps until the modem or a deadline wakes it up
+  events.setup();
+
   // Set up the state machine
   fsm.name = "Master FSM";
   fsm.debug = true;
-  fsm.currentState = AT_FREE;
+  fsm.currentState = ENTRYPOINT;
   fsm.changeStateCondition = []()
-  { return Sim7080G.fsm.currentState == AT_FREE; };
+  { return Sim7080G.isIdle(); };
 
   sendFSM.name = "Send FSM";
   sendFSM.debug = true;
   sendFSM.changeStateCondition = []()
-  { return queueList.isEmpty() && Sim7080G.fsm.currentState == AT_FREE; };
+  { return queueList.isEmpty() && Sim7080G.isIdle(); };
 
   // Initialize the SIM7080G serial port
   Sim7080G.begin(SIM7080G_BAUD, SERIAL_8N1, RX0, TX0);
   Sim7080G.flush();
+
+  // The queue is kept in flash, the items not sent before a power loss are queued again
+  LittleFS.begin(true);
+  queueList.onEnqueue = [](const QueueRecord &record)
+  { queueStore.enqueued(record); };
+  queueList.onDequeue = []()
+  { queueStore.dequeued(); };
+  queueStore.begin(queueList);
+
+#ifdef SIM7080G_TRACE
+  // Record every byte exchanged with the modem
+  traceFile = LittleFS.open(TRACE_FILE, "w");
+  Sim7080G.trace.begin(traceFile);
+#endif
+
+#ifdef SIM7080G_REPLAY
+  // Answer with a recorded session instead of the modem
+  traceFile = LittleFS.open(TRACE_FILE, "r");
+  if (traceReplay.begin(traceFile))
+    Sim7080G.emulator = &traceReplay;
+#endif
+
+#ifdef SIM7080G_SIMULATOR
+  // Answer with a simulated modem and server instead of the modem
+  simulator.config.track = SIMULATOR_TRACK;
+  simulator.config.trackLength = sizeof(SIMULATOR_TRACK) / sizeof(SIMULATOR_TRACK[0]);
+  simulator.begin();
+  Sim7080G.emulator = &simulator;
+#endif
+
+  geofences.begin(GEOFENCES, sizeof(GEOFENCES) / sizeof(GEOFENCES[0]));
+
   Sim7080G.setup();
+  GNSS.setup();
+  CATM1.setup();
+  TCP.setup();
 }
 
 void loop()
 {
+  Sim7080G.loop();
+
   switch (fsm.currentState)
   {
   case ENTRYPOINT: // Entry point of the FSM
   {
-    Sim7080G.powerOn();
+    if (!Sim7080G.powerOn())
+      break;
+
     fsm.setState(BasicState::START);
   }
   case START: // Start state of the FSM
   {
     // Serial.println(Sim7080G.send_AT_bloquant("AT+GSN", 300));
 
-    AT_RESPONSE response = Sim7080G.sendATCommand("AT+GSN");
+    AT_RESPONSE response = ATCommands::GSN.send(atCommand);
 
     if (response.isFinished)
     {
       response.message = response.message.substring(response.message.indexOf("\r\n") + 2);
       response.message.trim();
-      Sim7080G.imei = response.message.substring(0, 15);
+      Sim7080G.imei = response.message.substring(0, 15).toString();
 
       Serial.printf("IMEI: %s\n", Color::green(Sim7080G.imei));
-      Sim7080G.freeATState();
 
       fsm.setState(BasicState::GET_GNSS_DATA);
       // fsm.setState(BasicState::MODULE_CATM1);
@@ -75,48 +246,46 @@ void loop()
   }
   case GET_GNSS_DATA:
   {
-    if (GNSS.PowerOn())
+    // The engine keeps running and the +UGNSINF reports queue the fixes
+    if (GNSS.useTracking())
     {
-      GNSSResponse response = GNSS.GetData();
-
-      if (response.isFinished)
-      {
-        response.free();
-        if (response.data.fixStatus && (response.data.hdop >= 0.2 && response.data.hdop <= 10) && response.data.hpa <= 20)
-        {
-          Serial.printf("%sGNSS Run Status%s: %d\n", Color::_GRAY, Color::_RESET, response.data.gnssRunStatus);
-          Serial.printf("%sUTC DateTime%s: %s\n", Color::_GRAY, Color::_RESET, response.data.utcDateTime.toString().c_str());
-          Serial.printf("%sLatitude%s: %.6f\n", Color::_GRAY, Color::_RESET, response.data.latitude);
-          Serial.printf("%sLongitude%s: %.6f\n", Color::_GRAY, Color::_RESET, response.data.longitude);
-          Serial.printf("%sFix Status%s: %d\n", Color::_GRAY, Color::_RESET, response.data.fixStatus);
-          queueList.enqueue<GNSSData>(response.data);
-          fsm.setState(BasicState::TURN_OFF_GNSS);
-        }
-      }
+      if (GNSS.StartTracking())
+        fsm.setState(BasicState::PAUSED);
+      break;
+    }
+
+    GNSSData fix;
+
+    switch (GNSS.Acquire(fix))
+    {
+    case GNSS_ACQUIRED:
+      Serial.printf("%sUTC DateTime%s: %s\n", Color::_GRAY, Color::_RESET, fix.utcDateTime.toString().c_str());
+      Serial.printf("%sLatitude%s: %.7f\n", Color::_GRAY, Color::_RESET, Coordinates::toDegrees(fix.latitude));
+      Serial.printf("%sLongitude%s: %.7f\n", Color::_GRAY, Color::_RESET, Coordinates::toDegrees(fix.longitude));
+      Serial.printf("%sAccuracy%s: %.1f m\n", Color::_GRAY, Color::_RESET, fix.hpa);
+      GNSS.queue(fix);
+
+      fsm.setState(BasicState::TURN_OFF_GNSS);
+      break;
+    case GNSS_ACQUISITION_FAILED:
+      // The cell gives a coarse position on the next upload session, started right after
+      Serial.printf("[x] No GNSS fix after %lu s, falling back to the cell position\n", GNSS.acquisitionTimeout / 1000);
+      Cell.pending = true;
+      fsm.setState(BasicState::TURN_OFF_GNSS);
+      break;
+    default:
+      break;
     }
     break;
   }
   case GET_BATTERY_STATUS:
   {
-    AT_RESPONSE response = Sim7080G.sendATCommand("AT+CBC");
-    if (response.isFinished)
-    {
-      BATTERYData batteryData;
-      
-      response.message = response.message.substring(response.message.indexOf(",") + 1);
-      response.message = response.message.substring(0, response.message.indexOf(","));
-      batteryData.batteryLevel = atoi(response.message.c_str());
-      Serial.println(response.message);  
-      Serial.println(batteryData.batteryLevel);  
-
-      
-      Serial.printf("%sBattery status%s: %d%%\n", Color::_GRAY, Color::_RESET, batteryData.batteryLevel);
-      
-      queueList.enqueue<BATTERYData>(batteryData);
-      
-      Sim7080G.freeATState();
-      fsm.setState(BasicState::PAUSED);
-    }
+    if (!Sim7080G.isIdle())
+      break;
+
+    // Not worth a round-trip of its own, it rides along with the next GNSS or network query
+    ATCommands::CBC.submit(onBatteryStatus, BATTERY_HOLD);
+    fsm.setState(BasicState::PAUSED);
     break;
   }
   case TURN_OFF_GNSS:
@@ -129,19 +298,59 @@ void loop()
     break;
   }
   case MODULE_CATM1:
+    // GNSS and CAT-M1 share the RF path, tracking stops for the upload and resumes with a hot start
+    if (!GNSS.PowerOff())
+      break;
+
     CATM1.loop();
     break;
 
   case MODULE_TCP:
+    // Dropped by the network (+APP PDP: 0,DEACTIVE), the socket went with it
+    if (!CATM1.pdpActive && !Sim7080G.isPending(TCP.atCommand))
+    {
+      Serial.println("[x] PDP context dropped, activating it again");
+      TCP.reset();
+      CATM1.fsmCATM1.setState(PDP);
+      fsm.setState(BasicState::MODULE_CATM1);
+      break;
+    }
+
+    // The location service of the network needs the PDP context
+    if (Cell.pending && !Cell.Locate())
+      break;
+
+    // Stale assistance data is refreshed on the upload session, before the socket opens
+    if (GNSS.needsAssistance() && !GNSS.DownloadAssistance())
+      break;
+
+    // Nothing to send once the cell position the session was started for failed
+    if (TCP.fsmTCP.currentState == TCP_OPEN && queueList.isEmpty())
+    {
+      fsm.setState(BasicState::PAUSED);
+      break;
+    }
+
     TCP.loop();
     break;
   case PAUSED:
   {
     static bool init = false;
 
-    if (sendFSM.delay(1000 * 60) && !queueList.isEmpty())
+    // Tracking without a first fix is bounded like a duty cycle sample, the cell gives the position
+    if (GNSS.TrackingFailed())
+    {
+      Serial.printf("[x] No GNSS fix after %lu s of tracking, falling back to the cell position\n", GNSS.acquisitionTimeout / 1000);
+      Cell.pending = true;
+      fsm.setState(BasicState::TURN_OFF_GNSS);
+      break;
+    }
+
+    // A geofence crossing is sent right away, the batch waits for the next minute
+    if (Cell.pending || geofences.alert || (sendFSM.delay(1000 * 60) && !queueList.isEmpty()))
     {
-      Serial.println(queueList.to_json().dump().c_str());
+      geofences.alert = false;
+      Serial.printf("%u items to upload\n", (unsigned)queueList.size());
       fsm.setState(BasicState::MODULE_CATM1);
       break;
     }
@@ -154,7 +363,7 @@ void loop()
       break;
     }
 
-    if (fsm.delay(1000 * 60))
+    if (fsm.delay(GNSS.interval))
     {
       fsm.setState(BasicState::GET_GNSS_DATA);
       break;
@@ -163,15 +372,27 @@ void loop()
     break;
   }
   case STOPPED:
-  {
-    Sim7080G.powerOff();
-  }
   case RESTART:
   {
-    Sim7080G.powerOff();
+    queueStore.flush();
+    if (!Sim7080G.powerOff())
+      break;
+
+    // The handle may still point at a command of the session that ended, START sends AT+GSN again
+    atCommand = ATFuture();
     fsm.setState(BasicState::ENTRYPOINT);
+    break;
   }
   default:
     break;
   }
+
+  queueStore.loop();
+
+#ifdef SIM7080G_SIMULATOR
+  benchmarkCycle();
+#endif
+
+  // Sleep until the modem sends something or the nearest deadline
+  events.wait();
 }
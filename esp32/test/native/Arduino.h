@@ -0,0 +1,430 @@
+#pragma once
+#ifndef NATIVE_ARDUINO_H
+#define NATIVE_ARDUINO_H
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <cstdarg>
+#include <cmath>
+#include <ctime>
+#include <string>
+#include <functional>
+#include <algorithm>
+#include <new>
+
+/**
+ * @brief Subset of the Arduino-ESP32 core the firmware uses, for the native env of platformio.ini
+ *
+ * @details Header only, so that it needs no source filter. Time is virtual: it only moves through delay()
+ * and the wait of the event loop, so a simulated hour runs in a fraction of a second and every run is the same.
+ * Serial prints to stdout; the modem UART is inert, the firmware talks to Sim7080G.emulator instead.
+ */
+
+#define LOW 0x0
+#define HIGH 0x1
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define OUTPUT_OPEN_DRAIN 0x13
+#define SERIAL_8N1 0x800001c
+#define SOC_RX0 20
+#define SOC_TX0 21
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define CONFIG_DISABLE_HAL_LOCKS 1
+
+#define log_e(...)
+#define log_w(...)
+#define log_i(...)
+
+#pragma region Time
+/**
+ * @brief Virtual time of the host build, in milliseconds
+ */
+inline unsigned long nativeTime = 0;
+
+/**
+ * @brief Whether the loop task was notified since its last wait
+ */
+inline bool nativeNotified = false;
+
+inline unsigned long millis() { return nativeTime; }
+inline unsigned long micros() { return nativeTime * 1000; }
+inline void delay(unsigned long ms) { nativeTime += ms; }
+inline void delayMicroseconds(unsigned int) {}
+inline void yield() {}
+#pragma endregion Time
+
+#pragma region FreeRTOS
+typedef void *TaskHandle_t;
+typedef uint32_t TickType_t;
+#define pdTRUE 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+inline TaskHandle_t xTaskGetCurrentTaskHandle() { return &nativeNotified; }
+inline void xTaskNotifyGive(TaskHandle_t) { nativeNotified = true; }
+
+/**
+ * @brief Wait for a notification, the whole timeout passes at once when none is pending
+ */
+inline uint32_t ulTaskNotifyTake(int clear, TickType_t ticks)
+{
+    if (nativeNotified)
+    {
+        nativeNotified = !clear;
+        return 1;
+    }
+
+    nativeTime += ticks;
+    return 0;
+}
+#pragma endregion FreeRTOS
+
+#pragma region GPIO
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t) { return LOW; }
+#pragma endregion GPIO
+
+#pragma region String
+class String
+{
+private:
+    std::string text;
+
+public:
+    String() {}
+    String(const char *value) : text(value != nullptr ? value : "") {}
+    String(const std::string &value) : text(value) {}
+    String(char value) : text(1, value) {}
+    String(int value) : text(std::to_string(value)) {}
+    String(unsigned int value) : text(std::to_string(value)) {}
+    String(long value) : text(std::to_string(value)) {}
+    String(unsigned long value) : text(std::to_string(value)) {}
+    String(long long value) : text(std::to_string(value)) {}
+    String(unsigned long long value) : text(std::to_string(value)) {}
+    String(double value, unsigned int decimals = 2)
+    {
+        char buffer[64];
+        snprintf(buffer, sizeof(buffer), "%.*f", decimals, value);
+        text = buffer;
+    }
+
+    const char *c_str() const { return text.c_str(); }
+    unsigned int length() const { return text.size(); }
+    bool isEmpty() const { return text.empty(); }
+    bool reserve(unsigned int size)
+    {
+        text.reserve(size);
+        return true;
+    }
+
+    char operator[](unsigned int index) const { return index < text.size() ? text[index] : 0; }
+
+    int indexOf(char c, unsigned int from = 0) const
+    {
+        size_t at = text.find(c, from);
+        return at == std::string::npos ? -1 : (int)at;
+    }
+
+    int indexOf(const String &value, unsigned int from = 0) const
+    {
+        size_t at = text.find(value.text, from);
+        return at == std::string::npos ? -1 : (int)at;
+    }
+
+    String substring(unsigned int from) const { return from < text.size() ? String(text.substr(from)) : String(); }
+    String substring(unsigned int from, unsigned int to) const { return from < text.size() && from < to ? String(text.substr(from, to - from)) : String(); }
+
+    bool startsWith(const String &prefix) const { return text.compare(0, prefix.text.size(), prefix.text) == 0; }
+    bool endsWith(const String &suffix) const { return text.size() >= suffix.text.size() && text.compare(text.size() - suffix.text.size(), suffix.text.size(), suffix.text) == 0; }
+
+    void trim()
+    {
+        size_t first = text.find_first_not_of(" \t\r\n");
+        size_t last = text.find_last_not_of(" \t\r\n");
+        text = first == std::string::npos ? std::string() : text.substr(first, last - first + 1);
+    }
+
+    long toInt() const { return atol(text.c_str()); }
+    float toFloat() const { return atof(text.c_str()); }
+
+    String &operator+=(const String &value)
+    {
+        text += value.text;
+        return *this;
+    }
+
+    bool operator==(const String &value) const { return text == value.text; }
+    bool operator!=(const String &value) const { return text != value.text; }
+
+    friend String operator+(const String &left, const String &right) { return String(left.text + right.text); }
+};
+#pragma endregion String
+
+#pragma region Stream
+class Print;
+
+class Printable
+{
+public:
+    virtual ~Printable() {}
+    virtual size_t printTo(Print &p) const = 0;
+};
+
+class Print
+{
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+
+    virtual size_t write(const uint8_t *buffer, size_t size)
+    {
+        size_t count = 0;
+        while (count < size && write(buffer[count]))
+            count++;
+        return count;
+    }
+
+    size_t write(const char *text) { return write((const uint8_t *)text, strlen(text)); }
+    size_t write(const char *buffer, size_t size) { return write((const uint8_t *)buffer, size); }
+
+    virtual int availableForWrite() { return 0; }
+    virtual void flush() {}
+
+    size_t printf(const char *format, ...)
+    {
+        char buffer[256];
+        va_list args;
+
+        va_start(args, format);
+        int length = vsnprintf(buffer, sizeof(buffer), format, args);
+        va_end(args);
+
+        if (length < 0)
+            return 0;
+
+        if ((size_t)length < sizeof(buffer))
+            return write((const uint8_t *)buffer, length);
+
+        std::string text(length, '\0');
+        va_start(args, format);
+        vsnprintf(&text[0], length + 1, format, args);
+        va_end(args);
+
+        return write((const uint8_t *)text.data(), length);
+    }
+
+    size_t print(const char *text) { return write(text); }
+    size_t print(const String &text) { return write(text.c_str()); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int value, int base = 10) { return print((long)value, base); }
+    size_t print(unsigned int value, int base = 10) { return print((unsigned long)value, base); }
+    size_t print(long value, int base = 10) { return base == 16 ? printf("%lx", value) : printf("%ld", value); }
+    size_t print(unsigned long value, int base = 10) { return base == 16 ? printf("%lx", value) : printf("%lu", value); }
+    size_t print(double value, int decimals = 2) { return printf("%.*f", decimals, value); }
+    size_t print(const Printable &value) { return value.printTo(*this); }
+
+    size_t println() { return write("\r\n"); }
+
+    template <typename T>
+    size_t println(const T &value)
+    {
+        size_t count = print(value);
+        return count + println();
+    }
+};
+
+class Stream : public Print
+{
+protected:
+    unsigned long _timeout = 1000;
+
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    void setTimeout(unsigned long timeout) { _timeout = timeout; }
+
+    size_t readBytes(uint8_t *buffer, size_t length)
+    {
+        size_t count = 0;
+
+        for (int c; count < length && (c = read()) >= 0;)
+            buffer[count++] = c;
+
+        return count;
+    }
+
+    size_t readBytes(char *buffer, size_t length) { return readBytes((uint8_t *)buffer, length); }
+};
+#pragma endregion Stream
+
+#pragma region HardwareSerial
+struct uart_t;
+typedef void *SemaphoreHandle_t;
+typedef std::function<void(void)> OnReceiveCb;
+typedef std::function<void(int)> OnReceiveErrorCb;
+
+inline void uartSetPins(int, int, int, int, int) {}
+
+/**
+ * @brief Drop the prints of UART 0, e.g. while a benchmark times the firmware
+ */
+inline bool nativeSerialMuted = false;
+
+/**
+ * @brief UART 0 prints to stdout, the others take nothing and give nothing
+ */
+class HardwareSerial : public Stream
+{
+protected:
+    uint8_t _uart_nr;
+    uart_t *_uart = nullptr;
+    size_t _rxBufferSize = 0;
+    size_t _txBufferSize = 0;
+    OnReceiveCb _onReceiveCB;
+    OnReceiveErrorCb _onReceiveErrorCB;
+    bool _onReceiveTimeout = false;
+    uint8_t _rxTimeout = 0;
+    uint8_t _rxFIFOFull = 0;
+    TaskHandle_t _eventTask = nullptr;
+    unsigned long _baud = 0;
+
+public:
+    HardwareSerial(uint8_t uart_nr) : _uart_nr(uart_nr) {}
+
+    void begin(unsigned long baud, uint32_t config = SERIAL_8N1, int8_t rxPin = -1, int8_t txPin = -1, bool invert = false, unsigned long timeout_ms = 20000UL, uint8_t rxfifo_full_thrhd = 112) { _baud = baud; }
+    void end(bool fullyTerminate = true) {}
+    void updateBaudRate(unsigned long baud) { _baud = baud; }
+    uint32_t baudRate() { return _baud; }
+
+    void onReceive(OnReceiveCb function, bool onlyOnTimeout = false) { _onReceiveCB = function; }
+    size_t setRxBufferSize(size_t size) { return _rxBufferSize = size; }
+    size_t setTxBufferSize(size_t size) { return _txBufferSize = size; }
+
+    int available() override { return 0; }
+    int availableForWrite() override { return 128; }
+    int peek() override { return -1; }
+    int read() override { return -1; }
+    size_t read(uint8_t *buffer, size_t size) { return 0; }
+    size_t read(char *buffer, size_t size) { return 0; }
+    void flush() override { fflush(stdout); }
+    void flush(bool txOnly) { flush(); }
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t *buffer, size_t size) override { return _uart_nr == 0 && !nativeSerialMuted ? fwrite(buffer, 1, size, stdout) : size; }
+    using Print::write;
+
+    operator bool() const { return true; }
+};
+
+inline HardwareSerial Serial(0);
+inline HardwareSerial Serial1(1);
+#pragma endregion HardwareSerial
+
+#pragma region ESP
+inline long random(long max) { return max > 0 ? rand() % max : 0; }
+inline long random(long min, long max) { return max > min ? min + rand() % (max - min) : min; }
+inline void randomSeed(unsigned long seed) { srand(seed); }
+
+/**
+ * @brief Heap of the ESP32-C3 left to the sketch, in bytes
+ */
+#define NATIVE_HEAP_SIZE (320 * 1024)
+
+/**
+ * @brief Allocations of the host build, counted by the operator new below
+ *
+ * @details The firmware allocates through new only, String and nlohmann::json included. The shims count too,
+ * the LittleFS files first of all: compare peaks above the level at the start of what is measured.
+ */
+struct NativeHeap
+{
+    size_t used;
+
+    /**
+     * @brief Most bytes in use since boot, as ESP.getMinFreeHeap(), and since mark()
+     */
+    size_t peak;
+    size_t markPeak;
+
+    /**
+     * @brief Calls of operator new since boot
+     */
+    uint32_t allocations;
+
+    /**
+     * @brief Start measuring a peak from the bytes in use now
+     */
+    void mark() { markPeak = used; }
+};
+
+inline NativeHeap nativeHeap = {};
+
+/**
+ * @brief Size kept in front of each block, aligned like the block itself
+ */
+#define NATIVE_HEAP_HEADER alignof(std::max_align_t)
+
+// Replacements of the global operator new and delete may not be inline. Weak, their copies in every
+// translation unit that includes this header make a single definition at link time
+__attribute__((weak)) void *operator new(size_t size)
+{
+    uint8_t *block = (uint8_t *)malloc(size + NATIVE_HEAP_HEADER);
+    if (block == nullptr)
+        throw std::bad_alloc();
+
+    *(size_t *)block = size;
+    nativeHeap.used += size;
+    nativeHeap.allocations++;
+    nativeHeap.peak = nativeHeap.used > nativeHeap.peak ? nativeHeap.used : nativeHeap.peak;
+    nativeHeap.markPeak = nativeHeap.used > nativeHeap.markPeak ? nativeHeap.used : nativeHeap.markPeak;
+    return block + NATIVE_HEAP_HEADER;
+}
+
+__attribute__((weak)) void operator delete(void *pointer) noexcept
+{
+    if (pointer == nullptr)
+        return;
+
+    uint8_t *block = (uint8_t *)pointer - NATIVE_HEAP_HEADER;
+    nativeHeap.used -= *(size_t *)block;
+    free(block);
+}
+
+__attribute__((weak)) void *operator new[](size_t size) { return operator new(size); }
+__attribute__((weak)) void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+    try
+    {
+        return operator new(size);
+    }
+    catch (const std::bad_alloc &)
+    {
+        return nullptr;
+    }
+}
+__attribute__((weak)) void *operator new[](size_t size, const std::nothrow_t &) noexcept { return operator new(size, std::nothrow); }
+__attribute__((weak)) void operator delete[](void *pointer) noexcept { operator delete(pointer); }
+__attribute__((weak)) void operator delete(void *pointer, size_t) noexcept { operator delete(pointer); }
+__attribute__((weak)) void operator delete[](void *pointer, size_t) noexcept { operator delete(pointer); }
+__attribute__((weak)) void operator delete(void *pointer, const std::nothrow_t &) noexcept { operator delete(pointer); }
+__attribute__((weak)) void operator delete[](void *pointer, const std::nothrow_t &) noexcept { operator delete(pointer); }
+
+/**
+ * @brief Heap figures of the ESP32, from the allocations of the host build
+ */
+class EspClass
+{
+public:
+    uint32_t getHeapSize() { return NATIVE_HEAP_SIZE; }
+    uint32_t getFreeHeap() { return nativeHeap.used < NATIVE_HEAP_SIZE ? NATIVE_HEAP_SIZE - nativeHeap.used : 0; }
+    uint32_t getMinFreeHeap() { return nativeHeap.peak < NATIVE_HEAP_SIZE ? NATIVE_HEAP_SIZE - nativeHeap.peak : 0; }
+};
+
+inline EspClass ESP;
+#pragma endregion ESP
+
+#endif // NATIVE_ARDUINO_H
@@ -0,0 +1,157 @@
+#pragma once
+#ifndef NATIVE_LITTLEFS_H
+#define NATIVE_LITTLEFS_H
+#include <Arduino.h>
+#include <map>
+#include <set>
+#include <string>
+
+class LittleFSFS;
+
+/**
+ * @brief File of the in-memory file system, opened by LittleFSFS::open()
+ */
+class File : public Stream
+{
+private:
+    LittleFSFS *fs = nullptr;
+    std::string path;
+    size_t position = 0;
+    bool directory = false;
+
+    /**
+     * @brief Last entry returned by openNextFile()
+     */
+    std::string next;
+
+    std::string &data() const;
+
+public:
+    File() {}
+    File(LittleFSFS *fs, const std::string &path, bool directory, size_t position) : fs(fs), path(path), position(position), directory(directory) {}
+
+    operator bool() const { return fs != nullptr; }
+    bool isDirectory() const { return directory; }
+    const char *name() const { return path.c_str(); }
+    size_t size() const { return fs != nullptr && !directory ? data().size() : 0; }
+    void close() { fs = nullptr; }
+
+    int available() override { return fs != nullptr && !directory ? (int)(data().size() - position) : 0; }
+    int peek() override { return available() > 0 ? (uint8_t)data()[position] : -1; }
+    int read() override { return available() > 0 ? (uint8_t)data()[position++] : -1; }
+    size_t read(uint8_t *buffer, size_t size) { return readBytes(buffer, size); }
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t *buffer, size_t size) override;
+    using Print::write;
+
+    File openNextFile();
+};
+
+/**
+ * @brief LittleFS kept in memory, its content is public so that a test can tear or corrupt a file
+ */
+class LittleFSFS
+{
+public:
+    /**
+     * @brief Content of each file, by path
+     */
+    std::map<std::string, std::string> files;
+    std::set<std::string> directories;
+
+    /**
+     * @brief Bytes the next writes may still store, -1 without limit, a write past it comes back short like on a full flash
+     */
+    long writeBudget = -1;
+
+    /**
+     * @brief Writes and bytes written since the start
+     */
+    unsigned long writes = 0;
+    unsigned long bytesWritten = 0;
+
+    bool begin(bool formatOnFail = false) { return true; }
+
+    void format()
+    {
+        files.clear();
+        directories.clear();
+    }
+
+    bool exists(const char *path) const { return files.count(path) > 0 || directories.count(path) > 0; }
+
+    bool mkdir(const char *path)
+    {
+        directories.insert(path);
+        return true;
+    }
+
+    bool remove(const char *path) { return files.erase(path) > 0; }
+
+    bool rename(const char *from, const char *to)
+    {
+        auto file = files.find(from);
+        if (file == files.end())
+            return false;
+
+        files[to] = file->second;
+        files.erase(from);
+        return true;
+    }
+
+    File open(const char *path, const char *mode = "r")
+    {
+        if (directories.count(path) > 0)
+            return File(this, path, true, 0);
+
+        if (mode[0] == 'r' && files.count(path) == 0)
+            return File();
+
+        if (mode[0] == 'w')
+            files[path].clear();
+
+        return File(this, path, false, mode[0] == 'a' ? files[path].size() : 0);
+    }
+};
+
+inline LittleFSFS LittleFS;
+
+inline std::string &File::data() const { return fs->files[path]; }
+
+inline size_t File::write(const uint8_t *buffer, size_t size)
+{
+    if (fs == nullptr || directory)
+        return 0;
+
+    if (fs->writeBudget >= 0)
+    {
+        size = (long)size < fs->writeBudget ? size : fs->writeBudget;
+        fs->writeBudget -= size;
+    }
+
+    std::string &content = data();
+    content.replace(position, std::min(size, content.size() - position), (const char *)buffer, size);
+    position += size;
+
+    fs->writes++;
+    fs->bytesWritten += size;
+    return size;
+}
+
+inline File File::openNextFile()
+{
+    if (fs == nullptr || !directory)
+        return File();
+
+    std::string prefix = path + "/";
+    auto entry = fs->files.upper_bound(next.empty() ? prefix : next);
+
+    if (entry == fs->files.end() || entry->first.compare(0, prefix.size(), prefix) != 0)
+        return File();
+
+    next = entry->first;
+    return File(fs, entry->first, false, 0);
+}
+
+#endif // NATIVE_LITTLEFS_H
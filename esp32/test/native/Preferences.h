@@ -0,0 +1,70 @@
+#pragma once
+#ifndef NATIVE_PREFERENCES_H
+#define NATIVE_PREFERENCES_H
+#include <Arduino.h>
+#include <map>
+#include <string>
+
+/**
+ * @brief NVS kept in memory, shared by every Preferences like the flash partition
+ */
+inline std::map<std::string, std::string> nativeNVS;
+
+class Preferences
+{
+private:
+    std::string space;
+
+    std::string key(const char *name) const { return space + "/" + name; }
+
+public:
+    bool begin(const char *name, bool readOnly = false)
+    {
+        space = name;
+        return true;
+    }
+
+    void end() {}
+
+    bool clear()
+    {
+        for (auto entry = nativeNVS.begin(); entry != nativeNVS.end();)
+            entry = entry->first.compare(0, space.size() + 1, space + "/") == 0 ? nativeNVS.erase(entry) : std::next(entry);
+        return true;
+    }
+
+    bool isKey(const char *name) const { return nativeNVS.count(key(name)) > 0; }
+    bool remove(const char *name) { return nativeNVS.erase(key(name)) > 0; }
+
+    size_t putBytes(const char *name, const void *value, size_t length)
+    {
+        nativeNVS[key(name)].assign((const char *)value, length);
+        return length;
+    }
+
+    size_t getBytesLength(const char *name) const
+    {
+        auto entry = nativeNVS.find(key(name));
+        return entry == nativeNVS.end() ? 0 : entry->second.size();
+    }
+
+    size_t getBytes(const char *name, void *buffer, size_t length) const
+    {
+        auto entry = nativeNVS.find(key(name));
+        if (entry == nativeNVS.end() || entry->second.size() > length)
+            return 0;
+
+        memcpy(buffer, entry->second.data(), entry->second.size());
+        return entry->second.size();
+    }
+
+    size_t putUInt(const char *name, uint32_t value) { return putBytes(name, &value, sizeof(value)); }
+
+    uint32_t getUInt(const char *name, uint32_t defaultValue = 0) const
+    {
+        uint32_t value = defaultValue;
+        return getBytes(name, &value, sizeof(value)) == sizeof(value) ? value : defaultValue;
+    }
+};
+
+#endif // NATIVE_PREFERENCES_H
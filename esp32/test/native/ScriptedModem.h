@@ -0,0 +1,96 @@
+#pragma once
+#ifndef NATIVE_SCRIPTED_MODEM_H
+#define NATIVE_SCRIPTED_MODEM_H
+#include <Arduino.h>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Modem answering each command line with a scripted reply, set as Sim7080G.emulator by the tests of the AT layer
+ *
+ * @details A line without a reply is left unanswered, to run into the timeout. The reply becomes readable latency
+ * milliseconds after the end of the line, as a whole.
+ */
+class ScriptedModem : public Stream
+{
+private:
+    std::map<std::string, std::string> replies;
+    std::string line;
+    std::string output;
+    size_t outputStart = 0;
+
+    /**
+     * @brief Time (millis) the pending output becomes readable
+     */
+    unsigned long answerAt = 0;
+
+public:
+    /**
+     * @brief Time between the end of a line and its reply, in milliseconds
+     */
+    unsigned long latency = 20;
+
+    /**
+     * @brief Command lines received, in order, without their line ending
+     */
+    std::vector<std::string> commands;
+
+    /**
+     * @brief Script the reply to a command line
+     *
+     * @param command Line as written by the firmware, e.g. "AT+GSN"
+     * @param reply Bytes sent back, line endings included
+     */
+    void reply(const char *command, const char *reply) { replies[command] = reply; }
+
+    /**
+     * @brief Send bytes on its own, e.g. a URC, readable after the latency
+     */
+    void push(const char *text)
+    {
+        output += text;
+        answerAt = millis() + latency;
+    }
+
+    /**
+     * @brief Forget the script, the commands received and the output not read
+     */
+    void clear()
+    {
+        replies.clear();
+        commands.clear();
+        line.clear();
+        output.clear();
+        outputStart = 0;
+    }
+
+    int available() override { return (long)(millis() - answerAt) >= 0 ? (int)(output.size() - outputStart) : 0; }
+    int peek() override { return available() > 0 ? (uint8_t)output[outputStart] : -1; }
+    int read() override { return available() > 0 ? (uint8_t)output[outputStart++] : -1; }
+
+    size_t write(uint8_t c) override
+    {
+        if (c == '\n')
+            return 1;
+
+        if (c != '\r')
+        {
+            line += (char)c;
+            return 1;
+        }
+
+        commands.push_back(line);
+
+        auto entry = replies.find(line);
+        if (entry != replies.end())
+            push(entry->second.c_str());
+
+        line.clear();
+        return 1;
+    }
+
+    using Print::write;
+};
+
+#endif // NATIVE_SCRIPTED_MODEM_H
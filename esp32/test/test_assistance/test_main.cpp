@@ -0,0 +1,206 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <Preferences.h>
+#include <EventLoop.hpp>
+#include <SIM7080G/Serial.hpp>
+#include <SIM7080G/GNSS.hpp>
+#include <ScriptedModem.h>
+
+/**
+ * @brief Commands of the XTRA download, and the answers of the modem standing in for the HTTP server
+ */
+#define DOWNLOAD "AT+HTTPTOFS=\"" GNSS_XTRA_URL "\",\"" GNSS_XTRA_FILE "\""
+#define COPY "AT+CGNSCPY"
+#define ENABLE "AT+CGNSXTRA=1"
+
+static const char DOWNLOADED[] = "\r\nOK\r\n\r\n+HTTPTOFS: 200,37876\r\n";
+static const char NOT_FOUND[] = "\r\nOK\r\n\r\n+HTTPTOFS: 404,0\r\n";
+/**
+ * @brief DNS error, e.g. the PDP context dropped
+ */
+static const char DNS_ERROR[] = "\r\nOK\r\n\r\n+HTTPTOFS: 603,0\r\n";
+static const char OK[] = "\r\nOK\r\n";
+
+#define HOUR (1000UL * 60 * 60)
+
+static ScriptedModem modem;
+
+/**
+ * @brief Time of the fixes of the tests
+ */
+static const DateTime NOON(2024, 6, 1, 12, 0, 0, 0);
+
+/**
+ * @brief Reset the collar, the flash and the modem keep their content
+ */
+static void reboot()
+{
+    GNSS = SIM7080GGNSS();
+    GNSS.setup();
+}
+
+/**
+ * @brief Run DownloadAssistance() and the loop until it is finished
+ */
+static void download()
+{
+    while (!GNSS.DownloadAssistance())
+    {
+        Sim7080G.loop();
+        events.wait();
+    }
+}
+
+static void scriptDownload(const char *answer)
+{
+    modem.reply(DOWNLOAD, answer);
+    modem.reply(COPY, OK);
+    modem.reply(ENABLE, OK);
+}
+
+/**
+ * @brief End of the XTRA data written to flash, in Unix time
+ */
+static uint32_t storedExpiry()
+{
+    Preferences preferences;
+    preferences.begin("gnss", true);
+    return preferences.getUInt("xtra", 0);
+}
+
+void setUp()
+{
+    modem.clear();
+    Sim7080G.emulator = &modem;
+    Sim7080G.linkState = LINK_READY;
+    nativeNVS.clear();
+
+    while (!Sim7080G.isIdle())
+    {
+        Sim7080G.loop();
+        events.wait();
+    }
+
+    reboot();
+}
+
+void tearDown() {}
+
+void test_download_injects_the_data()
+{
+    GNSS.setClock(NOON);
+    scriptDownload(DOWNLOADED);
+
+    TEST_ASSERT_TRUE(GNSS.needsAssistance());
+    download();
+
+    TEST_ASSERT_FALSE(GNSS.needsAssistance());
+    TEST_ASSERT_EQUAL(3, modem.commands.size());
+    TEST_ASSERT_EQUAL_STRING(DOWNLOAD, modem.commands[0].c_str());
+    TEST_ASSERT_EQUAL_STRING(COPY, modem.commands[1].c_str());
+    TEST_ASSERT_EQUAL_STRING(ENABLE, modem.commands[2].c_str());
+
+    // Within the time the commands took
+    TEST_ASSERT_UINT32_WITHIN(2, NOON.toUnixTime() + GNSS_XTRA_VALIDITY / 1000, storedExpiry());
+}
+
+void test_failed_download_is_retried_later()
+{
+    GNSS.setClock(NOON);
+    scriptDownload(DNS_ERROR);
+
+    download();
+
+    // Neither copied nor injected, and not tried again on every session
+    TEST_ASSERT_EQUAL(1, modem.commands.size());
+    TEST_ASSERT_FALSE(GNSS.needsAssistance());
+    TEST_ASSERT_EQUAL(0, storedExpiry());
+
+    delay(GNSS_XTRA_RETRY / 2);
+    TEST_ASSERT_FALSE(GNSS.needsAssistance());
+
+    delay(GNSS_XTRA_RETRY / 2);
+    TEST_ASSERT_TRUE(GNSS.needsAssistance());
+
+    // Answered by the server, but not with the data
+    modem.reply(DOWNLOAD, NOT_FOUND);
+    download();
+    TEST_ASSERT_EQUAL(2, modem.commands.size());
+    TEST_ASSERT_FALSE(GNSS.needsAssistance());
+
+    delay(GNSS_XTRA_RETRY);
+    modem.reply(DOWNLOAD, DOWNLOADED);
+    download();
+
+    TEST_ASSERT_EQUAL(5, modem.commands.size());
+    TEST_ASSERT_FALSE(GNSS.needsAssistance());
+    TEST_ASSERT_NOT_EQUAL(0, storedExpiry());
+}
+
+void test_data_of_a_previous_boot_is_kept()
+{
+    GNSS.setClock(NOON);
+    scriptDownload(DOWNLOADED);
+    download();
+
+    // Reset a day later, the data is valid until its last GNSS_XTRA_REFRESH
+    delay(HOUR);
+    reboot();
+    GNSS.setClock(DateTime::fromUnixTime(NOON.toUnixTime() + 24 * 60 * 60));
+    TEST_ASSERT_FALSE(GNSS.needsAssistance());
+
+    delay(GNSS_XTRA_VALIDITY - GNSS_XTRA_REFRESH - 24 * HOUR - HOUR);
+    TEST_ASSERT_FALSE(GNSS.needsAssistance());
+
+    delay(HOUR);
+    TEST_ASSERT_TRUE(GNSS.needsAssistance());
+}
+
+void test_expired_data_of_a_previous_boot_is_downloaded_again()
+{
+    GNSS.setClock(NOON);
+    scriptDownload(DOWNLOADED);
+    download();
+
+    // The collar was off for three days, the uptime starts over
+    reboot();
+    TEST_ASSERT_TRUE(GNSS.needsAssistance());
+
+    GNSS.setClock(DateTime::fromUnixTime(NOON.toUnixTime() + 3 * 24 * 60 * 60));
+    TEST_ASSERT_TRUE(GNSS.needsAssistance());
+}
+
+void test_expiry_is_saved_once_the_clock_is_known()
+{
+    // No fix yet when the data was injected
+    scriptDownload(DOWNLOADED);
+    download();
+    TEST_ASSERT_FALSE(GNSS.needsAssistance());
+    TEST_ASSERT_EQUAL(0, storedExpiry());
+
+    delay(HOUR);
+    GNSS.setClock(NOON);
+    TEST_ASSERT_UINT32_WITHIN(2, NOON.toUnixTime() + GNSS_XTRA_VALIDITY / 1000 - HOUR / 1000, storedExpiry());
+}
+
+void test_clock_before_the_first_fix_is_ignored()
+{
+    scriptDownload(DOWNLOADED);
+    download();
+
+    // The modem reports its epoch until it has a fix
+    GNSS.setClock(DateTime(1980, 1, 6, 0, 0, 0, 0));
+    TEST_ASSERT_EQUAL(0, storedExpiry());
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_download_injects_the_data);
+    RUN_TEST(test_failed_download_is_retried_later);
+    RUN_TEST(test_data_of_a_previous_boot_is_kept);
+    RUN_TEST(test_expired_data_of_a_previous_boot_is_downloaded_again);
+    RUN_TEST(test_expiry_is_saved_once_the_clock_is_known);
+    RUN_TEST(test_clock_before_the_first_fix_is_ignored);
+    return UNITY_END();
+}
@@ -0,0 +1,221 @@
+#include <unity.h>
+#include <string>
+#include <vector>
+#include <Arduino.h>
+#include <EventLoop.hpp>
+#include <SIM7080G/Serial.hpp>
+#include <SIM7080G/ATCommands.hpp>
+#include <ScriptedModem.h>
+
+/**
+ * @brief Read-only queries queued together share one command line, each one gets its own lines back
+ *
+ * @details A query run on its own gets the whole response, a chained one only its information lines.
+ */
+
+static ScriptedModem modem;
+
+static const char BATTERY[] = "+CBC: 0,85,4012";
+static const char FIX[] = "+CGNSINF: 1,1,20240601120000.000,45.764043,4.835659,170.000,0.00,0.0,1,,1.1,1.4,0.9,,12,8,,,35,2.4,3.1";
+
+/**
+ * @brief Responses given to the completion callbacks, in order
+ */
+static std::vector<AT_RESPONSE> completed;
+static std::vector<std::string> completedLines;
+
+static void onComplete(const AT_RESPONSE &response)
+{
+    completed.push_back(response);
+    completedLines.push_back(response.message.toString().c_str());
+}
+
+/**
+ * @brief Queue AT+CBC at the priority of AT+CGNSINF, so that the older one leads the line
+ */
+static ATFuture submitBattery()
+{
+    ATFuture future = Sim7080G.submit(ATCommands::CBC.pattern, ATCommands::CBC.timeout);
+    Sim7080G.setChaining(future, ATCommands::CBC.expected);
+    return future;
+}
+
+static ATFuture submitFix()
+{
+    ATFuture future = Sim7080G.submit(ATCommands::CGNSINF.pattern, ATCommands::CGNSINF.timeout);
+    Sim7080G.setChaining(future, ATCommands::CGNSINF.expected);
+    return future;
+}
+
+/**
+ * @brief Longest a test waits for a command, a query sent over and over fails instead of hanging
+ */
+#define WAIT_LIMIT (1000UL * 30)
+
+/**
+ * @brief Run the loop until the command is finished
+ */
+static AT_RESPONSE wait(ATFuture &future)
+{
+    AT_RESPONSE response;
+    unsigned long start = millis();
+
+    while (!(response = Sim7080G.poll(future)).isFinished && millis() - start < WAIT_LIMIT)
+    {
+        Sim7080G.loop();
+        events.wait();
+    }
+
+    TEST_ASSERT_TRUE(response.isFinished);
+    return response;
+}
+
+/**
+ * @brief Run the loop for some time
+ */
+static void run(unsigned long time)
+{
+    unsigned long end = millis() + time;
+
+    while ((long)(millis() - end) < 0)
+    {
+        Sim7080G.loop();
+        events.wait();
+    }
+}
+
+void setUp()
+{
+    modem.clear();
+    Sim7080G.emulator = &modem;
+    Sim7080G.linkState = LINK_READY;
+    completed.clear();
+    completedLines.clear();
+
+    unsigned long start = millis();
+    while (!Sim7080G.isIdle() && millis() - start < WAIT_LIMIT)
+    {
+        Sim7080G.loop();
+        events.wait();
+    }
+}
+
+void tearDown() {}
+
+void test_chained_response_is_split()
+{
+    modem.reply("AT+CBC;+CGNSINF", (std::string("\r\n") + BATTERY + "\r\n\r\n" + FIX + "\r\n\r\nOK\r\n").c_str());
+
+    ATFuture battery = submitBattery();
+    ATFuture fix = submitFix();
+
+    AT_RESPONSE batteryResponse = wait(battery);
+    std::string batteryLine = batteryResponse.message.toString().c_str();
+    AT_RESPONSE fixResponse = wait(fix);
+
+    TEST_ASSERT_EQUAL(1, modem.commands.size());
+    TEST_ASSERT_EQUAL_STRING("AT+CBC;+CGNSINF", modem.commands[0].c_str());
+
+    TEST_ASSERT_EQUAL(AT_OK, batteryResponse.status);
+    TEST_ASSERT_EQUAL_STRING(BATTERY, batteryLine.c_str());
+    TEST_ASSERT_EQUAL(AT_OK, fixResponse.status);
+    TEST_ASSERT_EQUAL_STRING(FIX, fixResponse.message.toString().c_str());
+}
+
+void test_error_requeues_the_unanswered_query()
+{
+    // AT+CBC answered, AT+CGNSINF failed
+    modem.reply("AT+CBC;+CGNSINF", (std::string("\r\n") + BATTERY + "\r\n\r\nERROR\r\n").c_str());
+    modem.reply("AT+CGNSINF", "\r\nERROR\r\n");
+
+    ATFuture battery = submitBattery();
+    ATFuture fix = submitFix();
+
+    AT_RESPONSE batteryResponse = wait(battery);
+    std::string batteryLine = batteryResponse.message.toString().c_str();
+    AT_RESPONSE fixResponse = wait(fix);
+
+    TEST_ASSERT_EQUAL(AT_OK, batteryResponse.status);
+    TEST_ASSERT_EQUAL_STRING(BATTERY, batteryLine.c_str());
+
+    // Sent again on its own, the error is its own
+    TEST_ASSERT_EQUAL(2, modem.commands.size());
+    TEST_ASSERT_EQUAL_STRING("AT+CGNSINF", modem.commands[1].c_str());
+    TEST_ASSERT_EQUAL(AT_ERROR, fixResponse.status);
+}
+
+void test_error_of_the_first_query_requeues_both()
+{
+    modem.reply("AT+CBC;+CGNSINF", "\r\nERROR\r\n");
+    modem.reply("AT+CBC", "\r\nERROR\r\n");
+    modem.reply("AT+CGNSINF", (std::string("\r\n") + FIX + "\r\n\r\nOK\r\n").c_str());
+
+    ATFuture battery = submitBattery();
+    ATFuture fix = submitFix();
+
+    AT_RESPONSE batteryResponse = wait(battery);
+    AT_RESPONSE fixResponse = wait(fix);
+
+    TEST_ASSERT_EQUAL(3, modem.commands.size());
+    TEST_ASSERT_EQUAL_STRING("AT+CBC", modem.commands[1].c_str());
+    TEST_ASSERT_EQUAL_STRING("AT+CGNSINF", modem.commands[2].c_str());
+    TEST_ASSERT_EQUAL(AT_ERROR, batteryResponse.status);
+    TEST_ASSERT_EQUAL(AT_OK, fixResponse.status);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, fixResponse.message.indexOf(FIX));
+}
+
+void test_held_query_rides_along_with_the_next_one()
+{
+    modem.reply("AT+CGNSINF;+CBC", (std::string("\r\n") + FIX + "\r\n\r\n" + BATTERY + "\r\n\r\nOK\r\n").c_str());
+
+    TEST_ASSERT_TRUE(ATCommands::CBC.submit(onComplete, 5000));
+
+    // Waiting for a query to join, it does not keep the modem busy
+    run(1000);
+    TEST_ASSERT_EQUAL(0, modem.commands.size());
+    TEST_ASSERT_TRUE(Sim7080G.isIdle());
+
+    ATFuture fix = submitFix();
+    AT_RESPONSE fixResponse = wait(fix);
+
+    TEST_ASSERT_EQUAL(1, modem.commands.size());
+    TEST_ASSERT_EQUAL_STRING("AT+CGNSINF;+CBC", modem.commands[0].c_str());
+    TEST_ASSERT_EQUAL_STRING(FIX, fixResponse.message.toString().c_str());
+    TEST_ASSERT_EQUAL(1, completed.size());
+    TEST_ASSERT_EQUAL(AT_OK, completed[0].status);
+    TEST_ASSERT_EQUAL_STRING(BATTERY, completedLines[0].c_str());
+}
+
+void test_held_query_runs_alone_once_the_hold_expires()
+{
+    modem.reply("AT+CBC", (std::string("\r\n") + BATTERY + "\r\n\r\nOK\r\n").c_str());
+
+    unsigned long start = millis();
+    TEST_ASSERT_TRUE(ATCommands::CBC.submit(onComplete, 5000));
+
+    run(4900);
+    TEST_ASSERT_EQUAL(0, modem.commands.size());
+
+    while (completed.empty() && millis() - start < WAIT_LIMIT)
+    {
+        Sim7080G.loop();
+        events.wait();
+    }
+
+    TEST_ASSERT_GREATER_OR_EQUAL(5000, millis() - start);
+    TEST_ASSERT_EQUAL(1, modem.commands.size());
+    TEST_ASSERT_EQUAL_STRING("AT+CBC", modem.commands[0].c_str());
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, completedLines[0].find(BATTERY));
+    TEST_ASSERT_TRUE(Sim7080G.isIdle());
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_chained_response_is_split);
+    RUN_TEST(test_error_requeues_the_unanswered_query);
+    RUN_TEST(test_error_of_the_first_query_requeues_both);
+    RUN_TEST(test_held_query_rides_along_with_the_next_one);
+    RUN_TEST(test_held_query_runs_alone_once_the_hold_expires);
+    return UNITY_END();
+}
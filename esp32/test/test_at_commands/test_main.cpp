@@ -0,0 +1,110 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <climits>
+#include <SIM7080G/ATCommands.hpp>
+
+// A pattern that does not match its argument types does not compile, the check itself is constexpr
+static_assert(isValidATPattern("AT+CASEND=%d,%d", "dd"), "two integers");
+static_assert(isValidATPattern("AT+CAOPEN=%d,%d,%q,%q,%d", "ddqqd"), "integers and quoted strings");
+static_assert(isValidATPattern("AT+GSN", ""), "no argument");
+static_assert(!isValidATPattern("AT+CASEND=%d", "dd"), "missing placeholder");
+static_assert(!isValidATPattern("AT+CASEND=%d,%d", "d"), "extra placeholder");
+static_assert(!isValidATPattern("AT+CASEND=%q", "d"), "wrong placeholder");
+static_assert(!isValidATPattern("CASEND=%d", "d"), "no AT prefix");
+static_assert(!isValidATPattern("AT+GSN\r\n", ""), "line ending");
+
+void setUp() {}
+void tearDown() {}
+
+void test_format_integers()
+{
+    char command[SIM7080G_COMMAND_SIZE];
+
+    TEST_ASSERT_TRUE(ATCommands::CASEND.format(command, 0, 1234));
+    TEST_ASSERT_EQUAL_STRING("AT+CASEND=0,1234", command);
+
+    TEST_ASSERT_TRUE(ATCommands::IPR.format(command, 921600L));
+    TEST_ASSERT_EQUAL_STRING("AT+IPR=921600", command);
+}
+
+void test_format_extreme_integers()
+{
+    char buffer[32];
+    const ATArgument low[] = {ATArgument(LONG_MIN)};
+    const ATArgument zero[] = {ATArgument(0)};
+
+    TEST_ASSERT_TRUE(formatATCommand(buffer, sizeof(buffer), "AT+X=%d", low, 1));
+    char expected[32];
+    snprintf(expected, sizeof(expected), "AT+X=%ld", LONG_MIN);
+    TEST_ASSERT_EQUAL_STRING(expected, buffer);
+
+    TEST_ASSERT_TRUE(formatATCommand(buffer, sizeof(buffer), "AT+X=%d", zero, 1));
+    TEST_ASSERT_EQUAL_STRING("AT+X=0", buffer);
+}
+
+void test_format_quoted_and_raw_text()
+{
+    char command[SIM7080G_COMMAND_SIZE];
+
+    TEST_ASSERT_TRUE(ATCommands::CAOPEN.format(command, 0, 0, Quoted{"TCP"}, Quoted{"2.tcp.eu.ngrok.io"}, 12596));
+    TEST_ASSERT_EQUAL_STRING("AT+CAOPEN=0,0,\"TCP\",\"2.tcp.eu.ngrok.io\",12596", command);
+
+    TEST_ASSERT_TRUE(ATCommands::CATM1_CONFIGURE.format(command, Quoted{"iot.1nce.net"}, "\"1nce\",\"pw\""));
+    TEST_ASSERT_EQUAL_STRING("AT+CNMP=38;+CMNB=1;+CNACT=0,0;+CGDCONT=1,\"IP\",\"iot.1nce.net\";+CNCFG=0,1,\"1nce\",\"pw\"", command);
+}
+
+void test_quote_inside_a_quoted_argument_is_refused()
+{
+    char command[SIM7080G_COMMAND_SIZE];
+
+    TEST_ASSERT_FALSE(ATCommands::CAOPEN.format(command, 0, 0, Quoted{"TCP"}, Quoted{"evil\",\"host"}, 1));
+    TEST_ASSERT_FALSE(ATCommands::HTTPTOFS.format(command, Quoted{"http://x"}, Quoted{nullptr}));
+}
+
+void test_overflow_is_reported_and_terminated()
+{
+    char command[12];
+
+    TEST_ASSERT_FALSE(ATCommands::CASEND.format(command, 0, 123456));
+    TEST_ASSERT_EQUAL_STRING("AT+CASEND=0", command);
+
+    char exact[18];
+    TEST_ASSERT_TRUE(ATCommands::CASEND.format(exact, 0, 12345));
+    TEST_ASSERT_EQUAL_STRING("AT+CASEND=0,12345", exact);
+}
+
+void test_writer_with_no_room()
+{
+    char buffer[1] = {'x'};
+    ATCommandWriter writer(buffer, sizeof(buffer));
+
+    writer.append('A');
+    TEST_ASSERT_FALSE(writer.finish());
+    TEST_ASSERT_EQUAL_STRING("", buffer);
+
+    ATCommandWriter none(buffer, 0);
+    TEST_ASSERT_FALSE(none.finish());
+}
+
+void test_catalogue_metadata()
+{
+    TEST_ASSERT_EQUAL_STRING(">", ATCommands::CASEND.terminator);
+    TEST_ASSERT_EQUAL(AT_PRIORITY_HIGH, ATCommands::CASEND.priority);
+    TEST_ASSERT_EQUAL_STRING("+CGNSINF:", ATCommands::CGNSINF.expected);
+    TEST_ASSERT_EQUAL(1000, ATCommands::GSN.timeout);
+    TEST_ASSERT_NULL(ATCommands::GSN.terminator);
+    TEST_ASSERT_EQUAL(AT_PRIORITY_LINK, ATCommands::PROBE.priority);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_format_integers);
+    RUN_TEST(test_format_extreme_integers);
+    RUN_TEST(test_format_quoted_and_raw_text);
+    RUN_TEST(test_quote_inside_a_quoted_argument_is_refused);
+    RUN_TEST(test_overflow_is_reported_and_terminated);
+    RUN_TEST(test_writer_with_no_room);
+    RUN_TEST(test_catalogue_metadata);
+    return UNITY_END();
+}
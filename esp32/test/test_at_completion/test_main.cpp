@@ -0,0 +1,251 @@
+#include <unity.h>
+#include <chrono>
+#include <Arduino.h>
+#include <EventLoop.hpp>
+#include <SIM7080G/Serial.hpp>
+#include <SIM7080G/ATCommands.hpp>
+#include <ScriptedModem.h>
+
+/**
+ * @brief A command ends on its final result code, the timeout only bounds it
+ */
+
+static ScriptedModem modem;
+
+/**
+ * @brief Send a command and run the loop until its response is finished
+ */
+template <typename Command, typename... Values>
+static AT_RESPONSE run(const Command &command, Values... values)
+{
+    ATFuture future;
+    AT_RESPONSE response;
+
+    while (!(response = command.send(future, values...)).isFinished)
+    {
+        Sim7080G.loop();
+        events.wait();
+    }
+
+    return response;
+}
+
+static int urcCount = 0;
+
+void setUp()
+{
+    modem.clear();
+    Sim7080G.emulator = &modem;
+    Sim7080G.linkState = LINK_READY;
+
+    while (!Sim7080G.isIdle())
+    {
+        Sim7080G.loop();
+        events.wait();
+    }
+}
+
+void tearDown() {}
+
+void test_final_result_codes()
+{
+    TEST_ASSERT_EQUAL(AT_OK, SIM7080GHardwareSerial::finalResultCode(ATView("OK")));
+    TEST_ASSERT_EQUAL(AT_OK, SIM7080GHardwareSerial::finalResultCode(ATView("SEND OK")));
+    TEST_ASSERT_EQUAL(AT_ERROR, SIM7080GHardwareSerial::finalResultCode(ATView("ERROR")));
+    TEST_ASSERT_EQUAL(AT_ERROR, SIM7080GHardwareSerial::finalResultCode(ATView("+CME ERROR: 3")));
+    TEST_ASSERT_EQUAL(AT_ERROR, SIM7080GHardwareSerial::finalResultCode(ATView("SEND FAIL")));
+
+    TEST_ASSERT_EQUAL(AT_PENDING, SIM7080GHardwareSerial::finalResultCode(ATView("+CGNSINF: 1,1")));
+    TEST_ASSERT_EQUAL(AT_PENDING, SIM7080GHardwareSerial::finalResultCode(ATView("")));
+    TEST_ASSERT_EQUAL(AT_PENDING, SIM7080GHardwareSerial::finalResultCode(ATView("OKAY")));
+}
+
+void test_terminator_replaces_ok()
+{
+    TEST_ASSERT_EQUAL(AT_OK, SIM7080GHardwareSerial::finalResultCode(ATView("+APP PDP: 0,ACTIVE"), "+APP PDP:"));
+    TEST_ASSERT_EQUAL(AT_OK, SIM7080GHardwareSerial::finalResultCode(ATView(">"), ">"));
+    TEST_ASSERT_EQUAL(AT_PENDING, SIM7080GHardwareSerial::finalResultCode(ATView("OK"), "+APP PDP:"));
+
+    // An error ends the command whatever it waits for
+    TEST_ASSERT_EQUAL(AT_ERROR, SIM7080GHardwareSerial::finalResultCode(ATView("ERROR"), "+APP PDP:"));
+}
+
+void test_solicited_lines()
+{
+    TEST_ASSERT_TRUE(SIM7080GHardwareSerial::isSolicited(ATView("+CGNSINF: 1,1"), "AT+CGNSINF", nullptr));
+    TEST_ASSERT_TRUE(SIM7080GHardwareSerial::isSolicited(ATView("+CEREG: 0,1"), "AT+CBC;+CEREG?", nullptr));
+    TEST_ASSERT_TRUE(SIM7080GHardwareSerial::isSolicited(ATView("+APP PDP: 0,ACTIVE"), "AT+CNACT=0,1", "+APP PDP:"));
+
+    TEST_ASSERT_FALSE(SIM7080GHardwareSerial::isSolicited(ATView("+CEREG: 0,1"), "AT+CGNSINF", nullptr));
+    TEST_ASSERT_FALSE(SIM7080GHardwareSerial::isSolicited(ATView("+CBCX: 1"), "AT+CBC", nullptr));
+    TEST_ASSERT_FALSE(SIM7080GHardwareSerial::isSolicited(ATView("RDY"), "AT+GSN", nullptr));
+}
+
+void test_ok_ends_before_the_timeout()
+{
+    modem.reply("AT+GSN", "\r\n861234567890123\r\n\r\nOK\r\n");
+
+    unsigned long start = millis();
+    AT_RESPONSE response = run(ATCommands::GSN);
+
+    TEST_ASSERT_EQUAL(AT_OK, response.status);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, response.message.indexOf("861234567890123"));
+    TEST_ASSERT_LESS_THAN(ATCommands::GSN.timeout / 10, millis() - start);
+}
+
+void test_error_ends_before_the_timeout()
+{
+    modem.reply("AT+CACLOSE=0", "\r\n+CME ERROR: 3\r\n");
+
+    unsigned long start = millis();
+    AT_RESPONSE response = run(ATCommands::CACLOSE, 0);
+
+    TEST_ASSERT_EQUAL(AT_ERROR, response.status);
+    TEST_ASSERT_LESS_THAN(ATCommands::CACLOSE.timeout / 10, millis() - start);
+}
+
+void test_terminator_ends_the_command()
+{
+    modem.reply("AT+CPOWD=1", "\r\nNORMAL POWER DOWN\r\n");
+
+    unsigned long start = millis();
+    AT_RESPONSE response = run(ATCommands::CPOWD, 1);
+
+    TEST_ASSERT_EQUAL(AT_OK, response.status);
+    TEST_ASSERT_LESS_THAN(ATCommands::CPOWD.timeout / 10, millis() - start);
+}
+
+void test_timeout_is_the_ceiling()
+{
+    unsigned long start = millis();
+    AT_RESPONSE response = run(ATCommands::GSN);
+
+    TEST_ASSERT_EQUAL(AT_TIMEOUT, response.status);
+    TEST_ASSERT_GREATER_OR_EQUAL(ATCommands::GSN.timeout, millis() - start);
+    TEST_ASSERT_LESS_THAN(ATCommands::GSN.timeout + 100, millis() - start);
+    TEST_ASSERT_EQUAL(1, modem.commands.size());
+}
+
+void test_urc_does_not_end_the_command()
+{
+    Sim7080G.onURC("+CGEV:", [](const ATView &line)
+                   { urcCount++; });
+
+    modem.reply("AT+CBC", "\r\n+CGEV: ME PDN DEACT 1\r\n\r\n+CBC: 0,87,4120\r\n\r\nOK\r\n");
+
+    AT_RESPONSE response = run(ATCommands::CBC);
+
+    TEST_ASSERT_EQUAL(AT_OK, response.status);
+    TEST_ASSERT_EQUAL(1, urcCount);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, response.message.indexOf("+CBC: 0,87,4120"));
+    TEST_ASSERT_LESS_THAN(0, response.message.indexOf("+CGEV:"));
+}
+
+/**
+ * @brief Modem answering every command line with the same reply, without allocating, for the receive benchmark
+ */
+class FixedReplyModem : public Stream
+{
+public:
+    const char *reply = "";
+    size_t replyLength = 0;
+    size_t sent = 0;
+
+    /**
+     * @brief Bytes received by the firmware since the start
+     */
+    unsigned long bytes = 0;
+
+    int available() override { return (int)(replyLength - sent); }
+    int peek() override { return sent < replyLength ? (uint8_t)reply[sent] : -1; }
+    int read() override { return sent < replyLength ? (bytes++, (uint8_t)reply[sent++]) : -1; }
+
+    size_t readBytes(char *buffer, size_t length)
+    {
+        size_t count = replyLength - sent < length ? replyLength - sent : length;
+        memcpy(buffer, reply + sent, count);
+        sent += count;
+        bytes += count;
+        return count;
+    }
+
+    size_t write(uint8_t c) override
+    {
+        // The reply of the previous command is over, answer the new one
+        if (c == '\r')
+            sent = 0;
+        return 1;
+    }
+
+    using Print::write;
+};
+
+/**
+ * @brief Commands run by the receive benchmark
+ */
+#define BENCHMARK_COMMANDS 20000
+
+/**
+ * @brief Bytes/s of the AT receive path and heap allocations per command, from the write of the command to its
+ * finished response, with a reply as long as a +CGNSINF one
+ */
+void test_receive_throughput()
+{
+    static const char CGNSINF_REPLY[] = "\r\n+CGNSINF: 1,1,20240601012659.000,45.774061,-4.848677,170.000,1.25,271.5,1,,1.1,1.4,0.9,,12,8,3,,35,2.4,3.1\r\n\r\nOK\r\n";
+    static const char GSN_REPLY[] = "\r\n861234567890123\r\n\r\nOK\r\n";
+
+    struct Case
+    {
+        const char *name;
+        const char *reply;
+        size_t length;
+    };
+    static const Case cases[] = {
+        {"AT+CGNSINF", CGNSINF_REPLY, sizeof(CGNSINF_REPLY) - 1},
+        {"AT+GSN", GSN_REPLY, sizeof(GSN_REPLY) - 1},
+    };
+
+    FixedReplyModem fixed;
+    Sim7080G.emulator = &fixed;
+
+    printf("\n  command      bytes   host ms   bytes/s host   allocations/command\n");
+    for (const Case &item : cases)
+    {
+        fixed.reply = item.reply;
+        fixed.replyLength = item.length;
+        fixed.sent = item.length;
+        fixed.bytes = 0;
+
+        auto hostStart = std::chrono::steady_clock::now();
+        uint32_t allocations = nativeHeap.allocations;
+
+        for (int i = 0; i < BENCHMARK_COMMANDS; i++)
+        {
+            AT_RESPONSE response = item.reply == CGNSINF_REPLY ? run(ATCommands::CGNSINF) : run(ATCommands::GSN);
+            TEST_ASSERT_EQUAL(AT_OK, response.status);
+        }
+
+        allocations = nativeHeap.allocations - allocations;
+        double hostTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - hostStart).count();
+        printf("  %-10s  %6lu  %8.1f  %13.0f  %20.2f\n", item.name, fixed.bytes, hostTime,
+               fixed.bytes * 1000.0 / hostTime, (double)allocations / BENCHMARK_COMMANDS);
+
+        TEST_ASSERT_EQUAL((unsigned long)item.length * BENCHMARK_COMMANDS, fixed.bytes);
+        TEST_ASSERT_EQUAL(0, allocations);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_final_result_codes);
+    RUN_TEST(test_terminator_replaces_ok);
+    RUN_TEST(test_solicited_lines);
+    RUN_TEST(test_ok_ends_before_the_timeout);
+    RUN_TEST(test_error_ends_before_the_timeout);
+    RUN_TEST(test_terminator_ends_the_command);
+    RUN_TEST(test_timeout_is_the_ceiling);
+    RUN_TEST(test_urc_does_not_end_the_command);
+    RUN_TEST(test_receive_throughput);
+    return UNITY_END();
+}
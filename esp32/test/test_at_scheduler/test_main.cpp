@@ -0,0 +1,166 @@
+#include <unity.h>
+#include <string>
+#include <vector>
+#include <Arduino.h>
+#include <EventLoop.hpp>
+#include <SIM7080G/Serial.hpp>
+#include <SIM7080G/ATCommands.hpp>
+#include <ScriptedModem.h>
+
+/**
+ * @brief One command runs at a time, the queued ones follow by priority then in submission order
+ */
+
+static ScriptedModem modem;
+
+/**
+ * @brief Longest a test waits for the commands, a job never dispatched fails instead of hanging
+ */
+#define WAIT_LIMIT (1000UL * 30)
+
+/**
+ * @brief Commands whose completion callback ran, in order, and their status
+ */
+static std::vector<std::string> completed;
+static std::vector<AT_STATUS> statuses;
+
+static void onBattery(const AT_RESPONSE &response)
+{
+    completed.push_back("AT+CBC");
+    statuses.push_back(response.status);
+}
+
+static void onSend(const AT_RESPONSE &response)
+{
+    completed.push_back("AT+CASEND");
+    statuses.push_back(response.status);
+}
+
+static void onRegistration(const AT_RESPONSE &response)
+{
+    completed.push_back("AT+CEREG?");
+    statuses.push_back(response.status);
+}
+
+static void onClose(const AT_RESPONSE &response)
+{
+    completed.push_back("AT+CACLOSE");
+    statuses.push_back(response.status);
+}
+
+/**
+ * @brief Run the loop until the callbacks ran count times
+ */
+static void waitCompleted(size_t count)
+{
+    unsigned long start = millis();
+
+    while (completed.size() < count && millis() - start < WAIT_LIMIT)
+    {
+        Sim7080G.loop();
+        events.wait();
+    }
+
+    TEST_ASSERT_EQUAL(count, completed.size());
+}
+
+/**
+ * @brief Start AT+GSN and run the loop until it is written, the modem answers it after its latency
+ */
+static ATFuture startRunning()
+{
+    ATFuture running;
+    Sim7080G.poll(running);
+    TEST_ASSERT_FALSE(ATCommands::GSN.send(running).isFinished);
+
+    while (modem.commands.empty())
+    {
+        Sim7080G.loop();
+        events.wait();
+    }
+
+    return running;
+}
+
+void setUp()
+{
+    modem.clear();
+    modem.latency = 200;
+    Sim7080G.emulator = &modem;
+    Sim7080G.linkState = LINK_READY;
+    completed.clear();
+    statuses.clear();
+
+    unsigned long start = millis();
+    while (!Sim7080G.isIdle() && millis() - start < WAIT_LIMIT)
+    {
+        Sim7080G.loop();
+        events.wait();
+    }
+
+    modem.reply("AT+GSN", "\r\n861234567890123\r\n\r\nOK\r\n");
+    modem.reply("AT+CBC", "\r\n+CBC: 0,85,4012\r\n\r\nOK\r\n");
+    modem.reply("AT+CASEND=0,12", "\r\n>");
+    modem.reply("AT+CEREG?", "\r\n+CEREG: 0,5\r\n\r\nOK\r\n");
+    modem.reply("AT+CACLOSE=0", "\r\nOK\r\n");
+}
+
+void tearDown() {}
+
+void test_high_priority_overtakes_low()
+{
+    ATFuture running = startRunning();
+
+    // Both wait behind AT+GSN, the housekeeping query was queued first
+    TEST_ASSERT_TRUE(ATCommands::CBC.submit(onBattery, 0));
+    TEST_ASSERT_TRUE(ATCommands::CASEND.submit(onSend, 0, 0, 12));
+
+    // Nothing is written while AT+GSN runs
+    Sim7080G.loop();
+    TEST_ASSERT_EQUAL(1, modem.commands.size());
+
+    waitCompleted(2);
+
+    TEST_ASSERT_EQUAL(3, modem.commands.size());
+    TEST_ASSERT_EQUAL_STRING("AT+GSN", modem.commands[0].c_str());
+    TEST_ASSERT_EQUAL_STRING("AT+CASEND=0,12", modem.commands[1].c_str());
+    TEST_ASSERT_EQUAL_STRING("AT+CBC", modem.commands[2].c_str());
+
+    TEST_ASSERT_EQUAL_STRING("AT+CASEND", completed[0].c_str());
+    TEST_ASSERT_EQUAL(AT_OK, statuses[0]);
+    TEST_ASSERT_EQUAL_STRING("AT+CBC", completed[1].c_str());
+    TEST_ASSERT_EQUAL(AT_OK, statuses[1]);
+
+    // The running command was not cut short
+    AT_RESPONSE response = Sim7080G.poll(running);
+    TEST_ASSERT_TRUE(response.isFinished);
+    TEST_ASSERT_EQUAL(AT_OK, response.status);
+    TEST_ASSERT_TRUE(Sim7080G.isIdle());
+}
+
+void test_same_priority_in_submission_order()
+{
+    startRunning();
+
+    TEST_ASSERT_TRUE(ATCommands::CACLOSE.submit(onClose, 0, 0));
+    TEST_ASSERT_TRUE(ATCommands::CEREG_READ.submit(onRegistration, 0));
+    TEST_ASSERT_TRUE(ATCommands::CASEND.submit(onSend, 0, 0, 12));
+
+    waitCompleted(3);
+
+    TEST_ASSERT_EQUAL(4, modem.commands.size());
+    TEST_ASSERT_EQUAL_STRING("AT+CASEND=0,12", modem.commands[1].c_str());
+    TEST_ASSERT_EQUAL_STRING("AT+CACLOSE=0", modem.commands[2].c_str());
+    TEST_ASSERT_EQUAL_STRING("AT+CEREG?", modem.commands[3].c_str());
+    TEST_ASSERT_EQUAL_STRING("AT+CASEND", completed[0].c_str());
+    TEST_ASSERT_EQUAL_STRING("AT+CACLOSE", completed[1].c_str());
+    TEST_ASSERT_EQUAL_STRING("AT+CEREG?", completed[2].c_str());
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_high_priority_overtakes_low);
+    RUN_TEST(test_same_priority_in_submission_order);
+    return UNITY_END();
+}
@@ -0,0 +1,97 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <SIM7080G/ATView.hpp>
+
+void setUp() {}
+void tearDown() {}
+
+void test_view_does_not_copy()
+{
+    const char text[] = "+CBC: 0,87,4120";
+    ATView view(text);
+
+    TEST_ASSERT_TRUE(view.data() == text);
+    TEST_ASSERT_EQUAL(15, view.length());
+    TEST_ASSERT_TRUE(view.substring(6).data() == text + 6);
+}
+
+void test_search_and_compare()
+{
+    ATView view("+CEREG: 0,1\r\n");
+
+    TEST_ASSERT_EQUAL(6, view.indexOf(':'));
+    TEST_ASSERT_EQUAL(9, view.indexOf(',', 7));
+    TEST_ASSERT_EQUAL(-1, view.indexOf('x'));
+    TEST_ASSERT_EQUAL(8, view.indexOf("0,1"));
+    TEST_ASSERT_EQUAL(-1, view.indexOf("+CEREG: 0,1\r\n and more"));
+
+    TEST_ASSERT_TRUE(view.startsWith("+CEREG:"));
+    TEST_ASSERT_FALSE(view.startsWith("+CEREG: 0,1\r\n+"));
+    TEST_ASSERT_TRUE(ATView("OK") == "OK");
+    TEST_ASSERT_TRUE(ATView("OK") != "OKAY");
+    TEST_ASSERT_TRUE(ATView("OKAY") != "OK");
+}
+
+void test_substring_is_clamped()
+{
+    ATView view("abcdef");
+
+    TEST_ASSERT_TRUE(view.substring(2, 4) == "cd");
+    TEST_ASSERT_TRUE(view.substring(4, 2) == "cd");
+    TEST_ASSERT_TRUE(view.substring(4, 100) == "ef");
+    TEST_ASSERT_TRUE(view.substring(100).isEmpty());
+}
+
+void test_trim()
+{
+    ATView view(" \r\n861234567890123\r\n");
+    view.trim();
+    TEST_ASSERT_TRUE(view == "861234567890123");
+
+    ATView blank("\r\n\r\n");
+    blank.trim();
+    TEST_ASSERT_TRUE(blank.isEmpty());
+}
+
+void test_numbers()
+{
+    TEST_ASSERT_EQUAL(4120, ATView("4120,").toInt());
+    TEST_ASSERT_EQUAL(-73, ATView(" -73").toInt());
+    TEST_ASSERT_EQUAL(0, ATView("").toInt());
+    TEST_ASSERT_FLOAT_WITHIN(0.0001, 1.25, ATView("1.25,").toFloat());
+
+    TEST_ASSERT_EQUAL(457640431, ATView("45.7640431").toFixed(7));
+    TEST_ASSERT_EQUAL(-48356590, ATView("-4.835659").toFixed(7));
+    TEST_ASSERT_EQUAL(170, ATView("170").toFixed(0));
+    TEST_ASSERT_EQUAL(12, ATView("1.15").toFixed(1));
+    TEST_ASSERT_EQUAL(11, ATView("1.14").toFixed(1));
+}
+
+void test_next_line_skips_empty_lines()
+{
+    ATView reply("\r\n+CBC: 0,87,4120\r\n\r\nOK\r\n");
+    size_t offset = 0;
+
+    TEST_ASSERT_TRUE(reply.nextLine(offset) == "+CBC: 0,87,4120");
+    TEST_ASSERT_TRUE(reply.nextLine(offset) == "OK");
+    TEST_ASSERT_TRUE(reply.nextLine(offset).isEmpty());
+}
+
+void test_copy_for_logs()
+{
+    ATView view("+CSQ: 20,99", 5);
+    TEST_ASSERT_EQUAL_STRING("+CSQ:", view.toString().c_str());
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_view_does_not_copy);
+    RUN_TEST(test_search_and_compare);
+    RUN_TEST(test_substring_is_clamped);
+    RUN_TEST(test_trim);
+    RUN_TEST(test_numbers);
+    RUN_TEST(test_next_line_skips_empty_lines);
+    RUN_TEST(test_copy_for_logs);
+    return UNITY_END();
+}
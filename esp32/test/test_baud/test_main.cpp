@@ -0,0 +1,239 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <Preferences.h>
+#include <EventLoop.hpp>
+#include <SIM7080G/Serial.hpp>
+#include <SIM7080G/ATCommands.hpp>
+#include <SIM7080G/Simulator.hpp>
+#include <ScriptedModem.h>
+
+/**
+ * @brief Negotiation of the UART rate with AT+IPR, against the simulated modem
+ */
+
+static ModemSimulator modem;
+
+/**
+ * @brief Modem that stopped answering, e.g. on a noisy line
+ */
+static ScriptedModem silent;
+
+/**
+ * @brief Run the loop until the link is ready, or for a while
+ *
+ * @return Time it took, in milliseconds
+ */
+static unsigned long runUntilReady(unsigned long limit = 10000)
+{
+    unsigned long start = millis();
+
+    while (Sim7080G.linkState != LINK_READY && millis() - start < limit)
+    {
+        Sim7080G.loop();
+        events.wait();
+    }
+
+    return millis() - start;
+}
+
+static uint32_t storedBaud()
+{
+    Preferences preferences;
+    preferences.begin("sim7080g", true);
+    return preferences.getUInt("baud", 0);
+}
+
+static void storeBaud(uint32_t baud)
+{
+    Preferences preferences;
+    preferences.begin("sim7080g", false);
+    preferences.putUInt("baud", baud);
+}
+
+void setUp()
+{
+    nativeNVS.clear();
+    modem.begin();
+    Sim7080G.emulator = &modem;
+}
+
+void tearDown() {}
+
+void test_moves_a_fresh_modem_to_the_fastest_rate()
+{
+    Sim7080G.restartLink();
+    TEST_ASSERT_EQUAL(SIM7080G_BAUD, Sim7080G.linkBaud);
+
+    runUntilReady();
+
+    TEST_ASSERT_EQUAL(LINK_READY, Sim7080G.linkState);
+    TEST_ASSERT_EQUAL(SIM7080G_BAUD_MAX, Sim7080G.linkBaud);
+    TEST_ASSERT_EQUAL(SIM7080G_BAUD_MAX, modem.baud);
+    TEST_ASSERT_EQUAL(SIM7080G_BAUD_MAX, storedBaud());
+}
+
+void test_stored_rate_is_the_target()
+{
+    storeBaud(230400);
+    Sim7080G.restartLink();
+
+    runUntilReady();
+
+    TEST_ASSERT_EQUAL(LINK_READY, Sim7080G.linkState);
+    TEST_ASSERT_EQUAL(230400, Sim7080G.linkBaud);
+    TEST_ASSERT_EQUAL(230400, modem.baud);
+}
+
+void test_finds_a_modem_left_at_a_fixed_rate()
+{
+    // The ESP32 restarted, the modem kept the rate of the previous run
+    modem.baud = 460800;
+    storeBaud(460800);
+    Sim7080G.restartLink();
+
+    unsigned long elapsed = runUntilReady();
+
+    TEST_ASSERT_EQUAL(LINK_READY, Sim7080G.linkState);
+    TEST_ASSERT_EQUAL(460800, Sim7080G.linkBaud);
+
+    // Three unanswered probes at SIM7080G_BAUD, then the stored rate
+    TEST_ASSERT_GREATER_OR_EQUAL(3 * ATCommands::PROBE.timeout, elapsed);
+    TEST_ASSERT_LESS_THAN(4 * ATCommands::PROBE.timeout, elapsed);
+}
+
+void test_finds_a_modem_left_at_another_rate()
+{
+    // The NVS was erased, the modem kept the rate of the previous run
+    modem.baud = 460800;
+    Sim7080G.restartLink();
+
+    unsigned long elapsed = runUntilReady();
+
+    // Three unanswered probes at SIM7080G_BAUD, three at the target, then 460800, moved to the target
+    TEST_ASSERT_EQUAL(LINK_READY, Sim7080G.linkState);
+    TEST_ASSERT_EQUAL(SIM7080G_BAUD_MAX, Sim7080G.linkBaud);
+    TEST_ASSERT_EQUAL(SIM7080G_BAUD_MAX, modem.baud);
+    TEST_ASSERT_GREATER_OR_EQUAL(6 * ATCommands::PROBE.timeout, elapsed);
+    TEST_ASSERT_LESS_THAN(7 * ATCommands::PROBE.timeout, elapsed);
+}
+
+/**
+ * @brief Call powerOn() until it returns true, or for a while
+ *
+ * @return Number of PWRKEY pulses
+ */
+static unsigned int powerOnPulses(unsigned long limit = 3 * SIM7080G_BOOT_TIMEOUT)
+{
+    unsigned long start = millis();
+    unsigned int pulses = 0;
+    bool pulsing = false;
+
+    while (!Sim7080G.powerOn() && millis() - start < limit)
+    {
+        if (Sim7080G.powerState == POWER_PULSE && !pulsing)
+            pulses++;
+        pulsing = Sim7080G.powerState == POWER_PULSE;
+
+        Sim7080G.loop();
+        events.wait();
+    }
+
+    return pulses;
+}
+
+static void powerOnLeftAtFixedRate(bool stored)
+{
+    // The ESP32 alone restarted, the modem is still on at the rate of the previous run
+    modem.baud = 460800;
+    if (stored)
+        storeBaud(460800);
+    Sim7080G.powerState = POWER_OFF;
+
+    unsigned long start = millis();
+    unsigned int pulses = powerOnPulses();
+
+    TEST_ASSERT_EQUAL(POWER_ON, Sim7080G.powerState);
+    TEST_ASSERT_EQUAL(1, pulses);
+    TEST_ASSERT_LESS_THAN(SIM7080G_POWER_PULSE + SIM7080G_BOOT_TIMEOUT, millis() - start);
+
+    runUntilReady();
+    TEST_ASSERT_EQUAL(LINK_READY, Sim7080G.linkState);
+    TEST_ASSERT_EQUAL(stored ? 460800 : SIM7080G_BAUD_MAX, Sim7080G.linkBaud);
+}
+
+void test_power_on_finds_the_stored_rate()
+{
+    powerOnLeftAtFixedRate(true);
+}
+
+void test_power_on_finds_an_unknown_rate()
+{
+    powerOnLeftAtFixedRate(false);
+}
+
+void test_falls_back_after_timeouts()
+{
+    Sim7080G.restartLink();
+    runUntilReady();
+    TEST_ASSERT_EQUAL(SIM7080G_BAUD_MAX, Sim7080G.linkBaud);
+
+    // Commands time out in a row at the fast rate
+    silent.clear();
+    Sim7080G.emulator = &silent;
+
+    for (uint8_t i = 0; i < SIM7080G_LINK_MAX_ERRORS; i++)
+    {
+        ATFuture future;
+        while (!ATCommands::GSN.send(future).isFinished)
+        {
+            Sim7080G.loop();
+            events.wait();
+        }
+    }
+
+    TEST_ASSERT_EQUAL(LINK_FALLBACK, Sim7080G.linkState);
+
+    // The modem hears AT+IPR=0 and autobauds again, the link comes back one rate lower
+    Sim7080G.emulator = &modem;
+    runUntilReady();
+
+    TEST_ASSERT_EQUAL(LINK_READY, Sim7080G.linkState);
+    TEST_ASSERT_EQUAL(460800, Sim7080G.linkBaud);
+    TEST_ASSERT_EQUAL(460800, storedBaud());
+}
+
+void test_commands_wait_for_the_link()
+{
+    Sim7080G.restartLink();
+
+    ATFuture future;
+    AT_RESPONSE response = ATCommands::GSN.send(future);
+
+    // Only the link commands go through until it is ready, then the queued command runs at the new rate
+    while (!response.isFinished)
+    {
+        TEST_ASSERT_TRUE(Sim7080G.linkState == LINK_READY || !Sim7080G.isPending(future) || Sim7080G.jobs[future.slot].state == AT_JOB_QUEUED);
+        Sim7080G.loop();
+        events.wait();
+        response = ATCommands::GSN.send(future);
+    }
+
+    TEST_ASSERT_EQUAL(AT_OK, response.status);
+    TEST_ASSERT_EQUAL(SIM7080G_BAUD_MAX, Sim7080G.linkBaud);
+}
+
+int main(int argc, char **argv)
+{
+    Sim7080G.setup();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_moves_a_fresh_modem_to_the_fastest_rate);
+    RUN_TEST(test_stored_rate_is_the_target);
+    RUN_TEST(test_finds_a_modem_left_at_a_fixed_rate);
+    RUN_TEST(test_finds_a_modem_left_at_another_rate);
+    RUN_TEST(test_power_on_finds_the_stored_rate);
+    RUN_TEST(test_power_on_finds_an_unknown_rate);
+    RUN_TEST(test_falls_back_after_timeouts);
+    RUN_TEST(test_commands_wait_for_the_link);
+    return UNITY_END();
+}
@@ -0,0 +1,399 @@
+#include <unity.h>
+#include <algorithm>
+#include <chrono>
+#include <Arduino.h>
+#include <Preferences.h>
+#include <FSM.hpp>
+#include <EventLoop.hpp>
+#include <QueueList.hpp>
+#include <QueueStore.hpp>
+#include <SIM7080G/Serial.hpp>
+#include <SIM7080G/GNSS.hpp>
+#include <SIM7080G/TCP.hpp>
+#include <SIM7080G/Simulator.hpp>
+#include "track.h"
+
+/**
+ * @brief Cycle-time benchmark of the firmware against the simulated modem
+ *
+ * @details Runs setup() and loop() of main.cpp on the host, built with -D SIM7080G_SIMULATOR, over the simulated day
+ * of main.cpp. Time is virtual, see test/native/Arduino.h: the figures are those of the modem, the UART and the
+ * server, the same from one run to the next, to compare two versions of the firmware.
+ */
+
+void setup();
+void loop();
+extern ModemSimulator simulator;
+
+/**
+ * @brief Length of the simulated day of main.cpp, in milliseconds
+ */
+#define BENCHMARK_DAY (1000UL * 60 * 90)
+
+/**
+ * @brief Longest a cycle of the master FSM may take, from leaving PAUSED until it is back to it, in milliseconds
+ *
+ * @details A cold start without assistance takes 30 s to fix, an upload session about 10 s.
+ */
+#define BENCHMARK_MAX_CYCLE (1000UL * 60 * 2)
+
+/**
+ * @brief Most cycles recorded over the day
+ */
+#define BENCHMARK_MAX_CYCLES 128
+
+/**
+ * @brief Cost of one run of the master FSM
+ */
+struct BenchmarkCycle
+{
+    unsigned char firstState;
+
+    /**
+     * @brief Virtual time and time the modem spent on commands, in milliseconds
+     */
+    unsigned long time;
+    unsigned long busy;
+
+    /**
+     * @brief Iterations of loop(), at least one a millisecond while the emulator is polled
+     */
+    uint32_t iterations;
+
+    /**
+     * @brief Bytes received by the simulated server
+     */
+    uint32_t serverBytes;
+
+    /**
+     * @brief Most heap bytes in use above the level at the start of the cycle, and calls of operator new
+     */
+    size_t heapPeak;
+    uint32_t allocations;
+};
+
+static BenchmarkCycle cycles[BENCHMARK_MAX_CYCLES];
+static size_t cycleCount = 0;
+
+static double hostMilliseconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_day_cycles()
+{
+    auto hostStart = std::chrono::steady_clock::now();
+    BenchmarkCycle start = {};
+    bool running = false;
+
+    setup();
+
+    while (millis() < BENCHMARK_DAY)
+    {
+        loop();
+
+        if (!running && fsm.currentState != BasicState::PAUSED && fsm.currentState != BasicState::ENTRYPOINT)
+        {
+            running = true;
+            start = {fsm.currentState, millis(), Sim7080G.busyTime, events.cycles, simulator.serverBytes,
+                     nativeHeap.used, nativeHeap.allocations};
+            nativeHeap.mark();
+        }
+        else if (running && fsm.currentState == BasicState::PAUSED)
+        {
+            running = false;
+            if (cycleCount < BENCHMARK_MAX_CYCLES)
+                cycles[cycleCount++] = {start.firstState, millis() - start.time, Sim7080G.busyTime - start.busy,
+                                        events.cycles - start.iterations, simulator.serverBytes - start.serverBytes,
+                                        nativeHeap.markPeak - start.heapPeak, nativeHeap.allocations - start.allocations};
+        }
+    }
+
+    unsigned long longest = 0;
+    size_t heapPeak = 0;
+    printf("\n  state   time ms   busy ms   loops   server bytes   heap peak   allocations\n");
+    for (size_t i = 0; i < cycleCount; i++)
+    {
+        printf("  %5u  %8lu  %8lu  %6u  %13u  %10u  %12u\n", cycles[i].firstState, cycles[i].time, cycles[i].busy,
+               (unsigned)cycles[i].iterations, (unsigned)cycles[i].serverBytes, (unsigned)cycles[i].heapPeak,
+               (unsigned)cycles[i].allocations);
+        longest = cycles[i].time > longest ? cycles[i].time : longest;
+        heapPeak = cycles[i].heapPeak > heapPeak ? cycles[i].heapPeak : heapPeak;
+    }
+    printf("  %u cycles, %u loops, %u bytes in %u uploads, GNSS on %lu s, link at %u baud, %.0f ms of host CPU\n",
+           (unsigned)cycleCount, (unsigned)events.cycles, (unsigned)simulator.serverBytes, (unsigned)simulator.serverUploads,
+           simulator.gnssTime() / 1000, (unsigned)Sim7080G.linkBaud, hostMilliseconds(hostStart));
+
+    TEST_ASSERT_EQUAL(LINK_READY, Sim7080G.linkState);
+    TEST_ASSERT_GREATER_THAN(0, cycleCount);
+    TEST_ASSERT_GREATER_THAN(0, simulator.serverUploads);
+    TEST_ASSERT_LESS_OR_EQUAL(BENCHMARK_MAX_CYCLE, longest);
+    TEST_ASSERT_GREATER_THAN(0, heapPeak);
+}
+
+/**
+ * @brief Upload a full queue at each rate of the UART, the time is the one of AT+CASEND and its data
+ */
+void test_upload_throughput()
+{
+    static const uint32_t rates[] = {115200, 230400, 460800, 921600};
+    unsigned long previousTime = 0;
+
+    printf("\n     baud   bytes   send ms   bytes/s   CBOR host us\n");
+    for (uint32_t rate : rates)
+    {
+        GNSSData fix;
+        fix.gnssRunStatus = true;
+        fix.fixStatus = true;
+        fix.utcDateTime = DateTime(2025, 6, 1, 12, 0, 0, 0);
+        fix.latitude = 457640430;
+        fix.longitude = 48356590;
+        fix.hdop = 1.2;
+        fix.hpa = 3.5;
+
+        for (size_t i = 0; i < QUEUE_LIST_CAPACITY; i++)
+        {
+            fix.utcDateTime.second = i % 60;
+            fix.latitude += 100;
+            queueList.enqueue<GNSSData>(fix);
+        }
+
+        // Cost of the encoding alone, both passes, without the UART
+        auto hostStart = std::chrono::steady_clock::now();
+        QueueListCbor payload;
+        payload.begin(queueList);
+        size_t size = payload.size();
+        uint8_t buffer[128];
+        size_t encoded = 0;
+        for (size_t length; (length = payload.read(buffer, sizeof(buffer))) > 0;)
+            encoded += length;
+        payload.end();
+        double encodeTime = hostMilliseconds(hostStart) * 1000;
+        TEST_ASSERT_EQUAL(size, encoded);
+
+        // Same rate on both sides, as the link negotiation leaves it
+        Sim7080G.linkBaud = rate;
+        simulator.baud = rate;
+        uint32_t bytes = simulator.serverBytes;
+        unsigned long sendStart = 0;
+        unsigned long sendTime = 0;
+
+        unsigned long deadline = millis() + BENCHMARK_MAX_CYCLE;
+        while ((!Sim7080G.isIdle() || fsm.currentState != BasicState::PAUSED) && millis() < deadline)
+            loop();
+        fsm.setState(BasicState::MODULE_CATM1);
+
+        deadline = millis() + BENCHMARK_MAX_CYCLE;
+        while (fsm.currentState != BasicState::PAUSED && millis() < deadline)
+        {
+            loop();
+
+            bool sending = TCP.fsmTCP.currentState == TCP_SEND_SIZE || TCP.fsmTCP.currentState == TCP_SEND_DATA;
+            if (sending && sendStart == 0)
+                sendStart = millis();
+            else if (!sending && sendStart != 0 && sendTime == 0)
+                sendTime = millis() - sendStart;
+        }
+
+        bytes = simulator.serverBytes - bytes;
+        printf("  %7u  %6u  %8lu  %8lu  %13.0f\n", (unsigned)rate, (unsigned)bytes, sendTime,
+               sendTime > 0 ? bytes * 1000UL / sendTime : 0, encodeTime);
+
+        TEST_ASSERT_TRUE(queueList.isEmpty());
+        TEST_ASSERT_EQUAL(encoded, bytes);
+        if (previousTime > 0)
+            TEST_ASSERT_LESS_THAN(previousTime, sendTime);
+        previousTime = sendTime;
+    }
+}
+
+/**
+ * @brief Cost of following the recorded track once
+ */
+struct TrackRun
+{
+    unsigned long gnssTime;
+    uint32_t fixes;
+    uint32_t serverBytes;
+    uint32_t uploads;
+};
+
+static uint32_t queuedFixes = 0;
+
+/**
+ * @brief Run the firmware over RECORDED_TRACK, from its first point to its last
+ */
+static TrackRun runTrack(bool adaptive)
+{
+    GNSS.adaptive = adaptive;
+    GNSS.interval = GNSS.baseInterval;
+
+    simulator.config.track = RECORDED_TRACK;
+    simulator.config.trackLength = sizeof(RECORDED_TRACK) / sizeof(RECORDED_TRACK[0]);
+    simulator.restartTrack();
+
+    TrackRun start = {simulator.gnssTime(), queuedFixes, simulator.serverBytes, simulator.serverUploads};
+    unsigned long end = millis() + RECORDED_TRACK[sizeof(RECORDED_TRACK) / sizeof(RECORDED_TRACK[0]) - 1].time;
+
+    while (millis() < end)
+        loop();
+
+    return {simulator.gnssTime() - start.gnssTime, queuedFixes - start.fixes, simulator.serverBytes - start.serverBytes,
+            simulator.serverUploads - start.uploads};
+}
+
+/**
+ * @brief GNSS on-time, fixes queued and uplink over the recorded track, with the interval fixed then following the motion
+ */
+void test_recorded_track()
+{
+    queueList.onEnqueue = [](const QueueRecord &record)
+    {
+        queuedFixes += record.type == DATA_GNSS;
+        queueStore.enqueued(record);
+    };
+
+    TrackRun fixed = runTrack(false);
+    TrackRun adaptive = runTrack(true);
+
+    printf("\n  sampling   GNSS on s   fixes   server bytes   uploads\n");
+    printf("  fixed      %9lu  %6u  %13u  %8u\n", fixed.gnssTime / 1000, (unsigned)fixed.fixes, (unsigned)fixed.serverBytes,
+           (unsigned)fixed.uploads);
+    printf("  adaptive   %9lu  %6u  %13u  %8u\n", adaptive.gnssTime / 1000, (unsigned)adaptive.fixes,
+           (unsigned)adaptive.serverBytes, (unsigned)adaptive.uploads);
+
+    TEST_ASSERT_GREATER_THAN(0, adaptive.fixes);
+    TEST_ASSERT_LESS_THAN(fixed.gnssTime, adaptive.gnssTime);
+    TEST_ASSERT_LESS_THAN(fixed.fixes, adaptive.fixes);
+    TEST_ASSERT_LESS_THAN(fixed.serverBytes, adaptive.serverBytes);
+}
+
+/**
+ * @brief Power ons of each run of the constellation tuner benchmark, and the windows its figures are given over
+ */
+#define TTFF_SAMPLES 60
+static const size_t TTFF_WINDOWS[] = {0, 10, 30, TTFF_SAMPLES};
+
+/**
+ * @brief Times to fix of TTFF_SAMPLES cold starts in a row, and the set each one used
+ */
+struct TTFFRun
+{
+    unsigned long time[TTFF_SAMPLES];
+    uint8_t set[TTFF_SAMPLES];
+};
+
+static TTFFRun runTTFF()
+{
+    TTFFRun run = {};
+    unsigned long ttff = GNSS.ttff;
+    uint16_t samples[GNSS_CONSTELLATION_COUNT];
+    for (uint8_t i = 0; i < GNSS_CONSTELLATION_COUNT; i++)
+        samples[i] = GNSS.tuner.statistics(i).samples;
+
+    for (size_t count = 0; count < TTFF_SAMPLES;)
+    {
+        loop();
+        if (GNSS.ttff == ttff)
+            continue;
+
+        // ttff is a 3/4 moving average, the sample behind it is exact to the rounding, under 4 ms
+        run.time[count] = GNSS.ttff * 4 - ttff * 3;
+        ttff = GNSS.ttff;
+
+        for (uint8_t i = 0; i < GNSS_CONSTELLATION_COUNT; i++)
+        {
+            if (GNSS.tuner.statistics(i).samples != samples[i])
+                run.set[count] = i;
+            samples[i] = GNSS.tuner.statistics(i).samples;
+        }
+        count++;
+    }
+
+    return run;
+}
+
+/**
+ * @brief Mean and 95th percentile of the samples first to last - 1, in milliseconds
+ */
+static void ttffWindow(const TTFFRun &run, size_t first, size_t last, unsigned long &mean, unsigned long &p95)
+{
+    unsigned long sorted[TTFF_SAMPLES];
+    unsigned long sum = 0;
+
+    for (size_t i = first; i < last; i++)
+    {
+        sorted[i - first] = run.time[i];
+        sum += run.time[i];
+    }
+    std::sort(sorted, sorted + (last - first));
+
+    mean = sum / (last - first);
+    p95 = sorted[(last - first) * 95 / 100 < last - first - 1 ? (last - first) * 95 / 100 : last - first - 1];
+}
+
+/**
+ * @brief Mean and 95th percentile time to fix of cold starts, with the first set always used then with the tuner
+ *
+ * @details The simulated sky gives GPS 30 %, GLONASS 20 %, BeiDou 60 % and Galileo 10 % of a full one, GPS+BeiDou
+ * fixes the fastest. The engine is kept in duty cycles at a fixed interval without hot starts, each power on is a
+ * sample of the tuner.
+ */
+void test_ttff_convergence()
+{
+    const uint8_t shares[] = {30, 20, 60, 10, 0};
+    memcpy(simulator.config.systemShare, shares, sizeof(shares));
+    simulator.config.fixJitter = 30;
+    simulator.config.hotStartWindow = 0;
+    simulator.config.track = nullptr;
+    simulator.config.trackLength = 0;
+    GNSS.mode = GNSS_MODE_DUTY_CYCLE;
+    GNSS.adaptive = false;
+    GNSS.interval = GNSS.baseInterval;
+
+    GNSS.tuner.enabled = false;
+    TTFFRun fixed = runTTFF();
+
+    // The tuner starts from nothing, as on a new collar
+    nativeNVS.erase("gnss/tuner");
+    GNSS.tuner.enabled = true;
+    GNSS.tuner.begin();
+    TTFFRun tuned = runTTFF();
+
+    printf("\n  samples   fixed mean ms   p95 ms   tuned mean ms   p95 ms   on best set\n");
+    for (size_t w = 0; w + 1 < sizeof(TTFF_WINDOWS) / sizeof(TTFF_WINDOWS[0]); w++)
+    {
+        unsigned long fixedMean, fixedP95, tunedMean, tunedP95;
+        ttffWindow(fixed, TTFF_WINDOWS[w], TTFF_WINDOWS[w + 1], fixedMean, fixedP95);
+        ttffWindow(tuned, TTFF_WINDOWS[w], TTFF_WINDOWS[w + 1], tunedMean, tunedP95);
+
+        size_t best = 0;
+        for (size_t i = TTFF_WINDOWS[w]; i < TTFF_WINDOWS[w + 1]; i++)
+            best += tuned.set[i] == GNSS.tuner.best();
+
+        printf("  %2u-%-2u    %13lu  %7lu  %14lu  %7lu  %9u %%\n", (unsigned)TTFF_WINDOWS[w] + 1, (unsigned)TTFF_WINDOWS[w + 1],
+               fixedMean, fixedP95, tunedMean, tunedP95, (unsigned)(best * 100 / (TTFF_WINDOWS[w + 1] - TTFF_WINDOWS[w])));
+
+        // Once every set was tried, the tuner fixes faster than the default set
+        if (TTFF_WINDOWS[w] >= 2 * GNSS_TUNER_MIN_SAMPLES * GNSS_CONSTELLATION_COUNT)
+        {
+            TEST_ASSERT_LESS_THAN(fixedMean, tunedMean);
+            TEST_ASSERT_LESS_THAN(fixedP95, tunedP95);
+        }
+    }
+
+    TEST_ASSERT_EQUAL_STRING("GPS+BeiDou", GNSSTuner::constellations(GNSS.tuner.best()).name);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_day_cycles);
+    RUN_TEST(test_upload_throughput);
+    RUN_TEST(test_recorded_track);
+    RUN_TEST(test_ttff_convergence);
+    return UNITY_END();
+}
@@ -0,0 +1,1231 @@
+#pragma once
+#ifndef TEST_BENCHMARK_TRACK_H
+#define TEST_BENCHMARK_TRACK_H
+#include <SIM7080G/Simulator.hpp>
+
+/**
+ * @brief Day of a dog around the kennel of main.cpp, 1214 points over 5 h 32 min
+ *
+ * @details Generated, no GNSS recording of a collar being at hand: the positions carry the error of a still
+ * receiver, a Gauss-Markov wander of 3 m correlated over a minute, every 30 s at rest and every 10 s on the move.
+ * An hour in the kennel, 15 minutes in the garden, a 2.5 km walk with stops, 90 minutes in the kennel, a drive
+ * of 9 km at about 40 km/h to a park, 30 minutes off the leash, the drive back, then 45 minutes in the kennel.
+ */
+static const SimulatorWaypoint RECORDED_TRACK[] = {
+    {0UL, 45.764027, 4.835686},
+    {30000UL, 45.764013, 4.835692},
+    {60000UL, 45.763998, 4.835703},
+    {90000UL, 45.764014, 4.835729},
+    {120000UL, 45.764044, 4.835703},
+    {150000UL, 45.764037, 4.835701},
+    {180000UL, 45.764039, 4.835658},
+    {210000UL, 45.764054, 4.835584},
+    {240000UL, 45.764048, 4.835678},
+    {270000UL, 45.764058, 4.835628},
+    {300000UL, 45.764075, 4.835646},
+    {330000UL, 45.764050, 4.835633},
+    {360000UL, 45.764050, 4.835669},
+    {390000UL, 45.764045, 4.835719},
+    {420000UL, 45.764031, 4.835722},
+    {450000UL, 45.764004, 4.835639},
+    {480000UL, 45.764017, 4.835656},
+    {510000UL, 45.764067, 4.835647},
+    {540000UL, 45.764064, 4.835616},
+    {570000UL, 45.764057, 4.835650},
+    {600000UL, 45.764044, 4.835686},
+    {630000UL, 45.764074, 4.835694},
+    {660000UL, 45.764061, 4.835676},
+    {690000UL, 45.764068, 4.835639},
+    {720000UL, 45.764079, 4.835630},
+    {750000UL, 45.764072, 4.835609},
+    {780000UL, 45.764041, 4.835605},
+    {810000UL, 45.764054, 4.835629},
+    {840000UL, 45.764052, 4.835672},
+    {870000UL, 45.764030, 4.835695},
+    {900000UL, 45.764024, 4.835655},
+    {930000UL, 45.764020, 4.835690},
+    {960000UL, 45.764065, 4.835662},
+    {990000UL, 45.764034, 4.835614},
+    {1020000UL, 45.764039, 4.835646},
+    {1050000UL, 45.764050, 4.835660},
+    {1080000UL, 45.764077, 4.835662},
+    {1110000UL, 45.764073, 4.835653},
+    {1140000UL, 45.764041, 4.835588},
+    {1170000UL, 45.764043, 4.835598},
+    {1200000UL, 45.764033, 4.835604},
+    {1230000UL, 45.764038, 4.835630},
+    {1260000UL, 45.763993, 4.835630},
+    {1290000UL, 45.764022, 4.835652},
+    {1320000UL, 45.764026, 4.835660},
+    {1350000UL, 45.763999, 4.835671},
+    {1380000UL, 45.764010, 4.835668},
+    {1410000UL, 45.764037, 4.835669},
+    {1440000UL, 45.764015, 4.835604},
+    {1470000UL, 45.764016, 4.835625},
+    {1500000UL, 45.764031, 4.835670},
+    {1530000UL, 45.764044, 4.835675},
+    {1560000UL, 45.764006, 4.835692},
+    {1590000UL, 45.764024, 4.835743},
+    {1620000UL, 45.764048, 4.835687},
+    {1650000UL, 45.764048, 4.835695},
+    {1680000UL, 45.764026, 4.835631},
+    {1710000UL, 45.764042, 4.835626},
+    {1740000UL, 45.764038, 4.835642},
+    {1770000UL, 45.764034, 4.835673},
+    {1800000UL, 45.764044, 4.835676},
+    {1830000UL, 45.764062, 4.835668},
+    {1860000UL, 45.764028, 4.835665},
+    {1890000UL, 45.764006, 4.835670},
+    {1920000UL, 45.763995, 4.835665},
+    {1950000UL, 45.764041, 4.835683},
+    {1980000UL, 45.764025, 4.835631},
+    {2010000UL, 45.764023, 4.835673},
+    {2040000UL, 45.764043, 4.835621},
+    {2070000UL, 45.764061, 4.835645},
+    {2100000UL, 45.764070, 4.835693},
+    {2130000UL, 45.764042, 4.835697},
+    {2160000UL, 45.764046, 4.835716},
+    {2190000UL, 45.764039, 4.835651},
+    {2220000UL, 45.764044, 4.835684},
+    {2250000UL, 45.764039, 4.835667},
+    {2280000UL, 45.764044, 4.835660},
+    {2310000UL, 45.764035, 4.835647},
+    {2340000UL, 45.764070, 4.835639},
+    {2370000UL, 45.764064, 4.835683},
+    {2400000UL, 45.764079, 4.835624},
+    {2430000UL, 45.764049, 4.835600},
+    {2460000UL, 45.764044, 4.835555},
+    {2490000UL, 45.764014, 4.835592},
+    {2520000UL, 45.764033, 4.835584},
+    {2550000UL, 45.764043, 4.835653},
+    {2580000UL, 45.764023, 4.835695},
+    {2610000UL, 45.764030, 4.835614},
+    {2640000UL, 45.764039, 4.835636},
+    {2670000UL, 45.764072, 4.835624},
+    {2700000UL, 45.764100, 4.835637},
+    {2730000UL, 45.764089, 4.835640},
+    {2760000UL, 45.764083, 4.835687},
+    {2790000UL, 45.764068, 4.835660},
+    {2820000UL, 45.764073, 4.835653},
+    {2850000UL, 45.764068, 4.835687},
+    {2880000UL, 45.764062, 4.835688},
+    {2910000UL, 45.764059, 4.835680},
+    {2940000UL, 45.764072, 4.835710},
+    {2970000UL, 45.764067, 4.835638},
+    {3000000UL, 45.764027, 4.835672},
+    {3030000UL, 45.764065, 4.835707},
+    {3060000UL, 45.764047, 4.835697},
+    {3090000UL, 45.764035, 4.835695},
+    {3120000UL, 45.764037, 4.835651},
+    {3150000UL, 45.764053, 4.835656},
+    {3180000UL, 45.764096, 4.835694},
+    {3210000UL, 45.764043, 4.835709},
+    {3240000UL, 45.764025, 4.835672},
+    {3270000UL, 45.764029, 4.835628},
+    {3300000UL, 45.764100, 4.835667},
+    {3330000UL, 45.764060, 4.835700},
+    {3360000UL, 45.764006, 4.835723},
+    {3390000UL, 45.764024, 4.835707},
+    {3420000UL, 45.764052, 4.835696},
+    {3450000UL, 45.764062, 4.835654},
+    {3480000UL, 45.764065, 4.835649},
+    {3510000UL, 45.764069, 4.835649},
+    {3540000UL, 45.764069, 4.835639},
+    {3570000UL, 45.764033, 4.835626},
+    {3610000UL, 45.764101, 4.835602},
+    {3620000UL, 45.764124, 4.835584},
+    {3630000UL, 45.764173, 4.835594},
+    {3640000UL, 45.764165, 4.835588},
+    {3650000UL, 45.764165, 4.835599},
+    {3660000UL, 45.764177, 4.835523},
+    {3670000UL, 45.764197, 4.835434},
+    {3680000UL, 45.764219, 4.835464},
+    {3690000UL, 45.764211, 4.835484},
+    {3700000UL, 45.764205, 4.835481},
+    {3710000UL, 45.764176, 4.835526},
+    {3720000UL, 45.764087, 4.835602},
+    {3730000UL, 45.764065, 4.835647},
+    {3740000UL, 45.764063, 4.835625},
+    {3750000UL, 45.764060, 4.835612},
+    {3760000UL, 45.764061, 4.835608},
+    {3770000UL, 45.764059, 4.835587},
+    {3780000UL, 45.764044, 4.835586},
+    {3790000UL, 45.764055, 4.835592},
+    {3800000UL, 45.764018, 4.835624},
+    {3810000UL, 45.763996, 4.835663},
+    {3820000UL, 45.763937, 4.835673},
+    {3830000UL, 45.763964, 4.835747},
+    {3840000UL, 45.763913, 4.835777},
+    {3850000UL, 45.763908, 4.835827},
+    {3860000UL, 45.763964, 4.835830},
+    {3870000UL, 45.764014, 4.835837},
+    {3880000UL, 45.763991, 4.835848},
+    {3890000UL, 45.764045, 4.835893},
+    {3900000UL, 45.764111, 4.835898},
+    {3910000UL, 45.764153, 4.835866},
+    {3920000UL, 45.764208, 4.835867},
+    {3930000UL, 45.764243, 4.835885},
+    {3940000UL, 45.764174, 4.835874},
+    {3950000UL, 45.764153, 4.835888},
+    {3960000UL, 45.764155, 4.835880},
+    {3970000UL, 45.764179, 4.835882},
+    {3980000UL, 45.764139, 4.835888},
+    {3990000UL, 45.764100, 4.835870},
+    {4000000UL, 45.764054, 4.835836},
+    {4010000UL, 45.764007, 4.835777},
+    {4020000UL, 45.763997, 4.835800},
+    {4030000UL, 45.764026, 4.835728},
+    {4040000UL, 45.764040, 4.835730},
+    {4050000UL, 45.764044, 4.835663},
+    {4060000UL, 45.764056, 4.835692},
+    {4070000UL, 45.764070, 4.835592},
+    {4080000UL, 45.764097, 4.835577},
+    {4090000UL, 45.764100, 4.835580},
+    {4100000UL, 45.764107, 4.835532},
+    {4110000UL, 45.764109, 4.835467},
+    {4120000UL, 45.764152, 4.835462},
+    {4130000UL, 45.764196, 4.835507},
+    {4140000UL, 45.764247, 4.835595},
+    {4150000UL, 45.764238, 4.835592},
+    {4160000UL, 45.764188, 4.835610},
+    {4170000UL, 45.764164, 4.835549},
+    {4180000UL, 45.764151, 4.835500},
+    {4190000UL, 45.764157, 4.835389},
+    {4200000UL, 45.764088, 4.835438},
+    {4210000UL, 45.764044, 4.835387},
+    {4220000UL, 45.763988, 4.835433},
+    {4230000UL, 45.763982, 4.835478},
+    {4240000UL, 45.763947, 4.835536},
+    {4250000UL, 45.763922, 4.835509},
+    {4260000UL, 45.763915, 4.835530},
+    {4270000UL, 45.763938, 4.835573},
+    {4280000UL, 45.763913, 4.835526},
+    {4290000UL, 45.763885, 4.835607},
+    {4300000UL, 45.763850, 4.835580},
+    {4310000UL, 45.763873, 4.835518},
+    {4320000UL, 45.763885, 4.835519},
+    {4330000UL, 45.763886, 4.835546},
+    {4340000UL, 45.763902, 4.835499},
+    {4350000UL, 45.763884, 4.835487},
+    {4360000UL, 45.763874, 4.835587},
+    {4370000UL, 45.763853, 4.835661},
+    {4380000UL, 45.763809, 4.835753},
+    {4390000UL, 45.763791, 4.835735},
+    {4400000UL, 45.763802, 4.835772},
+    {4410000UL, 45.763819, 4.835797},
+    {4420000UL, 45.763847, 4.835820},
+    {4430000UL, 45.763916, 4.835864},
+    {4440000UL, 45.763909, 4.835868},
+    {4450000UL, 45.763953, 4.835917},
+    {4460000UL, 45.763950, 4.835912},
+    {4470000UL, 45.763945, 4.835897},
+    {4480000UL, 45.763973, 4.835896},
+    {4490000UL, 45.763913, 4.835968},
+    {4500000UL, 45.763914, 4.835956},
+    {4510000UL, 45.764041, 4.836049},
+    {4520000UL, 45.764135, 4.836101},
+    {4530000UL, 45.764239, 4.836184},
+    {4540000UL, 45.764361, 4.836247},
+    {4550000UL, 45.764491, 4.836342},
+    {4560000UL, 45.764583, 4.836316},
+    {4570000UL, 45.764692, 4.836348},
+    {4580000UL, 45.764850, 4.836419},
+    {4590000UL, 45.764967, 4.836496},
+    {4600000UL, 45.765073, 4.836535},
+    {4610000UL, 45.765168, 4.836575},
+    {4620000UL, 45.765292, 4.836598},
+    {4630000UL, 45.765363, 4.836662},
+    {4640000UL, 45.765371, 4.836641},
+    {4650000UL, 45.765386, 4.836776},
+    {4660000UL, 45.765348, 4.836932},
+    {4670000UL, 45.765275, 4.837110},
+    {4680000UL, 45.765257, 4.837248},
+    {4690000UL, 45.765255, 4.837455},
+    {4700000UL, 45.765296, 4.837615},
+    {4710000UL, 45.765353, 4.837739},
+    {4720000UL, 45.765385, 4.837968},
+    {4730000UL, 45.765369, 4.838135},
+    {4740000UL, 45.765349, 4.838347},
+    {4750000UL, 45.765311, 4.838483},
+    {4760000UL, 45.765272, 4.838624},
+    {4770000UL, 45.765230, 4.838789},
+    {4780000UL, 45.765191, 4.838934},
+    {4790000UL, 45.765144, 4.839067},
+    {4800000UL, 45.765035, 4.839272},
+    {4810000UL, 45.765004, 4.839414},
+    {4820000UL, 45.764975, 4.839644},
+    {4830000UL, 45.764981, 4.839847},
+    {4840000UL, 45.764977, 4.839976},
+    {4850000UL, 45.765038, 4.840133},
+    {4860000UL, 45.765072, 4.840308},
+    {4870000UL, 45.765117, 4.840533},
+    {4880000UL, 45.765108, 4.840717},
+    {4890000UL, 45.765157, 4.840915},
+    {4900000UL, 45.765169, 4.840948},
+    {4900000UL, 45.765170, 4.840936},
+    {4910000UL, 45.765164, 4.840928},
+    {4920000UL, 45.765162, 4.840911},
+    {4930000UL, 45.765181, 4.840914},
+    {4940000UL, 45.765186, 4.840928},
+    {4950000UL, 45.765183, 4.840915},
+    {4970000UL, 45.765319, 4.840959},
+    {4980000UL, 45.765466, 4.840931},
+    {4990000UL, 45.765592, 4.840942},
+    {5000000UL, 45.765743, 4.840901},
+    {5010000UL, 45.765811, 4.840923},
+    {5020000UL, 45.765975, 4.840970},
+    {5030000UL, 45.766088, 4.840947},
+    {5040000UL, 45.766181, 4.840922},
+    {5050000UL, 45.766338, 4.840912},
+    {5060000UL, 45.766447, 4.840909},
+    {5070000UL, 45.766584, 4.840905},
+    {5080000UL, 45.766666, 4.840919},
+    {5090000UL, 45.766783, 4.840971},
+    {5100000UL, 45.766947, 4.841039},
+    {5110000UL, 45.767070, 4.841116},
+    {5120000UL, 45.767168, 4.841133},
+    {5130000UL, 45.767309, 4.841113},
+    {5140000UL, 45.767430, 4.841100},
+    {5150000UL, 45.767535, 4.841109},
+    {5160000UL, 45.767675, 4.841110},
+    {5170000UL, 45.767747, 4.841103},
+    {5180000UL, 45.767883, 4.841050},
+    {5190000UL, 45.768063, 4.841014},
+    {5200000UL, 45.768172, 4.841015},
+    {5210000UL, 45.768272, 4.840985},
+    {5220000UL, 45.768427, 4.840998},
+    {5230000UL, 45.768565, 4.840928},
+    {5240000UL, 45.768716, 4.840933},
+    {5250000UL, 45.768868, 4.840909},
+    {5260000UL, 45.768943, 4.840885},
+    {5260000UL, 45.768951, 4.840859},
+    {5270000UL, 45.768934, 4.840828},
+    {5280000UL, 45.768929, 4.840832},
+    {5290000UL, 45.768920, 4.840857},
+    {5300000UL, 45.768875, 4.840876},
+    {5310000UL, 45.768879, 4.840882},
+    {5330000UL, 45.768809, 4.841019},
+    {5340000UL, 45.768744, 4.841146},
+    {5350000UL, 45.768672, 4.841266},
+    {5360000UL, 45.768577, 4.841401},
+    {5370000UL, 45.768508, 4.841577},
+    {5380000UL, 45.768387, 4.841740},
+    {5390000UL, 45.768301, 4.841865},
+    {5400000UL, 45.768243, 4.842027},
+    {5410000UL, 45.768189, 4.842206},
+    {5420000UL, 45.768150, 4.842364},
+    {5430000UL, 45.768094, 4.842553},
+    {5440000UL, 45.768030, 4.842739},
+    {5450000UL, 45.767979, 4.842823},
+    {5460000UL, 45.767873, 4.842914},
+    {5470000UL, 45.767744, 4.843015},
+    {5480000UL, 45.767625, 4.843167},
+    {5490000UL, 45.767538, 4.843275},
+    {5500000UL, 45.767447, 4.843365},
+    {5510000UL, 45.767455, 4.843395},
+    {5510000UL, 45.767443, 4.843390},
+    {5520000UL, 45.767441, 4.843392},
+    {5540000UL, 45.767289, 4.843442},
+    {5550000UL, 45.767212, 4.843475},
+    {5560000UL, 45.767093, 4.843465},
+    {5570000UL, 45.766955, 4.843475},
+    {5580000UL, 45.766798, 4.843521},
+    {5590000UL, 45.766671, 4.843615},
+    {5600000UL, 45.766608, 4.843619},
+    {5610000UL, 45.766470, 4.843738},
+    {5620000UL, 45.766381, 4.843778},
+    {5630000UL, 45.766237, 4.843845},
+    {5640000UL, 45.766105, 4.843948},
+    {5650000UL, 45.765997, 4.844024},
+    {5660000UL, 45.765844, 4.844084},
+    {5670000UL, 45.765736, 4.844124},
+    {5680000UL, 45.765597, 4.844107},
+    {5690000UL, 45.765423, 4.844090},
+    {5700000UL, 45.765310, 4.844075},
+    {5710000UL, 45.765220, 4.844094},
+    {5720000UL, 45.765097, 4.844085},
+    {5730000UL, 45.764977, 4.844208},
+    {5740000UL, 45.764929, 4.844192},
+    {5740000UL, 45.764928, 4.844162},
+    {5750000UL, 45.764904, 4.844144},
+    {5760000UL, 45.764866, 4.844121},
+    {5780000UL, 45.764888, 4.843912},
+    {5790000UL, 45.764900, 4.843832},
+    {5800000UL, 45.764907, 4.843716},
+    {5810000UL, 45.764960, 4.843489},
+    {5820000UL, 45.764999, 4.843334},
+    {5830000UL, 45.765029, 4.843109},
+    {5840000UL, 45.765042, 4.842947},
+    {5850000UL, 45.765023, 4.842787},
+    {5860000UL, 45.765016, 4.842611},
+    {5870000UL, 45.765045, 4.842366},
+    {5880000UL, 45.765086, 4.842178},
+    {5890000UL, 45.765099, 4.841954},
+    {5900000UL, 45.765117, 4.841743},
+    {5910000UL, 45.765104, 4.841543},
+    {5920000UL, 45.765098, 4.841371},
+    {5930000UL, 45.765101, 4.841157},
+    {5940000UL, 45.765117, 4.841008},
+    {5950000UL, 45.765125, 4.840803},
+    {5960000UL, 45.765142, 4.840661},
+    {5970000UL, 45.765164, 4.840489},
+    {5980000UL, 45.765139, 4.840298},
+    {5990000UL, 45.765101, 4.840109},
+    {6000000UL, 45.765118, 4.839940},
+    {6010000UL, 45.765178, 4.839745},
+    {6020000UL, 45.765220, 4.839598},
+    {6030000UL, 45.765261, 4.839413},
+    {6040000UL, 45.765300, 4.839255},
+    {6050000UL, 45.765366, 4.839064},
+    {6060000UL, 45.765365, 4.838918},
+    {6070000UL, 45.765403, 4.838750},
+    {6080000UL, 45.765456, 4.838587},
+    {6090000UL, 45.765520, 4.838378},
+    {6100000UL, 45.765601, 4.838191},
+    {6110000UL, 45.765625, 4.837974},
+    {6120000UL, 45.765674, 4.837799},
+    {6130000UL, 45.765688, 4.837727},
+    {6130000UL, 45.765717, 4.837724},
+    {6150000UL, 45.765604, 4.837680},
+    {6160000UL, 45.765504, 4.837623},
+    {6170000UL, 45.765401, 4.837571},
+    {6180000UL, 45.765275, 4.837505},
+    {6190000UL, 45.765196, 4.837467},
+    {6200000UL, 45.765126, 4.837407},
+    {6210000UL, 45.765040, 4.837336},
+    {6220000UL, 45.764943, 4.837230},
+    {6230000UL, 45.764830, 4.837107},
+    {6240000UL, 45.764799, 4.836964},
+    {6250000UL, 45.764725, 4.836889},
+    {6260000UL, 45.764681, 4.836766},
+    {6270000UL, 45.764618, 4.836686},
+    {6280000UL, 45.764521, 4.836551},
+    {6290000UL, 45.764430, 4.836454},
+    {6300000UL, 45.764353, 4.836347},
+    {6310000UL, 45.764289, 4.836222},
+    {6320000UL, 45.764225, 4.836092},
+    {6330000UL, 45.764148, 4.835981},
+    {6340000UL, 45.764073, 4.835833},
+    {6350000UL, 45.763989, 4.835744},
+    {6360000UL, 45.763901, 4.835642},
+    {6370000UL, 45.763809, 4.835556},
+    {6380000UL, 45.763747, 4.835446},
+    {6390000UL, 45.763658, 4.835364},
+    {6400000UL, 45.763565, 4.835236},
+    {6410000UL, 45.763486, 4.835151},
+    {6420000UL, 45.763380, 4.835027},
+    {6430000UL, 45.763299, 4.834949},
+    {6440000UL, 45.763215, 4.834862},
+    {6450000UL, 45.763137, 4.834745},
+    {6460000UL, 45.763117, 4.834726},
+    {6460000UL, 45.763135, 4.834784},
+    {6470000UL, 45.763147, 4.834741},
+    {6480000UL, 45.763119, 4.834764},
+    {6490000UL, 45.763110, 4.834713},
+    {6500000UL, 45.763118, 4.834720},
+    {6510000UL, 45.763102, 4.834684},
+    {6530000UL, 45.763125, 4.834535},
+    {6540000UL, 45.763133, 4.834405},
+    {6550000UL, 45.763200, 4.834240},
+    {6560000UL, 45.763267, 4.834110},
+    {6570000UL, 45.763325, 4.833951},
+    {6580000UL, 45.763419, 4.833874},
+    {6590000UL, 45.763506, 4.833768},
+    {6600000UL, 45.763614, 4.833711},
+    {6610000UL, 45.763711, 4.833595},
+    {6620000UL, 45.763808, 4.833491},
+    {6630000UL, 45.763887, 4.833399},
+    {6640000UL, 45.763971, 4.833351},
+    {6650000UL, 45.763979, 4.833320},
+    {6650000UL, 45.763996, 4.833327},
+    {6660000UL, 45.763991, 4.833307},
+    {6680000UL, 45.763999, 4.833516},
+    {6690000UL, 45.764017, 4.833713},
+    {6700000UL, 45.764029, 4.833837},
+    {6710000UL, 45.764037, 4.834056},
+    {6720000UL, 45.764056, 4.834260},
+    {6730000UL, 45.764052, 4.834412},
+    {6740000UL, 45.764041, 4.834563},
+    {6750000UL, 45.764059, 4.834719},
+    {6760000UL, 45.764060, 4.834926},
+    {6770000UL, 45.764110, 4.835120},
+    {6780000UL, 45.764156, 4.835284},
+    {6790000UL, 45.764199, 4.835481},
+    {6800000UL, 45.764181, 4.835673},
+    {6800000UL, 45.764027, 4.835683},
+    {6830000UL, 45.764013, 4.835694},
+    {6860000UL, 45.764062, 4.835692},
+    {6890000UL, 45.764023, 4.835687},
+    {6920000UL, 45.764063, 4.835658},
+    {6950000UL, 45.764059, 4.835601},
+    {6980000UL, 45.764046, 4.835636},
+    {7010000UL, 45.764076, 4.835635},
+    {7040000UL, 45.764079, 4.835633},
+    {7070000UL, 45.764067, 4.835633},
+    {7100000UL, 45.764068, 4.835655},
+    {7130000UL, 45.764093, 4.835654},
+    {7160000UL, 45.764059, 4.835671},
+    {7190000UL, 45.763996, 4.835699},
+    {7220000UL, 45.764036, 4.835688},
+    {7250000UL, 45.764049, 4.835740},
+    {7280000UL, 45.764064, 4.835686},
+    {7310000UL, 45.764072, 4.835685},
+    {7340000UL, 45.764033, 4.835643},
+    {7370000UL, 45.764084, 4.835671},
+    {7400000UL, 45.764037, 4.835700},
+    {7430000UL, 45.764026, 4.835652},
+    {7460000UL, 45.764036, 4.835671},
+    {7490000UL, 45.764047, 4.835611},
+    {7520000UL, 45.764033, 4.835633},
+    {7550000UL, 45.764022, 4.835609},
+    {7580000UL, 45.764032, 4.835639},
+    {7610000UL, 45.764027, 4.835701},
+    {7640000UL, 45.764053, 4.835698},
+    {7670000UL, 45.764032, 4.835686},
+    {7700000UL, 45.764023, 4.835745},
+    {7730000UL, 45.764046, 4.835756},
+    {7760000UL, 45.764042, 4.835718},
+    {7790000UL, 45.764033, 4.835718},
+    {7820000UL, 45.764044, 4.835664},
+    {7850000UL, 45.764023, 4.835650},
+    {7880000UL, 45.764058, 4.835636},
+    {7910000UL, 45.764039, 4.835664},
+    {7940000UL, 45.764016, 4.835655},
+    {7970000UL, 45.764021, 4.835654},
+    {8000000UL, 45.764027, 4.835676},
+    {8030000UL, 45.764037, 4.835691},
+    {8060000UL, 45.764021, 4.835697},
+    {8090000UL, 45.764001, 4.835700},
+    {8120000UL, 45.764020, 4.835712},
+    {8150000UL, 45.764008, 4.835711},
+    {8180000UL, 45.764026, 4.835645},
+    {8210000UL, 45.764045, 4.835596},
+    {8240000UL, 45.764058, 4.835651},
+    {8270000UL, 45.764054, 4.835685},
+    {8300000UL, 45.764066, 4.835697},
+    {8330000UL, 45.764040, 4.835667},
+    {8360000UL, 45.764049, 4.835686},
+    {8390000UL, 45.764075, 4.835656},
+    {8420000UL, 45.764028, 4.835682},
+    {8450000UL, 45.764033, 4.835746},
+    {8480000UL, 45.764065, 4.835732},
+    {8510000UL, 45.764096, 4.835735},
+    {8540000UL, 45.764122, 4.835751},
+    {8570000UL, 45.764094, 4.835745},
+    {8600000UL, 45.764055, 4.835653},
+    {8630000UL, 45.764097, 4.835656},
+    {8660000UL, 45.764049, 4.835566},
+    {8690000UL, 45.764034, 4.835602},
+    {8720000UL, 45.764056, 4.835580},
+    {8750000UL, 45.764046, 4.835526},
+    {8780000UL, 45.764009, 4.835543},
+    {8810000UL, 45.764033, 4.835604},
+    {8840000UL, 45.764026, 4.835619},
+    {8870000UL, 45.764016, 4.835658},
+    {8900000UL, 45.764028, 4.835671},
+    {8930000UL, 45.764014, 4.835673},
+    {8960000UL, 45.763998, 4.835653},
+    {8990000UL, 45.764019, 4.835699},
+    {9020000UL, 45.764033, 4.835682},
+    {9050000UL, 45.764056, 4.835626},
+    {9080000UL, 45.764072, 4.835643},
+    {9110000UL, 45.764044, 4.835693},
+    {9140000UL, 45.764024, 4.835693},
+    {9170000UL, 45.764035, 4.835719},
+    {9200000UL, 45.764065, 4.835650},
+    {9230000UL, 45.764054, 4.835624},
+    {9260000UL, 45.764049, 4.835663},
+    {9290000UL, 45.764042, 4.835698},
+    {9320000UL, 45.764024, 4.835602},
+    {9350000UL, 45.764030, 4.835620},
+    {9380000UL, 45.764026, 4.835573},
+    {9410000UL, 45.764043, 4.835639},
+    {9440000UL, 45.764094, 4.835650},
+    {9470000UL, 45.764098, 4.835669},
+    {9500000UL, 45.764085, 4.835621},
+    {9530000UL, 45.764091, 4.835668},
+    {9560000UL, 45.764095, 4.835644},
+    {9590000UL, 45.764050, 4.835628},
+    {9620000UL, 45.764033, 4.835637},
+    {9650000UL, 45.764071, 4.835689},
+    {9680000UL, 45.764057, 4.835683},
+    {9710000UL, 45.764071, 4.835670},
+    {9740000UL, 45.764100, 4.835649},
+    {9770000UL, 45.764057, 4.835645},
+    {9800000UL, 45.764029, 4.835689},
+    {9830000UL, 45.764028, 4.835607},
+    {9860000UL, 45.764008, 4.835619},
+    {9890000UL, 45.764014, 4.835630},
+    {9920000UL, 45.764046, 4.835586},
+    {9950000UL, 45.764065, 4.835571},
+    {9980000UL, 45.764022, 4.835605},
+    {10010000UL, 45.764047, 4.835645},
+    {10040000UL, 45.764019, 4.835634},
+    {10070000UL, 45.764051, 4.835639},
+    {10100000UL, 45.764066, 4.835625},
+    {10130000UL, 45.764105, 4.835613},
+    {10160000UL, 45.764073, 4.835635},
+    {10190000UL, 45.764091, 4.835672},
+    {10220000UL, 45.764099, 4.835680},
+    {10250000UL, 45.764081, 4.835630},
+    {10280000UL, 45.764045, 4.835682},
+    {10310000UL, 45.764049, 4.835658},
+    {10340000UL, 45.764042, 4.835619},
+    {10370000UL, 45.764032, 4.835672},
+    {10400000UL, 45.764062, 4.835690},
+    {10430000UL, 45.764065, 4.835690},
+    {10460000UL, 45.764065, 4.835675},
+    {10490000UL, 45.764070, 4.835713},
+    {10520000UL, 45.764025, 4.835660},
+    {10550000UL, 45.764069, 4.835683},
+    {10580000UL, 45.764074, 4.835655},
+    {10610000UL, 45.764064, 4.835670},
+    {10640000UL, 45.764071, 4.835635},
+    {10670000UL, 45.764083, 4.835598},
+    {10700000UL, 45.764024, 4.835622},
+    {10730000UL, 45.764064, 4.835683},
+    {10760000UL, 45.764075, 4.835698},
+    {10790000UL, 45.764042, 4.835716},
+    {10820000UL, 45.764038, 4.835697},
+    {10850000UL, 45.764043, 4.835684},
+    {10880000UL, 45.764073, 4.835709},
+    {10910000UL, 45.764053, 4.835672},
+    {10940000UL, 45.764045, 4.835611},
+    {10970000UL, 45.764035, 4.835611},
+    {11000000UL, 45.764050, 4.835640},
+    {11030000UL, 45.764055, 4.835680},
+    {11060000UL, 45.764009, 4.835658},
+    {11090000UL, 45.764058, 4.835619},
+    {11120000UL, 45.764029, 4.835598},
+    {11150000UL, 45.764014, 4.835585},
+    {11180000UL, 45.763988, 4.835616},
+    {11210000UL, 45.763992, 4.835576},
+    {11240000UL, 45.763996, 4.835536},
+    {11270000UL, 45.763998, 4.835600},
+    {11300000UL, 45.764002, 4.835633},
+    {11330000UL, 45.764015, 4.835588},
+    {11360000UL, 45.764015, 4.835565},
+    {11390000UL, 45.764058, 4.835609},
+    {11420000UL, 45.764052, 4.835564},
+    {11450000UL, 45.764000, 4.835553},
+    {11480000UL, 45.764032, 4.835561},
+    {11510000UL, 45.764026, 4.835659},
+    {11540000UL, 45.764043, 4.835648},
+    {11570000UL, 45.764060, 4.835619},
+    {11600000UL, 45.764038, 4.835651},
+    {11630000UL, 45.764068, 4.835643},
+    {11660000UL, 45.764085, 4.835633},
+    {11690000UL, 45.764044, 4.835628},
+    {11720000UL, 45.764056, 4.835620},
+    {11750000UL, 45.764056, 4.835701},
+    {11780000UL, 45.764009, 4.835699},
+    {11810000UL, 45.764039, 4.835707},
+    {11840000UL, 45.764039, 4.835640},
+    {11870000UL, 45.764043, 4.835674},
+    {11900000UL, 45.764050, 4.835660},
+    {11930000UL, 45.764041, 4.835700},
+    {11960000UL, 45.764053, 4.835701},
+    {11990000UL, 45.764046, 4.835658},
+    {12020000UL, 45.764032, 4.835629},
+    {12050000UL, 45.764039, 4.835665},
+    {12080000UL, 45.764005, 4.835691},
+    {12110000UL, 45.764006, 4.835639},
+    {12140000UL, 45.764038, 4.835627},
+    {12170000UL, 45.764047, 4.835661},
+    {12210000UL, 45.763978, 4.835757},
+    {12220000UL, 45.763907, 4.835880},
+    {12230000UL, 45.763822, 4.836036},
+    {12240000UL, 45.763808, 4.836184},
+    {12250000UL, 45.763747, 4.836307},
+    {12260000UL, 45.763697, 4.836462},
+    {12270000UL, 45.763666, 4.836606},
+    {12280000UL, 45.763630, 4.836771},
+    {12290000UL, 45.763567, 4.836952},
+    {12300000UL, 45.763570, 4.837027},
+    {12310000UL, 45.762706, 4.838209},
+    {12320000UL, 45.761929, 4.839276},
+    {12330000UL, 45.761025, 4.840314},
+    {12340000UL, 45.760226, 4.841239},
+    {12350000UL, 45.759463, 4.842058},
+    {12360000UL, 45.758883, 4.842812},
+    {12370000UL, 45.758046, 4.843631},
+    {12380000UL, 45.757293, 4.844524},
+    {12390000UL, 45.756504, 4.845420},
+    {12400000UL, 45.755780, 4.846329},
+    {12410000UL, 45.754840, 4.847362},
+    {12420000UL, 45.754060, 4.848246},
+    {12430000UL, 45.753305, 4.849084},
+    {12440000UL, 45.752674, 4.849776},
+    {12450000UL, 45.751789, 4.850809},
+    {12460000UL, 45.751114, 4.851707},
+    {12470000UL, 45.750450, 4.852598},
+    {12480000UL, 45.749761, 4.853491},
+    {12490000UL, 45.749030, 4.854542},
+    {12500000UL, 45.748229, 4.855619},
+    {12510000UL, 45.747619, 4.856484},
+    {12520000UL, 45.746814, 4.857575},
+    {12530000UL, 45.746028, 4.858742},
+    {12540000UL, 45.745319, 4.859721},
+    {12550000UL, 45.744763, 4.860619},
+    {12560000UL, 45.743971, 4.861783},
+    {12570000UL, 45.743260, 4.862811},
+    {12580000UL, 45.742624, 4.863756},
+    {12590000UL, 45.741916, 4.864937},
+    {12600000UL, 45.741110, 4.865910},
+    {12610000UL, 45.740449, 4.866774},
+    {12620000UL, 45.739581, 4.867986},
+    {12630000UL, 45.738931, 4.868976},
+    {12640000UL, 45.738324, 4.869931},
+    {12650000UL, 45.737567, 4.871189},
+    {12660000UL, 45.736869, 4.872270},
+    {12670000UL, 45.736178, 4.873287},
+    {12680000UL, 45.735444, 4.874263},
+    {12690000UL, 45.734626, 4.875340},
+    {12700000UL, 45.733861, 4.876298},
+    {12710000UL, 45.733197, 4.877080},
+    {12720000UL, 45.732288, 4.877982},
+    {12730000UL, 45.731584, 4.878678},
+    {12740000UL, 45.730795, 4.879319},
+    {12750000UL, 45.729926, 4.880031},
+    {12760000UL, 45.728917, 4.880931},
+    {12770000UL, 45.728078, 4.881848},
+    {12780000UL, 45.727192, 4.882834},
+    {12790000UL, 45.726355, 4.883693},
+    {12800000UL, 45.725610, 4.884624},
+    {12810000UL, 45.724961, 4.885267},
+    {12820000UL, 45.724297, 4.885898},
+    {12830000UL, 45.723273, 4.886695},
+    {12840000UL, 45.722266, 4.887586},
+    {12850000UL, 45.721345, 4.888370},
+    {12860000UL, 45.720597, 4.889105},
+    {12870000UL, 45.719876, 4.889896},
+    {12880000UL, 45.719208, 4.890720},
+    {12890000UL, 45.718303, 4.891712},
+    {12900000UL, 45.717595, 4.892482},
+    {12910000UL, 45.716770, 4.893220},
+    {12920000UL, 45.715846, 4.894086},
+    {12930000UL, 45.714864, 4.895031},
+    {12940000UL, 45.714150, 4.895684},
+    {12950000UL, 45.713215, 4.896368},
+    {12960000UL, 45.712203, 4.897065},
+    {12970000UL, 45.711274, 4.897700},
+    {12980000UL, 45.710412, 4.898145},
+    {12990000UL, 45.709592, 4.898570},
+    {13000000UL, 45.708601, 4.899107},
+    {13010000UL, 45.707554, 4.899511},
+    {13020000UL, 45.706596, 4.899904},
+    {13030000UL, 45.705515, 4.900420},
+    {13040000UL, 45.704469, 4.900905},
+    {13050000UL, 45.703684, 4.901368},
+    {13060000UL, 45.702754, 4.901886},
+    {13070000UL, 45.701825, 4.902388},
+    {13080000UL, 45.700912, 4.902940},
+    {13090000UL, 45.700048, 4.903308},
+    {13100000UL, 45.699237, 4.903573},
+    {13110000UL, 45.698754, 4.903687},
+    {13120000UL, 45.698759, 4.903692},
+    {13130000UL, 45.698828, 4.904070},
+    {13140000UL, 45.698840, 4.904253},
+    {13150000UL, 45.698743, 4.904565},
+    {13160000UL, 45.698624, 4.904740},
+    {13170000UL, 45.698633, 4.904907},
+    {13180000UL, 45.698608, 4.905197},
+    {13190000UL, 45.698595, 4.905208},
+    {13200000UL, 45.698601, 4.905239},
+    {13210000UL, 45.698558, 4.905502},
+    {13220000UL, 45.698788, 4.905459},
+    {13230000UL, 45.698773, 4.905425},
+    {13240000UL, 45.698784, 4.905428},
+    {13250000UL, 45.698990, 4.905348},
+    {13260000UL, 45.698838, 4.905070},
+    {13270000UL, 45.698845, 4.905102},
+    {13280000UL, 45.698659, 4.905023},
+    {13290000UL, 45.698524, 4.905195},
+    {13300000UL, 45.698498, 4.905233},
+    {13310000UL, 45.698394, 4.904881},
+    {13320000UL, 45.698402, 4.904868},
+    {13330000UL, 45.698374, 4.904865},
+    {13340000UL, 45.698193, 4.904594},
+    {13350000UL, 45.698047, 4.904385},
+    {13360000UL, 45.698018, 4.904108},
+    {13370000UL, 45.698012, 4.903950},
+    {13380000UL, 45.698073, 4.903785},
+    {13390000UL, 45.698191, 4.903490},
+    {13400000UL, 45.698196, 4.903541},
+    {13410000UL, 45.698197, 4.903512},
+    {13420000UL, 45.698279, 4.903253},
+    {13430000UL, 45.698299, 4.903277},
+    {13440000UL, 45.698306, 4.903281},
+    {13450000UL, 45.698316, 4.903310},
+    {13460000UL, 45.698321, 4.903146},
+    {13470000UL, 45.698317, 4.903157},
+    {13480000UL, 45.698287, 4.902961},
+    {13490000UL, 45.698310, 4.903005},
+    {13500000UL, 45.698310, 4.902861},
+    {13510000UL, 45.698428, 4.902523},
+    {13520000UL, 45.698731, 4.902571},
+    {13530000UL, 45.698800, 4.902370},
+    {13540000UL, 45.698850, 4.902168},
+    {13550000UL, 45.698805, 4.901988},
+    {13560000UL, 45.698840, 4.901724},
+    {13570000UL, 45.698588, 4.901937},
+    {13580000UL, 45.698448, 4.902231},
+    {13590000UL, 45.698606, 4.902538},
+    {13600000UL, 45.698587, 4.902764},
+    {13610000UL, 45.698589, 4.902763},
+    {13620000UL, 45.698570, 4.902755},
+    {13630000UL, 45.698409, 4.902761},
+    {13640000UL, 45.698388, 4.902760},
+    {13650000UL, 45.698211, 4.902986},
+    {13660000UL, 45.698093, 4.902749},
+    {13670000UL, 45.697846, 4.902777},
+    {13680000UL, 45.697850, 4.902771},
+    {13690000UL, 45.697518, 4.902889},
+    {13700000UL, 45.697648, 4.903035},
+    {13710000UL, 45.697679, 4.903012},
+    {13720000UL, 45.697705, 4.903006},
+    {13730000UL, 45.697852, 4.903280},
+    {13740000UL, 45.698021, 4.903349},
+    {13750000UL, 45.698073, 4.903123},
+    {13760000UL, 45.698119, 4.902810},
+    {13770000UL, 45.698214, 4.902392},
+    {13780000UL, 45.698347, 4.902196},
+    {13790000UL, 45.698552, 4.902061},
+    {13800000UL, 45.698861, 4.901941},
+    {13810000UL, 45.699001, 4.901965},
+    {13820000UL, 45.699018, 4.901978},
+    {13830000UL, 45.699245, 4.902062},
+    {13840000UL, 45.699569, 4.902119},
+    {13850000UL, 45.699589, 4.902131},
+    {13860000UL, 45.699485, 4.902083},
+    {13870000UL, 45.699478, 4.902301},
+    {13880000UL, 45.699206, 4.902488},
+    {13890000UL, 45.699051, 4.902750},
+    {13900000UL, 45.698958, 4.903189},
+    {13910000UL, 45.698936, 4.903310},
+    {13920000UL, 45.698687, 4.903469},
+    {13930000UL, 45.698585, 4.903598},
+    {13940000UL, 45.698591, 4.903605},
+    {13950000UL, 45.698499, 4.903306},
+    {13960000UL, 45.698410, 4.903182},
+    {13970000UL, 45.698253, 4.902826},
+    {13980000UL, 45.698280, 4.902478},
+    {13990000UL, 45.698277, 4.902475},
+    {14000000UL, 45.698273, 4.902451},
+    {14010000UL, 45.698285, 4.902461},
+    {14020000UL, 45.698489, 4.902162},
+    {14030000UL, 45.698485, 4.902135},
+    {14040000UL, 45.698493, 4.902113},
+    {14050000UL, 45.698514, 4.901781},
+    {14060000UL, 45.698533, 4.901776},
+    {14070000UL, 45.698714, 4.901831},
+    {14080000UL, 45.698823, 4.901956},
+    {14090000UL, 45.698886, 4.902310},
+    {14100000UL, 45.698851, 4.902682},
+    {14110000UL, 45.699105, 4.902843},
+    {14120000UL, 45.699076, 4.902864},
+    {14130000UL, 45.699174, 4.903182},
+    {14140000UL, 45.699251, 4.903265},
+    {14150000UL, 45.699404, 4.903505},
+    {14160000UL, 45.699616, 4.903450},
+    {14170000UL, 45.699632, 4.903295},
+    {14180000UL, 45.699644, 4.903133},
+    {14190000UL, 45.699634, 4.903124},
+    {14200000UL, 45.699399, 4.902987},
+    {14210000UL, 45.699325, 4.902743},
+    {14220000UL, 45.699330, 4.902769},
+    {14230000UL, 45.699279, 4.902593},
+    {14240000UL, 45.699275, 4.902578},
+    {14250000UL, 45.699274, 4.902571},
+    {14260000UL, 45.699269, 4.902561},
+    {14270000UL, 45.699040, 4.902297},
+    {14280000UL, 45.698841, 4.902524},
+    {14290000UL, 45.698816, 4.902774},
+    {14300000UL, 45.698889, 4.902835},
+    {14310000UL, 45.698888, 4.902824},
+    {14320000UL, 45.698889, 4.902821},
+    {14330000UL, 45.699042, 4.902683},
+    {14340000UL, 45.699185, 4.902585},
+    {14350000UL, 45.699004, 4.902283},
+    {14360000UL, 45.698885, 4.902381},
+    {14370000UL, 45.698722, 4.902454},
+    {14380000UL, 45.698712, 4.902457},
+    {14390000UL, 45.698526, 4.902197},
+    {14400000UL, 45.698545, 4.902194},
+    {14410000UL, 45.698402, 4.902206},
+    {14420000UL, 45.698365, 4.902517},
+    {14430000UL, 45.698359, 4.902513},
+    {14440000UL, 45.698412, 4.902617},
+    {14450000UL, 45.698452, 4.902970},
+    {14460000UL, 45.698428, 4.902971},
+    {14470000UL, 45.698438, 4.902978},
+    {14480000UL, 45.698438, 4.902954},
+    {14490000UL, 45.698436, 4.902980},
+    {14500000UL, 45.698589, 4.903177},
+    {14510000UL, 45.698847, 4.903268},
+    {14520000UL, 45.698875, 4.903079},
+    {14530000UL, 45.698867, 4.903098},
+    {14540000UL, 45.698717, 4.903065},
+    {14550000UL, 45.698724, 4.903107},
+    {14560000UL, 45.698734, 4.903134},
+    {14570000UL, 45.698693, 4.903376},
+    {14580000UL, 45.698666, 4.903598},
+    {14590000UL, 45.698559, 4.903923},
+    {14600000UL, 45.698744, 4.904326},
+    {14610000UL, 45.698936, 4.904532},
+    {14620000UL, 45.699146, 4.904764},
+    {14630000UL, 45.699282, 4.904764},
+    {14640000UL, 45.699251, 4.904780},
+    {14650000UL, 45.699238, 4.904760},
+    {14660000UL, 45.699467, 4.904905},
+    {14670000UL, 45.699687, 4.904862},
+    {14680000UL, 45.699676, 4.904856},
+    {14690000UL, 45.699679, 4.904814},
+    {14700000UL, 45.699497, 4.904973},
+    {14710000UL, 45.699390, 4.904995},
+    {14720000UL, 45.699378, 4.905104},
+    {14730000UL, 45.699340, 4.905294},
+    {14740000UL, 45.699333, 4.905288},
+    {14750000UL, 45.699316, 4.905240},
+    {14760000UL, 45.699350, 4.905287},
+    {14770000UL, 45.699584, 4.904965},
+    {14780000UL, 45.699768, 4.904660},
+    {14790000UL, 45.699796, 4.904659},
+    {14800000UL, 45.699799, 4.904720},
+    {14810000UL, 45.699790, 4.904734},
+    {14820000UL, 45.699543, 4.904650},
+    {14830000UL, 45.699548, 4.904649},
+    {14840000UL, 45.699337, 4.904667},
+    {14850000UL, 45.699170, 4.904746},
+    {14860000UL, 45.699171, 4.904729},
+    {14870000UL, 45.698904, 4.904703},
+    {14880000UL, 45.698920, 4.904690},
+    {14890000UL, 45.698783, 4.904595},
+    {14900000UL, 45.698478, 4.904471},
+    {14910000UL, 45.698229, 4.904446},
+    {14920000UL, 45.699059, 4.903319},
+    {14930000UL, 45.699771, 4.902481},
+    {14940000UL, 45.700510, 4.901794},
+    {14950000UL, 45.701255, 4.900976},
+    {14960000UL, 45.702017, 4.900043},
+    {14970000UL, 45.702650, 4.899143},
+    {14980000UL, 45.703441, 4.898082},
+    {14990000UL, 45.704000, 4.897214},
+    {15000000UL, 45.704639, 4.896240},
+    {15010000UL, 45.705322, 4.895185},
+    {15020000UL, 45.706182, 4.894176},
+    {15030000UL, 45.706821, 4.893347},
+    {15040000UL, 45.707489, 4.892604},
+    {15050000UL, 45.708354, 4.891506},
+    {15060000UL, 45.709082, 4.890559},
+    {15070000UL, 45.709850, 4.889342},
+    {15080000UL, 45.710483, 4.888400},
+    {15090000UL, 45.711235, 4.887260},
+    {15100000UL, 45.711960, 4.886059},
+    {15110000UL, 45.712706, 4.884806},
+    {15120000UL, 45.713362, 4.883767},
+    {15130000UL, 45.714075, 4.882590},
+    {15140000UL, 45.714640, 4.881648},
+    {15150000UL, 45.715257, 4.880808},
+    {15160000UL, 45.715827, 4.879978},
+    {15170000UL, 45.716418, 4.879153},
+    {15180000UL, 45.717107, 4.878107},
+    {15190000UL, 45.717802, 4.876933},
+    {15200000UL, 45.718370, 4.875959},
+    {15210000UL, 45.718942, 4.874795},
+    {15220000UL, 45.719612, 4.873640},
+    {15230000UL, 45.720144, 4.872533},
+    {15240000UL, 45.720676, 4.871519},
+    {15250000UL, 45.721200, 4.870456},
+    {15260000UL, 45.721839, 4.869227},
+    {15270000UL, 45.722382, 4.868130},
+    {15280000UL, 45.723014, 4.866943},
+    {15290000UL, 45.723605, 4.865712},
+    {15300000UL, 45.724188, 4.864484},
+    {15310000UL, 45.724701, 4.863499},
+    {15320000UL, 45.725238, 4.862470},
+    {15330000UL, 45.725707, 4.861551},
+    {15340000UL, 45.726240, 4.860352},
+    {15350000UL, 45.726836, 4.859101},
+    {15360000UL, 45.727510, 4.857961},
+    {15370000UL, 45.728019, 4.857089},
+    {15380000UL, 45.728554, 4.856044},
+    {15390000UL, 45.729229, 4.854679},
+    {15400000UL, 45.729823, 4.853541},
+    {15410000UL, 45.730403, 4.852318},
+    {15420000UL, 45.730970, 4.851183},
+    {15430000UL, 45.731544, 4.850054},
+    {15440000UL, 45.732231, 4.848849},
+    {15450000UL, 45.732899, 4.847791},
+    {15460000UL, 45.733413, 4.846744},
+    {15470000UL, 45.733906, 4.845445},
+    {15480000UL, 45.734481, 4.844066},
+    {15490000UL, 45.735042, 4.842728},
+    {15500000UL, 45.735736, 4.841367},
+    {15510000UL, 45.736378, 4.840177},
+    {15520000UL, 45.737163, 4.839032},
+    {15530000UL, 45.737950, 4.838011},
+    {15540000UL, 45.738651, 4.837116},
+    {15550000UL, 45.739432, 4.836229},
+    {15560000UL, 45.740260, 4.835210},
+    {15570000UL, 45.740883, 4.834471},
+    {15580000UL, 45.741603, 4.833471},
+    {15590000UL, 45.742413, 4.832365},
+    {15600000UL, 45.743260, 4.831229},
+    {15610000UL, 45.744162, 4.830108},
+    {15620000UL, 45.744831, 4.829154},
+    {15630000UL, 45.745559, 4.828114},
+    {15640000UL, 45.746380, 4.826976},
+    {15650000UL, 45.747186, 4.825782},
+    {15660000UL, 45.747927, 4.824625},
+    {15670000UL, 45.748517, 4.823599},
+    {15680000UL, 45.749042, 4.822543},
+    {15690000UL, 45.749571, 4.821368},
+    {15700000UL, 45.750160, 4.820174},
+    {15710000UL, 45.750681, 4.819086},
+    {15720000UL, 45.751187, 4.818093},
+    {15730000UL, 45.751305, 4.817831},
+    {15740000UL, 45.751388, 4.817889},
+    {15750000UL, 45.751463, 4.817983},
+    {15760000UL, 45.751591, 4.818097},
+    {15770000UL, 45.751691, 4.818238},
+    {15780000UL, 45.751723, 4.818336},
+    {15790000UL, 45.751844, 4.818445},
+    {15800000UL, 45.751915, 4.818554},
+    {15810000UL, 45.751947, 4.818695},
+    {15820000UL, 45.752014, 4.818875},
+    {15830000UL, 45.752049, 4.819033},
+    {15840000UL, 45.752088, 4.819138},
+    {15850000UL, 45.752159, 4.819334},
+    {15860000UL, 45.752188, 4.819517},
+    {15870000UL, 45.752224, 4.819637},
+    {15880000UL, 45.752253, 4.819806},
+    {15890000UL, 45.752235, 4.819956},
+    {15900000UL, 45.752241, 4.820083},
+    {15910000UL, 45.752273, 4.820278},
+    {15920000UL, 45.752274, 4.820431},
+    {15930000UL, 45.752303, 4.820627},
+    {15940000UL, 45.752336, 4.820770},
+    {15950000UL, 45.752372, 4.820906},
+    {15960000UL, 45.752397, 4.821057},
+    {15970000UL, 45.752427, 4.821235},
+    {15980000UL, 45.752425, 4.821401},
+    {15990000UL, 45.752402, 4.821532},
+    {16000000UL, 45.752372, 4.821699},
+    {16010000UL, 45.752351, 4.821912},
+    {16020000UL, 45.752261, 4.822067},
+    {16030000UL, 45.752190, 4.822236},
+    {16040000UL, 45.752143, 4.822353},
+    {16050000UL, 45.752104, 4.822508},
+    {16060000UL, 45.752014, 4.822637},
+    {16070000UL, 45.751951, 4.822743},
+    {16080000UL, 45.751884, 4.822865},
+    {16090000UL, 45.751859, 4.823003},
+    {16100000UL, 45.751804, 4.823114},
+    {16110000UL, 45.751731, 4.823239},
+    {16120000UL, 45.751641, 4.823361},
+    {16130000UL, 45.751575, 4.823500},
+    {16140000UL, 45.751484, 4.823659},
+    {16150000UL, 45.751411, 4.823807},
+    {16160000UL, 45.751343, 4.823958},
+    {16170000UL, 45.751256, 4.824147},
+    {16180000UL, 45.751183, 4.824249},
+    {16190000UL, 45.751105, 4.824380},
+    {16200000UL, 45.750990, 4.824480},
+    {16210000UL, 45.750909, 4.824652},
+    {16220000UL, 45.750878, 4.824788},
+    {16230000UL, 45.750858, 4.824925},
+    {16240000UL, 45.750822, 4.825047},
+    {16250000UL, 45.750750, 4.825177},
+    {16260000UL, 45.750698, 4.825328},
+    {16270000UL, 45.750665, 4.825499},
+    {16280000UL, 45.750622, 4.825672},
+    {16290000UL, 45.750527, 4.825785},
+    {16300000UL, 45.750461, 4.825954},
+    {16310000UL, 45.750405, 4.826098},
+    {16320000UL, 45.750318, 4.826233},
+    {16330000UL, 45.750245, 4.826278},
+    {16340000UL, 45.750136, 4.826392},
+    {16350000UL, 45.749999, 4.826492},
+    {16360000UL, 45.749916, 4.826526},
+    {16370000UL, 45.749829, 4.826671},
+    {16380000UL, 45.749723, 4.826777},
+    {16390000UL, 45.749646, 4.826903},
+    {16400000UL, 45.749531, 4.827030},
+    {16410000UL, 45.749448, 4.827142},
+    {16420000UL, 45.749332, 4.827281},
+    {16430000UL, 45.749244, 4.827466},
+    {16440000UL, 45.749168, 4.827566},
+    {16450000UL, 45.749114, 4.827697},
+    {16460000UL, 45.749055, 4.827776},
+    {16470000UL, 45.748949, 4.827883},
+    {16480000UL, 45.748867, 4.827951},
+    {16490000UL, 45.748757, 4.828067},
+    {16500000UL, 45.748648, 4.828216},
+    {16510000UL, 45.748518, 4.828370},
+    {16520000UL, 45.748435, 4.828514},
+    {16530000UL, 45.748349, 4.828563},
+    {16540000UL, 45.748208, 4.828635},
+    {16550000UL, 45.748119, 4.828727},
+    {16560000UL, 45.748014, 4.828855},
+    {16570000UL, 45.747853, 4.828897},
+    {16580000UL, 45.747701, 4.828910},
+    {16590000UL, 45.747587, 4.828923},
+    {16600000UL, 45.747491, 4.828934},
+    {16610000UL, 45.747360, 4.828928},
+    {16620000UL, 45.747242, 4.828963},
+    {16630000UL, 45.747161, 4.828965},
+    {16640000UL, 45.747084, 4.828938},
+    {16650000UL, 45.746951, 4.828960},
+    {16660000UL, 45.746852, 4.829000},
+    {16670000UL, 45.746743, 4.829058},
+    {16680000UL, 45.746623, 4.829087},
+    {16690000UL, 45.746488, 4.829086},
+    {16700000UL, 45.746395, 4.829028},
+    {16710000UL, 45.746236, 4.828948},
+    {16720000UL, 45.746120, 4.828889},
+    {16730000UL, 45.746022, 4.828819},
+    {16740000UL, 45.745925, 4.828710},
+    {16750000UL, 45.745842, 4.828598},
+    {16760000UL, 45.745772, 4.828520},
+    {16770000UL, 45.745674, 4.828407},
+    {16780000UL, 45.745583, 4.828304},
+    {16790000UL, 45.745483, 4.828175},
+    {16800000UL, 45.745420, 4.828010},
+    {16810000UL, 45.745372, 4.827902},
+    {16820000UL, 45.745322, 4.827800},
+    {16830000UL, 45.745161, 4.827720},
+    {16840000UL, 45.745042, 4.827679},
+    {16850000UL, 45.744939, 4.827622},
+    {16860000UL, 45.744829, 4.827563},
+    {16870000UL, 45.744745, 4.827553},
+    {16880000UL, 45.744653, 4.827532},
+    {16890000UL, 45.744516, 4.827525},
+    {16900000UL, 45.744418, 4.827479},
+    {16910000UL, 45.744328, 4.827462},
+    {16920000UL, 45.744178, 4.827506},
+    {16930000UL, 45.744057, 4.827538},
+    {16940000UL, 45.743930, 4.827566},
+    {16950000UL, 45.743821, 4.827570},
+    {16960000UL, 45.743740, 4.827594},
+    {16970000UL, 45.743612, 4.827634},
+    {16980000UL, 45.743530, 4.827730},
+    {16990000UL, 45.743424, 4.827772},
+    {17000000UL, 45.743319, 4.827819},
+    {17010000UL, 45.743178, 4.827824},
+    {17020000UL, 45.743083, 4.827783},
+    {17030000UL, 45.742919, 4.827774},
+    {17040000UL, 45.742776, 4.827737},
+    {17050000UL, 45.742674, 4.827686},
+    {17060000UL, 45.742596, 4.827674},
+    {17070000UL, 45.742486, 4.827694},
+    {17080000UL, 45.742369, 4.827710},
+    {17090000UL, 45.742253, 4.827745},
+    {17100000UL, 45.742157, 4.827735},
+    {17110000UL, 45.742058, 4.827711},
+    {17120000UL, 45.741943, 4.827727},
+    {17130000UL, 45.741816, 4.827706},
+    {17140000UL, 45.741693, 4.827672},
+    {17150000UL, 45.741553, 4.827613},
+    {17160000UL, 45.741437, 4.827511},
+    {17170000UL, 45.741349, 4.827443},
+    {17180000UL, 45.741247, 4.827367},
+    {17190000UL, 45.741160, 4.827296},
+    {17200000UL, 45.741038, 4.827189},
+    {17210000UL, 45.740935, 4.827159},
+    {17220000UL, 45.740815, 4.827092},
+    {17230000UL, 45.740751, 4.826979},
+    {17240000UL, 45.740667, 4.826862},
+    {17240000UL, 45.764059, 4.835602},
+    {17270000UL, 45.764062, 4.835603},
+    {17300000UL, 45.764032, 4.835675},
+    {17330000UL, 45.764007, 4.835685},
+    {17360000UL, 45.764004, 4.835658},
+    {17390000UL, 45.764011, 4.835678},
+    {17420000UL, 45.764030, 4.835670},
+    {17450000UL, 45.764038, 4.835706},
+    {17480000UL, 45.764016, 4.835713},
+    {17510000UL, 45.764047, 4.835704},
+    {17540000UL, 45.764042, 4.835659},
+    {17570000UL, 45.764032, 4.835606},
+    {17600000UL, 45.764055, 4.835625},
+    {17630000UL, 45.764026, 4.835612},
+    {17660000UL, 45.764045, 4.835607},
+    {17690000UL, 45.764009, 4.835660},
+    {17720000UL, 45.764029, 4.835648},
+    {17750000UL, 45.764065, 4.835666},
+    {17780000UL, 45.764054, 4.835643},
+    {17810000UL, 45.764084, 4.835643},
+    {17840000UL, 45.764068, 4.835594},
+    {17870000UL, 45.764058, 4.835644},
+    {17900000UL, 45.764056, 4.835644},
+    {17930000UL, 45.764031, 4.835685},
+    {17960000UL, 45.764071, 4.835653},
+    {17990000UL, 45.764058, 4.835628},
+    {18020000UL, 45.764027, 4.835637},
+    {18050000UL, 45.764026, 4.835633},
+    {18080000UL, 45.764047, 4.835658},
+    {18110000UL, 45.764012, 4.835681},
+    {18140000UL, 45.764063, 4.835668},
+    {18170000UL, 45.764053, 4.835644},
+    {18200000UL, 45.764025, 4.835675},
+    {18230000UL, 45.764024, 4.835704},
+    {18260000UL, 45.764026, 4.835667},
+    {18290000UL, 45.764049, 4.835644},
+    {18320000UL, 45.764015, 4.835668},
+    {18350000UL, 45.764033, 4.835675},
+    {18380000UL, 45.764025, 4.835607},
+    {18410000UL, 45.764047, 4.835646},
+    {18440000UL, 45.764059, 4.835665},
+    {18470000UL, 45.764102, 4.835685},
+    {18500000UL, 45.764083, 4.835701},
+    {18530000UL, 45.764054, 4.835694},
+    {18560000UL, 45.764063, 4.835707},
+    {18590000UL, 45.764042, 4.835709},
+    {18620000UL, 45.764069, 4.835670},
+    {18650000UL, 45.764048, 4.835655},
+    {18680000UL, 45.764063, 4.835626},
+    {18710000UL, 45.764047, 4.835683},
+    {18740000UL, 45.764036, 4.835621},
+    {18770000UL, 45.764074, 4.835639},
+    {18800000UL, 45.764058, 4.835689},
+    {18830000UL, 45.764038, 4.835653},
+    {18860000UL, 45.764084, 4.835651},
+    {18890000UL, 45.764040, 4.835683},
+    {18920000UL, 45.764078, 4.835671},
+    {18950000UL, 45.764073, 4.835627},
+    {18980000UL, 45.764045, 4.835629},
+    {19010000UL, 45.764049, 4.835624},
+    {19040000UL, 45.764100, 4.835656},
+    {19070000UL, 45.764070, 4.835624},
+    {19100000UL, 45.764047, 4.835640},
+    {19130000UL, 45.764064, 4.835688},
+    {19160000UL, 45.764038, 4.835715},
+    {19190000UL, 45.764018, 4.835715},
+    {19220000UL, 45.764042, 4.835676},
+    {19250000UL, 45.764067, 4.835648},
+    {19280000UL, 45.764056, 4.835668},
+    {19310000UL, 45.764055, 4.835666},
+    {19340000UL, 45.764069, 4.835745},
+    {19370000UL, 45.764053, 4.835775},
+    {19400000UL, 45.764053, 4.835734},
+    {19430000UL, 45.764050, 4.835700},
+    {19460000UL, 45.764040, 4.835699},
+    {19490000UL, 45.764058, 4.835628},
+    {19520000UL, 45.764070, 4.835635},
+    {19550000UL, 45.764058, 4.835662},
+    {19580000UL, 45.764056, 4.835625},
+    {19610000UL, 45.764077, 4.835700},
+    {19640000UL, 45.764047, 4.835670},
+    {19670000UL, 45.764026, 4.835684},
+    {19700000UL, 45.764031, 4.835653},
+    {19730000UL, 45.764052, 4.835655},
+    {19760000UL, 45.764068, 4.835685},
+    {19790000UL, 45.764058, 4.835655},
+    {19820000UL, 45.764051, 4.835636},
+    {19850000UL, 45.764040, 4.835632},
+    {19880000UL, 45.764072, 4.835612},
+    {19910000UL, 45.764058, 4.835660},
+};
+
+#endif // TEST_BENCHMARK_TRACK_H
@@ -0,0 +1,151 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <EventLoop.hpp>
+#include <QueueList.hpp>
+#include <SIM7080G/Serial.hpp>
+#include <SIM7080G/Cell.hpp>
+#include <ScriptedModem.h>
+
+/**
+ * @brief Serving cell of a registered modem, and of one out of coverage
+ */
+static const char SERVING_CELL[] = "\r\n+CPSI: LTE CAT-M1,Online,208-01,0x1B5A,27446555,123,EUTRAN-BAND20,6300,5,5,-10,-95,-65,15\r\n\r\nOK\r\n";
+static const char NO_SERVICE[] = "\r\n+CPSI: NO SERVICE,Online\r\n\r\nOK\r\n";
+
+/**
+ * @brief Position given by the location service, within 550 m
+ */
+static const char LOCATION[] = "\r\n+CLBS: 0,4.835659,45.767043,550,24/06/01,12:30:15\r\n\r\nOK\r\n";
+
+#define LOCATE_CLBS "AT+CLBS=4,0"
+
+static ScriptedModem modem;
+
+/**
+ * @brief Run Cell.Locate() and the loop until it is finished
+ */
+static void locate()
+{
+    Cell.pending = true;
+
+    while (!Cell.Locate())
+    {
+        Sim7080G.loop();
+        events.wait();
+    }
+}
+
+/**
+ * @brief JSON of the only item queued
+ */
+static json queued()
+{
+    TEST_ASSERT_EQUAL(1, queueList.size());
+    TEST_ASSERT_EQUAL_STRING("CELL", queueList.to_json()["it"][0]["t"].get<std::string>().c_str());
+    return queueList.to_json()["it"][0]["d"];
+}
+
+void setUp()
+{
+    modem.clear();
+    Sim7080G.emulator = &modem;
+    Sim7080G.linkState = LINK_READY;
+    queueList.clear();
+
+    while (!Sim7080G.isIdle())
+    {
+        Sim7080G.loop();
+        events.wait();
+    }
+}
+
+void tearDown() {}
+
+void test_position_of_the_serving_cell()
+{
+    modem.reply("AT+CPSI?", SERVING_CELL);
+    modem.reply(LOCATE_CLBS, LOCATION);
+
+    locate();
+
+    TEST_ASSERT_FALSE(Cell.pending);
+    json cell = queued();
+    TEST_ASSERT_EQUAL(457670430, cell["y"].get<int32_t>());
+    TEST_ASSERT_EQUAL(48356590, cell["x"].get<int32_t>());
+    TEST_ASSERT_EQUAL(550, cell["acc"].get<int>());
+    TEST_ASSERT_EQUAL(208, cell["mcc"].get<int>());
+    TEST_ASSERT_EQUAL(1, cell["mnc"].get<int>());
+    TEST_ASSERT_EQUAL(0x1B5A, cell["tac"].get<int>());
+    TEST_ASSERT_EQUAL(27446555, cell["ci"].get<int>());
+    TEST_ASSERT_EQUAL(-95, cell["rsrp"].get<int>());
+    TEST_ASSERT_EQUAL(DateTime(2024, 6, 1, 12, 30, 15, 0).toUnixTime(), cell["t"].get<long long>());
+
+    TEST_ASSERT_EQUAL(2, modem.commands.size());
+    TEST_ASSERT_EQUAL_STRING("AT+CPSI?", modem.commands[0].c_str());
+    TEST_ASSERT_EQUAL_STRING(LOCATE_CLBS, modem.commands[1].c_str());
+}
+
+void test_position_without_a_serving_cell()
+{
+    modem.reply("AT+CPSI?", NO_SERVICE);
+    modem.reply(LOCATE_CLBS, LOCATION);
+
+    locate();
+
+    json cell = queued();
+    TEST_ASSERT_EQUAL(457670430, cell["y"].get<int32_t>());
+    TEST_ASSERT_EQUAL(0, cell["mcc"].get<int>());
+    TEST_ASSERT_EQUAL(0, cell["ci"].get<int>());
+}
+
+void test_location_service_failure()
+{
+    modem.reply("AT+CPSI?", SERVING_CELL);
+    modem.reply(LOCATE_CLBS, "\r\n+CLBS: 1\r\n\r\nOK\r\n");
+
+    locate();
+
+    TEST_ASSERT_FALSE(Cell.pending);
+    TEST_ASSERT_TRUE(queueList.isEmpty());
+}
+
+void test_position_without_a_date()
+{
+    modem.reply("AT+CPSI?", SERVING_CELL);
+    modem.reply(LOCATE_CLBS, "\r\n+CLBS: 0,4.835659,45.767043,550\r\n\r\nOK\r\n");
+
+    locate();
+
+    TEST_ASSERT_TRUE(queueList.isEmpty());
+}
+
+void test_location_service_timeout()
+{
+    modem.reply("AT+CPSI?", SERVING_CELL);
+
+    unsigned long start = millis();
+    locate();
+
+    TEST_ASSERT_FALSE(Cell.pending);
+    TEST_ASSERT_TRUE(queueList.isEmpty());
+    TEST_ASSERT_GREATER_OR_EQUAL(ATCommands::CLBS.timeout, millis() - start);
+
+    // The next sample starts over from the serving cell
+    modem.reply(LOCATE_CLBS, LOCATION);
+    modem.commands.clear();
+    locate();
+
+    TEST_ASSERT_EQUAL_STRING("AT+CPSI?", modem.commands[0].c_str());
+    queued();
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_position_of_the_serving_cell);
+    RUN_TEST(test_position_without_a_serving_cell);
+    RUN_TEST(test_location_service_failure);
+    RUN_TEST(test_position_without_a_date);
+    RUN_TEST(test_location_service_timeout);
+    return UNITY_END();
+}
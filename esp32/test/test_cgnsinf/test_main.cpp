@@ -0,0 +1,316 @@
+#include <unity.h>
+#include <chrono>
+#include <Arduino.h>
+#include <vector>
+#include <SIM7080G/GNSS.hpp>
+
+/**
+ * @brief Line captured from the modem, outdoors with a 3D fix
+ */
+static const char FIX[] = "+CGNSINF: 1,1,20240601012659.000,45.774061,-4.848677,170.000,1.25,271.5,1,,1.1,1.4,0.9,,12,8,3,,35,2.4,3.1";
+
+/**
+ * @brief Parse a copy of the text of exactly its length, so that a read past the view is caught by the sanitizers
+ */
+static bool parse(CGNSINFFields &fields, const char *text, size_t length)
+{
+    std::vector<char> copy(text, text + length);
+    return fields.parse(ATView(copy.data(), copy.size()));
+}
+
+static bool parse(CGNSINFFields &fields, const char *text)
+{
+    return parse(fields, text, strlen(text));
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_every_field_of_a_fix()
+{
+    CGNSINFFields fields;
+    TEST_ASSERT_TRUE(parse(fields, FIX));
+
+    TEST_ASSERT_TRUE(fields.runStatus);
+    TEST_ASSERT_TRUE(fields.fixStatus);
+    TEST_ASSERT_EQUAL(2024, fields.utcDateTime.year);
+    TEST_ASSERT_EQUAL(6, fields.utcDateTime.month);
+    TEST_ASSERT_EQUAL(1, fields.utcDateTime.day);
+    TEST_ASSERT_EQUAL(1, fields.utcDateTime.hour);
+    TEST_ASSERT_EQUAL(26, fields.utcDateTime.minute);
+    TEST_ASSERT_EQUAL(59, fields.utcDateTime.second);
+    TEST_ASSERT_EQUAL(457740610, fields.latitude);
+    TEST_ASSERT_EQUAL(-48486770, fields.longitude);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 170.0, fields.altitude);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 1.25, fields.speed);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 271.5, fields.course);
+    TEST_ASSERT_EQUAL(1, fields.fixMode);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 1.1, fields.hdop);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 1.4, fields.pdop);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 0.9, fields.vdop);
+    TEST_ASSERT_EQUAL(12, fields.satellitesInView);
+    TEST_ASSERT_EQUAL(8, fields.satellitesUsed);
+    TEST_ASSERT_EQUAL(3, fields.glonassUsed);
+    TEST_ASSERT_EQUAL(35, fields.cn0Max);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 2.4, fields.hpa);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 3.1, fields.vpa);
+
+    // The reserved fields are empty
+    TEST_ASSERT_FALSE(fields.has(CGNSINF_RESERVED_1));
+    TEST_ASSERT_FALSE(fields.has(CGNSINF_RESERVED_2));
+    TEST_ASSERT_FALSE(fields.has(CGNSINF_RESERVED_3));
+    TEST_ASSERT_TRUE(fields.has(CGNSINF_VPA));
+}
+
+void test_empty_fields_before_the_first_fix()
+{
+    CGNSINFFields fields;
+    TEST_ASSERT_TRUE(parse(fields, "+CGNSINF: 1,0,,,,,,,,,,,,,,,,,,,"));
+
+    TEST_ASSERT_TRUE(fields.runStatus);
+    TEST_ASSERT_FALSE(fields.fixStatus);
+    TEST_ASSERT_EQUAL((1UL << CGNSINF_RUN_STATUS) | (1UL << CGNSINF_FIX_STATUS), fields.present);
+    TEST_ASSERT_EQUAL(0, fields.latitude);
+    TEST_ASSERT_EQUAL(0, fields.utcDateTime.year);
+}
+
+void test_engine_off()
+{
+    CGNSINFFields fields;
+    TEST_ASSERT_TRUE(parse(fields, "+CGNSINF: 0,,,,,,,,,,,,,,,,,,,,"));
+
+    TEST_ASSERT_FALSE(fields.runStatus);
+    TEST_ASSERT_FALSE(fields.has(CGNSINF_FIX_STATUS));
+}
+
+void test_no_line_or_no_run_status()
+{
+    CGNSINFFields fields;
+
+    TEST_ASSERT_FALSE(parse(fields, "\r\nOK\r\n"));
+    TEST_ASSERT_FALSE(parse(fields, "+CGNSINF: ,1,,,"));
+    TEST_ASSERT_FALSE(parse(fields, "GNSINF: 1,1"));
+    TEST_ASSERT_FALSE(parse(fields, "+XGNSINF: 1,1"));
+    TEST_ASSERT_FALSE(parse(fields, ""));
+}
+
+void test_line_inside_a_response()
+{
+    CGNSINFFields fields;
+    TEST_ASSERT_TRUE(parse(fields, "\r\n+CGNSINF: 1,1,20240601012659.000,45.774061,4.848677\r\n\r\nOK\r\n"));
+
+    TEST_ASSERT_EQUAL(48486770, fields.longitude);
+
+    // The line ends at its line ending, OK is not a field
+    TEST_ASSERT_FALSE(fields.has(CGNSINF_ALTITUDE));
+}
+
+void test_report_urc()
+{
+    CGNSINFFields fields;
+    TEST_ASSERT_TRUE(parse(fields, "+UGNSINF: 1,1,20240601012659.000,45.774061,4.848677,170.000,0.00,0.0,1,,1.1,1.4,0.9,,12,8,,,35,2.4,3.1"));
+
+    TEST_ASSERT_EQUAL(457740610, fields.latitude);
+    TEST_ASSERT_FALSE(fields.has(CGNSINF_GLONASS_USED));
+}
+
+void test_parse_resets_the_previous_fields()
+{
+    CGNSINFFields fields;
+    parse(fields, FIX);
+    parse(fields, "+CGNSINF: 1,0,,,,,,,,,,,,,,,,,,,");
+
+    TEST_ASSERT_EQUAL(0, fields.latitude);
+    TEST_ASSERT_FALSE(fields.has(CGNSINF_LATITUDE));
+}
+
+void test_every_truncation_of_a_fix()
+{
+    size_t length = strlen(FIX);
+
+    // Each prefix parses into a subset of the fields of the whole line
+    for (size_t cut = 0; cut <= length; cut++)
+    {
+        CGNSINFFields fields;
+        bool parsed = parse(fields, FIX, cut);
+
+        TEST_ASSERT_EQUAL(cut >= strlen("+CGNSINF: 1"), parsed);
+        TEST_ASSERT_EQUAL(0, fields.present & ~((1UL << CGNSINF_FIELD_COUNT) - 1));
+    }
+}
+
+void test_random_corruptions()
+{
+    static const char alphabet[] = "0123456789,.-+ \r\nCGNSINF:";
+    srand(13);
+
+    for (int trial = 0; trial < 5000; trial++)
+    {
+        char line[sizeof(FIX)];
+        memcpy(line, FIX, sizeof(FIX));
+        size_t length = rand() % sizeof(FIX);
+
+        for (int flips = rand() % 8; flips > 0; flips--)
+            line[rand() % sizeof(FIX)] = alphabet[rand() % (sizeof(alphabet) - 1)];
+
+        CGNSINFFields fields;
+        parse(fields, line, length);
+
+        TEST_ASSERT_EQUAL(0, fields.present & ~((1UL << CGNSINF_FIELD_COUNT) - 1));
+    }
+}
+
+void test_date_time()
+{
+    DateTime time(ATView("20240601012659.250"));
+    TEST_ASSERT_EQUAL(250, time.millisecond);
+
+    DateTime noMilliseconds(ATView("20240601012659"));
+    TEST_ASSERT_EQUAL(59, noMilliseconds.second);
+    TEST_ASSERT_EQUAL(0, noMilliseconds.millisecond);
+
+    DateTime tooShort(ATView("2024060101"));
+    TEST_ASSERT_EQUAL(0, tooShort.year);
+
+    DateTime back = DateTime::fromUnixTime(1717205219);
+    TEST_ASSERT_EQUAL(2024, back.year);
+    TEST_ASSERT_EQUAL(6, back.month);
+    TEST_ASSERT_EQUAL(1, back.day);
+    TEST_ASSERT_EQUAL(1, back.hour);
+    TEST_ASSERT_EQUAL(26, back.minute);
+    TEST_ASSERT_EQUAL(59, back.second);
+    TEST_ASSERT_EQUAL(1717205219, back.toUnixTime());
+}
+
+void test_record_of_a_fix()
+{
+    CGNSINFFields fields;
+    TEST_ASSERT_TRUE(parse(fields, FIX));
+
+    GNSSData data = GNSSData::from_fields(fields);
+    TEST_ASSERT_EQUAL(17000, data.altitude);
+    TEST_ASSERT_EQUAL(125, data.speed);
+    TEST_ASSERT_EQUAL(27150, data.course);
+    TEST_ASSERT_EQUAL(310, data.vpa);
+
+    // A VPA past 655.35 m and an aircraft speed saturate instead of wrapping around
+    TEST_ASSERT_TRUE(parse(fields, "+CGNSINF: 1,1,20240601012659.000,45.774061,-4.848677,9850.000,870.5,271.5,1,,1.1,1.4,0.9,,12,8,3,,35,2.4,912.7"));
+
+    data = GNSSData::from_fields(fields);
+    TEST_ASSERT_EQUAL(985000, data.altitude);
+    TEST_ASSERT_EQUAL(UINT16_MAX, data.speed);
+    TEST_ASSERT_EQUAL(UINT16_MAX, data.vpa);
+}
+
+/**
+ * @brief Lines captured from the modem, fed to the fuzz run as they are and mutated
+ */
+static const char *const CAPTURED[] = {
+    FIX,
+    "+CGNSINF: 1,0,,,,,,,,,,,,,,,,,,,",
+    "+CGNSINF: 0,,,,,,,,,,,,,,,,,,,,",
+    "+UGNSINF: 1,1,20240601012659.000,45.774061,4.848677,170.000,0.00,0.0,1,,1.1,1.4,0.9,,12,8,,,35,2.4,3.1",
+    "\r\n+CGNSINF: 1,1,20240601012659.000,45.774061,4.848677\r\n\r\nOK\r\n",
+};
+
+/**
+ * @brief Mutated lines of the fuzz run
+ */
+#define FUZZ_TRIALS 200000
+
+/**
+ * @brief Host time of a parse of each captured line, then a fuzz run of mutated ones, with the heap allocations
+ * of the parser counted by the native operator new
+ *
+ * @details Mutations: truncation, bytes replaced from the alphabet of the line, bytes dropped or repeated, and
+ * long runs of digits. Built with -fsanitize=address,undefined, a read past a line is caught too.
+ */
+void test_fuzz_benchmark()
+{
+    static const char alphabet[] = "0123456789,.-+ \r\nCGNSINF:";
+    srand(1013);
+
+    printf("\n  line                                      ns/parse   allocations\n");
+    for (const char *line : CAPTURED)
+    {
+        size_t length = strlen(line);
+        std::vector<char> copy(line, line + length);
+        ATView view(copy.data(), copy.size());
+        CGNSINFFields fields;
+
+        uint32_t allocations = nativeHeap.allocations;
+        auto hostStart = std::chrono::steady_clock::now();
+        for (int i = 0; i < 100000; i++)
+            TEST_ASSERT_TRUE(fields.parse(view));
+        double hostTime = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - hostStart).count();
+
+        printf("  %-40.40s  %8.1f  %12u\n", line[0] == '\r' ? line + 2 : line, hostTime / 100000,
+               (unsigned)(nativeHeap.allocations - allocations));
+        TEST_ASSERT_EQUAL(allocations, nativeHeap.allocations);
+    }
+
+    uint32_t allocations = 0;
+    unsigned parsed = 0;
+    for (int trial = 0; trial < FUZZ_TRIALS; trial++)
+    {
+        const char *source = CAPTURED[rand() % (sizeof(CAPTURED) / sizeof(CAPTURED[0]))];
+        std::vector<char> line(source, source + strlen(source));
+
+        for (int mutations = 1 + rand() % 6; mutations > 0 && !line.empty(); mutations--)
+        {
+            size_t at = rand() % line.size();
+            switch (rand() % 5)
+            {
+            case 0:
+                line.resize(at);
+                break;
+            case 1:
+                line[at] = alphabet[rand() % (sizeof(alphabet) - 1)];
+                break;
+            case 2:
+                line.erase(line.begin() + at);
+                break;
+            case 3:
+                line.insert(line.begin() + at, line[at]);
+                break;
+            case 4:
+                line.insert(line.begin() + at, 12 + rand() % 40, (char)('0' + rand() % 10));
+                break;
+            }
+        }
+
+        // Exactly the length of the line, a read past it is a heap overflow
+        std::vector<char> exact(line.begin(), line.end());
+        CGNSINFFields fields;
+        uint32_t before = nativeHeap.allocations;
+        parsed += fields.parse(ATView(exact.data(), exact.size()));
+        allocations += nativeHeap.allocations - before;
+
+        TEST_ASSERT_EQUAL(0, fields.present & ~((1UL << CGNSINF_FIELD_COUNT) - 1));
+    }
+
+    printf("  %u mutated lines, %u parsed, %u allocations\n", FUZZ_TRIALS, parsed, (unsigned)allocations);
+    TEST_ASSERT_EQUAL(0, allocations);
+}
+
+int main(int argc, char **argv)
+{
+    // The firmware runs in UTC, as the ESP32 does without a TZ
+    setenv("TZ", "UTC0", 1);
+    tzset();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_every_field_of_a_fix);
+    RUN_TEST(test_empty_fields_before_the_first_fix);
+    RUN_TEST(test_engine_off);
+    RUN_TEST(test_no_line_or_no_run_status);
+    RUN_TEST(test_line_inside_a_response);
+    RUN_TEST(test_report_urc);
+    RUN_TEST(test_parse_resets_the_previous_fields);
+    RUN_TEST(test_every_truncation_of_a_fix);
+    RUN_TEST(test_random_corruptions);
+    RUN_TEST(test_date_time);
+    RUN_TEST(test_record_of_a_fix);
+    RUN_TEST(test_fuzz_benchmark);
+    return UNITY_END();
+}
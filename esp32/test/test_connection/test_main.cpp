@@ -0,0 +1,129 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <FSM.hpp>
+#include <QueueList.hpp>
+#include <SIM7080G/Serial.hpp>
+#include <SIM7080G/CATM1.hpp>
+#include <SIM7080G/Cell.hpp>
+#include <SIM7080G/TCP.hpp>
+#include <SIM7080G/Simulator.hpp>
+
+/**
+ * @brief The firmware of main.cpp against a simulated network that closes the socket or drops the PDP context
+ *
+ * @details The tests run one after the other on the same firmware, setup() is only called by the first one. The track
+ * of the simulator ends still, the later sessions are started by a cell position.
+ */
+
+void setup();
+void loop();
+extern ModemSimulator simulator;
+
+/**
+ * @brief Longest wait for a state or an upload, in milliseconds, past it the test fails instead of hanging
+ */
+#define WAIT_LIMIT (1000UL * 60 * 60)
+
+/**
+ * @brief Run loop() until the condition holds or WAIT_LIMIT runs out
+ *
+ * @return Whether the condition holds
+ */
+template <typename Condition>
+static bool runUntil(Condition condition)
+{
+    unsigned long end = millis() + WAIT_LIMIT;
+
+    while (!condition() && millis() < end)
+        loop();
+
+    return condition();
+}
+
+/**
+ * @brief Run loop() until the next upload ends the session
+ *
+ * @return Time it took in milliseconds, WAIT_LIMIT if it never came
+ */
+static unsigned long waitUpload()
+{
+    uint32_t uploads = simulator.serverUploads;
+    unsigned long start = millis();
+
+    if (!runUntil([&]
+                  { return simulator.serverUploads > uploads && fsm.currentState == BasicState::PAUSED; }))
+        return WAIT_LIMIT;
+
+    printf("\n  Uploaded after %lu ms, %u commands answered ERROR\n", millis() - start, (unsigned)simulator.errors);
+    return millis() - start;
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_socket_closed_before_the_size()
+{
+    setup();
+
+    // Opened, nothing sent on it yet
+    TEST_ASSERT_TRUE(runUntil([]
+                              { return TCP.fsmTCP.currentState == TCP_SEND; }));
+    simulator.closeSocket();
+
+    // The +CASTATE URC comes first, no AT+CASEND goes to the closed socket
+    TEST_ASSERT_LESS_THAN(WAIT_LIMIT, waitUpload());
+    TEST_ASSERT_EQUAL(0, simulator.errors);
+    TEST_ASSERT_TRUE(queueList.isEmpty());
+}
+
+void test_socket_closed_during_the_size()
+{
+    simulator.errors = 0;
+    Cell.pending = true;
+
+    // AT+CASEND queued, the socket closes before the modem runs it
+    TEST_ASSERT_TRUE(runUntil([]
+                              { return TCP.fsmTCP.currentState == TCP_SEND_SIZE && Sim7080G.isPending(TCP.atCommand); }));
+    simulator.closeSocket();
+
+    // Answered ERROR once, then the socket is opened again instead of sending the size forever
+    TEST_ASSERT_LESS_THAN(WAIT_LIMIT, waitUpload());
+    TEST_ASSERT_EQUAL(1, simulator.errors);
+    TEST_ASSERT_TRUE(queueList.isEmpty());
+}
+
+void test_pdp_dropped_during_the_session()
+{
+    Cell.pending = true;
+    TEST_ASSERT_TRUE(runUntil([]
+                              { return fsm.currentState == BasicState::MODULE_TCP; }));
+    simulator.dropPDP();
+
+    // Activated again, then the socket
+    TEST_ASSERT_LESS_THAN(WAIT_LIMIT, waitUpload());
+    TEST_ASSERT_TRUE(CATM1.pdpActive);
+    TEST_ASSERT_TRUE(queueList.isEmpty());
+}
+
+void test_pdp_dropped_between_sessions()
+{
+    TEST_ASSERT_TRUE(runUntil([]
+                              { return fsm.currentState == BasicState::PAUSED && Sim7080G.isIdle(); }));
+    simulator.dropPDP();
+    Cell.pending = true;
+
+    // The next session does not wait for an IP address of the dropped context
+    TEST_ASSERT_LESS_THAN(WAIT_LIMIT, waitUpload());
+    TEST_ASSERT_TRUE(CATM1.pdpActive);
+    TEST_ASSERT_EQUAL(IP, CATM1.fsmCATM1.currentState);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_socket_closed_before_the_size);
+    RUN_TEST(test_socket_closed_during_the_size);
+    RUN_TEST(test_pdp_dropped_during_the_session);
+    RUN_TEST(test_pdp_dropped_between_sessions);
+    return UNITY_END();
+}
@@ -0,0 +1,134 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <climits>
+#include <EventLoop.hpp>
+#include <SIM7080G/Serial.hpp>
+#include <SIM7080G/ATCommands.hpp>
+
+/**
+ * @brief Sleep of the loop, the virtual clock of test/native moves by the time the loop would sleep
+ */
+
+/**
+ * @brief Time one wait() sleeps, in milliseconds
+ */
+static unsigned long sleep()
+{
+    unsigned long start = millis();
+    events.wait();
+    return millis() - start;
+}
+
+void setUp()
+{
+    nativeNotified = false;
+    events.hasWake = false;
+}
+
+void tearDown() {}
+
+void test_sleeps_the_longest_without_deadline()
+{
+    uint32_t cycles = events.cycles;
+
+    TEST_ASSERT_EQUAL(EVENT_LOOP_MAX_WAIT, sleep());
+    TEST_ASSERT_EQUAL(cycles + 1, events.cycles);
+}
+
+void test_nearest_deadline_wins()
+{
+    events.wakeAt(millis() + 300);
+    events.wakeAt(millis() + 100);
+    events.wakeAt(millis() + 200);
+
+    TEST_ASSERT_EQUAL(100, sleep());
+}
+
+void test_deadlines_are_cleared_by_wait()
+{
+    events.wakeAt(millis() + 10);
+    sleep();
+
+    TEST_ASSERT_FALSE(events.hasWake);
+    TEST_ASSERT_EQUAL(EVENT_LOOP_MAX_WAIT, sleep());
+}
+
+void test_past_deadline_does_not_sleep()
+{
+    events.wakeAt(millis() - 10);
+    TEST_ASSERT_EQUAL(0, sleep());
+
+    events.wakeNow();
+    TEST_ASSERT_EQUAL(0, sleep());
+}
+
+void test_deadline_beyond_the_longest_sleep()
+{
+    events.wakeAt(millis() + EVENT_LOOP_MAX_WAIT * 3);
+    TEST_ASSERT_EQUAL(EVENT_LOOP_MAX_WAIT, sleep());
+}
+
+void test_deadline_across_the_wraparound_of_millis()
+{
+    nativeTime = ULONG_MAX - 50;
+
+    events.wakeAt(millis() + 200);
+    events.wakeAt(millis() + 100);
+
+    TEST_ASSERT_EQUAL(100, sleep());
+    TEST_ASSERT_EQUAL(49, millis());
+}
+
+void test_notification_wakes_at_once()
+{
+    events.setup();
+    events.notify();
+
+    TEST_ASSERT_EQUAL(0, sleep());
+    TEST_ASSERT_EQUAL(EVENT_LOOP_MAX_WAIT, sleep());
+}
+
+void test_idle_modem_does_not_wake_the_loop()
+{
+    Sim7080G.emulator = nullptr;
+    Sim7080G.linkState = LINK_READY;
+
+    Sim7080G.loop();
+    TEST_ASSERT_EQUAL(EVENT_LOOP_MAX_WAIT, sleep());
+}
+
+void test_command_wakes_the_loop_for_its_timeout()
+{
+    Sim7080G.emulator = nullptr;
+    Sim7080G.linkState = LINK_READY;
+
+    // Nothing answers on the UART of the host, the command runs into its timeout in a handful of iterations
+    ATFuture future;
+    uint32_t cycles = events.cycles;
+    unsigned long start = millis();
+
+    while (!ATCommands::GSN.send(future).isFinished)
+    {
+        Sim7080G.loop();
+        events.wait();
+    }
+
+    TEST_ASSERT_GREATER_OR_EQUAL(ATCommands::GSN.timeout, millis() - start);
+    TEST_ASSERT_LESS_OR_EQUAL(ATCommands::GSN.timeout + 2, millis() - start);
+    TEST_ASSERT_LESS_OR_EQUAL(4, events.cycles - cycles);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_sleeps_the_longest_without_deadline);
+    RUN_TEST(test_nearest_deadline_wins);
+    RUN_TEST(test_deadlines_are_cleared_by_wait);
+    RUN_TEST(test_past_deadline_does_not_sleep);
+    RUN_TEST(test_deadline_beyond_the_longest_sleep);
+    RUN_TEST(test_deadline_across_the_wraparound_of_millis);
+    RUN_TEST(test_notification_wakes_at_once);
+    RUN_TEST(test_idle_modem_does_not_wake_the_loop);
+    RUN_TEST(test_command_wakes_the_loop_for_its_timeout);
+    return UNITY_END();
+}
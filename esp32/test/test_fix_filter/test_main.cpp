@@ -0,0 +1,166 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <FixFilter.hpp>
+
+/**
+ * @brief Kennel of main.cpp, in 1e-7 degrees
+ */
+#define HOME_LATITUDE 457640430
+#define HOME_LONGITUDE 48356590
+
+/**
+ * @brief 1e-7 degrees of latitude in a meter
+ */
+#define UNITS_PER_METER 90
+
+static FixFilter filter;
+
+/**
+ * @brief Noise of a fix, roughly normal with a standard deviation of sigma, from a fixed seed
+ */
+static int32_t noise(int32_t sigma)
+{
+    // Sum of 12 uniform draws, minus 6, has a unit variance
+    int32_t sum = 0;
+    for (int i = 0; i < 12; i++)
+        sum += rand() % 1000;
+
+    return (int64_t)(sum - 6000) * sigma / 1000;
+}
+
+static uint32_t distanceFromEstimate(int32_t latitude, int32_t longitude)
+{
+    int32_t estimatedLatitude, estimatedLongitude;
+    filter.estimate(estimatedLatitude, estimatedLongitude);
+
+    return Coordinates::distance(estimatedLatitude, estimatedLongitude, latitude, longitude);
+}
+
+void setUp()
+{
+    filter.reset();
+    srand(18);
+}
+
+void tearDown() {}
+
+void test_first_fix_is_the_estimate()
+{
+    TEST_ASSERT_FALSE(filter.hasEstimate());
+    TEST_ASSERT_EQUAL(UINT32_MAX, filter.uncertainty());
+
+    TEST_ASSERT_TRUE(filter.update(HOME_LATITUDE, HOME_LONGITUDE, 500, 0));
+
+    TEST_ASSERT_TRUE(filter.hasEstimate());
+    TEST_ASSERT_LESS_OR_EQUAL(2, distanceFromEstimate(HOME_LATITUDE, HOME_LONGITUDE));
+
+    // 5 m on each axis
+    TEST_ASSERT_UINT32_WITHIN(2, 707, filter.uncertainty());
+}
+
+void test_accuracy_below_a_meter_counts_as_a_meter()
+{
+    filter.update(HOME_LATITUDE, HOME_LONGITUDE, 0, 0);
+    TEST_ASSERT_UINT32_WITHIN(2, 141, filter.uncertainty());
+}
+
+void test_noise_of_a_still_collar_is_averaged()
+{
+    // 5 m of noise on each axis, a fix every 10 s for 10 minutes
+    uint32_t worstFix = 0;
+
+    for (unsigned long time = 0; time < 1000UL * 60 * 10; time += 10000)
+    {
+        int32_t latitude = HOME_LATITUDE + noise(5 * UNITS_PER_METER);
+        int32_t longitude = HOME_LONGITUDE + noise(7 * UNITS_PER_METER);
+        uint32_t error = Coordinates::distance(latitude, longitude, HOME_LATITUDE, HOME_LONGITUDE);
+        worstFix = error > worstFix ? error : worstFix;
+
+        filter.update(latitude, longitude, 500, time);
+    }
+
+    TEST_ASSERT_LESS_THAN(300, distanceFromEstimate(HOME_LATITUDE, HOME_LONGITUDE));
+    TEST_ASSERT_LESS_THAN(worstFix / 2, distanceFromEstimate(HOME_LATITUDE, HOME_LONGITUDE));
+    TEST_ASSERT_LESS_THAN(707, filter.uncertainty());
+}
+
+void test_walk_is_followed()
+{
+    // 1.5 m/s to the north, a fix every 2 s with 3 m of noise
+    int32_t latitude = HOME_LATITUDE;
+
+    for (unsigned long time = 0; time <= 1000UL * 60 * 5; time += 2000)
+    {
+        latitude = HOME_LATITUDE + (int32_t)(time * 3 * UNITS_PER_METER / 2 / 1000);
+        filter.update(latitude + noise(3 * UNITS_PER_METER), HOME_LONGITUDE + noise(4 * UNITS_PER_METER), 300, time);
+    }
+
+    TEST_ASSERT_LESS_THAN(400, distanceFromEstimate(latitude, HOME_LONGITUDE));
+}
+
+void test_outlier_is_rejected()
+{
+    for (unsigned long time = 0; time < 60000; time += 5000)
+        filter.update(HOME_LATITUDE, HOME_LONGITUDE, 500, time);
+
+    // 500 m off in 5 s, with a 5 m accuracy
+    TEST_ASSERT_FALSE(filter.update(HOME_LATITUDE + 500 * UNITS_PER_METER, HOME_LONGITUDE, 500, 60000));
+    TEST_ASSERT_LESS_OR_EQUAL(100, distanceFromEstimate(HOME_LATITUDE, HOME_LONGITUDE));
+
+    // A good fix clears the count
+    TEST_ASSERT_TRUE(filter.update(HOME_LATITUDE, HOME_LONGITUDE, 500, 65000));
+}
+
+void test_outliers_in_a_row_start_a_new_track()
+{
+    for (unsigned long time = 0; time < 60000; time += 5000)
+        filter.update(HOME_LATITUDE, HOME_LONGITUDE, 500, time);
+
+    int32_t farLatitude = HOME_LATITUDE + 500 * UNITS_PER_METER;
+    unsigned long time = 60000;
+
+    for (uint8_t i = 1; i < FIX_FILTER_MAX_OUTLIERS; i++, time += 5000)
+        TEST_ASSERT_FALSE(filter.update(farLatitude, HOME_LONGITUDE, 500, time));
+
+    // The collar did move, the filter follows it
+    TEST_ASSERT_TRUE(filter.update(farLatitude, HOME_LONGITUDE, 500, time));
+    TEST_ASSERT_LESS_OR_EQUAL(2, distanceFromEstimate(farLatitude, HOME_LONGITUDE));
+}
+
+void test_gap_starts_a_new_track()
+{
+    filter.update(HOME_LATITUDE, HOME_LONGITUDE, 500, 0);
+    filter.update(HOME_LATITUDE, HOME_LONGITUDE, 500, 10000);
+
+    int32_t farLatitude = HOME_LATITUDE + 2000 * UNITS_PER_METER;
+    TEST_ASSERT_TRUE(filter.update(farLatitude, HOME_LONGITUDE, 500, 10000 + FIX_FILTER_MAX_GAP + 1));
+
+    TEST_ASSERT_LESS_OR_EQUAL(2, distanceFromEstimate(farLatitude, HOME_LONGITUDE));
+    TEST_ASSERT_UINT32_WITHIN(2, 707, filter.uncertainty());
+}
+
+void test_southern_and_western_hemispheres()
+{
+    // Near Ushuaia, the cosine of the latitude shrinks the east axis
+    int32_t latitude = -548000000;
+    int32_t longitude = -683000000;
+
+    for (unsigned long time = 0; time < 60000; time += 5000)
+        filter.update(latitude + noise(3 * UNITS_PER_METER), longitude + noise(5 * UNITS_PER_METER), 300, time);
+
+    TEST_ASSERT_LESS_THAN(300, distanceFromEstimate(latitude, longitude));
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_first_fix_is_the_estimate);
+    RUN_TEST(test_accuracy_below_a_meter_counts_as_a_meter);
+    RUN_TEST(test_noise_of_a_still_collar_is_averaged);
+    RUN_TEST(test_walk_is_followed);
+    RUN_TEST(test_outlier_is_rejected);
+    RUN_TEST(test_outliers_in_a_row_start_a_new_track);
+    RUN_TEST(test_gap_starts_a_new_track);
+    RUN_TEST(test_southern_and_western_hemispheres);
+    return UNITY_END();
+}
@@ -0,0 +1,330 @@
+#include <unity.h>
+#include <chrono>
+#include <vector>
+#include <Arduino.h>
+#include <Geofence.hpp>
+#include "../test_benchmark/track.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * @brief Center of the home zone
+ */
+#define HOME_LATITUDE 457640000
+#define HOME_LONGITUDE 48357500
+
+/**
+ * @brief 1e-7 degrees of latitude in a meter
+ */
+#define UNITS_PER_METER 90
+
+/**
+ * @brief Home zone of main.cpp, about 330 m north-south and 430 m east-west
+ */
+static const GeofencePoint HOME[] = {
+    {457625000, 48330000},
+    {457625000, 48385000},
+    {457655000, 48385000},
+    {457655000, 48330000},
+};
+
+/**
+ * @brief U open to the north, the notch between its arms is outside
+ */
+static const GeofencePoint U_SHAPE[] = {
+    {457700000, 48400000},
+    {457700000, 48430000},
+    {457730000, 48430000},
+    {457730000, 48420000},
+    {457710000, 48420000},
+    {457710000, 48410000},
+    {457730000, 48410000},
+    {457730000, 48400000},
+};
+
+/**
+ * @brief Triangle near Ushuaia, south and west
+ */
+static const GeofencePoint SOUTH_WEST[] = {
+    {-548000000, -683000000},
+    {-548000000, -682900000},
+    {-547900000, -682950000},
+};
+
+static const GeofencePoint LINE[] = {
+    {457625000, 48330000},
+    {457655000, 48385000},
+};
+
+static const GeofencePoint TOO_WIDE[] = {
+    {0, -900000000},
+    {0, 900000000},
+    {10000000, 0},
+};
+
+static Geofences fences;
+
+void setUp() {}
+void tearDown() {}
+
+void test_first_fix_only_sets_the_sides()
+{
+    static const Geofence table[] = {{"home", HOME, 4}};
+    fences.begin(table, 1);
+
+    TEST_ASSERT_FALSE(fences.update(HOME_LATITUDE, HOME_LONGITUDE));
+    TEST_ASSERT_TRUE(fences.isInside(0));
+    TEST_ASSERT_FALSE(fences.alert);
+}
+
+void test_leaving_and_entering_raise_an_alert()
+{
+    static const Geofence table[] = {{"home", HOME, 4}};
+    fences.begin(table, 1);
+    fences.update(HOME_LATITUDE, HOME_LONGITUDE);
+
+    TEST_ASSERT_TRUE(fences.update(457700000, HOME_LONGITUDE));
+    TEST_ASSERT_FALSE(fences.isInside(0));
+    TEST_ASSERT_TRUE(fences.alert);
+
+    // Still outside, no new crossing, the alert stays until the upload clears it
+    TEST_ASSERT_FALSE(fences.update(457710000, HOME_LONGITUDE));
+    fences.alert = false;
+
+    TEST_ASSERT_TRUE(fences.update(HOME_LATITUDE, HOME_LONGITUDE));
+    TEST_ASSERT_TRUE(fences.isInside(0));
+    TEST_ASSERT_TRUE(fences.alert);
+}
+
+void test_crossing_counts_past_the_margin()
+{
+    static const Geofence table[] = {{"home", HOME, 4}};
+    fences.begin(table, 1);
+    fences.update(HOME_LATITUDE, HOME_LONGITUDE);
+
+    // 5 m north of the north edge, within the margin
+    TEST_ASSERT_FALSE(fences.update(457655000 + 5 * UNITS_PER_METER, HOME_LONGITUDE));
+    TEST_ASSERT_TRUE(fences.isInside(0));
+
+    TEST_ASSERT_TRUE(fences.update(457655000 + 15 * UNITS_PER_METER, HOME_LONGITUDE));
+    TEST_ASSERT_FALSE(fences.isInside(0));
+
+    // Back 5 m inside, still counted outside
+    TEST_ASSERT_FALSE(fences.update(457655000 - 5 * UNITS_PER_METER, HOME_LONGITUDE));
+    TEST_ASSERT_FALSE(fences.isInside(0));
+}
+
+void test_concave_fence()
+{
+    static const Geofence table[] = {{"u", U_SHAPE, 8}};
+    fences.begin(table, 1);
+
+    // In the notch, within the bounding box but outside of the polygon
+    fences.update(457725000, 48415000);
+    TEST_ASSERT_FALSE(fences.isInside(0));
+
+    fences.begin(table, 1);
+    fences.update(457725000, 48405000);
+    TEST_ASSERT_TRUE(fences.isInside(0));
+
+    fences.begin(table, 1);
+    fences.update(457705000, 48415000);
+    TEST_ASSERT_TRUE(fences.isInside(0));
+}
+
+void test_fences_are_independent()
+{
+    static const Geofence table[] = {{"home", HOME, 4}, {"u", U_SHAPE, 8}};
+    fences.begin(table, 2);
+    fences.update(HOME_LATITUDE, HOME_LONGITUDE);
+
+    TEST_ASSERT_TRUE(fences.isInside(0));
+    TEST_ASSERT_FALSE(fences.isInside(1));
+
+    TEST_ASSERT_TRUE(fences.update(457705000, 48415000));
+    TEST_ASSERT_FALSE(fences.isInside(0));
+    TEST_ASSERT_TRUE(fences.isInside(1));
+}
+
+void test_southern_and_western_hemispheres()
+{
+    static const Geofence table[] = {{"ushuaia", SOUTH_WEST, 3}};
+    fences.begin(table, 1);
+
+    fences.update(-547980000, -682950000);
+    TEST_ASSERT_TRUE(fences.isInside(0));
+
+    TEST_ASSERT_TRUE(fences.update(-547900000, -682990000));
+    TEST_ASSERT_FALSE(fences.isInside(0));
+}
+
+void test_invalid_fences_are_ignored()
+{
+    static const Geofence table[] = {{"line", LINE, 2}, {"wide", TOO_WIDE, 3}};
+    fences.begin(table, 2);
+
+    fences.update(HOME_LATITUDE, HOME_LONGITUDE);
+    TEST_ASSERT_FALSE(fences.isInside(0));
+
+    fences.update(5000000, 0);
+    TEST_ASSERT_FALSE(fences.isInside(1));
+    TEST_ASSERT_FALSE(fences.alert);
+}
+
+void test_fences_beyond_the_maximum_are_ignored()
+{
+    static Geofence table[GEOFENCE_MAX + 6];
+    for (Geofence &fence : table)
+        fence = {"home", HOME, 4};
+
+    fences.begin(table, GEOFENCE_MAX + 6);
+    fences.update(HOME_LATITUDE, HOME_LONGITUDE);
+
+    TEST_ASSERT_TRUE(fences.isInside(0));
+    TEST_ASSERT_TRUE(fences.isInside(GEOFENCE_MAX - 1));
+    TEST_ASSERT_TRUE(fences.update(457700000, HOME_LONGITUDE));
+    TEST_ASSERT_FALSE(fences.isInside(GEOFENCE_MAX - 1));
+}
+
+/**
+ * @brief Fixes of each run of the benchmark
+ */
+#define BENCHMARK_FIXES 200000
+
+/**
+ * @brief Time stamp of the host, in TSC cycles on x86 and in nanoseconds elsewhere
+ */
+static uint64_t hostTicks()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+/**
+ * @brief Even-odd ray cast in doubles, the reference of the integer one
+ */
+static bool referenceContains(const Geofence &fence, int32_t latitude, int32_t longitude)
+{
+    bool inside = false;
+
+    for (uint8_t i = 0, j = fence.count - 1; i < fence.count; j = i++)
+    {
+        double yi = fence.vertices[i].latitude, xi = fence.vertices[i].longitude;
+        double yj = fence.vertices[j].latitude, xj = fence.vertices[j].longitude;
+
+        if ((yi > latitude) != (yj > latitude) && longitude < (xj - xi) * (latitude - yi) / (yj - yi) + xi)
+            inside = !inside;
+    }
+
+    return inside;
+}
+
+/**
+ * @brief Cost of update() per fix with dozens of fences, on the recorded track of test_benchmark and on fixes
+ * spread uniformly over the fences
+ *
+ * @details The fences are star-shaped polygons of 4 to 32 vertices and 50 to 400 m, within 3 km of the kennel,
+ * concave ones included. With no margin, the side of each fence must match a ray cast in doubles.
+ */
+void test_cycles_per_fix()
+{
+    static const uint8_t fenceCounts[] = {1, 12, 48};
+    srand(22);
+
+    std::vector<std::vector<GeofencePoint>> polygons;
+    std::vector<Geofence> table;
+    polygons.push_back(std::vector<GeofencePoint>(HOME, HOME + 4));
+
+    while (polygons.size() < GEOFENCE_MAX)
+    {
+        int32_t latitude = HOME_LATITUDE + (rand() % 6000 - 3000) * UNITS_PER_METER;
+        int32_t longitude = HOME_LONGITUDE + (rand() % 6000 - 3000) * UNITS_PER_METER * 14 / 10;
+        int vertices = 4 + rand() % 29;
+        double radius = 50 + rand() % 350;
+
+        std::vector<GeofencePoint> polygon;
+        for (int i = 0; i < vertices; i++)
+        {
+            double angle = 2 * M_PI * i / vertices;
+            double r = radius * (0.5 + (rand() % 50) / 100.0);
+            polygon.push_back({latitude + (int32_t)(r * cos(angle) * UNITS_PER_METER), longitude + (int32_t)(r * sin(angle) * UNITS_PER_METER * 14 / 10)});
+        }
+        polygons.push_back(polygon);
+    }
+
+    for (size_t i = 0; i < polygons.size(); i++)
+        table.push_back({"fence", polygons[i].data(), (uint8_t)polygons[i].size()});
+
+    std::vector<GeofencePoint> walk, uniform;
+    size_t trackLength = sizeof(RECORDED_TRACK) / sizeof(RECORDED_TRACK[0]);
+    for (size_t i = 0; i < BENCHMARK_FIXES; i++)
+    {
+        const SimulatorWaypoint &waypoint = RECORDED_TRACK[i % trackLength];
+        walk.push_back({(int32_t)lround(waypoint.latitude * 1e7), (int32_t)lround(waypoint.longitude * 1e7)});
+        uniform.push_back({HOME_LATITUDE + (rand() % 7000 - 3500) * UNITS_PER_METER, HOME_LONGITUDE + (rand() % 7000 - 3500) * UNITS_PER_METER * 14 / 10});
+    }
+
+    printf("\n  fences   recorded track   uniform fixes   (%s per fix)\n",
+#if defined(__x86_64__) || defined(__i386__)
+           "TSC cycles"
+#else
+           "ns"
+#endif
+    );
+
+    for (uint8_t count : fenceCounts)
+    {
+        uint64_t ticks[2];
+        const std::vector<GeofencePoint> *runs[] = {&walk, &uniform};
+
+        for (int run = 0; run < 2; run++)
+        {
+            fences.begin(table.data(), count);
+            fences.margin = GEOFENCE_MARGIN;
+
+            // The crossings are logged, without the cost of the host stdout
+            nativeSerialMuted = true;
+            uint64_t start = hostTicks();
+            for (const GeofencePoint &fix : *runs[run])
+                fences.update(fix.latitude, fix.longitude);
+            ticks[run] = (hostTicks() - start) / BENCHMARK_FIXES;
+            nativeSerialMuted = false;
+        }
+
+        printf("  %6u  %15lu  %14lu\n", count, (unsigned long)ticks[0], (unsigned long)ticks[1]);
+    }
+
+    // Same sides as the reference, without the margin
+    fences.begin(table.data(), GEOFENCE_MAX);
+    fences.margin = 0;
+    unsigned mismatches = 0;
+    nativeSerialMuted = true;
+    for (size_t i = 0; i < 20000; i++)
+    {
+        fences.update(uniform[i].latitude, uniform[i].longitude);
+        for (uint8_t fence = 0; fence < GEOFENCE_MAX; fence++)
+            mismatches += fences.isInside(fence) != referenceContains(table[fence], uniform[i].latitude, uniform[i].longitude);
+    }
+    nativeSerialMuted = false;
+
+    TEST_ASSERT_EQUAL(0, mismatches);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_first_fix_only_sets_the_sides);
+    RUN_TEST(test_leaving_and_entering_raise_an_alert);
+    RUN_TEST(test_crossing_counts_past_the_margin);
+    RUN_TEST(test_concave_fence);
+    RUN_TEST(test_fences_are_independent);
+    RUN_TEST(test_southern_and_western_hemispheres);
+    RUN_TEST(test_invalid_fences_are_ignored);
+    RUN_TEST(test_fences_beyond_the_maximum_are_ignored);
+    RUN_TEST(test_cycles_per_fix);
+    return UNITY_END();
+}
@@ -0,0 +1,217 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <Preferences.h>
+#include <SIM7080G/GNSSTuner.hpp>
+
+/**
+ * @brief Times to fix of the sets on the simulated sky, the third one is the fastest
+ */
+static const unsigned long SET_TIMES[GNSS_CONSTELLATION_COUNT] = {30000, 25000, 12000, 20000};
+
+static GNSSTuner tuner;
+
+/**
+ * @brief Index of a set returned by select()
+ */
+static uint8_t indexOf(const GNSSConstellations &set)
+{
+    for (uint8_t i = 0; i < GNSS_CONSTELLATION_COUNT; i++)
+        if (&GNSSTuner::constellations(i) == &set)
+            return i;
+
+    TEST_FAIL_MESSAGE("unknown constellation set");
+    return 0;
+}
+
+/**
+ * @brief Select a set and end its sample with its time on the simulated sky
+ */
+static uint8_t sample()
+{
+    uint8_t set = indexOf(tuner.select());
+    tuner.record(SET_TIMES[set], 500);
+    return set;
+}
+
+void setUp()
+{
+    nativeNVS.clear();
+    srand(22);
+    tuner = GNSSTuner();
+    tuner.begin();
+}
+
+void tearDown() {}
+
+void test_untried_sets_go_first()
+{
+    for (uint8_t i = 0; i < GNSS_CONSTELLATION_COUNT; i++)
+    {
+        for (uint8_t j = 0; j < GNSS_TUNER_MIN_SAMPLES; j++)
+            TEST_ASSERT_EQUAL(i, sample());
+    }
+
+    TEST_ASSERT_EQUAL(2, tuner.best());
+}
+
+void test_selection_holds_until_the_sample_ends()
+{
+    const GNSSConstellations &first = tuner.select();
+
+    TEST_ASSERT_EQUAL_PTR(&first, &tuner.select());
+    tuner.record(1000, 500);
+    TEST_ASSERT_EQUAL(1, tuner.statistics(0).samples);
+
+    // Without a selection, a sample is not accounted
+    tuner.record(1000, 500);
+    TEST_ASSERT_EQUAL(1, tuner.statistics(0).samples);
+}
+
+void test_best_set_without_exploration()
+{
+    tuner.exploration = 0;
+    for (uint8_t i = 0; i < GNSS_CONSTELLATION_COUNT * GNSS_TUNER_MIN_SAMPLES; i++)
+        sample();
+
+    for (int i = 0; i < 100; i++)
+        TEST_ASSERT_EQUAL(2, sample());
+}
+
+void test_exploration_tries_the_other_sets()
+{
+    for (uint8_t i = 0; i < GNSS_CONSTELLATION_COUNT * GNSS_TUNER_MIN_SAMPLES; i++)
+        sample();
+
+    tuner.exploration = 100;
+    int visits[GNSS_CONSTELLATION_COUNT] = {};
+    for (int i = 0; i < 300; i++)
+    {
+        uint8_t set = indexOf(tuner.select());
+        visits[set]++;
+
+        // Keep the measures as they are, the best set stays the same
+        tuner.record(SET_TIMES[set], 500);
+    }
+
+    TEST_ASSERT_EQUAL(0, visits[2]);
+    TEST_ASSERT_GREATER_THAN(50, visits[0]);
+    TEST_ASSERT_GREATER_THAN(50, visits[1]);
+    TEST_ASSERT_GREATER_THAN(50, visits[3]);
+}
+
+void test_exploration_share()
+{
+    for (uint8_t i = 0; i < GNSS_CONSTELLATION_COUNT * GNSS_TUNER_MIN_SAMPLES; i++)
+        sample();
+
+    int explored = 0;
+    for (int i = 0; i < 1000; i++)
+        explored += sample() != 2;
+
+    TEST_ASSERT_GREATER_THAN(GNSS_TUNER_EXPLORATION * 10 / 2, explored);
+    TEST_ASSERT_LESS_THAN(GNSS_TUNER_EXPLORATION * 10 * 2, explored);
+}
+
+void test_moving_average()
+{
+    tuner.select();
+    tuner.record(1000, 400);
+    tuner.select();
+    tuner.record(2000, 800);
+
+    TEST_ASSERT_EQUAL(1250, tuner.statistics(0).time);
+    TEST_ASSERT_EQUAL(500, tuner.statistics(0).accuracy);
+
+    // A failure counts its timeout and leaves the accuracy, on the next set to try
+    TEST_ASSERT_EQUAL(1, indexOf(tuner.select()));
+    tuner.record(1000, 400);
+    tuner.select();
+    tuner.fail(90000);
+
+    TEST_ASSERT_EQUAL(2, tuner.statistics(1).samples);
+    TEST_ASSERT_EQUAL((1000 * 3 + 90000) / 4, tuner.statistics(1).time);
+    TEST_ASSERT_EQUAL(400, tuner.statistics(1).accuracy);
+}
+
+void test_failures_lose_the_best_set()
+{
+    tuner.exploration = 0;
+    for (uint8_t i = 0; i < GNSS_CONSTELLATION_COUNT * GNSS_TUNER_MIN_SAMPLES; i++)
+        sample();
+    TEST_ASSERT_EQUAL(2, tuner.best());
+
+    // The sky changes, the fastest set no longer gets a fix
+    for (int i = 0; i < 4 && indexOf(tuner.select()) == 2; i++)
+        tuner.fail(90000);
+
+    TEST_ASSERT_EQUAL(3, tuner.best());
+}
+
+void test_disabled_tuner_uses_the_first_set()
+{
+    tuner.enabled = false;
+
+    for (int i = 0; i < 10; i++)
+    {
+        TEST_ASSERT_EQUAL(0, sample());
+        tuner.fail(90000);
+    }
+
+    TEST_ASSERT_EQUAL(0, tuner.statistics(0).samples);
+}
+
+void test_statistics_survive_a_reset()
+{
+    for (uint8_t i = 0; i < GNSS_TUNER_SAVE_SAMPLES - 1; i++)
+        sample();
+
+    // Not written yet, the writes are batched
+    GNSSTuner restarted;
+    restarted.begin();
+    TEST_ASSERT_EQUAL(0, restarted.statistics(0).samples);
+
+    sample();
+    restarted.begin();
+    for (uint8_t i = 0; i < GNSS_CONSTELLATION_COUNT; i++)
+    {
+        TEST_ASSERT_EQUAL(tuner.statistics(i).samples, restarted.statistics(i).samples);
+        TEST_ASSERT_EQUAL(tuner.statistics(i).time, restarted.statistics(i).time);
+        TEST_ASSERT_EQUAL(tuner.statistics(i).accuracy, restarted.statistics(i).accuracy);
+    }
+    TEST_ASSERT_EQUAL(2, restarted.best());
+}
+
+void test_older_layout_is_dropped()
+{
+    for (uint8_t i = 0; i < GNSS_TUNER_SAVE_SAMPLES; i++)
+        sample();
+
+    // The version is the first byte of the record
+    nativeNVS["gnss/tuner"][0] = GNSS_TUNER_VERSION + 1;
+
+    GNSSTuner restarted;
+    restarted.begin();
+    for (uint8_t i = 0; i < GNSS_CONSTELLATION_COUNT; i++)
+        TEST_ASSERT_EQUAL(0, restarted.statistics(i).samples);
+
+    // A record of another size is dropped too
+    nativeNVS["gnss/tuner"].resize(3);
+    restarted.begin();
+    TEST_ASSERT_EQUAL(0, restarted.statistics(0).samples);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_untried_sets_go_first);
+    RUN_TEST(test_selection_holds_until_the_sample_ends);
+    RUN_TEST(test_best_set_without_exploration);
+    RUN_TEST(test_exploration_tries_the_other_sets);
+    RUN_TEST(test_exploration_share);
+    RUN_TEST(test_moving_average);
+    RUN_TEST(test_failures_lose_the_best_set);
+    RUN_TEST(test_disabled_tuner_uses_the_first_set);
+    RUN_TEST(test_statistics_survive_a_reset);
+    RUN_TEST(test_older_layout_is_dropped);
+    return UNITY_END();
+}
@@ -0,0 +1,146 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <FSM.hpp>
+#include <EventLoop.hpp>
+#include <QueueList.hpp>
+#include <SIM7080G/Serial.hpp>
+#include <SIM7080G/GNSS.hpp>
+#include <SIM7080G/Cell.hpp>
+#include <SIM7080G/Simulator.hpp>
+
+/**
+ * @brief The firmware of main.cpp indoors, against a simulated modem whose GNSS gets no fix
+ *
+ * @details The tests run one after the other on the same firmware, setup() is only called by the first one.
+ */
+
+void setup();
+void loop();
+extern ModemSimulator simulator;
+
+/**
+ * @brief Time the GNSS may stay on past acquisitionTimeout, for the last report and AT+CGNSPWR=0 to go through
+ */
+#define NO_FIX_POWER_OFF (1000UL * 5)
+
+/**
+ * @brief GNSS sessions over a run, from AT+CGNSPWR=1 to AT+CGNSPWR=0
+ */
+struct NoFixRun
+{
+    uint32_t sessions;
+    unsigned long longest;
+    unsigned long gnssTime;
+    uint32_t cellLocations;
+    uint32_t uploads;
+    bool tracked;
+};
+
+/**
+ * @brief Run loop() for a time and measure the GNSS sessions
+ */
+static NoFixRun run(unsigned long duration)
+{
+    NoFixRun result = {0, 0, simulator.gnssTime(), simulator.cellLocations, simulator.serverUploads, false};
+    unsigned long end = millis() + duration;
+    unsigned long sessionStart = millis();
+    bool on = GNSS.fsmPower.currentState != GNSS_OFF;
+
+    while (millis() < end)
+    {
+        loop();
+
+        bool powered = GNSS.fsmPower.currentState != GNSS_OFF;
+        if (powered && !on)
+        {
+            sessionStart = millis();
+            result.sessions++;
+        }
+        else if (!powered && on)
+        {
+            result.longest = millis() - sessionStart > result.longest ? millis() - sessionStart : result.longest;
+        }
+        on = powered;
+        result.tracked |= GNSS.fsmPower.currentState == GNSS_TRACKING;
+    }
+
+    if (on)
+        result.longest = millis() - sessionStart > result.longest ? millis() - sessionStart : result.longest;
+
+    result.gnssTime = simulator.gnssTime() - result.gnssTime;
+    result.cellLocations = simulator.cellLocations - result.cellLocations;
+    result.uploads = simulator.serverUploads - result.uploads;
+
+    printf("\n  %u GNSS sessions, longest %lu s, GNSS on %lu s of %lu s, %u cell positions, %u uploads%s\n",
+           (unsigned)result.sessions, result.longest / 1000, result.gnssTime / 1000, duration / 1000,
+           (unsigned)result.cellLocations, (unsigned)result.uploads, result.tracked ? ", tracked" : "");
+
+    return result;
+}
+
+/**
+ * @brief Each sample ends within acquisitionTimeout and is followed by a cell position, uploaded on the same session
+ *
+ * @param reportTime Time between two reports of a tracking session running at the start, the timeout counts from the last one
+ */
+static void assertBounded(const NoFixRun &result, unsigned long reportTime = 0)
+{
+    TEST_ASSERT_GREATER_THAN(1, result.sessions);
+    TEST_ASSERT_LESS_OR_EQUAL(GNSS.acquisitionTimeout + reportTime + NO_FIX_POWER_OFF, result.longest);
+    TEST_ASSERT_GREATER_OR_EQUAL(result.sessions - 1, result.cellLocations);
+    TEST_ASSERT_GREATER_OR_EQUAL(result.cellLocations, result.uploads);
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_no_fix_from_boot()
+{
+    simulator.config.noFix = true;
+    setup();
+
+    // No time to fix measured, the default one does not choose tracking
+    NoFixRun result = run(1000UL * 60 * 60 * 3);
+
+    TEST_ASSERT_FALSE(result.tracked);
+    assertBounded(result);
+}
+
+void test_indoors_while_tracking()
+{
+    // Outdoors under a sky where a fix takes 40 s, even hot, tracking is cheaper at a fixed interval
+    simulator.config.noFix = false;
+    simulator.config.fixTime = simulator.config.hotStartTime = 40000;
+    GNSS.adaptive = false;
+
+    NoFixRun outdoors = run(1000UL * 60 * 30);
+    TEST_ASSERT_TRUE(outdoors.tracked);
+    TEST_ASSERT_TRUE(GNSS.useTracking());
+
+    // Then indoors, tracking loses its fix and falls back to the duty cycle
+    simulator.config.noFix = true;
+    NoFixRun indoors = run(1000UL * 60 * 60);
+
+    TEST_ASSERT_FALSE(GNSS.useTracking());
+    assertBounded(indoors, GNSS.interval);
+}
+
+void test_forced_tracking_without_fix()
+{
+    simulator.config.noFix = true;
+    GNSS.mode = GNSS_MODE_TRACKING;
+
+    NoFixRun result = run(1000UL * 60 * 60);
+
+    TEST_ASSERT_TRUE(result.tracked);
+    assertBounded(result);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_no_fix_from_boot);
+    RUN_TEST(test_indoors_while_tracking);
+    RUN_TEST(test_forced_tracking_without_fix);
+    return UNITY_END();
+}
@@ -0,0 +1,364 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <chrono>
+#include <vector>
+#include <QueueList.hpp>
+#include <SIM7080G/Serial.hpp>
+#include <SIM7080G/GNSS.hpp>
+#include <SIM7080G/Cell.hpp>
+
+#define HOME_LATITUDE 457640430
+#define HOME_LONGITUDE 48356590
+
+/**
+ * @brief Bytes of the timestamp at the end of the envelope, a 4-byte CBOR integer, which may tick between two encodings
+ */
+#define CBOR_TIME_SIZE 4
+
+static QueueList queue;
+static int enqueued = 0;
+static int dequeued = 0;
+
+static void enqueueBattery(uint8_t level)
+{
+    BATTERYData battery;
+    battery.batteryLevel = level;
+    queue.enqueue<BATTERYData>(battery);
+}
+
+/**
+ * @brief Queue GNSS fixes, cell positions and battery levels, in turn
+ */
+static void enqueueMixed(size_t items)
+{
+    GNSSData fix;
+    fix.gnssRunStatus = true;
+    fix.fixStatus = true;
+    fix.utcDateTime = DateTime(2025, 6, 1, 12, 0, 0, 0);
+    fix.latitude = HOME_LATITUDE;
+    fix.longitude = HOME_LONGITUDE;
+    fix.hdop = 1.2;
+    fix.hpa = 3.5;
+
+    CELLData cell;
+    cell.utcDateTime = fix.utcDateTime;
+    cell.latitude = HOME_LATITUDE;
+    cell.longitude = HOME_LONGITUDE;
+    cell.accuracy = 800;
+    cell.mcc = 208;
+    cell.mnc = 1;
+    cell.tac = 0x1A2B;
+    cell.cellId = 0x01ABCDEF;
+    cell.rsrp = -97;
+
+    for (size_t i = 0; i < items; i++)
+    {
+        fix.utcDateTime.second = i % 60;
+        fix.latitude += rand() % 200 - 100;
+        fix.longitude += rand() % 200 - 100;
+
+        if (i % 3 == 0)
+            queue.enqueue<GNSSData>(fix);
+        else if (i % 3 == 1)
+            queue.enqueue<CELLData>(cell);
+        else
+            enqueueBattery(i & 0xFF);
+    }
+}
+
+/**
+ * @brief Battery level of the item at a position from the head
+ */
+static int batteryAt(size_t index)
+{
+    return queue.to_json()["it"][index]["d"]["b"].get<int>();
+}
+
+/**
+ * @brief Read a whole encoding, length bytes at a time
+ */
+static std::vector<uint8_t> readAll(QueueListCbor &payload, size_t length)
+{
+    std::vector<uint8_t> bytes;
+    std::vector<uint8_t> buffer(length);
+
+    for (size_t read; (read = payload.read(buffer.data(), length)) > 0;)
+        bytes.insert(bytes.end(), buffer.begin(), buffer.begin() + read);
+
+    return bytes;
+}
+
+/**
+ * @brief Same bytes as to_cbor(), but the timestamp
+ */
+static void assertSameEncoding(const std::vector<uint8_t> &expected, const std::vector<uint8_t> &actual)
+{
+    TEST_ASSERT_EQUAL(expected.size(), actual.size());
+    TEST_ASSERT_GREATER_THAN(CBOR_TIME_SIZE, actual.size());
+    TEST_ASSERT_EQUAL(0, memcmp(expected.data(), actual.data(), actual.size() - CBOR_TIME_SIZE));
+}
+
+void setUp()
+{
+    srand(24);
+    queue.onEnqueue = nullptr;
+    queue.onDequeue = nullptr;
+    queue.clear();
+    queue.dropped = 0;
+}
+
+void tearDown() {}
+
+void test_items_come_out_in_order()
+{
+    TEST_ASSERT_TRUE(queue.isEmpty());
+
+    for (uint8_t i = 0; i < 10; i++)
+        enqueueBattery(i);
+
+    TEST_ASSERT_EQUAL(10, queue.size());
+    queue.dequeue();
+    queue.dequeue();
+
+    TEST_ASSERT_EQUAL(8, queue.size());
+    for (uint8_t i = 0; i < 8; i++)
+        TEST_ASSERT_EQUAL(i + 2, batteryAt(i));
+
+    queue.drop(100);
+    TEST_ASSERT_TRUE(queue.isEmpty());
+
+    // Nothing left to drop
+    queue.dequeue();
+    TEST_ASSERT_EQUAL(0, queue.size());
+}
+
+void test_full_queue_drops_the_oldest()
+{
+    for (int i = 0; i < QUEUE_LIST_CAPACITY + 20; i++)
+        enqueueBattery(i);
+
+    TEST_ASSERT_EQUAL(QUEUE_LIST_CAPACITY, queue.size());
+    TEST_ASSERT_EQUAL(20, queue.dropped);
+    TEST_ASSERT_EQUAL(20, batteryAt(0));
+    TEST_ASSERT_EQUAL(QUEUE_LIST_CAPACITY + 19, batteryAt(QUEUE_LIST_CAPACITY - 1));
+
+    // Around the end of the ring
+    queue.drop(QUEUE_LIST_CAPACITY - 3);
+    for (int i = 0; i < 5; i++)
+        enqueueBattery(200 + i);
+
+    TEST_ASSERT_EQUAL(8, queue.size());
+    TEST_ASSERT_EQUAL(QUEUE_LIST_CAPACITY + 17, batteryAt(0));
+    TEST_ASSERT_EQUAL(204, batteryAt(7));
+}
+
+void test_callbacks()
+{
+    enqueued = dequeued = 0;
+    queue.onEnqueue = [](const QueueRecord &record)
+    { enqueued++; };
+    queue.onDequeue = []()
+    { dequeued++; };
+
+    for (int i = 0; i < QUEUE_LIST_CAPACITY + 2; i++)
+        enqueueBattery(i);
+    queue.drop(3);
+
+    TEST_ASSERT_EQUAL(QUEUE_LIST_CAPACITY + 2, enqueued);
+    TEST_ASSERT_EQUAL(5, dequeued);
+
+    queue.clear();
+    TEST_ASSERT_EQUAL(QUEUE_LIST_CAPACITY + 2, dequeued);
+}
+
+void test_stream_matches_to_cbor()
+{
+    static const size_t lengths[] = {1, 7, 128, 4096};
+
+    for (size_t items : {0, 1, 5, QUEUE_LIST_CAPACITY})
+    {
+        queue.clear();
+        enqueueMixed(items);
+        std::vector<uint8_t> expected = queue.to_cbor();
+
+        for (size_t length : lengths)
+        {
+            QueueListCbor payload;
+            payload.begin(queue);
+
+            TEST_ASSERT_EQUAL(expected.size(), payload.size());
+            TEST_ASSERT_EQUAL(items, payload.items());
+            assertSameEncoding(expected, readAll(payload, length));
+            payload.end();
+        }
+    }
+}
+
+void test_items_queued_after_begin_are_left()
+{
+    enqueueMixed(10);
+    std::vector<uint8_t> expected = queue.to_cbor();
+
+    QueueListCbor payload;
+    payload.begin(queue);
+    enqueueMixed(5);
+
+    assertSameEncoding(expected, readAll(payload, 64));
+    TEST_ASSERT_EQUAL(10, payload.items());
+
+    // Once sent, the encoded items leave and the newer ones stay for the next upload
+    queue.drop(payload.items());
+    payload.end();
+    TEST_ASSERT_EQUAL(5, queue.size());
+    TEST_ASSERT_EQUAL(0, payload.items());
+}
+
+void test_eviction_while_encoding_stops_short()
+{
+    enqueueMixed(QUEUE_LIST_CAPACITY);
+
+    QueueListCbor payload;
+    payload.begin(queue);
+    size_t size = payload.size();
+
+    uint8_t buffer[64];
+    size_t read = payload.read(buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL(sizeof(buffer), read);
+
+    // A full queue makes room for 10 new items, the first ones encoded are gone
+    enqueueMixed(10);
+    TEST_ASSERT_EQUAL(QUEUE_LIST_CAPACITY - 10, payload.items());
+
+    read += readAll(payload, sizeof(buffer)).size();
+    TEST_ASSERT_LESS_THAN(size, read);
+
+    queue.drop(payload.items());
+    payload.end();
+    TEST_ASSERT_EQUAL(10, queue.size());
+    TEST_ASSERT_EQUAL(10, queue.dropped);
+}
+
+void test_drop_sent_items_after_eviction()
+{
+    enqueueMixed(QUEUE_LIST_CAPACITY);
+
+    QueueListCbor payload;
+    payload.begin(queue);
+    readAll(payload, 256);
+
+    // Evicted after the encoding, they were sent but are already gone
+    enqueueMixed(QUEUE_LIST_CAPACITY + 5);
+    TEST_ASSERT_EQUAL(0, payload.items());
+
+    queue.drop(payload.items());
+    payload.end();
+    TEST_ASSERT_EQUAL(QUEUE_LIST_CAPACITY, queue.size());
+}
+
+void test_read_after_end()
+{
+    enqueueMixed(3);
+
+    QueueListCbor payload;
+    payload.begin(queue);
+    payload.end();
+
+    uint8_t buffer[16];
+    TEST_ASSERT_EQUAL(0, payload.read(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL(0, payload.size());
+    TEST_ASSERT_EQUAL(0, payload.items());
+}
+
+/**
+ * @brief Minutes in the simulated day, between two cell positions, and between two uploads
+ */
+#define DAY_MINUTES (60 * 24)
+#define DAY_CELL_PERIOD 10
+#define DAY_UPLOAD_PERIOD 30
+
+/**
+ * @brief Hours of the day without coverage, the queue overflows and drops its oldest items
+ */
+#define DAY_OUTAGE_START 6
+#define DAY_OUTAGE_END 10
+
+static double hostMicroseconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief A day of fixes every minute, cell positions and uploads, without any heap block left behind
+ *
+ * @details The ring copies the items into its records without any allocation. The encoding of an upload builds each
+ * item with nlohmann::json, the blocks only live for that item: the heap is the same before the day and after each
+ * upload, so nothing is left to fragment however long the collar runs. The host time of the enqueues and uploads is
+ * given to compare two versions of the queue, it says nothing of the ESP32 itself.
+ */
+void test_day_of_enqueue_and_drain()
+{
+    size_t heapBefore = nativeHeap.used;
+    nativeHeap.mark();
+
+    uint32_t enqueueAllocations = 0, drainAllocations = 0;
+    uint32_t items = 0, sent = 0, uploads = 0, bytes = 0;
+    double enqueueTime = 0, drainTime = 0;
+    uint8_t buffer[256];
+
+    for (uint32_t minute = 0; minute < DAY_MINUTES; minute++)
+    {
+        uint32_t allocations = nativeHeap.allocations;
+        auto start = std::chrono::steady_clock::now();
+        enqueueMixed(minute % DAY_CELL_PERIOD == 0 ? 3 : 1);
+        enqueueTime += hostMicroseconds(start);
+        enqueueAllocations += nativeHeap.allocations - allocations;
+        items += minute % DAY_CELL_PERIOD == 0 ? 3 : 1;
+
+        bool covered = minute < DAY_OUTAGE_START * 60 || minute >= DAY_OUTAGE_END * 60;
+        if (!covered || minute % DAY_UPLOAD_PERIOD != DAY_UPLOAD_PERIOD - 1)
+            continue;
+
+        allocations = nativeHeap.allocations;
+        start = std::chrono::steady_clock::now();
+        QueueListCbor payload;
+        payload.begin(queue);
+        for (size_t read; (read = payload.read(buffer, sizeof(buffer))) > 0;)
+            bytes += read;
+        sent += payload.items();
+        queue.drop(payload.items());
+        payload.end();
+        drainTime += hostMicroseconds(start);
+        drainAllocations += nativeHeap.allocations - allocations;
+        uploads++;
+
+        TEST_ASSERT_TRUE(queue.isEmpty());
+        TEST_ASSERT_EQUAL(heapBefore, nativeHeap.used);
+    }
+
+    printf("\n  items   sent   dropped   uploads   bytes    heap peak   enqueue ns/item   allocs/item   drain ns/item   allocs/item\n");
+    printf("  %5u  %5u  %8u  %8u  %6u  %10u  %16.0f  %12u  %14.0f  %12.1f\n", (unsigned)items, (unsigned)sent,
+           (unsigned)queue.dropped, (unsigned)uploads, (unsigned)bytes, (unsigned)(nativeHeap.markPeak - heapBefore),
+           enqueueTime * 1000 / items, (unsigned)(enqueueAllocations / items), drainTime * 1000 / sent,
+           (double)drainAllocations / sent);
+
+    TEST_ASSERT_EQUAL(items, sent + queue.dropped);
+    TEST_ASSERT_GREATER_THAN(0, queue.dropped);
+    TEST_ASSERT_EQUAL(0, enqueueAllocations);
+    // The encoding holds one item at a time, not the whole queue
+    TEST_ASSERT_LESS_THAN(QUEUE_LIST_CAPACITY * QUEUE_LIST_RECORD_SIZE, nativeHeap.markPeak - heapBefore);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_items_come_out_in_order);
+    RUN_TEST(test_full_queue_drops_the_oldest);
+    RUN_TEST(test_callbacks);
+    RUN_TEST(test_stream_matches_to_cbor);
+    RUN_TEST(test_items_queued_after_begin_are_left);
+    RUN_TEST(test_eviction_while_encoding_stops_short);
+    RUN_TEST(test_drop_sent_items_after_eviction);
+    RUN_TEST(test_read_after_end);
+    RUN_TEST(test_day_of_enqueue_and_drain);
+    return UNITY_END();
+}
@@ -0,0 +1,457 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <QueueList.hpp>
+#include <QueueStore.hpp>
+#include <SIM7080G/Serial.hpp>
+#include <SIM7080G/GNSS.hpp>
+
+#define HOME_LATITUDE 457640430
+#define HOME_LONGITUDE 48356590
+
+/**
+ * @brief First segment written after a boot on an empty flash
+ */
+#define FIRST_SEGMENT QUEUE_STORE_DIRECTORY "/00000000.log"
+
+static QueueList queue;
+static QueueStore store;
+
+/**
+ * @brief Power the collar off without a flush, and boot it again on the same flash
+ */
+static void reboot()
+{
+    queue.onEnqueue = nullptr;
+    queue.onDequeue = nullptr;
+    queue.clear();
+    queue.dropped = 0;
+    store = QueueStore();
+
+    queue.onEnqueue = [](const QueueRecord &record)
+    { store.enqueued(record); };
+    queue.onDequeue = []()
+    { store.dequeued(); };
+    store.begin(queue);
+}
+
+static void enqueueBattery(uint8_t level)
+{
+    BATTERYData battery;
+    battery.batteryLevel = level;
+    queue.enqueue<BATTERYData>(battery);
+}
+
+static void enqueueBatteries(int from, int to)
+{
+    for (int i = from; i < to; i++)
+        enqueueBattery(i & 0xFF);
+}
+
+static void enqueueFixes(size_t items)
+{
+    GNSSData fix;
+    fix.gnssRunStatus = true;
+    fix.fixStatus = true;
+    fix.utcDateTime = DateTime(2025, 6, 1, 12, 0, 0, 0);
+    fix.latitude = HOME_LATITUDE;
+    fix.longitude = HOME_LONGITUDE;
+    fix.hdop = 1.2;
+    fix.hpa = 3.5;
+
+    for (size_t i = 0; i < items; i++)
+    {
+        fix.utcDateTime.second = i % 60;
+        fix.latitude += rand() % 200 - 100;
+        fix.longitude += rand() % 200 - 100;
+        queue.enqueue<GNSSData>(fix);
+        store.loop();
+    }
+}
+
+/**
+ * @brief Check the queue holds the battery levels from first, in order
+ */
+static void assertBatteries(int first, size_t items)
+{
+    TEST_ASSERT_EQUAL(items, queue.size());
+
+    json content = queue.to_json()["it"];
+    for (size_t i = 0; i < items; i++)
+        TEST_ASSERT_EQUAL((first + i) & 0xFF, content[i]["d"]["b"].get<int>());
+}
+
+/**
+ * @brief Offset past the record at offset, CRC-32 included
+ */
+static size_t recordEnd(const std::string &segment, size_t offset)
+{
+    return offset + QUEUE_STORE_HEADER_SIZE + ((uint8_t)segment[offset + 2] | ((uint8_t)segment[offset + 3] << 8)) + QUEUE_STORE_CRC_SIZE;
+}
+
+/**
+ * @brief Offsets of the records of a segment, the commit ones included
+ */
+static std::vector<size_t> records(const std::string &segment)
+{
+    std::vector<size_t> offsets;
+
+    for (size_t offset = 0; offset + QUEUE_STORE_HEADER_SIZE <= segment.size(); offset = recordEnd(segment, offset))
+        offsets.push_back(offset);
+
+    return offsets;
+}
+
+static size_t segmentCount()
+{
+    size_t count = 0;
+
+    for (auto &file : LittleFS.files)
+        count += file.first.compare(0, sizeof(QUEUE_STORE_DIRECTORY), QUEUE_STORE_DIRECTORY "/") == 0;
+
+    return count;
+}
+
+void setUp()
+{
+    srand(25);
+    LittleFS.format();
+    LittleFS.writeBudget = -1;
+    LittleFS.writes = 0;
+    reboot();
+}
+
+void tearDown() {}
+
+void test_empty_flash()
+{
+    TEST_ASSERT_TRUE(LittleFS.exists(QUEUE_STORE_DIRECTORY));
+    TEST_ASSERT_EQUAL(0, store.restored);
+    TEST_ASSERT_TRUE(queue.isEmpty());
+    TEST_ASSERT_EQUAL(0, segmentCount());
+}
+
+void test_items_are_written_by_batches()
+{
+    enqueueBatteries(0, QUEUE_STORE_BATCH - 1);
+    store.loop();
+    TEST_ASSERT_EQUAL(0, LittleFS.writes);
+
+    enqueueBattery(QUEUE_STORE_BATCH - 1);
+    store.loop();
+    TEST_ASSERT_EQUAL(1, LittleFS.writes);
+
+    // One item waits until the delay is over
+    enqueueBattery(QUEUE_STORE_BATCH);
+    delay(QUEUE_STORE_FLUSH_DELAY - 1);
+    store.loop();
+    TEST_ASSERT_EQUAL(1, LittleFS.writes);
+
+    delay(1);
+    store.loop();
+    TEST_ASSERT_EQUAL(2, LittleFS.writes);
+}
+
+void test_power_loss_restores_the_items_written()
+{
+    enqueueBatteries(0, 10);
+    TEST_ASSERT_TRUE(store.flush());
+
+    // Buffered only, lost with the power
+    enqueueBatteries(10, 12);
+
+    reboot();
+    TEST_ASSERT_EQUAL(10, store.restored);
+    assertBatteries(0, 10);
+
+    // The sequences go on, the next items follow the restored ones
+    enqueueBatteries(20, 25);
+    TEST_ASSERT_TRUE(store.flush());
+
+    reboot();
+    TEST_ASSERT_EQUAL(15, queue.size());
+    TEST_ASSERT_EQUAL(24, queue.to_json()["it"][14]["d"]["b"].get<int>());
+}
+
+void test_committed_items_are_not_restored()
+{
+    enqueueBatteries(0, 10);
+    store.flush();
+
+    // Upload confirmed by the modem
+    queue.drop(4);
+    TEST_ASSERT_TRUE(store.flush());
+
+    reboot();
+    assertBatteries(4, 6);
+
+    // Sent before the commit was written, sent again after the boot
+    queue.drop(6);
+    reboot();
+    assertBatteries(4, 6);
+}
+
+void test_items_sent_while_buffered_are_never_written()
+{
+    enqueueBatteries(0, 5);
+    queue.drop(5);
+
+    TEST_ASSERT_TRUE(store.flush());
+    TEST_ASSERT_EQUAL(0, LittleFS.writes);
+    TEST_ASSERT_EQUAL(0, store.bytesWritten);
+
+    reboot();
+    TEST_ASSERT_TRUE(queue.isEmpty());
+}
+
+void test_torn_record_ends_the_segment()
+{
+    enqueueBatteries(0, 10);
+    store.flush();
+
+    // Power lost in the middle of the last record
+    std::string &segment = LittleFS.files[FIRST_SEGMENT];
+    segment.resize(segment.size() - 5);
+
+    reboot();
+    assertBatteries(0, 9);
+
+    // Never appended after the torn record
+    enqueueBatteries(10, 12);
+    TEST_ASSERT_TRUE(store.flush());
+    TEST_ASSERT_EQUAL(2, segmentCount());
+
+    reboot();
+    TEST_ASSERT_EQUAL(11, queue.size());
+    TEST_ASSERT_EQUAL(11, queue.to_json()["it"][10]["d"]["b"].get<int>());
+}
+
+void test_corrupt_record_ends_the_segment()
+{
+    enqueueBatteries(0, 10);
+    store.flush();
+
+    // The segment starts with a commit, then the items
+    std::string &segment = LittleFS.files[FIRST_SEGMENT];
+    std::vector<size_t> offsets = records(segment);
+    TEST_ASSERT_EQUAL(11, offsets.size());
+    TEST_ASSERT_EQUAL(QUEUE_STORE_COMMIT, (uint8_t)segment[offsets[0] + 1]);
+
+    segment[offsets[5] + QUEUE_STORE_HEADER_SIZE] ^= 0x01;
+    reboot();
+    assertBatteries(0, 4);
+
+    // A bad magic too
+    segment[offsets[5] + QUEUE_STORE_HEADER_SIZE] ^= 0x01;
+    segment[offsets[3]] = 0;
+    reboot();
+    assertBatteries(0, 2);
+}
+
+void test_short_write_is_retried()
+{
+    enqueueBatteries(0, 8);
+
+    // Room for the commit and a few items, the last one torn
+    LittleFS.writeBudget = 60;
+    TEST_ASSERT_FALSE(store.flush());
+    TEST_ASSERT_EQUAL(60, store.bytesWritten);
+
+    LittleFS.writeBudget = -1;
+    TEST_ASSERT_TRUE(store.flush());
+    TEST_ASSERT_EQUAL(2, segmentCount());
+
+    // Each item once, the torn one from the second segment
+    reboot();
+    TEST_ASSERT_EQUAL(8, store.restored);
+    assertBatteries(0, 8);
+}
+
+void test_power_loss_after_a_short_write()
+{
+    enqueueBatteries(0, 8);
+
+    LittleFS.writeBudget = 60;
+    TEST_ASSERT_FALSE(store.flush());
+    LittleFS.writeBudget = -1;
+
+    // The records written whole, but the commit
+    const std::string &segment = LittleFS.files[FIRST_SEGMENT];
+    size_t whole = 0;
+    for (size_t offset : records(segment))
+        whole += recordEnd(segment, offset) <= segment.size();
+    TEST_ASSERT_GREATER_THAN(1, whole);
+
+    reboot();
+    assertBatteries(0, whole - 1);
+}
+
+void test_committed_segments_are_deleted()
+{
+    enqueueFixes(QUEUE_LIST_CAPACITY);
+    TEST_ASSERT_TRUE(store.flush());
+    TEST_ASSERT_GREATER_THAN(1, segmentCount());
+
+    queue.drop(QUEUE_LIST_CAPACITY);
+    TEST_ASSERT_TRUE(store.flush());
+    TEST_ASSERT_EQUAL(1, segmentCount());
+
+    reboot();
+    TEST_ASSERT_TRUE(queue.isEmpty());
+    TEST_ASSERT_EQUAL(0, store.restored);
+}
+
+void test_evicted_items_are_committed()
+{
+    enqueueBatteries(0, QUEUE_LIST_CAPACITY + 10);
+    TEST_ASSERT_TRUE(store.flush());
+
+    reboot();
+    TEST_ASSERT_EQUAL(QUEUE_LIST_CAPACITY, store.restored);
+    assertBatteries(10, QUEUE_LIST_CAPACITY);
+}
+
+/**
+ * @brief Power cuts injected, and most bytes a cut flush may still write
+ */
+#define CRASH_RUNS 1000
+#define CRASH_MAX_BUDGET 256
+
+/**
+ * @brief Items appended by the throughput run
+ */
+#define APPEND_ITEMS 20000
+
+/**
+ * @brief Battery levels of the queue, from the head
+ */
+static std::vector<int> batteryLevels()
+{
+    std::vector<int> levels;
+    json content = queue.to_json()["it"];
+
+    for (auto &item : content)
+        levels.push_back(item["d"]["b"].get<int>());
+
+    return levels;
+}
+
+/**
+ * @brief Power cut in the middle of a flush, at a random byte, after a random history of items and uploads
+ *
+ * @details After the boot the queue must hold a run of the items in order, each once: everything queued at the
+ * last flush that succeeded, at most the items committed since dropped, at most the items buffered since added.
+ * The store must then go on from there.
+ */
+void test_crash_injection()
+{
+    size_t torn = 0, lost = 0, resent = 0;
+
+    for (int run = 0; run < CRASH_RUNS; run++)
+    {
+        LittleFS.format();
+        LittleFS.writeBudget = -1;
+        reboot();
+
+        // Levels from 0 to 199, a byte each, the steps below never queue more
+        int next = 0, goodFirst = 0, goodEnd = 0;
+        int steps = 1 + rand() % 24;
+        for (int step = 0; step < steps; step++)
+        {
+            int items = 1 + rand() % 8;
+            enqueueBatteries(next, next + items);
+            next += items;
+
+            if (rand() % 3 == 0)
+                queue.drop(rand() % (queue.size() + 1));
+
+            if (rand() % 2 == 0 && store.flush())
+            {
+                goodFirst = queue.isEmpty() ? next : batteryLevels().front();
+                goodEnd = next;
+            }
+        }
+
+        int crashFirst = queue.isEmpty() ? next : batteryLevels().front();
+        LittleFS.writeBudget = rand() % CRASH_MAX_BUDGET;
+        unsigned long before = LittleFS.bytesWritten;
+        bool flushed = store.flush();
+        torn += !flushed && LittleFS.bytesWritten > before;
+        LittleFS.writeBudget = -1;
+
+        reboot();
+        std::vector<int> levels = batteryLevels();
+        // Nothing restored, as if the run stopped where the queue started at the cut
+        int first = levels.empty() ? crashFirst : levels.front();
+        int end = levels.empty() ? crashFirst : levels.back() + 1;
+
+        for (size_t i = 0; i < levels.size(); i++)
+            TEST_ASSERT_EQUAL(first + (int)i, levels[i]);
+        TEST_ASSERT_TRUE(first >= goodFirst && first <= crashFirst);
+        TEST_ASSERT_TRUE(end >= goodEnd && end <= next);
+        if (flushed)
+            TEST_ASSERT_EQUAL(next, end);
+
+        lost += next - end;
+        resent += crashFirst - first;
+
+        // The sequences go on after the restored items
+        enqueueBatteries(200, 204);
+        TEST_ASSERT_TRUE(store.flush());
+        reboot();
+        levels = batteryLevels();
+        TEST_ASSERT_EQUAL(end - first + 4, levels.size());
+        TEST_ASSERT_EQUAL(203, levels.back());
+    }
+
+    printf("\n  power cuts   torn writes   buffered items lost   committed items sent again\n");
+    printf("  %10u  %12u  %20u  %27u\n", (unsigned)CRASH_RUNS, (unsigned)torn, (unsigned)lost, (unsigned)resent);
+    TEST_ASSERT_GREATER_THAN(0, torn);
+}
+
+/**
+ * @brief Host time, flash writes and bytes of a long run of fixes, written by batches and evicted from a full queue
+ *
+ * @details The figures of a flash write are those of the LittleFS shim, the host time only compares two versions
+ * of the store.
+ */
+void test_append_throughput()
+{
+    auto start = std::chrono::steady_clock::now();
+    enqueueFixes(APPEND_ITEMS);
+    TEST_ASSERT_TRUE(store.flush());
+    double time = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    printf("\n  items   ns/item   writes   items/write   bytes/item   segments\n");
+    printf("  %5u  %8.0f  %7lu  %12.1f  %11.1f  %9u\n", (unsigned)APPEND_ITEMS, time / APPEND_ITEMS, LittleFS.writes,
+           (double)APPEND_ITEMS / LittleFS.writes, (double)store.bytesWritten / APPEND_ITEMS, (unsigned)segmentCount());
+
+    // Batches of QUEUE_STORE_BATCH items, the committed segments deleted as the ring evicts
+    TEST_ASSERT_LESS_OR_EQUAL(APPEND_ITEMS / QUEUE_STORE_BATCH * 2, LittleFS.writes);
+    TEST_ASSERT_LESS_OR_EQUAL(QUEUE_STORE_MAX_SEGMENTS, segmentCount());
+
+    reboot();
+    TEST_ASSERT_EQUAL(QUEUE_LIST_CAPACITY, store.restored);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_flash);
+    RUN_TEST(test_items_are_written_by_batches);
+    RUN_TEST(test_power_loss_restores_the_items_written);
+    RUN_TEST(test_committed_items_are_not_restored);
+    RUN_TEST(test_items_sent_while_buffered_are_never_written);
+    RUN_TEST(test_torn_record_ends_the_segment);
+    RUN_TEST(test_corrupt_record_ends_the_segment);
+    RUN_TEST(test_short_write_is_retried);
+    RUN_TEST(test_power_loss_after_a_short_write);
+    RUN_TEST(test_committed_segments_are_deleted);
+    RUN_TEST(test_evicted_items_are_committed);
+    RUN_TEST(test_crash_injection);
+    RUN_TEST(test_append_throughput);
+    return UNITY_END();
+}
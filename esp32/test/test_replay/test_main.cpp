@@ -0,0 +1,64 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <FSM.hpp>
+#include <EventLoop.hpp>
+#include <QueueList.hpp>
+#include <SIM7080G/Serial.hpp>
+#include <SIM7080G/GNSS.hpp>
+#include <SIM7080G/TCP.hpp>
+#include <SIM7080G/Trace.hpp>
+#include "trace.h"
+
+/**
+ * @brief Replay of a recorded modem session through setup() and loop() of main.cpp
+ *
+ * @details Built by the native_replay env of platformio.ini, with -D SIM7080G_REPLAY instead of the simulator:
+ * main.cpp plays /trace.bin back in place of the modem, the firmware must go through the recorded session
+ * as it did when it was recorded.
+ */
+
+void setup();
+void loop();
+extern TraceReplay traceReplay;
+extern File traceFile;
+
+/**
+ * @brief Time of the first upload in the recorded session, and how late the replay may be, in milliseconds
+ */
+#define REPLAY_SESSION (1000UL * 99)
+#define REPLAY_MARGIN (1000UL * 5)
+
+void setUp() {}
+void tearDown() {}
+
+void test_replays_the_recorded_session()
+{
+    LittleFS.files["/trace.bin"] = std::string((const char *)RECORDED_TRACE, sizeof(RECORDED_TRACE));
+
+    setup();
+    TEST_ASSERT_TRUE(traceReplay.isActive());
+    TEST_ASSERT_EQUAL_PTR(&traceReplay, Sim7080G.emulator);
+
+    bool uploaded = false;
+    while (!uploaded && millis() < REPLAY_SESSION + REPLAY_MARGIN)
+    {
+        loop();
+        uploaded = traceFile.available() == 0 && fsm.currentState == BasicState::PAUSED && queueList.isEmpty() && Sim7080G.isIdle();
+    }
+
+    // Every recorded answer was read, in the same order and at the same rate as in the session
+    TEST_ASSERT_TRUE(uploaded);
+    TEST_ASSERT_EQUAL(LINK_READY, Sim7080G.linkState);
+    TEST_ASSERT_EQUAL(921600, Sim7080G.linkBaud);
+    TEST_ASSERT_GREATER_THAN(0, GNSS.ttff);
+    TEST_ASSERT_EQUAL(TCP_OPEN, TCP.fsmTCP.currentState);
+    TEST_ASSERT_GREATER_OR_EQUAL(REPLAY_SESSION - REPLAY_MARGIN, millis());
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_replays_the_recorded_session);
+    return UNITY_END();
+}
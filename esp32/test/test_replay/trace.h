@@ -0,0 +1,214 @@
+#pragma once
+#ifndef TEST_REPLAY_TRACE_H
+#define TEST_REPLAY_TRACE_H
+#include <cstdint>
+
+/**
+ * @brief Modem session from boot to the first upload, 3161 bytes
+ *
+ * @details Recorded to /trace.bin by a build of main.cpp with -D SIM7080G_TRACE -D SIM7080G_SIMULATOR: link
+ * negotiation to 921600 baud, a cold start fixing after 30 s, then the upload of 131 bytes.
+ * Record it again when the firmware words its commands differently, the replay matches written bytes by count.
+ */
+static const uint8_t RECORDED_TRACE[] = {
+    0x53, 0x49, 0x4d, 0x54, 0x01, 0x81, 0x00, 0x41, 0x54, 0x81, 0x00, 0x0d, 0x0a, 0x0c, 0xa0, 0x9c,
+    0x01, 0x0d, 0x0a, 0x52, 0x44, 0x59, 0x0d, 0x0a, 0x0d, 0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x8c, 0xe8,
+    0x07, 0x41, 0x54, 0x2b, 0x49, 0x50, 0x52, 0x3d, 0x39, 0x32, 0x31, 0x36, 0x30, 0x30, 0x81, 0x00,
+    0x0d, 0x0a, 0x05, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x81, 0xe8, 0x07, 0x41,
+    0x54, 0x81, 0x00, 0x0d, 0x0a, 0x05, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x81,
+    0xe8, 0x07, 0x41, 0x54, 0x81, 0x00, 0x0d, 0x0a, 0x05, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x4f, 0x4b,
+    0x0d, 0x0a, 0x81, 0xe8, 0x07, 0x41, 0x54, 0x81, 0x00, 0x0d, 0x0a, 0x05, 0xa0, 0x9c, 0x01, 0x0d,
+    0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x81, 0xe8, 0xf5, 0x05, 0x41, 0x54, 0x81, 0x00, 0x0d, 0x0a, 0x81,
+    0xb0, 0xb7, 0x12, 0x41, 0x54, 0x81, 0x00, 0x0d, 0x0a, 0x81, 0xb0, 0xb7, 0x12, 0x41, 0x54, 0x81,
+    0x00, 0x0d, 0x0a, 0x81, 0xb0, 0xb7, 0x12, 0x41, 0x54, 0x81, 0x00, 0x0d, 0x0a, 0x05, 0xa0, 0x9c,
+    0x01, 0x0d, 0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x81, 0x00, 0x41, 0x54, 0x81, 0x00, 0x0d, 0x0a, 0x05,
+    0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x81, 0xe8, 0x07, 0x41, 0x54, 0x81, 0x00,
+    0x0d, 0x0a, 0x05, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x81, 0xe8, 0x07, 0x41,
+    0x54, 0x81, 0x00, 0x0d, 0x0a, 0x05, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x85,
+    0x00, 0x41, 0x54, 0x2b, 0x47, 0x53, 0x4e, 0x81, 0x00, 0x0d, 0x0a, 0x18, 0xa0, 0x9c, 0x01, 0x0d,
+    0x0a, 0x38, 0x36, 0x39, 0x39, 0x35, 0x31, 0x30, 0x33, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x31,
+    0x0d, 0x0a, 0x0d, 0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x9e, 0x00, 0x41, 0x54, 0x2b, 0x43, 0x47, 0x4e,
+    0x53, 0x50, 0x57, 0x52, 0x3d, 0x31, 0x3b, 0x2b, 0x43, 0x47, 0x4e, 0x53, 0x4d, 0x4f, 0x44, 0x3d,
+    0x31, 0x2c, 0x30, 0x2c, 0x30, 0x2c, 0x31, 0x2c, 0x30, 0x81, 0x00, 0x0d, 0x0a, 0x05, 0xa0, 0x9c,
+    0x01, 0x0d, 0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x89, 0x00, 0x41, 0x54, 0x2b, 0x43, 0x47, 0x4e, 0x53,
+    0x49, 0x4e, 0x46, 0x81, 0x00, 0x0d, 0x0a, 0x29, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x2b, 0x43, 0x47,
+    0x4e, 0x53, 0x49, 0x4e, 0x46, 0x3a, 0x20, 0x31, 0x2c, 0x30, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c,
+    0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x0d, 0x0a, 0x0d,
+    0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x89, 0xc0, 0x84, 0x3d, 0x41, 0x54, 0x2b, 0x43, 0x47, 0x4e, 0x53,
+    0x49, 0x4e, 0x46, 0x81, 0x00, 0x0d, 0x0a, 0x29, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x2b, 0x43, 0x47,
+    0x4e, 0x53, 0x49, 0x4e, 0x46, 0x3a, 0x20, 0x31, 0x2c, 0x30, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c,
+    0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x0d, 0x0a, 0x0d,
+    0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x89, 0xc0, 0x84, 0x3d, 0x41, 0x54, 0x2b, 0x43, 0x47, 0x4e, 0x53,
+    0x49, 0x4e, 0x46, 0x81, 0x00, 0x0d, 0x0a, 0x29, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x2b, 0x43, 0x47,
+    0x4e, 0x53, 0x49, 0x4e, 0x46, 0x3a, 0x20, 0x31, 0x2c, 0x30, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c,
+    0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x0d, 0x0a, 0x0d,
+    0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x89, 0xc0, 0x84, 0x3d, 0x41, 0x54, 0x2b, 0x43, 0x47, 0x4e, 0x53,
+    0x49, 0x4e, 0x46, 0x81, 0x00, 0x0d, 0x0a, 0x29, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x2b, 0x43, 0x47,
+    0x4e, 0x53, 0x49, 0x4e, 0x46, 0x3a, 0x20, 0x31, 0x2c, 0x30, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c,
+    0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x0d, 0x0a, 0x0d,
+    0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x89, 0xc0, 0x84, 0x3d, 0x41, 0x54, 0x2b, 0x43, 0x47, 0x4e, 0x53,
+    0x49, 0x4e, 0x46, 0x81, 0x00, 0x0d, 0x0a, 0x29, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x2b, 0x43, 0x47,
+    0x4e, 0x53, 0x49, 0x4e, 0x46, 0x3a, 0x20, 0x31, 0x2c, 0x30, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c,
+    0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x0d, 0x0a, 0x0d,
+    0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x89, 0xc0, 0x84, 0x3d, 0x41, 0x54, 0x2b, 0x43, 0x47, 0x4e, 0x53,
+    0x49, 0x4e, 0x46, 0x81, 0x00, 0x0d, 0x0a, 0x29, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x2b, 0x43, 0x47,
+    0x4e, 0x53, 0x49, 0x4e, 0x46, 0x3a, 0x20, 0x31, 0x2c, 0x30, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c,
+    0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x0d, 0x0a, 0x0d,
+    0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x89, 0xc0, 0x84, 0x3d, 0x41, 0x54, 0x2b, 0x43, 0x47, 0x4e, 0x53,
+    0x49, 0x4e, 0x46, 0x81, 0x00, 0x0d, 0x0a, 0x29, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x2b, 0x43, 0x47,
+    0x4e, 0x53, 0x49, 0x4e, 0x46, 0x3a, 0x20, 0x31, 0x2c, 0x30, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c,
+    0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x0d, 0x0a, 0x0d,
+    0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x89, 0xc0, 0x84, 0x3d, 0x41, 0x54, 0x2b, 0x43, 0x47, 0x4e, 0x53,
+    0x49, 0x4e, 0x46, 0x81, 0x00, 0x0d, 0x0a, 0x29, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x2b, 0x43, 0x47,
+    0x4e, 0x53, 0x49, 0x4e, 0x46, 0x3a, 0x20, 0x31, 0x2c, 0x30, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c,
+    0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x0d, 0x0a, 0x0d,
+    0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x89, 0xc0, 0x84, 0x3d, 0x41, 0x54, 0x2b, 0x43, 0x47, 0x4e, 0x53,
+    0x49, 0x4e, 0x46, 0x81, 0x00, 0x0d, 0x0a, 0x29, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x2b, 0x43, 0x47,
+    0x4e, 0x53, 0x49, 0x4e, 0x46, 0x3a, 0x20, 0x31, 0x2c, 0x30, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c,
+    0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x0d, 0x0a, 0x0d,
+    0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x89, 0xc0, 0x84, 0x3d, 0x41, 0x54, 0x2b, 0x43, 0x47, 0x4e, 0x53,
+    0x49, 0x4e, 0x46, 0x81, 0x00, 0x0d, 0x0a, 0x29, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x2b, 0x43, 0x47,
+    0x4e, 0x53, 0x49, 0x4e, 0x46, 0x3a, 0x20, 0x31, 0x2c, 0x30, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c,
+    0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x0d, 0x0a, 0x0d,
+    0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x89, 0xc0, 0x84, 0x3d, 0x41, 0x54, 0x2b, 0x43, 0x47, 0x4e, 0x53,
+    0x49, 0x4e, 0x46, 0x81, 0x00, 0x0d, 0x0a, 0x29, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x2b, 0x43, 0x47,
+    0x4e, 0x53, 0x49, 0x4e, 0x46, 0x3a, 0x20, 0x31, 0x2c, 0x30, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c,
+    0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x0d, 0x0a, 0x0d,
+    0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x89, 0xc0, 0x84, 0x3d, 0x41, 0x54, 0x2b, 0x43, 0x47, 0x4e, 0x53,
+    0x49, 0x4e, 0x46, 0x81, 0x00, 0x0d, 0x0a, 0x29, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x2b, 0x43, 0x47,
+    0x4e, 0x53, 0x49, 0x4e, 0x46, 0x3a, 0x20, 0x31, 0x2c, 0x30, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c,
+    0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x0d, 0x0a, 0x0d,
+    0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x89, 0xc0, 0x84, 0x3d, 0x41, 0x54, 0x2b, 0x43, 0x47, 0x4e, 0x53,
+    0x49, 0x4e, 0x46, 0x81, 0x00, 0x0d, 0x0a, 0x29, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x2b, 0x43, 0x47,
+    0x4e, 0x53, 0x49, 0x4e, 0x46, 0x3a, 0x20, 0x31, 0x2c, 0x30, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c,
+    0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x0d, 0x0a, 0x0d,
+    0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x89, 0xc0, 0x84, 0x3d, 0x41, 0x54, 0x2b, 0x43, 0x47, 0x4e, 0x53,
+    0x49, 0x4e, 0x46, 0x81, 0x00, 0x0d, 0x0a, 0x29, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x2b, 0x43, 0x47,
+    0x4e, 0x53, 0x49, 0x4e, 0x46, 0x3a, 0x20, 0x31, 0x2c, 0x30, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c,
+    0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x0d, 0x0a, 0x0d,
+    0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x89, 0xc0, 0x84, 0x3d, 0x41, 0x54, 0x2b, 0x43, 0x47, 0x4e, 0x53,
+    0x49, 0x4e, 0x46, 0x81, 0x00, 0x0d, 0x0a, 0x29, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x2b, 0x43, 0x47,
+    0x4e, 0x53, 0x49, 0x4e, 0x46, 0x3a, 0x20, 0x31, 0x2c, 0x30, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c,
+    0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x0d, 0x0a, 0x0d,
+    0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x89, 0xc0, 0x84, 0x3d, 0x41, 0x54, 0x2b, 0x43, 0x47, 0x4e, 0x53,
+    0x49, 0x4e, 0x46, 0x81, 0x00, 0x0d, 0x0a, 0x29, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x2b, 0x43, 0x47,
+    0x4e, 0x53, 0x49, 0x4e, 0x46, 0x3a, 0x20, 0x31, 0x2c, 0x30, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c,
+    0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x0d, 0x0a, 0x0d,
+    0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x89, 0xc0, 0x84, 0x3d, 0x41, 0x54, 0x2b, 0x43, 0x47, 0x4e, 0x53,
+    0x49, 0x4e, 0x46, 0x81, 0x00, 0x0d, 0x0a, 0x29, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x2b, 0x43, 0x47,
+    0x4e, 0x53, 0x49, 0x4e, 0x46, 0x3a, 0x20, 0x31, 0x2c, 0x30, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c,
+    0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x0d, 0x0a, 0x0d,
+    0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x89, 0xc0, 0x84, 0x3d, 0x41, 0x54, 0x2b, 0x43, 0x47, 0x4e, 0x53,
+    0x49, 0x4e, 0x46, 0x81, 0x00, 0x0d, 0x0a, 0x29, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x2b, 0x43, 0x47,
+    0x4e, 0x53, 0x49, 0x4e, 0x46, 0x3a, 0x20, 0x31, 0x2c, 0x30, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c,
+    0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x0d, 0x0a, 0x0d,
+    0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x89, 0xc0, 0x84, 0x3d, 0x41, 0x54, 0x2b, 0x43, 0x47, 0x4e, 0x53,
+    0x49, 0x4e, 0x46, 0x81, 0x00, 0x0d, 0x0a, 0x29, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x2b, 0x43, 0x47,
+    0x4e, 0x53, 0x49, 0x4e, 0x46, 0x3a, 0x20, 0x31, 0x2c, 0x30, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c,
+    0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x0d, 0x0a, 0x0d,
+    0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x89, 0xc0, 0x84, 0x3d, 0x41, 0x54, 0x2b, 0x43, 0x47, 0x4e, 0x53,
+    0x49, 0x4e, 0x46, 0x81, 0x00, 0x0d, 0x0a, 0x29, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x2b, 0x43, 0x47,
+    0x4e, 0x53, 0x49, 0x4e, 0x46, 0x3a, 0x20, 0x31, 0x2c, 0x30, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c,
+    0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x0d, 0x0a, 0x0d,
+    0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x89, 0xc0, 0x84, 0x3d, 0x41, 0x54, 0x2b, 0x43, 0x47, 0x4e, 0x53,
+    0x49, 0x4e, 0x46, 0x81, 0x00, 0x0d, 0x0a, 0x29, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x2b, 0x43, 0x47,
+    0x4e, 0x53, 0x49, 0x4e, 0x46, 0x3a, 0x20, 0x31, 0x2c, 0x30, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c,
+    0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x0d, 0x0a, 0x0d,
+    0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x89, 0xc0, 0x84, 0x3d, 0x41, 0x54, 0x2b, 0x43, 0x47, 0x4e, 0x53,
+    0x49, 0x4e, 0x46, 0x81, 0x00, 0x0d, 0x0a, 0x29, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x2b, 0x43, 0x47,
+    0x4e, 0x53, 0x49, 0x4e, 0x46, 0x3a, 0x20, 0x31, 0x2c, 0x30, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c,
+    0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x0d, 0x0a, 0x0d,
+    0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x89, 0xc0, 0x84, 0x3d, 0x41, 0x54, 0x2b, 0x43, 0x47, 0x4e, 0x53,
+    0x49, 0x4e, 0x46, 0x81, 0x00, 0x0d, 0x0a, 0x29, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x2b, 0x43, 0x47,
+    0x4e, 0x53, 0x49, 0x4e, 0x46, 0x3a, 0x20, 0x31, 0x2c, 0x30, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c,
+    0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x0d, 0x0a, 0x0d,
+    0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x89, 0xc0, 0x84, 0x3d, 0x41, 0x54, 0x2b, 0x43, 0x47, 0x4e, 0x53,
+    0x49, 0x4e, 0x46, 0x81, 0x00, 0x0d, 0x0a, 0x29, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x2b, 0x43, 0x47,
+    0x4e, 0x53, 0x49, 0x4e, 0x46, 0x3a, 0x20, 0x31, 0x2c, 0x30, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c,
+    0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x0d, 0x0a, 0x0d,
+    0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x89, 0xc0, 0x84, 0x3d, 0x41, 0x54, 0x2b, 0x43, 0x47, 0x4e, 0x53,
+    0x49, 0x4e, 0x46, 0x81, 0x00, 0x0d, 0x0a, 0x29, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x2b, 0x43, 0x47,
+    0x4e, 0x53, 0x49, 0x4e, 0x46, 0x3a, 0x20, 0x31, 0x2c, 0x30, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c,
+    0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x0d, 0x0a, 0x0d,
+    0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x89, 0xc0, 0x84, 0x3d, 0x41, 0x54, 0x2b, 0x43, 0x47, 0x4e, 0x53,
+    0x49, 0x4e, 0x46, 0x81, 0x00, 0x0d, 0x0a, 0x29, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x2b, 0x43, 0x47,
+    0x4e, 0x53, 0x49, 0x4e, 0x46, 0x3a, 0x20, 0x31, 0x2c, 0x30, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c,
+    0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x0d, 0x0a, 0x0d,
+    0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x89, 0xc0, 0x84, 0x3d, 0x41, 0x54, 0x2b, 0x43, 0x47, 0x4e, 0x53,
+    0x49, 0x4e, 0x46, 0x81, 0x00, 0x0d, 0x0a, 0x29, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x2b, 0x43, 0x47,
+    0x4e, 0x53, 0x49, 0x4e, 0x46, 0x3a, 0x20, 0x31, 0x2c, 0x30, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c,
+    0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x0d, 0x0a, 0x0d,
+    0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x89, 0xc0, 0x84, 0x3d, 0x41, 0x54, 0x2b, 0x43, 0x47, 0x4e, 0x53,
+    0x49, 0x4e, 0x46, 0x81, 0x00, 0x0d, 0x0a, 0x29, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x2b, 0x43, 0x47,
+    0x4e, 0x53, 0x49, 0x4e, 0x46, 0x3a, 0x20, 0x31, 0x2c, 0x30, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c,
+    0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x0d, 0x0a, 0x0d,
+    0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x89, 0xc0, 0x84, 0x3d, 0x41, 0x54, 0x2b, 0x43, 0x47, 0x4e, 0x53,
+    0x49, 0x4e, 0x46, 0x81, 0x00, 0x0d, 0x0a, 0x29, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x2b, 0x43, 0x47,
+    0x4e, 0x53, 0x49, 0x4e, 0x46, 0x3a, 0x20, 0x31, 0x2c, 0x30, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c,
+    0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x0d, 0x0a, 0x0d,
+    0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x89, 0xc0, 0x84, 0x3d, 0x41, 0x54, 0x2b, 0x43, 0x47, 0x4e, 0x53,
+    0x49, 0x4e, 0x46, 0x81, 0x00, 0x0d, 0x0a, 0x29, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x2b, 0x43, 0x47,
+    0x4e, 0x53, 0x49, 0x4e, 0x46, 0x3a, 0x20, 0x31, 0x2c, 0x30, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c,
+    0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x0d, 0x0a, 0x0d,
+    0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x89, 0xc0, 0x84, 0x3d, 0x41, 0x54, 0x2b, 0x43, 0x47, 0x4e, 0x53,
+    0x49, 0x4e, 0x46, 0x81, 0x00, 0x0d, 0x0a, 0x6f, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x2b, 0x43, 0x47,
+    0x4e, 0x53, 0x49, 0x4e, 0x46, 0x3a, 0x20, 0x31, 0x2c, 0x31, 0x2c, 0x32, 0x30, 0x32, 0x34, 0x30,
+    0x36, 0x30, 0x31, 0x30, 0x30, 0x30, 0x30, 0x33, 0x31, 0x2e, 0x30, 0x30, 0x30, 0x2c, 0x34, 0x35,
+    0x2e, 0x37, 0x36, 0x34, 0x30, 0x34, 0x35, 0x2c, 0x34, 0x2e, 0x38, 0x33, 0x35, 0x36, 0x36, 0x31,
+    0x2c, 0x31, 0x37, 0x30, 0x2e, 0x30, 0x30, 0x30, 0x2c, 0x30, 0x2e, 0x30, 0x30, 0x2c, 0x30, 0x2e,
+    0x30, 0x2c, 0x31, 0x2c, 0x2c, 0x31, 0x2e, 0x31, 0x2c, 0x31, 0x2e, 0x34, 0x2c, 0x30, 0x2e, 0x39,
+    0x2c, 0x2c, 0x31, 0x32, 0x2c, 0x38, 0x2c, 0x2c, 0x2c, 0x33, 0x35, 0x2c, 0x32, 0x2e, 0x34, 0x2c,
+    0x33, 0x2e, 0x31, 0x0d, 0x0a, 0x0d, 0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x8b, 0x00, 0x41, 0x54, 0x2b,
+    0x43, 0x47, 0x4e, 0x53, 0x50, 0x57, 0x52, 0x3d, 0x30, 0x81, 0x00, 0x0d, 0x0a, 0x05, 0xa0, 0x9c,
+    0x01, 0x0d, 0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0xd3, 0x80, 0x8e, 0xce, 0x1c, 0x41, 0x54, 0x2b, 0x43,
+    0x4e, 0x4d, 0x50, 0x3d, 0x33, 0x38, 0x3b, 0x2b, 0x43, 0x4d, 0x4e, 0x42, 0x3d, 0x31, 0x3b, 0x2b,
+    0x43, 0x4e, 0x41, 0x43, 0x54, 0x3d, 0x30, 0x2c, 0x30, 0x3b, 0x2b, 0x43, 0x47, 0x44, 0x43, 0x4f,
+    0x4e, 0x54, 0x3d, 0x31, 0x2c, 0x22, 0x49, 0x50, 0x22, 0x2c, 0x22, 0x69, 0x6f, 0x74, 0x2e, 0x31,
+    0x6e, 0x63, 0x65, 0x2e, 0x6e, 0x65, 0x74, 0x22, 0x3b, 0x2b, 0x43, 0x4e, 0x43, 0x46, 0x47, 0x3d,
+    0x30, 0x2c, 0x31, 0x2c, 0x69, 0x6f, 0x74, 0x2e, 0x31, 0x6e, 0x63, 0x65, 0x2e, 0x6e, 0x65, 0x74,
+    0x81, 0x00, 0x0d, 0x0a, 0x05, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x8b, 0x00,
+    0x41, 0x54, 0x2b, 0x43, 0x4e, 0x41, 0x43, 0x54, 0x3d, 0x30, 0x2c, 0x31, 0x81, 0x00, 0x0d, 0x0a,
+    0x05, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x15, 0xa0, 0xe8, 0x3b, 0x0d, 0x0a,
+    0x2b, 0x41, 0x50, 0x50, 0x20, 0x50, 0x44, 0x50, 0x3a, 0x20, 0x30, 0x2c, 0x41, 0x43, 0x54, 0x49,
+    0x56, 0x45, 0x0d, 0x0a, 0x8d, 0x00, 0x41, 0x54, 0x2b, 0x43, 0x45, 0x52, 0x45, 0x47, 0x3f, 0x3b,
+    0x2b, 0x43, 0x42, 0x43, 0x81, 0x00, 0x0d, 0x0a, 0x27, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x2b, 0x43,
+    0x45, 0x52, 0x45, 0x47, 0x3a, 0x20, 0x30, 0x2c, 0x35, 0x0d, 0x0a, 0x0d, 0x0a, 0x2b, 0x43, 0x42,
+    0x43, 0x3a, 0x20, 0x30, 0x2c, 0x38, 0x37, 0x2c, 0x34, 0x31, 0x30, 0x30, 0x0d, 0x0a, 0x0d, 0x0a,
+    0x4f, 0x4b, 0x0d, 0x0a, 0x88, 0x80, 0x89, 0x7a, 0x41, 0x54, 0x2b, 0x43, 0x4e, 0x41, 0x43, 0x54,
+    0x3f, 0x81, 0x00, 0x0d, 0x0a, 0x20, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x2b, 0x43, 0x4e, 0x41, 0x43,
+    0x54, 0x3a, 0x20, 0x30, 0x2c, 0x31, 0x2c, 0x22, 0x31, 0x30, 0x2e, 0x36, 0x34, 0x2e, 0x30, 0x2e,
+    0x32, 0x22, 0x0d, 0x0a, 0x0d, 0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0xcc, 0x00, 0x41, 0x54, 0x2b, 0x48,
+    0x54, 0x54, 0x50, 0x54, 0x4f, 0x46, 0x53, 0x3d, 0x22, 0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f,
+    0x69, 0x6f, 0x74, 0x31, 0x2e, 0x78, 0x74, 0x72, 0x61, 0x63, 0x6c, 0x6f, 0x75, 0x64, 0x2e, 0x6e,
+    0x65, 0x74, 0x2f, 0x78, 0x74, 0x72, 0x61, 0x33, 0x67, 0x72, 0x5f, 0x37, 0x32, 0x68, 0x2e, 0x62,
+    0x69, 0x6e, 0x22, 0x2c, 0x22, 0x2f, 0x63, 0x75, 0x73, 0x74, 0x6f, 0x6d, 0x65, 0x72, 0x2f, 0x58,
+    0x74, 0x72, 0x61, 0x33, 0x2e, 0x62, 0x69, 0x6e, 0x22, 0x81, 0x00, 0x0d, 0x0a, 0x05, 0xa0, 0x9c,
+    0x01, 0x0d, 0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x17, 0xa0, 0xf1, 0xb5, 0x01, 0x0d, 0x0a, 0x2b, 0x48,
+    0x54, 0x54, 0x50, 0x54, 0x4f, 0x46, 0x53, 0x3a, 0x20, 0x32, 0x30, 0x30, 0x2c, 0x33, 0x38, 0x30,
+    0x31, 0x36, 0x0d, 0x0a, 0x89, 0x00, 0x41, 0x54, 0x2b, 0x43, 0x47, 0x4e, 0x53, 0x43, 0x50, 0x59,
+    0x81, 0x00, 0x0d, 0x0a, 0x05, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x8c, 0x00,
+    0x41, 0x54, 0x2b, 0x43, 0x47, 0x4e, 0x53, 0x58, 0x54, 0x52, 0x41, 0x3d, 0x31, 0x81, 0x00, 0x0d,
+    0x0a, 0x05, 0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0xac, 0x00, 0x41, 0x54, 0x2b,
+    0x43, 0x41, 0x4f, 0x50, 0x45, 0x4e, 0x3d, 0x30, 0x2c, 0x30, 0x2c, 0x22, 0x54, 0x43, 0x50, 0x22,
+    0x2c, 0x22, 0x32, 0x2e, 0x74, 0x63, 0x70, 0x2e, 0x65, 0x75, 0x2e, 0x6e, 0x67, 0x72, 0x6f, 0x6b,
+    0x2e, 0x69, 0x6f, 0x22, 0x2c, 0x31, 0x32, 0x35, 0x39, 0x36, 0x81, 0x00, 0x0d, 0x0a, 0x26, 0xa0,
+    0x9c, 0x01, 0x0d, 0x0a, 0x2b, 0x43, 0x41, 0x4f, 0x50, 0x45, 0x4e, 0x3a, 0x20, 0x30, 0x2c, 0x30,
+    0x0d, 0x0a, 0x0d, 0x0a, 0x2b, 0x43, 0x41, 0x44, 0x41, 0x54, 0x41, 0x49, 0x4e, 0x44, 0x3a, 0x20,
+    0x30, 0x0d, 0x0a, 0x0d, 0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x8e, 0x00, 0x41, 0x54, 0x2b, 0x43, 0x41,
+    0x53, 0x45, 0x4e, 0x44, 0x3d, 0x30, 0x2c, 0x31, 0x33, 0x31, 0x81, 0x00, 0x0d, 0x0a, 0x03, 0xa0,
+    0x9c, 0x01, 0x0d, 0x0a, 0x3e, 0x20, 0xbf, 0x00, 0xa4, 0x61, 0x63, 0x02, 0x61, 0x69, 0x6f, 0x38,
+    0x36, 0x39, 0x39, 0x35, 0x31, 0x30, 0x33, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x31, 0x62, 0x69,
+    0x74, 0x82, 0xa2, 0x61, 0x64, 0xab, 0x62, 0x61, 0x6c, 0x19, 0x42, 0x68, 0x62, 0x63, 0x6f, 0x00,
+    0x64, 0x68, 0x64, 0x6f, 0x70, 0xfa, 0x3f, 0x8c, 0xcc, 0xcd, 0x63, 0x68, 0x70, 0x61, 0xfa, 0x40,
+    0x58, 0xf5, 0xc3, 0x62, 0x73, 0x70, 0x00, 0x62, 0xbf, 0x00, 0x73, 0x75, 0x08, 0x62, 0x73, 0x76,
+    0x0c, 0x61, 0x74, 0x1a, 0x66, 0x5a, 0x64, 0x9f, 0x63, 0x76, 0x70, 0x61, 0x19, 0x01, 0x36, 0x61,
+    0x78, 0x1a, 0x02, 0xe1, 0xdd, 0x02, 0x61, 0x79, 0x1a, 0x1b, 0x47, 0x0a, 0x02, 0x61, 0x74, 0x64,
+    0x47, 0x4e, 0x53, 0x53, 0xa2, 0x61, 0x64, 0xa1, 0x61, 0x62, 0x18, 0x57, 0x61, 0x74, 0x67, 0x42,
+    0x41, 0x54, 0x54, 0x45, 0x52, 0x59, 0x61, 0x74, 0x1a, 0x6a, 0x82, 0x00, 0xd2, 0xe0, 0x1c, 0x05,
+    0x88, 0xa4, 0x01, 0x0d, 0x0a, 0x4f, 0x4b, 0x0d, 0x0a, 0x8b, 0x00, 0x41, 0x54, 0x2b, 0x43, 0x41,
+    0x43, 0x4c, 0x4f, 0x53, 0x45, 0x3d, 0x30, 0x81, 0x00, 0x0d, 0x0a, 0x8b, 0xa8, 0x8c, 0x3d, 0x41,
+    0x54, 0x2b, 0x43, 0x41, 0x43, 0x4c, 0x4f, 0x53, 0x45, 0x3d, 0x30, 0x81, 0x00, 0x0d, 0x0a, 0x05,
+    0xa0, 0x9c, 0x01, 0x0d, 0x0a, 0x4f, 0x4b, 0x0d, 0x0a,
+};
+
+#endif // TEST_REPLAY_TRACE_H
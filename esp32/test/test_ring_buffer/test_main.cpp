@@ -0,0 +1,139 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <RingBuffer.hpp>
+
+/**
+ * @brief Source handing out a fixed text, like the UART FIFO for RingBuffer::receive()
+ */
+struct TextSource
+{
+    const char *text;
+    size_t left;
+    unsigned int reads = 0;
+
+    int available() { return (int)left; }
+
+    size_t read(uint8_t *buffer, size_t size)
+    {
+        size_t count = size < left ? size : left;
+        memcpy(buffer, text, count);
+        text += count;
+        left -= count;
+        reads++;
+        return count;
+    }
+};
+
+void setUp() {}
+void tearDown() {}
+
+void test_write_and_read_back()
+{
+    RingBuffer<16> ring;
+
+    TEST_ASSERT_EQUAL(16, ring.space());
+    TEST_ASSERT_EQUAL(5, ring.write("hello", 5));
+    TEST_ASSERT_EQUAL(5, ring.size());
+    TEST_ASSERT_EQUAL(0, ring.begin());
+    TEST_ASSERT_EQUAL(5, ring.end());
+    TEST_ASSERT_EQUAL_MEMORY("hello", ring.at(ring.begin()), 5);
+}
+
+void test_write_stops_when_full()
+{
+    RingBuffer<8> ring;
+
+    TEST_ASSERT_EQUAL(8, ring.write("0123456789", 10));
+    TEST_ASSERT_EQUAL(0, ring.space());
+    TEST_ASSERT_EQUAL(0, ring.write("x", 1));
+    TEST_ASSERT_EQUAL_MEMORY("01234567", ring.at(0), 8);
+}
+
+void test_span_across_the_end_is_contiguous()
+{
+    RingBuffer<8> ring;
+
+    ring.write("abcdef", 6);
+    ring.consume(5);
+    TEST_ASSERT_EQUAL(5, ring.write("ghijk", 5));
+
+    // Positions 5 to 10 wrap around index 0, the mirror keeps them in one piece
+    TEST_ASSERT_EQUAL(6, ring.size());
+    TEST_ASSERT_EQUAL_MEMORY("fghijk", ring.at(5), 6);
+}
+
+void test_clear_and_consume()
+{
+    RingBuffer<8> ring;
+
+    ring.write("abcd", 4);
+    ring.consume(2);
+    TEST_ASSERT_EQUAL(2, ring.size());
+    TEST_ASSERT_EQUAL(2, ring.begin());
+
+    ring.clear();
+    TEST_ASSERT_EQUAL(0, ring.size());
+    TEST_ASSERT_EQUAL(4, ring.begin());
+    TEST_ASSERT_EQUAL(8, ring.space());
+}
+
+void test_erase_closes_the_gap()
+{
+    RingBuffer<16> ring;
+
+    ring.write("OK\r\n+URC\r\nEND", 13);
+    ring.erase(4, 10);
+
+    TEST_ASSERT_EQUAL(7, ring.size());
+    TEST_ASSERT_EQUAL_MEMORY("OK\r\nEND", ring.at(0), 7);
+}
+
+void test_erase_across_the_end()
+{
+    RingBuffer<8> ring;
+
+    ring.write("123456", 6);
+    ring.consume(6);
+    ring.write("abcdefg", 7);
+    ring.erase(7, 9);
+
+    TEST_ASSERT_EQUAL(5, ring.size());
+    TEST_ASSERT_EQUAL_MEMORY("adefg", ring.at(6), 5);
+}
+
+void test_receive_takes_the_fifo_in_one_call()
+{
+    RingBuffer<16> ring;
+    ring.write("0123456789", 10);
+    ring.consume(10);
+
+    // 10 bytes from index 10, the copy is split at the end of the storage
+    TextSource source{"+CGNSINF: 1,1", 13};
+    TEST_ASSERT_EQUAL(13, ring.receive(source));
+    TEST_ASSERT_EQUAL(2, source.reads);
+    TEST_ASSERT_EQUAL_MEMORY("+CGNSINF: 1,1", ring.at(10), 13);
+}
+
+void test_receive_leaves_what_does_not_fit()
+{
+    RingBuffer<8> ring;
+    TextSource source{"0123456789", 10};
+
+    TEST_ASSERT_EQUAL(8, ring.receive(source));
+    TEST_ASSERT_EQUAL(2, source.left);
+    TEST_ASSERT_EQUAL(0, ring.receive(source));
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_write_and_read_back);
+    RUN_TEST(test_write_stops_when_full);
+    RUN_TEST(test_span_across_the_end_is_contiguous);
+    RUN_TEST(test_clear_and_consume);
+    RUN_TEST(test_erase_closes_the_gap);
+    RUN_TEST(test_erase_across_the_end);
+    RUN_TEST(test_receive_takes_the_fifo_in_one_call);
+    RUN_TEST(test_receive_leaves_what_does_not_fit);
+    return UNITY_END();
+}
@@ -0,0 +1,177 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <string>
+#include <EventLoop.hpp>
+#include <SIM7080G/Serial.hpp>
+#include <SIM7080G/ATCommands.hpp>
+#include <SIM7080G/Trace.hpp>
+#include <ScriptedModem.h>
+
+/**
+ * @brief Sink keeping the trace in memory
+ */
+class TextSink : public Print
+{
+public:
+    std::string bytes;
+
+    size_t write(uint8_t c) override
+    {
+        bytes += (char)c;
+        return 1;
+    }
+
+    using Print::write;
+};
+
+static ScriptedModem modem;
+
+/**
+ * @brief Send AT+GSN and run the loop until it is finished
+ *
+ * @return Time it took, in milliseconds
+ */
+static unsigned long runGSN(AT_RESPONSE &response)
+{
+    ATFuture future;
+    unsigned long start = millis();
+
+    while (!(response = ATCommands::GSN.send(future)).isFinished)
+    {
+        Sim7080G.loop();
+        events.wait();
+    }
+
+    return millis() - start;
+}
+
+void setUp()
+{
+    LittleFS.format();
+    modem.clear();
+}
+
+void tearDown() {}
+
+void test_record_format()
+{
+    TextSink sink;
+    TraceWriter writer;
+
+    writer.begin(sink);
+    TEST_ASSERT_EQUAL_MEMORY("SIMT\x01", sink.bytes.data(), 5);
+
+    delay(1);
+    writer.record(false, (const uint8_t *)"OK", 2);
+    writer.record(true, (const uint8_t *)"AT\r\n", 4);
+
+    // Received record of 2 bytes 1000 us later, 1000 as a varint, then a written one right after it
+    const char expected[] = "\x01\xE8\x07OK\x83\x00" "AT\r\n";
+    TEST_ASSERT_EQUAL(5 + sizeof(expected) - 1, sink.bytes.size());
+    TEST_ASSERT_EQUAL_MEMORY(expected, sink.bytes.data() + 5, sizeof(expected) - 1);
+}
+
+void test_long_write_is_split_into_records()
+{
+    TextSink sink;
+    TraceWriter writer;
+    uint8_t data[300];
+    memset(data, 'x', sizeof(data));
+
+    writer.begin(sink);
+    writer.record(false, data, sizeof(data));
+
+    // 128, 128 then 44 bytes, each with its header and a zero delay
+    TEST_ASSERT_EQUAL(5 + 3 * 2 + sizeof(data), sink.bytes.size());
+    TEST_ASSERT_EQUAL((char)(TRACE_RECORD_SIZE - 1), sink.bytes[5]);
+    TEST_ASSERT_EQUAL((char)(TRACE_RECORD_SIZE - 1), sink.bytes[5 + 2 + TRACE_RECORD_SIZE]);
+    TEST_ASSERT_EQUAL((char)(44 - 1), sink.bytes[5 + 2 * (2 + TRACE_RECORD_SIZE)]);
+}
+
+void test_inactive_writer_records_nothing()
+{
+    TraceWriter writer;
+
+    TEST_ASSERT_FALSE(writer.isActive());
+    writer.record(true, (const uint8_t *)"AT", 2);
+}
+
+void test_replay_rejects_other_files()
+{
+    File file = LittleFS.open("/other.bin", "w");
+    file.write((const uint8_t *)"JSON{}", 6);
+    file = LittleFS.open("/other.bin", "r");
+
+    TraceReplay replay;
+    TEST_ASSERT_FALSE(replay.begin(file));
+    TEST_ASSERT_FALSE(replay.isActive());
+}
+
+void test_replay_waits_for_the_command_and_the_delay()
+{
+    File file = LittleFS.open("/trace.bin", "w");
+    TraceWriter writer;
+    writer.begin(file);
+    writer.record(true, (const uint8_t *)"AT\r\n", 4);
+    delay(20);
+    writer.record(false, (const uint8_t *)"\r\nOK\r\n", 6);
+    writer.end();
+
+    file = LittleFS.open("/trace.bin", "r");
+    TraceReplay replay;
+    TEST_ASSERT_TRUE(replay.begin(file));
+
+    // Nothing before the command was written again, then nothing before its original delay
+    TEST_ASSERT_EQUAL(0, replay.available());
+    replay.write((const uint8_t *)"AT\r\n", 4);
+    TEST_ASSERT_EQUAL(0, replay.available());
+
+    delay(20);
+    TEST_ASSERT_EQUAL(6, replay.available());
+
+    char reply[6];
+    TEST_ASSERT_EQUAL(6, replay.readBytes(reply, sizeof(reply)));
+    TEST_ASSERT_EQUAL_MEMORY("\r\nOK\r\n", reply, 6);
+    TEST_ASSERT_EQUAL(-1, replay.read());
+}
+
+void test_session_replays_through_the_scheduler()
+{
+    modem.latency = 35;
+    modem.reply("AT+GSN", "\r\n869951030000001\r\n\r\nOK\r\n");
+    Sim7080G.emulator = &modem;
+    Sim7080G.linkState = LINK_READY;
+
+    File file = LittleFS.open("/trace.bin", "w");
+    Sim7080G.trace.begin(file);
+
+    AT_RESPONSE response;
+    unsigned long recorded = runGSN(response);
+    Sim7080G.trace.end();
+    TEST_ASSERT_EQUAL(AT_OK, response.status);
+
+    // Same answer after the same latency, without the modem
+    file = LittleFS.open("/trace.bin", "r");
+    TraceReplay replay;
+    TEST_ASSERT_TRUE(replay.begin(file));
+    Sim7080G.emulator = &replay;
+
+    unsigned long replayed = runGSN(response);
+
+    TEST_ASSERT_EQUAL(AT_OK, response.status);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, response.message.indexOf("869951030000001"));
+    TEST_ASSERT_UINT32_WITHIN(2, recorded, replayed);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_record_format);
+    RUN_TEST(test_long_write_is_split_into_records);
+    RUN_TEST(test_inactive_writer_records_nothing);
+    RUN_TEST(test_replay_rejects_other_files);
+    RUN_TEST(test_replay_waits_for_the_command_and_the_delay);
+    RUN_TEST(test_session_replays_through_the_scheduler);
+    return UNITY_END();
+}
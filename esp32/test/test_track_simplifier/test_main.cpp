@@ -0,0 +1,233 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <vector>
+#include <TrackSimplifier.hpp>
+#include "../test_benchmark/track.h"
+
+#define HOME_LATITUDE 457640430
+#define HOME_LONGITUDE 48356590
+
+/**
+ * @brief 1e-7 degrees of latitude in a meter
+ */
+#define UNITS_PER_METER 90
+
+struct Point
+{
+    int32_t latitude;
+    int32_t longitude;
+    unsigned long time;
+};
+
+static TrackSimplifier simplifier;
+
+/**
+ * @brief Push a track through the simplifier
+ *
+ * @return Indexes of the points kept, the last one flushed
+ */
+static std::vector<size_t> simplify(const std::vector<Point> &track)
+{
+    std::vector<size_t> kept;
+    for (size_t i = 0; i < track.size(); i++)
+    {
+        TrackDecision decision = simplifier.push(track[i].latitude, track[i].longitude, track[i].time);
+        if (decision == TRACK_KEEP)
+            kept.push_back(i);
+        else if (decision == TRACK_KEEP_PREVIOUS)
+            kept.push_back(i - 1);
+    }
+
+    if (simplifier.flush())
+        kept.push_back(track.size() - 1);
+
+    return kept;
+}
+
+/**
+ * @brief Largest distance of a dropped point to the segment between the kept points around it, in centimeters
+ */
+static uint32_t maxDeviation(const std::vector<Point> &track, const std::vector<size_t> &kept)
+{
+    uint32_t deviation = 0;
+
+    for (size_t k = 1; k < kept.size(); k++)
+    {
+        const Point &from = track[kept[k - 1]];
+        const Point &to = track[kept[k]];
+
+        for (size_t i = kept[k - 1] + 1; i < kept[k]; i++)
+        {
+            uint32_t distance = Coordinates::segmentDistance(track[i].latitude, track[i].longitude, from.latitude, from.longitude, to.latitude, to.longitude);
+            deviation = distance > deviation ? distance : deviation;
+        }
+    }
+
+    return deviation;
+}
+
+void setUp()
+{
+    simplifier.reset();
+    simplifier.tolerance = TRACK_TOLERANCE;
+}
+
+void tearDown() {}
+
+void test_first_point_is_kept()
+{
+    TEST_ASSERT_EQUAL(TRACK_KEEP, simplifier.push(HOME_LATITUDE, HOME_LONGITUDE, 0));
+    TEST_ASSERT_EQUAL(TRACK_HOLD, simplifier.push(HOME_LATITUDE + 10 * UNITS_PER_METER, HOME_LONGITUDE, 1000));
+}
+
+void test_straight_line_fills_the_window()
+{
+    simplifier.push(HOME_LATITUDE, HOME_LONGITUDE, 0);
+
+    for (int i = 1; i <= TRACK_WINDOW_SIZE; i++)
+        TEST_ASSERT_EQUAL(TRACK_HOLD, simplifier.push(HOME_LATITUDE + i * 10 * UNITS_PER_METER, HOME_LONGITUDE, i * 1000));
+
+    // The full window keeps its last point
+    TEST_ASSERT_EQUAL(TRACK_KEEP_PREVIOUS, simplifier.push(HOME_LATITUDE + 170 * UNITS_PER_METER, HOME_LONGITUDE, 17000));
+}
+
+void test_turn_keeps_the_corner()
+{
+    simplifier.push(HOME_LATITUDE, HOME_LONGITUDE, 0);
+
+    for (int i = 1; i <= 5; i++)
+        TEST_ASSERT_EQUAL(TRACK_HOLD, simplifier.push(HOME_LATITUDE + i * 20 * UNITS_PER_METER, HOME_LONGITUDE, i * 1000));
+
+    // 30 m to the east of the corner, the corner is 20 m away from the shortcut
+    int32_t corner = HOME_LATITUDE + 100 * UNITS_PER_METER;
+    TEST_ASSERT_EQUAL(TRACK_KEEP_PREVIOUS, simplifier.push(corner, HOME_LONGITUDE + 30 * UNITS_PER_METER * 10 / 7, 6000));
+}
+
+void test_max_span_runs_from_the_kept_point()
+{
+    unsigned long step = 1000UL * 60 * 2;
+    simplifier.push(HOME_LATITUDE, HOME_LONGITUDE, 0);
+
+    // Slow and straight, only the span ends the segments
+    unsigned long keptTime = 0;
+    for (int i = 1; i <= 20; i++)
+    {
+        unsigned long time = i * step;
+        TrackDecision decision = simplifier.push(HOME_LATITUDE + i * UNITS_PER_METER, HOME_LONGITUDE, time);
+
+        if (time - keptTime > TRACK_MAX_SPAN)
+        {
+            TEST_ASSERT_EQUAL(TRACK_KEEP_PREVIOUS, decision);
+            keptTime = time - step;
+        }
+        else
+        {
+            TEST_ASSERT_EQUAL(TRACK_HOLD, decision);
+        }
+    }
+}
+
+void test_dropped_points_stay_within_tolerance()
+{
+    // A walk with turns and 3 m of jitter, a point a second
+    std::vector<Point> track;
+    srand(21);
+    int32_t latitude = HOME_LATITUDE;
+    int32_t longitude = HOME_LONGITUDE;
+
+    for (unsigned long time = 0; time < 1000UL * 60 * 20; time += 1000)
+    {
+        int heading = (time / 45000) % 4;
+        latitude += heading == 0 ? 130 : heading == 2 ? -60 : 10;
+        longitude += heading == 1 ? 170 : heading == 3 ? -90 : 15;
+        track.push_back({latitude + (rand() % 540 - 270), longitude + (rand() % 760 - 380), time});
+    }
+
+    std::vector<size_t> kept = simplify(track);
+
+    TEST_ASSERT_EQUAL(0, kept.front());
+    TEST_ASSERT_EQUAL(track.size() - 1, kept.back());
+    TEST_ASSERT_LESS_THAN(track.size() / 3, kept.size());
+
+    // Rounding of the integer distance, a centimeter or two
+    TEST_ASSERT_LESS_OR_EQUAL(TRACK_TOLERANCE * 100 + 2, maxDeviation(track, kept));
+}
+
+void test_flush_ends_the_segment()
+{
+    TEST_ASSERT_FALSE(simplifier.flush());
+
+    simplifier.push(HOME_LATITUDE, HOME_LONGITUDE, 0);
+    TEST_ASSERT_FALSE(simplifier.flush());
+
+    simplifier.push(HOME_LATITUDE + 50 * UNITS_PER_METER, HOME_LONGITUDE, 1000);
+    TEST_ASSERT_TRUE(simplifier.flush());
+    TEST_ASSERT_FALSE(simplifier.flush());
+
+    // The flushed point is the new anchor, a point 20 m off its line from the first one is only held
+    TEST_ASSERT_EQUAL(TRACK_HOLD, simplifier.push(HOME_LATITUDE + 50 * UNITS_PER_METER, HOME_LONGITUDE + 20 * UNITS_PER_METER, 2000));
+}
+
+void test_zero_tolerance_keeps_every_point()
+{
+    simplifier.tolerance = 0;
+
+    for (int i = 0; i < 5; i++)
+        TEST_ASSERT_EQUAL(TRACK_KEEP, simplifier.push(HOME_LATITUDE + i * UNITS_PER_METER, HOME_LONGITUDE, i * 1000));
+}
+
+void test_reset_starts_a_new_track()
+{
+    simplifier.push(HOME_LATITUDE, HOME_LONGITUDE, 0);
+    simplifier.push(HOME_LATITUDE + UNITS_PER_METER, HOME_LONGITUDE, 1000);
+    simplifier.reset();
+
+    TEST_ASSERT_FALSE(simplifier.flush());
+    TEST_ASSERT_EQUAL(TRACK_KEEP, simplifier.push(HOME_LATITUDE, HOME_LONGITUDE, 2000));
+}
+
+/**
+ * @brief Compression of the recorded track of test_benchmark against the largest deviation, for a few tolerances
+ *
+ * @details The kept points are those queued for the upload, each about 85 bytes of CBOR.
+ */
+void test_recorded_track_compression()
+{
+    std::vector<Point> track;
+    for (const SimulatorWaypoint &waypoint : RECORDED_TRACK)
+        track.push_back({(int32_t)lround(waypoint.latitude * 1e7), (int32_t)lround(waypoint.longitude * 1e7), waypoint.time});
+
+    static const uint32_t tolerances[] = {0, 5, 10, 20, 50};
+
+    printf("\n  tolerance m   points   kept   ratio   max deviation m\n");
+    for (uint32_t tolerance : tolerances)
+    {
+        simplifier.reset();
+        simplifier.tolerance = tolerance;
+
+        std::vector<size_t> kept = simplify(track);
+        uint32_t deviation = maxDeviation(track, kept);
+
+        printf("  %11u  %7u  %5u  %5.1fx  %16.2f\n", (unsigned)tolerance, (unsigned)track.size(), (unsigned)kept.size(),
+               (double)track.size() / kept.size(), deviation / 100.0);
+
+        TEST_ASSERT_LESS_OR_EQUAL(tolerance * 100 + 2, deviation);
+        if (tolerance == 0)
+            TEST_ASSERT_EQUAL(track.size(), kept.size());
+    }
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_first_point_is_kept);
+    RUN_TEST(test_straight_line_fills_the_window);
+    RUN_TEST(test_turn_keeps_the_corner);
+    RUN_TEST(test_max_span_runs_from_the_kept_point);
+    RUN_TEST(test_dropped_points_stay_within_tolerance);
+    RUN_TEST(test_flush_ends_the_segment);
+    RUN_TEST(test_zero_tolerance_keeps_every_point);
+    RUN_TEST(test_reset_starts_a_new_track);
+    RUN_TEST(test_recorded_track_compression);
+    return UNITY_END();
+}
@@ -3,7 +3,7 @@ import bodyParser from "body-parser";
 import TCPServer from "./src/classes/TCPServer";
 import TCPClient from "./src/classes/TCPClient";
 import mongoose from "mongoose";
-import { getStore, print } from "./src/utils";
+import { getStore, print, toCellValue, toGNSSValue } from "./src/utils";
 // import { encode, decode } from "./cbor";
 // import { decode } from "cbor-x/decode";
 import { decode, diagnose, encode } from "cbor2";
@@ -167,15 +167,20 @@ tcpServer.on("data", async (client: TCPClient, data: Buffer) => {
                 tcpData.it.forEach(async (item) => {
                     switch (item.t) {
                         case "GNSS":
-                            print("GNSS Data Received:");
-                            print("GNSS Details:", item.d);
+                        case "CELL":
+                            /*
+                             * Cell positions, sent when the GNSS got no fix, go on the map with the fixes
+                             */
+                            print(`${item.t} Data Received:`);
+                            print(`${item.t} Details:`, item.d);
+                            const gnssValue =
+                                item.t === "GNSS"
+                                    ? toGNSSValue(item.d)
+                                    : toCellValue(item.d);
+
                             await Data.create({
                                 IoT_Id: deviceFind._id,
-                                ValueReceive: {
-                                    Longitude: item.d.lo,
-                                    latitude: item.d.la,
-                                    Time: item.d.t,
-                                },
+                                ValueReceive: gnssValue,
                                 TypeValue: "GPS",
                             });
 
@@ -212,9 +217,14 @@ tcpServer.on("data", async (client: TCPClient, data: Buffer) => {
                                     type: "GPS",
                                     data: {
                                         imei: tcpData.i,
-                                        longitude: item.d.lo,
-                                        latitude: item.d.la,
-                                        time: item.d.t,
+                                        longitude: gnssValue.Longitude,
+                                        latitude: gnssValue.latitude,
+                                        time: gnssValue.Time,
+                                        altitude: gnssValue.Altitude,
+                                        speed: gnssValue.Speed,
+                                        course: gnssValue.Course,
+                                        source: gnssValue.Source,
+                                        accuracy: gnssValue.Accuracy,
                                     },
                                 },
                                 wsClientsUUIDs
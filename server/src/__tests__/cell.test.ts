@@ -0,0 +1,52 @@
+import { toCellValue } from '../utils';
+
+describe('Cell Position Decoding Tests', () => {
+    test('should store a cell position as a coarse GPS value', () => {
+        /*
+        * Item data as sent by the firmware, CELLData::to_json()
+        */
+        const value = toCellValue({
+            t: 1717245296,
+            y: 457670440,
+            x: 48356590,
+            acc: 550,
+            mcc: 208,
+            mnc: 1,
+            tac: 7002,
+            ci: 27446555,
+            rsrp: -95
+        });
+
+        expect(value).toEqual({
+            latitude: 45.767044,
+            Longitude: 4.835659,
+            Time: 1717245296,
+            Source: 'CELL',
+            Accuracy: 550,
+            Cell: {
+                Mcc: 208,
+                Mnc: 1,
+                Tac: 7002,
+                Id: 27446555,
+                Rsrp: -95
+            }
+        });
+    });
+
+    test('should not carry the GNSS-only fields', () => {
+        const value = toCellValue({
+            t: 1717245296,
+            y: 457670440,
+            x: 48356590,
+            acc: 2000,
+            mcc: 0,
+            mnc: 0,
+            tac: 0,
+            ci: 0,
+            rsrp: 0
+        });
+
+        expect(value.Altitude).toBeUndefined();
+        expect(value.SatellitesUsed).toBeUndefined();
+    });
+});
@@ -0,0 +1,63 @@
+import { toGNSSValue } from '../utils';
+
+describe('GNSS Data Decoding Tests', () => {
+    test('should convert the integer-scaled fields to plain units', () => {
+        /*
+        * Item data as sent by the firmware, GNSSData::to_json()
+        */
+        const value = toGNSSValue({
+            t: 1717245296,
+            y: 455000000,
+            x: 42500000,
+            hdop: 1.5,
+            hpa: 2.5,
+            al: 17050,
+            sp: 1234,
+            co: 8750,
+            vpa: 310,
+            sv: 12,
+            su: 8
+        });
+
+        expect(value).toEqual({
+            latitude: 45.5,
+            Longitude: 4.25,
+            Time: 1717245296,
+            Source: 'GNSS',
+            Altitude: 170.5,
+            Speed: 12.34,
+            Course: 87.5,
+            Vpa: 3.1,
+            SatellitesInView: 12,
+            SatellitesUsed: 8
+        });
+    });
+
+    test('should keep the seventh decimal of the coordinates', () => {
+        const value = toGNSSValue({
+            t: 1717245296,
+            y: -457640431,
+            x: 1799999999,
+            hdop: 1.5,
+            hpa: 2.5
+        });
+
+        expect(value.latitude).toBe(-45.7640431);
+        expect(value.Longitude).toBe(179.9999999);
+    });
+
+    test('should leave out the fields older firmware does not send', () => {
+        const value = toGNSSValue({
+            t: 1717245296,
+            la: 45.5,
+            lo: 4.25,
+            hdop: 1.5,
+            hpa: 2.5
+        });
+
+        expect(value.latitude).toBe(45.5);
+        expect(value.Longitude).toBe(4.25);
+        expect(value.Altitude).toBeUndefined();
+        expect(value.SatellitesUsed).toBeUndefined();
+    });
+});
@@ -265,6 +265,58 @@ const options: swaggerJsdoc.Options = {
                             type: 'number',
                             format: 'float',
                             description: 'Longitude in degrees'
+                        },
+                        Time: {
+                            type: 'number',
+                            description: 'UTC time of the fix, Unix time in seconds'
+                        },
+                        Altitude: {
+                            type: 'number',
+                            format: 'float',
+                            description: 'MSL altitude in meters'
+                        },
+                        Speed: {
+                            type: 'number',
+                            format: 'float',
+                            description: 'Speed over ground in km/h'
+                        },
+                        Course: {
+                            type: 'number',
+                            format: 'float',
+                            description: 'Course over ground in degrees'
+                        },
+                        Vpa: {
+                            type: 'number',
+                            format: 'float',
+                            description: 'Vertical position accuracy in meters'
+                        },
+                        SatellitesInView: {
+                            type: 'integer',
+                            description: 'GNSS satellites in view'
+                        },
+                        SatellitesUsed: {
+                            type: 'integer',
+                            description: 'GNSS satellites used for the fix'
+                        },
+                        Source: {
+                            type: 'string',
+                            enum: ['GNSS', 'CELL'],
+                            description: 'GNSS fix, or coarse cell position when the GNSS got no fix'
+                        },
+                        Accuracy: {
+                            type: 'number',
+                            description: 'Horizontal accuracy in meters, cell positions only'
+                        },
+                        Cell: {
+                            type: 'object',
+                            description: 'Serving cell of a cell position',
+                            properties: {
+                                Mcc: { type: 'integer' },
+                                Mnc: { type: 'integer' },
+                                Tac: { type: 'integer' },
+                                Id: { type: 'integer' },
+                                Rsrp: { type: 'integer', description: 'RSRP in dBm' }
+                            }
                         }
                     }
                 }
@@ -17,5 +17,21 @@ export interface IDataGNSS extends Omit<IData, 'ValueReceive'> {
     ValueReceive: {
         latitude: number; // Latitude in degrees
         Longitude: number; // Longitude in degrees
+        Time: number; // UTC time of the fix, Unix time in seconds
+        Altitude?: number; // MSL altitude in meters
+        Speed?: number; // Speed over ground in km/h
+        Course?: number; // Course over ground in degrees
+        Vpa?: number; // Vertical position accuracy in meters
+        SatellitesInView?: number;
+        SatellitesUsed?: number;
+        Source?: "GNSS" | "CELL"; // Missing for GNSS fixes stored before cell positions
+        Accuracy?: number; // Horizontal accuracy in meters, cell positions only
+        Cell?: {
+            Mcc: number;
+            Mnc: number;
+            Tac: number;
+            Id: number;
+            Rsrp: number;
+        };
     };
 }
\ No newline at end of file
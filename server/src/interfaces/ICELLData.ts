@@ -0,0 +1,15 @@
+import IIOTData from "./IIOTData";
+
+export default interface ICELLData extends IIOTData {
+    d: {
+        t: number; // UTC time given by the location service, Unix time in seconds
+        y: number; // Latitude in 1e-7 degrees
+        x: number; // Longitude in 1e-7 degrees
+        acc: number; // Accuracy in meters
+        mcc: number; // Mobile country code of the serving cell, 0 if unknown
+        mnc: number; // Mobile network code of the serving cell
+        tac: number; // Tracking area code of the serving cell
+        ci: number; // Cell identity of the serving cell
+        rsrp: number; // RSRP of the serving cell in dBm
+    };
+}
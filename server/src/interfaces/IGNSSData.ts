@@ -2,7 +2,18 @@ import IIOTData from "./IIOTData";
 
 export default interface IGNSSData extends IIOTData {
     d: {
-        latitude: number; // Latitude in degrees
-        Longitude: number; // Longitude in degrees
+        t: number; // UTC time of the fix, Unix time in seconds
+        y?: number; // Latitude in 1e-7 degrees
+        x?: number; // Longitude in 1e-7 degrees
+        la?: number; // Latitude in degrees, older firmware sends it in place of y
+        lo?: number; // Longitude in degrees, older firmware sends it in place of x
+        hdop: number; // Horizontal dilution of precision
+        hpa: number; // Horizontal position accuracy in meters
+        al?: number; // MSL altitude in centimeters
+        sp?: number; // Speed over ground in hundredths of km/h
+        co?: number; // Course over ground in hundredths of degrees
+        vpa?: number; // Vertical position accuracy in centimeters
+        sv?: number; // GNSS satellites in view
+        su?: number; // GNSS satellites used for the fix
     };
 }
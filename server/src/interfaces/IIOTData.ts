@@ -3,7 +3,7 @@ export default interface IIOTData {
      * @type {string}
      * @description Type of the data, e.g., "GNSSData", "SensorData", etc.
      */
-    t: "GNSS" | "BATTERY" | "Sensor" | "IOT";
+    t: "GNSS" | "CELL" | "BATTERY" | "Sensor" | "IOT";
 
     /**
      * @type {any}
@@ -1,6 +1,7 @@
 import IGNSSData from "./IGNSSData";
 import IIOTData from "./IIOTData";
 import IBATTERYData from "./IBATTERYData";
+import ICELLData from "./ICELLData";
 
 export default interface ITCPReceiveData {
     /**
@@ -23,10 +24,10 @@ export default interface ITCPReceiveData {
     t: number;
 
     /**
-     * @type {IGNSSData[] | IIOTData[] |IBATTERYData[]}
+     * @type {IGNSSData[] | ICELLData[] | IIOTData[] |IBATTERYData[]}
      * @description Array of GNSS or other IoT data
      */
-    it: IGNSSData[] | IIOTData[] | IBATTERYData[]; // Array of GNSS or other IOT data
+    it: IGNSSData[] | ICELLData[] | IIOTData[] | IBATTERYData[]; // Array of GNSS or other IOT data
 
     /**
      * @type {string}
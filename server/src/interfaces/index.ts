@@ -5,3 +5,4 @@ export * from "./UsersInterface";
 export * from "./ITCPReceiveData";
 export * from "./IIOTData";
 export * from "./IGNSSData";
+export * from "./ICELLData";
@@ -1,6 +1,9 @@
 import MongoStore from "connect-mongo";
 import { Request, Response, NextFunction } from "express";
 import { z } from "zod";
+import IGNSSData from "./interfaces/IGNSSData";
+import ICELLData from "./interfaces/ICELLData";
+import { IDataGNSS } from "./interfaces/DataInterface";
 
 let store: MongoStore;
 
@@ -59,3 +62,71 @@ export const getStore = (): MongoStore => {
 
     return store;
 };
+
+/**
+ * Divides an integer-scaled value sent by a device, missing values stay missing
+ * @param {number | undefined} value - Scaled value
+ * @param {number} scale - Scale of the value
+ * @returns {number | undefined} Value in plain units
+ */
+const unscale = (value: number | undefined, scale: number): number | undefined => {
+    return value === undefined ? undefined : value / scale;
+};
+
+/**
+ * Scale of the coordinates sent by a device, integers in 1e-7 degrees
+ */
+export const COORDINATE_SCALE = 1e7;
+
+/**
+ * Reads a coordinate sent by a device, as an integer in 1e-7 degrees or, from older firmware, in degrees
+ * @param {number | undefined} scaled - Coordinate in 1e-7 degrees
+ * @param {number | undefined} degrees - Coordinate in degrees
+ * @returns {number} Coordinate in degrees
+ */
+const toDegrees = (scaled: number | undefined, degrees: number | undefined): number => {
+    return scaled !== undefined ? scaled / COORDINATE_SCALE : degrees ?? 0;
+};
+
+/**
+ * Converts the payload of a GNSS item sent by a device to the value stored in the database
+ * @param {IGNSSData["d"]} data - Payload of the GNSS item, integer-scaled fields
+ * @returns {IDataGNSS["ValueReceive"]} Value in plain units
+ */
+export const toGNSSValue = (data: IGNSSData["d"]): IDataGNSS["ValueReceive"] => {
+    return {
+        latitude: toDegrees(data.y, data.la),
+        Longitude: toDegrees(data.x, data.lo),
+        Time: data.t,
+        Source: "GNSS",
+        Altitude: unscale(data.al, 100),
+        Speed: unscale(data.sp, 100),
+        Course: unscale(data.co, 100),
+        Vpa: unscale(data.vpa, 100),
+        SatellitesInView: data.sv,
+        SatellitesUsed: data.su,
+    };
+};
+
+/**
+ * Converts the payload of a CELL item sent by a device to the value stored in the database
+ * Cell positions are stored with the GNSS fixes so that the map stays populated, Source tells them apart
+ * @param {ICELLData["d"]} data - Payload of the CELL item
+ * @returns {IDataGNSS["ValueReceive"]} Value in plain units
+ */
+export const toCellValue = (data: ICELLData["d"]): IDataGNSS["ValueReceive"] => {
+    return {
+        latitude: data.y / COORDINATE_SCALE,
+        Longitude: data.x / COORDINATE_SCALE,
+        Time: data.t,
+        Source: "CELL",
+        Accuracy: data.acc,
+        Cell: {
+            Mcc: data.mcc,
+            Mnc: data.mnc,
+            Tac: data.tac,
+            Id: data.ci,
+            Rsrp: data.rsrp,
+        },
+    };
+};